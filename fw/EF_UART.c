@@ -25,13 +25,12 @@
 #define EF_UART_C
 
 #include <EF_UART.h>
+#include <EF_UART_inline.h>
 #include <version.h>
 
-#define EF_UART0_BASE ((uint32_t) 0x10000000)       // Base address of the UART registers
-                                                    // This is a dummy address, the actual address should be defined in the linker script
-
-
+#ifndef EF_UART_REG_SPACE
 #define EF_UART_REG_SPACE ((EF_UART_REGS*)EF_UART0_BASE)
+#endif
 
 
 /* Driver Version */
@@ -46,229 +45,523 @@ static const DRIVER_VERSION DriverVersion = {
 //
 
 
-static DRIVER_VERSION EF_UART_getVersion(void){
+DRIVER_VERSION EF_UART_getVersion(void){
 
     return DriverVersion;
 }
 
-static void EF_UART_enable(void){
+void EF_UART_enable(EF_UART_REGS *uart){
 
     // set the enable bit to 1 at the specified offset
-    EF_UART_REG_SPACE->CTRL |= (1 << EF_UART_CTRL_REG_EN_BIT);
+    uart->CTRL |= (1 << EF_UART_CTRL_REG_EN_BIT);
     return;
 }
 
 
-static void EF_UART_setGclkEnable (uint32_t value){
+void EF_UART_setGclkEnable(EF_UART_REGS *uart, uint32_t value){
 
-    EF_UART_REG_SPACE->GCLK = value;
+    uart->GCLK = value;
     return;
 }
 
 
-static void EF_UART_disable(void){
+void EF_UART_disable(EF_UART_REGS *uart){
 
     // Clear the enable bit using the specified  mask
-    EF_UART_REG_SPACE->CTRL &= ~EF_UART_CTRL_REG_EN_MASK;
+    uart->CTRL &= ~EF_UART_CTRL_REG_EN_MASK;
     return;
 }
 
 
-static void EF_UART_enableRx(void){
+void EF_UART_enableRx(EF_UART_REGS *uart){
     
     // set the enable bit to 1 at the specified offset
-    EF_UART_REG_SPACE->CTRL |= (1 << EF_UART_CTRL_REG_RXEN_BIT);
+    uart->CTRL |= (1 << EF_UART_CTRL_REG_RXEN_BIT);
     return;
 }
 
 
-static void EF_UART_disableRx(void){
+void EF_UART_disableRx(EF_UART_REGS *uart){
     
     // Clear the enable bit using the specified  mask
-    EF_UART_REG_SPACE->CTRL &= ~EF_UART_CTRL_REG_RXEN_MASK;
+    uart->CTRL &= ~EF_UART_CTRL_REG_RXEN_MASK;
     return;
 }
 
 
-static void EF_UART_enableTx(void){
+void EF_UART_enableTx(EF_UART_REGS *uart){
 
     // set the enable bit to 1 at the specified offset
-    EF_UART_REG_SPACE->CTRL |= (1 << EF_UART_CTRL_REG_TXEN_BIT);
+    uart->CTRL |= (1 << EF_UART_CTRL_REG_TXEN_BIT);
     return;
 }
 
 
-static void EF_UART_disableTx(void){
+void EF_UART_disableTx(EF_UART_REGS *uart){
 
     // Clear the enable bit using the specified  mask
-    EF_UART_REG_SPACE->CTRL &= ~EF_UART_CTRL_REG_TXEN_MASK;
+    uart->CTRL &= ~EF_UART_CTRL_REG_TXEN_MASK;
     return;
 }
 
 
-static void EF_UART_enableLoopBack(void){
+void EF_UART_enableLoopBack(EF_UART_REGS *uart){
 
     // set the enable bit to 1 at the specified offset
-    EF_UART_REG_SPACE->CTRL |= (1 << EF_UART_CTRL_REG_LPEN_BIT);
+    uart->CTRL |= (1 << EF_UART_CTRL_REG_LPEN_BIT);
     return;
 }
 
 
-static void EF_UART_disableLoopBack(void){
+void EF_UART_disableLoopBack(EF_UART_REGS *uart){
 
     // Clear the enable bit using the specified  mask
-    EF_UART_REG_SPACE->CTRL &= ~EF_UART_CTRL_REG_LPEN_MASK;
+    uart->CTRL &= ~EF_UART_CTRL_REG_LPEN_MASK;
     return;
 }
 
 
-static void EF_UART_enableGlitchFilter(void){
-
-    // Clear the enable bit using the specified  mask
-    EF_UART_REG_SPACE->CTRL &= ~EF_UART_CTRL_REG_GFEN_MASK;
+void EF_UART_enableGlitchFilter(EF_UART_REGS *uart){
 
     // set the enable bit to 1 at the specified offset
-    EF_UART_REG_SPACE->CTRL |= (1 << EF_UART_CTRL_REG_GFEN_BIT);
+    uart->CTRL |= (1 << EF_UART_CTRL_REG_GFEN_BIT);
     return;
 }
 
 
-static void EF_UART_disableGlitchFilter(void){
+void EF_UART_disableGlitchFilter(EF_UART_REGS *uart){
 
     // Clear the enable bit using the specified  mask
-    EF_UART_REG_SPACE->CTRL &= ~EF_UART_CTRL_REG_GFEN_MASK;
+    uart->CTRL &= ~EF_UART_CTRL_REG_GFEN_MASK;
+    return;
+}
+
+
+void EF_UART_setFlowControl(EF_UART_REGS *uart, bool rts, bool cts, uint32_t rts_level){
+
+    // the watermark is changed with RTS off so rts_n never follows a half written setting
+    uint32_t ctrl = uart->CTRL & ~(EF_UART_CTRL_REG_RTSEN_MASK | EF_UART_CTRL_REG_CTSEN_MASK);
+    uart->CTRL = ctrl;
+    uart->RTS = rts_level & EF_UART_RTS_REG_LEVEL_MASK;
+    if (rts)
+        ctrl |= EF_UART_CTRL_REG_RTSEN_MASK;
+    if (cts)
+        ctrl |= EF_UART_CTRL_REG_CTSEN_MASK;
+    uart->CTRL = ctrl;
+    return;
+}
+
+void EF_UART_setRS485(EF_UART_REGS *uart, bool enable, uint32_t lead_bits, uint32_t lag_bits){
+
+    // the timing is changed with de off, the next character starts with a full lead time
+    uart->CTRL &= ~EF_UART_CTRL_REG_DEEN_MASK;
+    if (!enable)
+        return;
+    uart->DE = ((lead_bits << EF_UART_DE_REG_LEAD_BIT) & EF_UART_DE_REG_LEAD_MASK) |
+               ((lag_bits << EF_UART_DE_REG_LAG_BIT) & EF_UART_DE_REG_LAG_MASK);
+    uart->CTRL |= EF_UART_CTRL_REG_DEEN_MASK;
+    return;
+}
+
+void EF_UART_setMultidrop(EF_UART_REGS *uart, bool enable, uint32_t address, uint32_t mask){
+
+    // clearing ADEN drops the current selection, so a new address takes effect from the next address frame
+    uart->CTRL &= ~EF_UART_CTRL_REG_ADEN_MASK;
+    if (!enable)
+        return;
+    // the receiver compares all 9 bits, and the ninth bit of an address frame is always set
+    uart->MATCH = EF_UART_ADDRESS_FLAG | address;
+    uart->MATCH_MASK = mask & ~EF_UART_ADDRESS_FLAG;
+    uart->CTRL |= EF_UART_CTRL_REG_ADEN_MASK;
+    return;
+}
+
+
+void EF_UART_setCTRL(EF_UART_REGS *uart, uint32_t value){
+
+    uart->CTRL = value;
+    return;
+}
+
+
+uint32_t EF_UART_getCTRL(EF_UART_REGS *uart){
+
+    return (uart->CTRL);
+}
+
+
+void EF_UART_setDataSize(EF_UART_REGS *uart, uint32_t value){
+
+    // Replace the field bits in a single read-modify-write
+    uart->CFG = (uart->CFG & ~EF_UART_CFG_REG_WLEN_MASK) | ((value << EF_UART_CFG_REG_WLEN_BIT) & EF_UART_CFG_REG_WLEN_MASK);
+    return;
+}
+
+
+void EF_UART_setPrescaler(EF_UART_REGS *uart, uint32_t prescaler){
+
+    uart->PR = prescaler;
     return;
 }
 
 
-static void EF_UART_setCTRL(uint32_t value){
+uint32_t EF_UART_getPrescaler(EF_UART_REGS *uart){
+
+    return (uart->PR);
+}
+
+
+void EF_UART_setPrescalerFraction(EF_UART_REGS *uart, uint32_t fraction){
 
-    EF_UART_REG_SPACE->CTRL = value;
+    uart->PRF = fraction;
     return;
 }
 
 
-static uint32_t EF_UART_getCTRL(void){
+uint32_t EF_UART_getPrescalerFraction(EF_UART_REGS *uart){
+
+    return (uart->PRF);
+}
+
+
+// Error in ppm of the baud rate given by a divisor in 1/16 of the prescaler
+static int32_t EF_UART_baudError(uint32_t clk_hz, uint32_t baud, uint32_t samples, uint32_t divisor){
+
+    uint64_t achieved = ((uint64_t)clk_hz * EF_UART_PRF_STEPS * 1000000) / ((uint64_t)divisor * samples);
+    return (int32_t)(((int64_t)achieved - (int64_t)baud * 1000000) / baud);
+}
+
+
+int32_t EF_UART_calcBaudRate(uint32_t clk_hz, uint32_t baud, uint32_t samples, uint32_t *prescaler, uint32_t *fraction){
+
+    // PR+1 ranges from 1 to 2^16 and PRF from 0 to 15, in 1/16 that is 16 to 2^20+15
+    const uint32_t min_divisor = EF_UART_PRF_STEPS;
+    const uint32_t max_divisor = (0x10000 * EF_UART_PRF_STEPS) + EF_UART_PRF_STEPS - 1;
+
+    if (baud == 0)
+        baud = 1;
+
+    // the exact divisor lies between two steps; take the one with the smaller error
+    uint64_t divisor = ((uint64_t)clk_hz * EF_UART_PRF_STEPS) / ((uint64_t)baud * samples);
+    if (divisor < min_divisor)
+        divisor = min_divisor;
+    if (divisor > max_divisor)
+        divisor = max_divisor;
+    int32_t error = EF_UART_baudError(clk_hz, baud, samples, divisor);
+    if (divisor < max_divisor){
+        int32_t next_error = EF_UART_baudError(clk_hz, baud, samples, divisor + 1);
+        if (((next_error < 0) ? -next_error : next_error) < ((error < 0) ? -error : error)){
+            divisor++;
+            error = next_error;
+        }
+    }
+
+    *prescaler = (divisor / EF_UART_PRF_STEPS) - 1;
+    *fraction = divisor % EF_UART_PRF_STEPS;
+    return error;
+}
+
+
+int32_t EF_UART_setBaudRate(EF_UART_REGS *uart, uint32_t clk_hz, uint32_t baud){
+
+    uint32_t prescaler, fraction;
+    int32_t error = EF_UART_calcBaudRate(clk_hz, baud, EF_UART_getSamplesPerBit(uart), &prescaler, &fraction);
+
+    uart->PR = prescaler;
+    uart->PRF = fraction;
+    return error;
+}
 
-    return (EF_UART_REG_SPACE->CTRL);
+
+bool EF_UART_autoBaud(EF_UART_REGS *uart, uint32_t timeout){
+
+    // same range as in EF_UART_calcBaudRate
+    const uint32_t min_divisor = EF_UART_PRF_STEPS;
+    const uint32_t max_divisor = (0x10000 * EF_UART_PRF_STEPS) + EF_UART_PRF_STEPS - 1;
+    uint32_t samples = EF_UART_getSamplesPerBit(uart);
+    uint32_t polls = 0;
+
+    uart->IC = EF_UART_ABR_FLAG;
+    uart->CTRL |= EF_UART_CTRL_REG_ABREN_MASK;
+    while ((uart->RIS & EF_UART_ABR_FLAG) == 0){
+        if ((timeout != 0) && (++polls == timeout)){
+            uart->CTRL &= ~EF_UART_CTRL_REG_ABREN_MASK;
+            return false;
+        }
+    }
+    uint32_t count = (uart->ABR & EF_UART_ABR_REG_COUNT_MASK) >> EF_UART_ABR_REG_COUNT_BIT;
+    uart->IC = EF_UART_ABR_FLAG;
+
+    // count is 8 bit times; a bit is divisor/16 * samples cycles, so the divisor is count * 16 / (8 * samples)
+    bool measured = (count != 0);
+    if (measured){
+        uint32_t divisor = ((2 * count) + (samples / 2)) / samples;
+        if (divisor < min_divisor)
+            divisor = min_divisor;
+        if (divisor > max_divisor)
+            divisor = max_divisor;
+        uart->PR = (divisor / EF_UART_PRF_STEPS) - 1;
+        uart->PRF = divisor % EF_UART_PRF_STEPS;
+    }
+    // the receiver starts again at the new rate
+    uart->CTRL &= ~EF_UART_CTRL_REG_ABREN_MASK;
+    return measured;
+}
+
+bool EF_UART_getStats(EF_UART_REGS *uart, EF_UART_STATS *stats){
+
+    if ((uart->CAP & EF_UART_CAP_REG_STATS_MASK) == 0)
+        return false;
+
+    // one write captures all the counters at the same cycle; the reads that follow cannot tear
+    uart->STATS_SNAP = EF_UART_STATS_SNAP_REG_SNAP_MASK;
+    uint32_t fe_pe = uart->STATS_FE_PE;
+    uint32_t or_brk = uart->STATS_OR_BRK;
+    uint32_t max = uart->STATS_MAX;
+    stats->tx_chars = uart->STATS_TX;
+    stats->rx_chars = uart->STATS_RX;
+    stats->frame_errors = (fe_pe & EF_UART_STATS_FE_PE_REG_FE_MASK) >> EF_UART_STATS_FE_PE_REG_FE_BIT;
+    stats->parity_errors = (fe_pe & EF_UART_STATS_FE_PE_REG_PE_MASK) >> EF_UART_STATS_FE_PE_REG_PE_BIT;
+    stats->overruns = (or_brk & EF_UART_STATS_OR_BRK_REG_OR_MASK) >> EF_UART_STATS_OR_BRK_REG_OR_BIT;
+    stats->breaks = (or_brk & EF_UART_STATS_OR_BRK_REG_BRK_MASK) >> EF_UART_STATS_OR_BRK_REG_BRK_BIT;
+    stats->timeouts = uart->STATS_RTO;
+    stats->rx_fifo_max = (max & EF_UART_STATS_MAX_REG_RXMAX_MASK) >> EF_UART_STATS_MAX_REG_RXMAX_BIT;
+    stats->tx_fifo_max = (max & EF_UART_STATS_MAX_REG_TXMAX_MASK) >> EF_UART_STATS_MAX_REG_TXMAX_BIT;
+    return true;
 }
 
+void EF_UART_setSyncWord(EF_UART_REGS *uart, bool enable, uint32_t pattern, uint32_t mask, uint32_t length, bool hunt){
+
+    // clearing en restarts the search, and the hunt with it
+    uart->SYNC_CTRL = 0;
+    if (!enable)
+        return;
+    uart->SYNC = pattern;
+    uart->SYNC_MASK = mask;
+    uart->SYNC_CTRL = (((length - 1) << EF_UART_SYNC_CTRL_REG_LEN_BIT) & EF_UART_SYNC_CTRL_REG_LEN_MASK) |
+                      EF_UART_SYNC_CTRL_REG_EN_MASK |
+                      (hunt ? EF_UART_SYNC_CTRL_REG_HUNT_MASK : 0);
+    return;
+}
 
-static void EF_UART_setDataSize(uint32_t value){
+bool EF_UART_setCRC(EF_UART_REGS *uart, bool enable, uint32_t width, uint32_t poly, uint32_t init, bool reflect, bool invert){
+
+    uint32_t size;
+
+    if ((uart->CAP & EF_UART_CAP_REG_CRC_MASK) == 0)
+        return false;
+    if (width == 8)
+        size = 0;
+    else if (width == 16)
+        size = 1;
+    else if (width == 32)
+        size = 2;
+    else
+        return false;
+
+    uart->CRC_CTRL = 0;
+    uart->CRC_POLY = poly;
+    uart->CRC_INIT = init;
+    uart->CRC_CTRL = (enable ? EF_UART_CRC_CTRL_REG_EN_MASK : 0) |
+                     (size << EF_UART_CRC_CTRL_REG_SIZE_BIT) |
+                     (reflect ? (EF_UART_CRC_CTRL_REG_REFIN_MASK | EF_UART_CRC_CTRL_REG_REFOUT_MASK) : 0) |
+                     (invert ? EF_UART_CRC_CTRL_REG_INV_MASK : 0);
+    // the restart aligns CRC_INIT to the width in CRC_CTRL, so it comes last
+    uart->CRC_RST = EF_UART_CRC_RST_REG_TX_MASK | EF_UART_CRC_RST_REG_RX_MASK;
+    return true;
+}
 
-    // Clear the field bits in the register using the defined mask
-    EF_UART_REG_SPACE->CFG &= ~EF_UART_CFG_REG_WLEN_MASK;
+void EF_UART_crcReset(EF_UART_REGS *uart, bool tx, bool rx){
 
-    // Set the bits with the given value at the defined offset
-    EF_UART_REG_SPACE->CFG |= ((value << EF_UART_CFG_REG_WLEN_BIT) & EF_UART_CFG_REG_WLEN_MASK);
+    uart->CRC_RST = (tx ? EF_UART_CRC_RST_REG_TX_MASK : 0) | (rx ? EF_UART_CRC_RST_REG_RX_MASK : 0);
     return;
 }
 
+bool EF_UART_crcGetTx(EF_UART_REGS *uart, uint32_t *crc, uint32_t timeout){
+
+    uint32_t polls = 0;
+
+    // a character is added when it leaves the FIFO, so an empty FIFO means all of them are in
+    while ((uart->STATUS & EF_UART_STATUS_REG_TXLVL_MASK) != 0){
+        if ((timeout != 0) && (++polls == timeout))
+            return false;
+    }
+    *crc = uart->CRC_TX;
+    return true;
+}
+
+uint32_t EF_UART_crcGetRx(EF_UART_REGS *uart){
+
+    return uart->CRC_RX;
+}
 
-static void EF_UART_setPrescaler(uint32_t prescaler){
+void EF_UART_setFrameGap(EF_UART_REGS *uart, uint32_t gap){
 
-    EF_UART_REG_SPACE->PR = prescaler;
+    uart->GAP = gap;
     return;
 }
 
+uint32_t EF_UART_readGapFrame(EF_UART_REGS *uart, uint8_t *data, uint32_t length, uint32_t *errors){
+
+    uint8_t discard[4];
+    // one read pops the descriptor; the characters of the frame are already in the RX FIFO
+    uint32_t frame = uart->FRAME;
+    uint32_t frame_length = (frame & EF_UART_FRAME_REG_LEN_MASK) >> EF_UART_FRAME_REG_LEN_BIT;
+
+    *errors = frame & (EF_UART_FRAME_REG_FE_MASK | EF_UART_FRAME_REG_PE_MASK |
+                       EF_UART_FRAME_REG_OR_MASK | EF_UART_FRAME_REG_MERGED_MASK);
+    if (frame_length < length)
+        length = frame_length;
+    EF_UART_readBufferInline(uart, data, length);
+    // the rest of a frame longer than data is dropped, so the next frame starts at the head of the RX FIFO
+    for (uint32_t rest = frame_length - length; rest != 0; ){
+        uint32_t count = (rest < sizeof(discard)) ? rest : sizeof(discard);
+        EF_UART_readBufferInline(uart, discard, count);
+        rest -= count;
+    }
+    return frame_length;
+}
 
-static uint32_t EF_UART_getPrescaler(void){
+void EF_UART_setSynchronous(EF_UART_REGS *uart, bool enable, bool external_clock){
 
-    return (EF_UART_REG_SPACE->PR);
+    // the mode is changed with the UART off, so no character is cut between the two clocks
+    uint32_t ctrl = uart->CTRL & ~(EF_UART_CTRL_REG_SCEN_MASK | EF_UART_CTRL_REG_SCEXT_MASK);
+    uart->CTRL = ctrl & ~EF_UART_CTRL_REG_EN_MASK;
+    if (enable)
+        ctrl |= EF_UART_CTRL_REG_SCEN_MASK | (external_clock ? EF_UART_CTRL_REG_SCEXT_MASK : 0);
+    uart->CTRL = ctrl;
+    return;
 }
 
 
-static void EF_UART_setTwoStopBitsSelect(bool is_two_bits){
+void EF_UART_setTwoStopBitsSelect(EF_UART_REGS *uart, bool is_two_bits){
 
     if (is_two_bits){
 
         // set the enable bit to 1 at the specified offset
-        EF_UART_REG_SPACE->CFG |= (1 << EF_UART_CFG_REG_STP2_BIT);
+        uart->CFG |= (1 << EF_UART_CFG_REG_STP2_BIT);
 
     }
     else {
         // Clear the enable bit using the specified  mask
-        EF_UART_REG_SPACE->CFG &= ~EF_UART_CFG_REG_STP2_MASK;
+        uart->CFG &= ~EF_UART_CFG_REG_STP2_MASK;
     }
     return;
 }
 
-static void EF_UART_setParityType(enum parity_type parity){
+void EF_UART_setParityType(EF_UART_REGS *uart, enum parity_type parity){
 
-    // Clear the field bits in the register using the defined mask
-    EF_UART_REG_SPACE->CFG &= ~EF_UART_CFG_REG_PARITY_MASK;
-
-    // Set the bits with the given value at the defined offset
-    EF_UART_REG_SPACE->CFG |= ((parity << EF_UART_CFG_REG_PARITY_BIT) & EF_UART_CFG_REG_PARITY_MASK);
+    // Replace the field bits in a single read-modify-write
+    uart->CFG = (uart->CFG & ~EF_UART_CFG_REG_PARITY_MASK) | ((parity << EF_UART_CFG_REG_PARITY_BIT) & EF_UART_CFG_REG_PARITY_MASK);
     return;
 }
 
-static void EF_UART_setTimeoutBits(uint32_t value){
+void EF_UART_setTimeoutBits(EF_UART_REGS *uart, uint32_t value){
+
+    // Replace the field bits in a single read-modify-write
+    uart->CFG = (uart->CFG & ~EF_UART_CFG_REG_TIMEOUT_MASK) | ((value << EF_UART_CFG_REG_TIMEOUT_BIT) & EF_UART_CFG_REG_TIMEOUT_MASK);
+    return;
+}
 
-    // Clear the field bits in the register using the defined mask
-    EF_UART_REG_SPACE->CFG &= ~EF_UART_CFG_REG_TIMEOUT_MASK;
+void EF_UART_setOversampling(EF_UART_REGS *uart, enum oversampling_type oversampling){
 
-    // Set the bits with the given value at the defined offset
-    EF_UART_REG_SPACE->CFG |= ((value << EF_UART_CFG_REG_TIMEOUT_BIT) & EF_UART_CFG_REG_TIMEOUT_MASK);
+    uart->CFG = (uart->CFG & ~EF_UART_CFG_REG_OSR_MASK) | (((uint32_t)oversampling << EF_UART_CFG_REG_OSR_BIT) & EF_UART_CFG_REG_OSR_MASK);
     return;
 }
 
-static void EF_UART_setConfig(uint32_t value){
+void EF_UART_setMajorityVote(EF_UART_REGS *uart, bool enable){
 
-    EF_UART_REG_SPACE->CFG = value;
+    if (enable)
+        uart->CFG |= EF_UART_CFG_REG_MAJ_MASK;
+    else
+        uart->CFG &= ~EF_UART_CFG_REG_MAJ_MASK;
     return;
 }
 
-static uint32_t EF_UART_getConfig(void){
+uint32_t EF_UART_getSamplesPerBit(EF_UART_REGS *uart){
 
-    return (EF_UART_REG_SPACE->CFG);
+    // a synchronous bit is one period of sclk, which toggles on every tick
+    if (uart->CTRL & EF_UART_CTRL_REG_SCEN_MASK)
+        return 2;
+    switch ((uart->CFG & EF_UART_CFG_REG_OSR_MASK) >> EF_UART_CFG_REG_OSR_BIT){
+    case OVERSAMPLING_16:   return 16;
+    case OVERSAMPLING_8:    return 8;
+    case OVERSAMPLING_4:    return 4;
+    default:                return EF_UART_SAMPLES;
+    }
+}
+
+void EF_UART_setConfig(EF_UART_REGS *uart, uint32_t value){
+
+    uart->CFG = value;
     return;
 }
 
-static void EF_UART_setRxFIFOThreshold(uint32_t value){
+uint32_t EF_UART_getConfig(EF_UART_REGS *uart){
 
-    EF_UART_REG_SPACE->RX_FIFO_THRESHOLD = value;
+    return (uart->CFG);
+}
+
+void EF_UART_setRxFIFOThreshold(EF_UART_REGS *uart, uint32_t value){
+
+    uart->RX_FIFO_THRESHOLD = value;
     return;
 }
 
-static uint32_t EF_UART_getRxFIFOThreshold(void){
+uint32_t EF_UART_getRxFIFOThreshold(EF_UART_REGS *uart){
 
-    return (EF_UART_REG_SPACE->RX_FIFO_THRESHOLD);
+    return (uart->RX_FIFO_THRESHOLD);
 }
 
-static void EF_UART_setTxFIFOThreshold(uint32_t value){
+void EF_UART_setTxFIFOThreshold(EF_UART_REGS *uart, uint32_t value){
 
-    EF_UART_REG_SPACE->TX_FIFO_THRESHOLD=value;
+    uart->TX_FIFO_THRESHOLD=value;
     return;
 }
 
-static uint32_t EF_UART_getTxFIFOThreshold(void){
+uint32_t EF_UART_getTxFIFOThreshold(EF_UART_REGS *uart){
+
+    return (uart->TX_FIFO_THRESHOLD);
+}
+
+
+uint32_t EF_UART_getTxCount(EF_UART_REGS *uart){
+
+    return(uart->TX_FIFO_LEVEL);
+}
+
+uint32_t EF_UART_getRxCount(EF_UART_REGS *uart){
 
-    return (EF_UART_REG_SPACE->TX_FIFO_THRESHOLD);
+    return(uart->RX_FIFO_LEVEL);
 }
 
 
-static uint32_t EF_UART_getTxCount(void){
+uint32_t EF_UART_getStatus(EF_UART_REGS *uart){
+
+    return EF_UART_getStatusInline(uart);
+}
+
+uint32_t EF_UART_getCapabilities(EF_UART_REGS *uart){
 
-    return(EF_UART_REG_SPACE->TX_FIFO_LEVEL);
+    return (uart->CAP);
 }
 
-static uint32_t EF_UART_getRxCount(void){
+uint32_t EF_UART_getFIFODepth(EF_UART_REGS *uart){
 
-    return(EF_UART_REG_SPACE->RX_FIFO_LEVEL);
+    return 1u << ((uart->CAP & EF_UART_CAP_REG_FAW_MASK) >> EF_UART_CAP_REG_FAW_BIT);
 }
 
 
-static void EF_UART_setMatchData(uint32_t matchData){
+void EF_UART_setMatchData(EF_UART_REGS *uart, uint32_t matchData){
 
-    EF_UART_REG_SPACE->MATCH = matchData;
+    uart->MATCH = matchData;
     return;
 }
 
 
-static uint32_t EF_UART_getMatchData(void){
+uint32_t EF_UART_getMatchData(EF_UART_REGS *uart){
 
-    return (EF_UART_REG_SPACE->MATCH);
+    return (uart->MATCH);
 }
 
  // Interrupts bits in RIS, MIS, IM, and ICR
@@ -282,53 +575,95 @@ static uint32_t EF_UART_getMatchData(void){
  // bit 7: parity error
  // bit 8: overrun 
  // bit 9: timeout 
+ // bit 10: transmission complete
+ // bit 11: baud rate measured
+ // bit 12: coalesced RX/TX event
+ // bit 13: noise detected by the majority vote
+ // bit 14: sync word received
+ // bit 15: end of frame (idle gap)
 
-static uint32_t EF_UART_getRIS(void){
+uint32_t EF_UART_getRIS(EF_UART_REGS *uart){
 
-    return (EF_UART_REG_SPACE->RIS);
+    return EF_UART_getRISInline(uart);
 }
 
-static uint32_t EF_UART_getMIS(void){
+uint32_t EF_UART_getMIS(EF_UART_REGS *uart){
 
-    return (EF_UART_REG_SPACE->MIS);
+    return (uart->MIS);
 }
 
-static void EF_UART_setIM(uint32_t mask){
+void EF_UART_setIM(EF_UART_REGS *uart, uint32_t mask){
 
-    EF_UART_REG_SPACE->IM |= mask;
+    uart->IM |= mask;
     return;
 }
 
-static uint32_t EF_UART_getIM(void){
+uint32_t EF_UART_getIM(EF_UART_REGS *uart){
 
-    return (EF_UART_REG_SPACE->IM);
+    return (uart->IM);
 }
 
-static void EF_UART_setICR(uint32_t mask){
+void EF_UART_setICR(EF_UART_REGS *uart, uint32_t mask){
 
-    (EF_UART_REG_SPACE->IC) |= mask;
+    EF_UART_setICRInline(uart, mask);
     return;
 }
 
 
-static void EF_UART_writeChar(char data){
+void EF_UART_writeChar(EF_UART_REGS *uart, char data){
+
+    EF_UART_writeCharInline(uart, data);
+    return;
+}
+
+void EF_UART_writeAddress(EF_UART_REGS *uart, uint32_t address){
 
-    while((EF_UART_getRIS() & EF_UART_TXE_FLAG) == 0x0); // wait until TX empty flag is 1  
-    EF_UART_REG_SPACE->TXDATA = data;
-    EF_UART_setICR(EF_UART_TXE_FLAG);
+    while((EF_UART_getRIS(uart) & EF_UART_TXE_FLAG) == 0x0); // wait until TX empty flag is 1
+    uart->TXDATA = EF_UART_ADDRESS_FLAG | address;
+    EF_UART_setICR(uart, EF_UART_TXE_FLAG);
     return;
 }
 
-static void EF_UART_writeCharArr(const char *char_arr){
+void EF_UART_writeCharArr(EF_UART_REGS *uart, const char *char_arr){
 
     while (*char_arr){
-        while((EF_UART_getRIS() & EF_UART_TXB_FLAG) == 0x0); // wait until tx level below flag is 1
-        EF_UART_REG_SPACE->TXDATA = (*(char_arr++));
-        EF_UART_setICR(EF_UART_TXB_FLAG);
+        while((EF_UART_getRIS(uart) & EF_UART_TXB_FLAG) == 0x0); // wait until tx level below flag is 1
+        uart->TXDATA = (*(char_arr++));
+        EF_UART_setICR(uart, EF_UART_TXB_FLAG);
+    }
+    return;
+}
+
+void EF_UART_writeBuffer(EF_UART_REGS *uart, const uint8_t *data, uint32_t length){
+
+    // the same loop as EF_UART_writeBufferInline, with the depth of this instance instead of EF_UART_FIFO_DEPTH
+    uint32_t depth = EF_UART_getFIFODepth(uart);
+
+    while (length){
+        uint32_t count = EF_UART_txFreeInline(depth, uart->STATUS);
+        if (count > length)
+            count = length;
+        EF_UART_writeFIFOInline(uart, data, count);
+        data += count;
+        length -= count;
     }
     return;
 }
 
+void EF_UART_writeBufferAndWait(EF_UART_REGS *uart, const uint8_t *data, uint32_t length){
+
+    if (length == 0)
+        return;
+    // TC may be left over from an earlier transmission. This one cannot raise it before its first character has
+    // been sent, so it is cleared right after that character is queued.
+    EF_UART_writeBuffer(uart, data, 1);
+    uart->IC = EF_UART_TC_FLAG;
+    EF_UART_writeBuffer(uart, data + 1, length - 1);
+    while ((uart->RIS & EF_UART_TC_FLAG) == 0);
+    uart->IC = EF_UART_TC_FLAG;
+    return;
+}
+
 /*void EF_UART_writeInt(uint32_t uart_base, char data){
 
     EF_UART_REGS* uart = (EF_UART_REGS*)uart_base;
@@ -337,59 +672,1216 @@ static void EF_UART_writeCharArr(const char *char_arr){
     EF_UART_setICR(uart_base, 0x2);
 }*/
 
-static uint32_t EF_UART_readChar(void){
+uint32_t EF_UART_readChar(EF_UART_REGS *uart){
+
+    return EF_UART_readCharInline(uart);
+}
+
+void EF_UART_readBuffer(EF_UART_REGS *uart, uint8_t *data, uint32_t length){
+
+    EF_UART_readBufferInline(uart, data, length);
+    return;
+}
+
+uint32_t EF_UART_readBufferTagged(EF_UART_REGS *uart, uint8_t *data, uint32_t *errors, uint32_t length){
+
+    uint32_t tags = 0;
+    uint32_t index = 0;
+
+    for (uint32_t i = 0; i < (length + 31) / 32; i++)
+        errors[i] = 0;
+    while (index < length){
+        uint32_t count = (uart->STATUS & EF_UART_STATUS_REG_RXLVL_MASK) >> EF_UART_STATUS_REG_RXLVL_BIT;
+        if (count > length - index)
+            count = length - index;
+        while (count--){
+            // one read per byte, the tags come with it
+            uint32_t word = uart->RXDATA;
+            data[index] = (uint8_t)word;
+            if (word & EF_UART_RXDATA_ERROR_MASK)
+                errors[index / 32] |= (uint32_t)1 << (index % 32);
+            tags |= word;
+            index++;
+        }
+    }
+    return tags & EF_UART_RXDATA_TAGS_MASK;
+}
+
+uint32_t EF_UART_readUntil(EF_UART_REGS *uart, char delimiter, uint8_t *data, uint32_t length){
+
+    uint32_t count = 0;
+    uint32_t mis = 0;
+
+    // the address filter compares against MATCH and MATCH_MASK, they cannot hold the delimiter meanwhile
+    if ((length == 0) || (uart->CTRL & EF_UART_CTRL_REG_ADEN_MASK))
+        return 0;
+
+    uint32_t match = uart->MATCH;
+    uint32_t match_mask = uart->MATCH_MASK;
+    uint32_t im = uart->IM;
+    uart->MATCH = (uint8_t)delimiter;
+    uart->MATCH_MASK = 0;
+    uart->IM = EF_UART_MATCH_FLAG | EF_UART_RTO_FLAG | EF_UART_RXF_FLAG;
+    while (1){
+        // Clear the events before draining; whatever arrives after the drain raises them again
+        uart->IC = EF_UART_MATCH_FLAG | EF_UART_RTO_FLAG | EF_UART_RXF_FLAG;
+        uint32_t level = (uart->STATUS & EF_UART_STATUS_REG_RXLVL_MASK) >> EF_UART_STATUS_REG_RXLVL_BIT;
+        bool done = false;
+        while (level-- && !done){
+            uint8_t c = uart->RXDATA;
+            data[count++] = c;
+            // bytes after the delimiter stay in the FIFO for the next call
+            done = (c == (uint8_t)delimiter) || (count == length);
+        }
+        // or the line has been idle for the timeout, and everything received is drained
+        if (done || (mis & EF_UART_RTO_FLAG))
+            break;
+        // sleep until the delimiter, the end of the frame or a full FIFO raises the interrupt
+        while ((mis = uart->MIS) == 0)
+            EF_UART_WAIT_FOR_IRQ(uart);
+    }
+    uart->IM = im;
+    uart->MATCH = match;
+    uart->MATCH_MASK = match_mask;
+    return count;
+}
+
+
+//
+//   Shadowed configuration
+//
+
+EF_UART_CONFIG *EF_UART_configSetPrescaler(EF_UART_CONFIG *config, uint32_t prescaler){
+
+    config->PR = prescaler;
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetPrescalerFraction(EF_UART_CONFIG *config, uint32_t fraction){
+
+    config->PRF = fraction;
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetCTRL(EF_UART_CONFIG *config, uint32_t value){
+
+    config->CTRL = value;
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetDataSize(EF_UART_CONFIG *config, uint32_t value){
+
+    config->CFG = (config->CFG & ~EF_UART_CFG_REG_WLEN_MASK) | ((value << EF_UART_CFG_REG_WLEN_BIT) & EF_UART_CFG_REG_WLEN_MASK);
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetTwoStopBitsSelect(EF_UART_CONFIG *config, bool is_two_bits){
+
+    config->CFG = (config->CFG & ~EF_UART_CFG_REG_STP2_MASK) | (is_two_bits ? EF_UART_CFG_REG_STP2_MASK : 0);
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetParityType(EF_UART_CONFIG *config, enum parity_type parity){
+
+    config->CFG = (config->CFG & ~EF_UART_CFG_REG_PARITY_MASK) | ((parity << EF_UART_CFG_REG_PARITY_BIT) & EF_UART_CFG_REG_PARITY_MASK);
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetTimeoutBits(EF_UART_CONFIG *config, uint32_t value){
+
+    config->CFG = (config->CFG & ~EF_UART_CFG_REG_TIMEOUT_MASK) | ((value << EF_UART_CFG_REG_TIMEOUT_BIT) & EF_UART_CFG_REG_TIMEOUT_MASK);
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetOversampling(EF_UART_CONFIG *config, enum oversampling_type oversampling){
+
+    config->CFG = (config->CFG & ~EF_UART_CFG_REG_OSR_MASK) | (((uint32_t)oversampling << EF_UART_CFG_REG_OSR_BIT) & EF_UART_CFG_REG_OSR_MASK);
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetMajorityVote(EF_UART_CONFIG *config, bool enable){
+
+    if (enable)
+        config->CFG |= EF_UART_CFG_REG_MAJ_MASK;
+    else
+        config->CFG &= ~EF_UART_CFG_REG_MAJ_MASK;
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetRxFIFOThreshold(EF_UART_CONFIG *config, uint32_t value){
+
+    config->RX_FIFO_THRESHOLD = value;
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetTxFIFOThreshold(EF_UART_CONFIG *config, uint32_t value){
+
+    config->TX_FIFO_THRESHOLD = value;
+    return config;
+}
+
+EF_UART_CONFIG *EF_UART_configSetIM(EF_UART_CONFIG *config, uint32_t mask){
+
+    config->IM = mask;
+    return config;
+}
+
+void EF_UART_readConfig(EF_UART_REGS *uart, EF_UART_CONFIG *config){
+
+    config->PR = uart->PR;
+    config->PRF = uart->PRF;
+    config->CTRL = uart->CTRL;
+    config->CFG = uart->CFG;
+    config->RX_FIFO_THRESHOLD = uart->RX_FIFO_THRESHOLD;
+    config->TX_FIFO_THRESHOLD = uart->TX_FIFO_THRESHOLD;
+    config->IM = uart->IM;
+    return;
+}
+
+uint32_t EF_UART_applyConfig(EF_UART_REGS *uart, EF_UART_CONFIG *shadow, const EF_UART_CONFIG *config){
+
+    uint32_t writes = 0;
+    bool frame_changed = (config->PR != shadow->PR) || (config->PRF != shadow->PRF) || (config->CFG != shadow->CFG);
+
+    // The baud rate and the frame format are only changed while the UART is disabled,
+    // so the line never sees a half applied configuration
+    if (frame_changed && (shadow->CTRL & EF_UART_CTRL_REG_EN_MASK)){
+        shadow->CTRL &= ~EF_UART_CTRL_REG_EN_MASK;
+        uart->CTRL = shadow->CTRL;
+        writes++;
+    }
+    if (config->PR != shadow->PR){
+        uart->PR = shadow->PR = config->PR;
+        writes++;
+    }
+    if (config->PRF != shadow->PRF){
+        uart->PRF = shadow->PRF = config->PRF;
+        writes++;
+    }
+    if (config->CFG != shadow->CFG){
+        uart->CFG = shadow->CFG = config->CFG;
+        writes++;
+    }
+    if (config->RX_FIFO_THRESHOLD != shadow->RX_FIFO_THRESHOLD){
+        uart->RX_FIFO_THRESHOLD = shadow->RX_FIFO_THRESHOLD = config->RX_FIFO_THRESHOLD;
+        writes++;
+    }
+    if (config->TX_FIFO_THRESHOLD != shadow->TX_FIFO_THRESHOLD){
+        uart->TX_FIFO_THRESHOLD = shadow->TX_FIFO_THRESHOLD = config->TX_FIFO_THRESHOLD;
+        writes++;
+    }
+    if (config->CTRL != shadow->CTRL){
+        uart->CTRL = shadow->CTRL = config->CTRL;
+        writes++;
+    }
+    if (config->IM != shadow->IM){
+        uart->IM = shadow->IM = config->IM;
+        writes++;
+    }
+    return writes;
+}
+
+
+//
+//   Interrupt driven mode
+//
+
+static bool EF_UART_isPowerOfTwo(uint32_t value){
+
+    return (value != 0) && ((value & (value - 1)) == 0);
+}
+
+static void EF_UART_ringInit(EF_UART_RING_BUFFER *ring, uint8_t *buffer, uint32_t size){
+
+    ring->buffer = buffer;
+    ring->mask = size - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    return;
+}
+
+// Move as many bytes as the RX FIFO holds into the RX ring buffer
+static void EF_UART_drainRxFIFO(EF_UART_IRQ_STATE *state){
+
+    EF_UART_REGS *uart = state->regs;
+    EF_UART_RING_BUFFER *ring = &state->rx;
+    uint32_t head = ring->head;
+    uint32_t count = (uart->STATUS & EF_UART_STATUS_REG_RXLVL_MASK) >> EF_UART_STATUS_REG_RXLVL_BIT;
+
+    while (count){
+        // 4 bytes per access while there are 4 to pop, the rest one at a time
+        uint32_t n = (count >= 4) ? 4 : 1;
+        uint32_t word = (n == 4) ? uart->RXDATA_PACKED : uart->RXDATA;
+        count -= n;
+        for (; n != 0; n--, word >>= 8){
+            if ((head - ring->tail) > ring->mask){
+                // ring buffer is full; the FIFO still has to be drained to release the interrupt
+                state->rx_dropped++;
+                continue;
+            }
+            ring->buffer[head & ring->mask] = (uint8_t)word;
+            head++;
+        }
+    }
+    ring->head = head;
+    return;
+}
+
+// Move bytes from the TX ring buffer into the free TX FIFO entries; returns the number of bytes left in the ring buffer
+static uint32_t EF_UART_fillTxFIFO(EF_UART_IRQ_STATE *state){
+
+    EF_UART_REGS *uart = state->regs;
+    EF_UART_RING_BUFFER *ring = &state->tx;
+    uint32_t tail = ring->tail;
+    uint32_t pending = ring->head - tail;
+    uint32_t space = EF_UART_txFreeInline(state->fifo_depth, uart->STATUS);
+
+    if (space > pending)
+        space = pending;
+    pending -= space;
+    for (; space >= 4; space -= 4, tail += 4)
+        uart->TXDATA_PACKED = (uint32_t)ring->buffer[tail & ring->mask] | ((uint32_t)ring->buffer[(tail + 1) & ring->mask] << 8) |
+                              ((uint32_t)ring->buffer[(tail + 2) & ring->mask] << 16) | ((uint32_t)ring->buffer[(tail + 3) & ring->mask] << 24);
+    while (space--){
+        uart->TXDATA = ring->buffer[tail & ring->mask];
+        tail++;
+    }
+    ring->tail = tail;
+    return pending;
+}
+
+bool EF_UART_initIRQMode(EF_UART_REGS *uart, EF_UART_IRQ_STATE *state, uint8_t *tx_buffer, uint32_t tx_size, uint8_t *rx_buffer, uint32_t rx_size){
+
+    if (!EF_UART_isPowerOfTwo(tx_size) || !EF_UART_isPowerOfTwo(rx_size))
+        return false;
+
+    uart->IM = 0;
+    state->regs = uart;
+    EF_UART_ringInit(&state->tx, tx_buffer, tx_size);
+    EF_UART_ringInit(&state->rx, rx_buffer, rx_size);
+    state->rx_dropped = 0;
+    state->delimiter = -1;
+    state->frame_mode = false;
+    state->in_frame = false;
+    state->rx_idle_mark = 0;
+    state->tx_coalescing = false;
+    state->tx_refill = 0;
+    state->tx_refill_context = 0;
+    state->fifo_depth = EF_UART_getFIFODepth(uart);
+
+    uart->TX_FIFO_FLUSH = 1;
+    uart->RX_FIFO_FLUSH = 1;
+    // TXB stays enabled; a zero threshold keeps it low until EF_UART_write has data for it
+    uart->TX_FIFO_THRESHOLD = 0;
+    uart->RX_FIFO_THRESHOLD = EF_UART_IRQ_RX_THRESHOLD_OF(state->fifo_depth);
+    uart->IC = 0xFFFF;
+    uart->IM = EF_UART_RXA_FLAG | EF_UART_RXF_FLAG | EF_UART_RTO_FLAG | EF_UART_TXB_FLAG;
+    return true;
+}
+
+uint32_t EF_UART_write(EF_UART_IRQ_STATE *state, const uint8_t *data, uint32_t length){
+
+    EF_UART_RING_BUFFER *ring = &state->tx;
+    uint32_t head = ring->head;
+    uint32_t used = head - ring->tail;
+    uint32_t space = ring->mask + 1 - used;
+    uint32_t count = (length < space) ? length : space;
+
+    for (uint32_t i = 0; i < count; i++)
+        ring->buffer[(head + i) & ring->mask] = data[i];
+    ring->head = head + count;
+
+    // TXB refills the FIFO from the ring buffer; EF_UART_handleIRQ zeroes the threshold again once the ring buffer is
+    // empty. IM is left to the interrupt handler: this is a plain write, and a handler that runs before it finds the
+    // data and only costs one more TXB. With TX coalescing a ring buffer that still holds data is refilled by the COAL
+    // event on its way, unless the handler drained it before the new head was visible.
+    if ((count != 0) && ((used == 0) || !state->tx_coalescing || (ring->tail == head)))
+        state->regs->TX_FIFO_THRESHOLD = EF_UART_IRQ_TX_THRESHOLD_OF(state->fifo_depth);
+    return count;
+}
+
+uint32_t EF_UART_read(EF_UART_IRQ_STATE *state, uint8_t *data, uint32_t length){
+
+    EF_UART_RING_BUFFER *ring = &state->rx;
+    uint32_t tail = ring->tail;
+    uint32_t available = ring->head - tail;
+    uint32_t count = (length < available) ? length : available;
+
+    for (uint32_t i = 0; i < count; i++)
+        data[i] = ring->buffer[(tail + i) & ring->mask];
+    ring->tail = tail + count;
+    return count;
+}
+
+uint32_t EF_UART_getRxDropped(EF_UART_IRQ_STATE *state){
+
+    return state->rx_dropped;
+}
+
+void EF_UART_setTxRefill(EF_UART_IRQ_STATE *state, void (*refill)(void *context), void *context){
+
+    // removed while the context changes, in case TXB interrupts in between
+    state->tx_refill = 0;
+    state->tx_refill_context = context;
+    state->tx_refill = refill;
+    return;
+}
+
+// Frame mode, waiting for the first byte of a frame: RXA with a zero threshold, RTO masked as it repeats while the line is idle
+static void EF_UART_armFrameStart(EF_UART_IRQ_STATE *state){
+
+    EF_UART_REGS *uart = state->regs;
+
+    state->in_frame = false;
+    uart->IM &= ~EF_UART_RTO_FLAG;
+    uart->RX_FIFO_THRESHOLD = 0;
+    return;
+}
+
+// Frame mode, inside a frame: only the delimiter, the idle line or a nearly full FIFO interrupt
+static void EF_UART_armFrameEnd(EF_UART_IRQ_STATE *state){
+
+    EF_UART_REGS *uart = state->regs;
+
+    uart->RX_FIFO_THRESHOLD = EF_UART_IRQ_RX_THRESHOLD_OF(state->fifo_depth);
+    // a stale RTO of the idle line before this frame must not end it
+    uart->IC = EF_UART_RTO_FLAG;
+    uart->IM |= EF_UART_RTO_FLAG;
+    state->in_frame = true;
+    return;
+}
+
+// Gives MATCH and MATCH_MASK back to the application once the frame mode delimiter no longer needs them
+static void EF_UART_releaseMatch(EF_UART_IRQ_STATE *state){
+
+    EF_UART_REGS *uart = state->regs;
+
+    if (state->frame_mode && (state->delimiter >= 0)){
+        uart->MATCH = state->match;
+        uart->MATCH_MASK = state->match_mask;
+    }
+    return;
+}
+
+void EF_UART_enableFrameMode(EF_UART_IRQ_STATE *state, int32_t delimiter){
+
+    EF_UART_REGS *uart = state->regs;
+
+    uart->IM = 0;
+    EF_UART_releaseMatch(state);
+    // the address filter compares against MATCH and MATCH_MASK, frames only end with the idle line then
+    if (uart->CTRL & EF_UART_CTRL_REG_ADEN_MASK)
+        delimiter = -1;
+    state->delimiter = delimiter;
+    state->rx_idle_mark = state->rx.head;
+    state->frame_mode = true;
+    if (delimiter >= 0){
+        state->match = uart->MATCH;
+        state->match_mask = uart->MATCH_MASK;
+        uart->MATCH = (uint32_t)delimiter;
+        uart->MATCH_MASK = 0;
+        uart->IC = EF_UART_MATCH_FLAG;
+    }
+    EF_UART_armFrameStart(state);
+    uint32_t mask = EF_UART_RXA_FLAG | EF_UART_RXF_FLAG | EF_UART_TXB_FLAG;
+    if (delimiter >= 0)
+        mask |= EF_UART_MATCH_FLAG;
+    uart->IM = mask;
+    return;
+}
+
+void EF_UART_disableFrameMode(EF_UART_IRQ_STATE *state){
+
+    EF_UART_REGS *uart = state->regs;
+
+    uart->IM = 0;
+    EF_UART_releaseMatch(state);
+    state->frame_mode = false;
+    state->in_frame = false;
+    state->delimiter = -1;
+    uart->RX_FIFO_THRESHOLD = EF_UART_IRQ_RX_THRESHOLD_OF(state->fifo_depth);
+    uart->IC = EF_UART_MATCH_FLAG;
+    uart->IM = EF_UART_RXA_FLAG | EF_UART_RXF_FLAG | EF_UART_RTO_FLAG | EF_UART_TXB_FLAG;
+    return;
+}
+
+void EF_UART_setIRQCoalescing(EF_UART_IRQ_STATE *state, uint32_t rx_count, uint32_t tx_count, uint32_t time_cycles){
+
+    EF_UART_REGS *uart = state->regs;
+
+    if (rx_count > 0xFF)
+        rx_count = 0xFF;
+    if (tx_count > 0xFF)
+        tx_count = 0xFF;
+    if (time_cycles > 0xFFFFFF)
+        time_cycles = 0xFFFFFF;
+
+    uart->IM = 0;
+    uart->COAL = (rx_count << EF_UART_COAL_REG_RXCNT_BIT) | (tx_count << EF_UART_COAL_REG_TXCNT_BIT);
+    uart->COAL_TIME = time_cycles;
+    uart->IC = EF_UART_COAL_FLAG;
+    state->tx_coalescing = (tx_count != 0);
+
+    uint32_t mask = EF_UART_RXF_FLAG | EF_UART_TXB_FLAG;
+    if (rx_count != 0){
+        // COAL replaces RXA; RTO still ends a message that stops short of the count when there is no time bound
+        mask |= EF_UART_COAL_FLAG;
+        if (time_cycles == 0)
+            mask |= EF_UART_RTO_FLAG;
+    } else {
+        mask |= EF_UART_RXA_FLAG | EF_UART_RTO_FLAG;
+    }
+    if (tx_count != 0)
+        mask |= EF_UART_COAL_FLAG;
+    uart->IM = mask;
+    return;
+}
 
-    while((EF_UART_getRIS() & EF_UART_RXA_FLAG) == 0x0); // wait over RX fifo level above flag to be 1
-    uint32_t data = EF_UART_REG_SPACE->RXDATA;
-    EF_UART_setICR(EF_UART_RXA_FLAG);
+uint32_t EF_UART_readFrame(EF_UART_IRQ_STATE *state, uint8_t *data, uint32_t length){
+
+    EF_UART_RING_BUFFER *ring = &state->rx;
+    uint32_t tail = ring->tail;
+    uint32_t available = ring->head - tail;
+    uint32_t idle = state->rx_idle_mark - tail;
+    uint32_t count = 0;
+
+    // the frame ends at the first delimiter ...
+    if (state->delimiter >= 0){
+        uint32_t limit = (available < length) ? available : length;
+        for (uint32_t i = 0; i < limit; i++){
+            if (ring->buffer[(tail + i) & ring->mask] == (uint8_t)state->delimiter){
+                count = i + 1;
+                break;
+            }
+        }
+    }
+    // ... or where the line went idle
+    if ((count == 0) && (idle != 0) && (idle <= available))
+        count = idle;
+    // a frame that does not fit is returned in pieces
+    if ((count == 0) && (available >= length))
+        count = length;
+    if (count > length)
+        count = length;
+
+    for (uint32_t i = 0; i < count; i++)
+        data[i] = ring->buffer[(tail + i) & ring->mask];
+    ring->tail = tail + count;
+    return count;
+}
+
+void EF_UART_handleIRQ(EF_UART_IRQ_STATE *state){
+
+    EF_UART_REGS *uart = state->regs;
+    uint32_t mis = uart->MIS;
+
+    // Clear the event flags up front so that events while draining raise them again; RXA and RXF follow the
+    // FIFO level and are only cleared once the FIFO is drained, or they would be raised again at once
+    if (mis & ~(EF_UART_TXB_FLAG | EF_UART_RXA_FLAG | EF_UART_RXF_FLAG))
+        uart->IC = mis & ~(EF_UART_TXB_FLAG | EF_UART_RXA_FLAG | EF_UART_RXF_FLAG);
+
+    if (mis & (EF_UART_RXA_FLAG | EF_UART_RXF_FLAG | EF_UART_RTO_FLAG | EF_UART_MATCH_FLAG | EF_UART_COAL_FLAG))
+        EF_UART_drainRxFIFO(state);
+
+    if (state->frame_mode){
+        EF_UART_RING_BUFFER *ring = &state->rx;
+        if (mis & EF_UART_RTO_FLAG){
+            // the line went idle: everything received so far belongs to the frame
+            state->rx_idle_mark = ring->head;
+            EF_UART_armFrameStart(state);
+        } else if ((mis & EF_UART_MATCH_FLAG) && (ring->head != ring->tail) && (ring->buffer[(ring->head - 1) & ring->mask] == (uint8_t)state->delimiter)){
+            // the delimiter was the last byte received, no need to wait for the idle line
+            EF_UART_armFrameStart(state);
+        } else if ((mis & (EF_UART_RXA_FLAG | EF_UART_RXF_FLAG)) && !state->in_frame){
+            EF_UART_armFrameEnd(state);
+        }
+    }
+
+    if (mis & (EF_UART_RXA_FLAG | EF_UART_RXF_FLAG))
+        uart->IC = mis & (EF_UART_RXA_FLAG | EF_UART_RXF_FLAG);
+
+    // With TX coalescing TXB only starts a transmission; the COAL events of the characters sent refill the FIFO.
+    // The refill hook tops up the ring buffer first, so TXB is only turned off once it has nothing more either.
+    if (mis & EF_UART_TXB_FLAG){
+        if (state->tx_refill)
+            state->tx_refill(state->tx_refill_context);
+        if ((EF_UART_fillTxFIFO(state) == 0) || state->tx_coalescing)
+            uart->TX_FIFO_THRESHOLD = 0;
+        uart->IC = EF_UART_TXB_FLAG;
+    } else if ((mis & EF_UART_COAL_FLAG) && state->tx_coalescing && (state->tx.head != state->tx.tail)){
+        if (state->tx_refill)
+            state->tx_refill(state->tx_refill_context);
+        EF_UART_fillTxFIFO(state);
+    }
+    return;
+}
 
-    return data;
+uint32_t EF_UART_handleMultiIRQ(EF_UART_REGS *uart, EF_UART_IRQ_STATE *const states[], uint32_t channels){
+
+    uint32_t pending = uart->IRQ_SUMMARY;
+
+    if (channels < 32)
+        pending &= (1u << channels) - 1;
+    for (uint32_t i = 0, bits = pending; bits != 0; i++, bits >>= 1)
+        if (bits & 1)
+            EF_UART_handleIRQ(states[i]);
+    return pending;
+}
+
+void EF_UART_initDMA(EF_UART_REGS *uart, EF_UART_DMA_STATE *state, const EF_UART_DMA_CONTROLLER *controller){
+
+    uint32_t depth = EF_UART_getFIFODepth(uart);
+    uint32_t burst = EF_UART_DMA_BURST_OF(depth);
+
+    // a TX burst needs the threshold depth-burst+1 to fit in the FAW bits of TX_FIFO_THRESHOLD
+    if (burst < 2)
+        burst = 2;
+    if (burst > depth)
+        burst = depth;
+
+    state->regs = uart;
+    state->controller = controller;
+    state->burst = burst;
+    state->length[DMA_TX] = 0;
+    state->length[DMA_RX] = 0;
+    state->rx_data = 0;
+    uart->CTRL &= ~(EF_UART_CTRL_REG_TXDMAEN_MASK | EF_UART_CTRL_REG_RXDMAEN_MASK);
+}
+
+bool EF_UART_startTxDMA(EF_UART_DMA_STATE *state, const uint8_t *data, uint32_t length){
+
+    EF_UART_REGS *uart = state->regs;
+    const EF_UART_DMA_CONTROLLER *dma = state->controller;
+
+    if ((length == 0) || (state->length[DMA_TX] != 0))
+        return false;
+
+    // tx_dma_req is TX level below the threshold, i.e. at least burst free entries
+    uart->TX_FIFO_THRESHOLD = EF_UART_getFIFODepth(uart) - state->burst + 1;
+    if (!dma->start(dma->context, DMA_TX, (uintptr_t)&uart->TXDATA, (uintptr_t)data, length, state->burst))
+        return false;
+    state->length[DMA_TX] = length;
+    uart->CTRL |= EF_UART_CTRL_REG_TXDMAEN_MASK;
+    return true;
+}
+
+bool EF_UART_startRxDMA(EF_UART_DMA_STATE *state, uint8_t *data, uint32_t length){
+
+    EF_UART_REGS *uart = state->regs;
+    const EF_UART_DMA_CONTROLLER *dma = state->controller;
+
+    if ((length == 0) || (state->length[DMA_RX] != 0))
+        return false;
+
+    // rx_dma_req is RX level above the threshold, i.e. at least burst waiting entries
+    uart->RX_FIFO_THRESHOLD = state->burst - 1;
+    if (!dma->start(dma->context, DMA_RX, (uintptr_t)&uart->RXDATA, (uintptr_t)data, length, state->burst))
+        return false;
+    state->length[DMA_RX] = length;
+    state->rx_data = data;
+    uart->CTRL |= EF_UART_CTRL_REG_RXDMAEN_MASK;
+    return true;
+}
+
+uint32_t EF_UART_getDMACount(EF_UART_DMA_STATE *state, enum dma_direction direction){
+
+    const EF_UART_DMA_CONTROLLER *dma = state->controller;
+
+    if (state->length[direction] == 0)
+        return 0;
+    return state->length[direction] - dma->remaining(dma->context, direction);
+}
+
+uint32_t EF_UART_completeDMA(EF_UART_DMA_STATE *state, enum dma_direction direction){
+
+    const EF_UART_DMA_CONTROLLER *dma = state->controller;
+    uint32_t enable = (direction == DMA_TX) ? EF_UART_CTRL_REG_TXDMAEN_MASK : EF_UART_CTRL_REG_RXDMAEN_MASK;
+    uint32_t count;
+
+    if (state->length[direction] == 0)
+        return 0;
+
+    // withdraw the request first so the channel cannot be triggered again while it is stopped
+    state->regs->CTRL &= ~enable;
+    uint32_t remaining = dma->remaining(dma->context, direction);
+    if (remaining != 0){
+        dma->stop(dma->context, direction);
+        remaining = dma->remaining(dma->context, direction);
+    }
+    count = state->length[direction] - remaining;
+
+    // bytes short of a burst are never requested; move them by CPU
+    if (direction == DMA_RX){
+        uint32_t level;
+        while ((count < state->length[DMA_RX]) && ((level = (state->regs->STATUS & EF_UART_STATUS_REG_RXLVL_MASK) >> EF_UART_STATUS_REG_RXLVL_BIT) != 0)){
+            if (level > state->length[DMA_RX] - count)
+                level = state->length[DMA_RX] - count;
+            EF_UART_readFIFOInline(state->regs, &state->rx_data[count], level);
+            count += level;
+        }
+    }
+    state->length[direction] = 0;
+    return count;
+}
+
+
+//
+//   EF_DRIVER_UART0; the instance at EF_UART_REG_SPACE behind the driver access structure
+//
+
+/* Ring buffers shared between the application and EF_UART_IRQHandler */
+static EF_UART_IRQ_STATE EF_UART0_IRQState;
+
+/* Transfers of the DMA mode */
+static EF_UART_DMA_STATE EF_UART0_DMAState;
+
+/* Last configuration applied through EF_DRIVER_UART0.applyConfig; starts from the reset values */
+static EF_UART_CONFIG EF_UART0_Shadow = EF_UART_CONFIG_DEFAULT;
+
+static void EF_UART0_enable(void){
+
+    EF_UART_enable(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_setGclkEnable(uint32_t value){
+
+    EF_UART_setGclkEnable(EF_UART_REG_SPACE, value);
+    return;
+}
+
+static void EF_UART0_disable(void){
+
+    EF_UART_disable(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_enableRx(void){
+
+    EF_UART_enableRx(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_disableRx(void){
+
+    EF_UART_disableRx(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_enableTx(void){
+
+    EF_UART_enableTx(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_disableTx(void){
+
+    EF_UART_disableTx(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_enableLoopBack(void){
+
+    EF_UART_enableLoopBack(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_disableLoopBack(void){
+
+    EF_UART_disableLoopBack(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_enableGlitchFilter(void){
+
+    EF_UART_enableGlitchFilter(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_disableGlitchFilter(void){
+
+    EF_UART_disableGlitchFilter(EF_UART_REG_SPACE);
+    return;
+}
+
+static void EF_UART0_setFlowControl(bool rts, bool cts, uint32_t rts_level){
+
+    EF_UART_setFlowControl(EF_UART_REG_SPACE, rts, cts, rts_level);
+    return;
+}
+
+static void EF_UART0_setMultidrop(bool enable, uint32_t address, uint32_t mask){
+
+    EF_UART_setMultidrop(EF_UART_REG_SPACE, enable, address, mask);
+    return;
+}
+
+static void EF_UART0_writeAddress(uint32_t address){
+
+    EF_UART_writeAddress(EF_UART_REG_SPACE, address);
+    return;
+}
+
+static void EF_UART0_setRS485(bool enable, uint32_t lead_bits, uint32_t lag_bits){
+
+    EF_UART_setRS485(EF_UART_REG_SPACE, enable, lead_bits, lag_bits);
+    return;
+}
+
+static void EF_UART0_writeBufferAndWait(const uint8_t *data, uint32_t length){
+
+    EF_UART_writeBufferAndWait(EF_UART_REG_SPACE, data, length);
+    return;
+}
+
+static bool EF_UART0_autoBaud(uint32_t timeout){
+
+    return EF_UART_autoBaud(EF_UART_REG_SPACE, timeout);
+}
+
+static void EF_UART0_setCTRL(uint32_t value){
+
+    EF_UART_setCTRL(EF_UART_REG_SPACE, value);
+    return;
+}
+
+static uint32_t EF_UART0_getCTRL(void){
+
+    return EF_UART_getCTRL(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_setDataSize(uint32_t value){
+
+    EF_UART_setDataSize(EF_UART_REG_SPACE, value);
+    return;
+}
+
+static void EF_UART0_setPrescaler(uint32_t prescaler){
+
+    EF_UART_setPrescaler(EF_UART_REG_SPACE, prescaler);
+    return;
+}
+
+static uint32_t EF_UART0_getPrescaler(void){
+
+    return EF_UART_getPrescaler(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_setPrescalerFraction(uint32_t fraction){
+
+    EF_UART_setPrescalerFraction(EF_UART_REG_SPACE, fraction);
+    return;
+}
+
+static uint32_t EF_UART0_getPrescalerFraction(void){
+
+    return EF_UART_getPrescalerFraction(EF_UART_REG_SPACE);
+}
+
+static int32_t EF_UART0_setBaudRate(uint32_t clk_hz, uint32_t baud){
+
+    return EF_UART_setBaudRate(EF_UART_REG_SPACE, clk_hz, baud);
+}
+
+static void EF_UART0_setTwoStopBitsSelect(bool is_two_bits){
+
+    EF_UART_setTwoStopBitsSelect(EF_UART_REG_SPACE, is_two_bits);
+    return;
+}
+
+static void EF_UART0_setParityType(enum parity_type parity){
+
+    EF_UART_setParityType(EF_UART_REG_SPACE, parity);
+    return;
+}
+
+static void EF_UART0_setTimeoutBits(uint32_t value){
+
+    EF_UART_setTimeoutBits(EF_UART_REG_SPACE, value);
+    return;
+}
+
+static void EF_UART0_setOversampling(enum oversampling_type oversampling){
+
+    EF_UART_setOversampling(EF_UART_REG_SPACE, oversampling);
+    return;
+}
+
+static uint32_t EF_UART0_getSamplesPerBit(void){
+
+    return EF_UART_getSamplesPerBit(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_setConfig(uint32_t value){
+
+    EF_UART_setConfig(EF_UART_REG_SPACE, value);
+    return;
+}
+
+static uint32_t EF_UART0_getConfig(void){
+
+    return EF_UART_getConfig(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_setRxFIFOThreshold(uint32_t value){
+
+    EF_UART_setRxFIFOThreshold(EF_UART_REG_SPACE, value);
+    return;
+}
+
+static uint32_t EF_UART0_getRxFIFOThreshold(void){
+
+    return EF_UART_getRxFIFOThreshold(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_setTxFIFOThreshold(uint32_t value){
+
+    EF_UART_setTxFIFOThreshold(EF_UART_REG_SPACE, value);
+    return;
+}
+
+static uint32_t EF_UART0_getTxFIFOThreshold(void){
+
+    return EF_UART_getTxFIFOThreshold(EF_UART_REG_SPACE);
+}
+
+static uint32_t EF_UART0_getTxCount(void){
+
+    return EF_UART_getTxCount(EF_UART_REG_SPACE);
+}
+
+static uint32_t EF_UART0_getRxCount(void){
+
+    return EF_UART_getRxCount(EF_UART_REG_SPACE);
+}
+
+static uint32_t EF_UART0_getStatus(void){
+
+    return EF_UART_getStatus(EF_UART_REG_SPACE);
+}
+
+static uint32_t EF_UART0_getFIFODepth(void){
+
+    return EF_UART_getFIFODepth(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_setMatchData(uint32_t matchData){
+
+    EF_UART_setMatchData(EF_UART_REG_SPACE, matchData);
+    return;
+}
+
+static uint32_t EF_UART0_getMatchData(void){
+
+    return EF_UART_getMatchData(EF_UART_REG_SPACE);
+}
+
+static uint32_t EF_UART0_getRIS(void){
+
+    return EF_UART_getRIS(EF_UART_REG_SPACE);
+}
+
+static uint32_t EF_UART0_getMIS(void){
+
+    return EF_UART_getMIS(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_setIM(uint32_t mask){
+
+    EF_UART_setIM(EF_UART_REG_SPACE, mask);
+    return;
+}
+
+static uint32_t EF_UART0_getIM(void){
+
+    return EF_UART_getIM(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_setICR(uint32_t mask){
+
+    EF_UART_setICR(EF_UART_REG_SPACE, mask);
+    return;
+}
+
+static void EF_UART0_writeChar(char data){
+
+    EF_UART_writeChar(EF_UART_REG_SPACE, data);
+    return;
+}
+
+static void EF_UART0_writeCharArr(const char *char_arr){
+
+    EF_UART_writeCharArr(EF_UART_REG_SPACE, char_arr);
+    return;
+}
+
+static void EF_UART0_writeBuffer(const uint8_t *data, uint32_t length){
+
+    EF_UART_writeBuffer(EF_UART_REG_SPACE, data, length);
+    return;
+}
+
+static uint32_t EF_UART0_readChar(void){
+
+    return EF_UART_readChar(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_readBuffer(uint8_t *data, uint32_t length){
+
+    EF_UART_readBuffer(EF_UART_REG_SPACE, data, length);
+    return;
+}
+
+static uint32_t EF_UART0_readBufferTagged(uint8_t *data, uint32_t *errors, uint32_t length){
+
+    return EF_UART_readBufferTagged(EF_UART_REG_SPACE, data, errors, length);
+}
+
+static bool EF_UART0_initIRQMode(uint8_t *tx_buffer, uint32_t tx_size, uint8_t *rx_buffer, uint32_t rx_size){
+
+    return EF_UART_initIRQMode(EF_UART_REG_SPACE, &EF_UART0_IRQState, tx_buffer, tx_size, rx_buffer, rx_size);
+}
+
+static uint32_t EF_UART0_write(const uint8_t *data, uint32_t length){
+
+    return EF_UART_write(&EF_UART0_IRQState, data, length);
+}
+
+static uint32_t EF_UART0_read(uint8_t *data, uint32_t length){
+
+    return EF_UART_read(&EF_UART0_IRQState, data, length);
+}
+
+static uint32_t EF_UART0_getRxDropped(void){
+
+    return EF_UART_getRxDropped(&EF_UART0_IRQState);
+}
+
+static void EF_UART0_setTxRefill(void (*refill)(void *context), void *context){
+
+    EF_UART_setTxRefill(&EF_UART0_IRQState, refill, context);
+    return;
+}
+
+static uint32_t EF_UART0_readUntil(char delimiter, uint8_t *data, uint32_t length){
+
+    return EF_UART_readUntil(EF_UART_REG_SPACE, delimiter, data, length);
+}
+
+static void EF_UART0_setMajorityVote(bool enable){
+
+    EF_UART_setMajorityVote(EF_UART_REG_SPACE, enable);
+    return;
+}
+
+static void EF_UART0_setSyncWord(bool enable, uint32_t pattern, uint32_t mask, uint32_t length, bool hunt){
+
+    EF_UART_setSyncWord(EF_UART_REG_SPACE, enable, pattern, mask, length, hunt);
+    return;
+}
+
+static bool EF_UART0_setCRC(bool enable, uint32_t width, uint32_t poly, uint32_t init, bool reflect, bool invert){
+
+    return EF_UART_setCRC(EF_UART_REG_SPACE, enable, width, poly, init, reflect, invert);
+}
+
+static void EF_UART0_crcReset(bool tx, bool rx){
+
+    EF_UART_crcReset(EF_UART_REG_SPACE, tx, rx);
+    return;
+}
+
+static bool EF_UART0_crcGetTx(uint32_t *crc, uint32_t timeout){
+
+    return EF_UART_crcGetTx(EF_UART_REG_SPACE, crc, timeout);
+}
+
+static uint32_t EF_UART0_crcGetRx(void){
+
+    return EF_UART_crcGetRx(EF_UART_REG_SPACE);
+}
+
+static void EF_UART0_setFrameGap(uint32_t gap){
+
+    EF_UART_setFrameGap(EF_UART_REG_SPACE, gap);
+    return;
+}
+
+static uint32_t EF_UART0_readGapFrame(uint8_t *data, uint32_t length, uint32_t *errors){
+
+    return EF_UART_readGapFrame(EF_UART_REG_SPACE, data, length, errors);
+}
+
+static void EF_UART0_setSynchronous(bool enable, bool external_clock){
+
+    EF_UART_setSynchronous(EF_UART_REG_SPACE, enable, external_clock);
+    return;
+}
+
+static bool EF_UART0_getStats(EF_UART_STATS *stats){
+
+    return EF_UART_getStats(EF_UART_REG_SPACE, stats);
+}
+
+static void EF_UART0_setIRQCoalescing(uint32_t rx_count, uint32_t tx_count, uint32_t time_cycles){
+
+    EF_UART_setIRQCoalescing(&EF_UART0_IRQState, rx_count, tx_count, time_cycles);
+    return;
+}
+
+static void EF_UART0_enableFrameMode(int32_t delimiter){
+
+    EF_UART_enableFrameMode(&EF_UART0_IRQState, delimiter);
+    return;
+}
+
+static void EF_UART0_disableFrameMode(void){
+
+    EF_UART_disableFrameMode(&EF_UART0_IRQState);
+    return;
+}
+
+static uint32_t EF_UART0_readFrame(uint8_t *data, uint32_t length){
+
+    return EF_UART_readFrame(&EF_UART0_IRQState, data, length);
+}
+
+static uint32_t EF_UART0_applyConfig(const EF_UART_CONFIG *config){
+
+    return EF_UART_applyConfig(EF_UART_REG_SPACE, &EF_UART0_Shadow, config);
+}
+
+static void EF_UART0_readConfig(EF_UART_CONFIG *config){
+
+    // resynchronize the shadow as well, the registers may have been written through the single register setters
+    EF_UART_readConfig(EF_UART_REG_SPACE, &EF_UART0_Shadow);
+    *config = EF_UART0_Shadow;
+    return;
+}
+
+static void EF_UART0_initDMA(const EF_UART_DMA_CONTROLLER *controller){
+
+    EF_UART_initDMA(EF_UART_REG_SPACE, &EF_UART0_DMAState, controller);
+    return;
+}
+
+static bool EF_UART0_startTxDMA(const uint8_t *data, uint32_t length){
+
+    return EF_UART_startTxDMA(&EF_UART0_DMAState, data, length);
+}
+
+static bool EF_UART0_startRxDMA(uint8_t *data, uint32_t length){
+
+    return EF_UART_startRxDMA(&EF_UART0_DMAState, data, length);
+}
+
+static uint32_t EF_UART0_getDMACount(enum dma_direction direction){
+
+    return EF_UART_getDMACount(&EF_UART0_DMAState, direction);
+}
+
+static uint32_t EF_UART0_completeDMA(enum dma_direction direction){
+
+    return EF_UART_completeDMA(&EF_UART0_DMAState, direction);
+}
+
+EF_UART_IRQ_STATE *EF_UART_getIRQState(void){
+
+    return &EF_UART0_IRQState;
+}
+
+void EF_UART_IRQHandler(void){
+
+    EF_UART_handleIRQ(&EF_UART0_IRQState);
+    return;
 }
 
-extern EF_DRIVER_UART EF_DRIVER_UART0;
-EF_DRIVER_UART0 =  {
+EF_DRIVER_UART EF_DRIVER_UART0 = {
     .UART_REGS = EF_UART_REG_SPACE,
     .getVersion = EF_UART_getVersion,
-    .enable = EF_UART_enable,
-    .disable = EF_UART_disable,
-    .setGclkEnable = EF_UART_setGclkEnable,
-    .enableRx = EF_UART_enableRx,
-    .disableRx = EF_UART_disableRx,
-    .enableTx = EF_UART_enableTx,
-    .disableTx = EF_UART_disableTx,
-    .enableLoopBack = EF_UART_enableLoopBack,
-    .disableLoopBack = EF_UART_disableLoopBack,
-    .enableGlitchFilter = EF_UART_enableGlitchFilter,
-    .disableGlitchFilter = EF_UART_disableGlitchFilter,
-    .setCTRL = EF_UART_setCTRL,
-    .getCTRL = EF_UART_getCTRL,
-    .setDataSize = EF_UART_setDataSize,
-    .setTwoStopBitsSelect = EF_UART_setTwoStopBitsSelect,
-    .setParityType = EF_UART_setParityType,
-    .setTimeoutBits = EF_UART_setTimeoutBits,
-    .setConfig = EF_UART_setConfig,
-    .getConfig = EF_UART_getConfig,
-    .setRxFIFOThreshold = EF_UART_setRxFIFOThreshold,
-    .getRxFIFOThreshold = EF_UART_getRxFIFOThreshold,
-    .setTxFIFOThreshold = EF_UART_setTxFIFOThreshold,
-    .getTxFIFOThreshold = EF_UART_getTxFIFOThreshold,
-    .setMatchData = EF_UART_setMatchData,
-    .getMatchData = EF_UART_getMatchData,
-    .getTxCount = EF_UART_getTxCount,
-    .getRxCount = EF_UART_getRxCount,
-    .setPrescaler = EF_UART_setPrescaler,
-    .getPrescaler = EF_UART_getPrescaler,
-    .getRIS = EF_UART_getRIS,
-    .getMIS = EF_UART_getMIS,
-    .setIM = EF_UART_setIM,
-    .getIM = EF_UART_getIM,
-    .setICR = EF_UART_setICR,
-    .writeCharArr = EF_UART_writeCharArr,
-    .writeChar = EF_UART_writeChar,
-    .readChar = EF_UART_readChar
+    .enable = EF_UART0_enable,
+    .disable = EF_UART0_disable,
+    .setGclkEnable = EF_UART0_setGclkEnable,
+    .enableRx = EF_UART0_enableRx,
+    .disableRx = EF_UART0_disableRx,
+    .enableTx = EF_UART0_enableTx,
+    .disableTx = EF_UART0_disableTx,
+    .enableLoopBack = EF_UART0_enableLoopBack,
+    .disableLoopBack = EF_UART0_disableLoopBack,
+    .enableGlitchFilter = EF_UART0_enableGlitchFilter,
+    .disableGlitchFilter = EF_UART0_disableGlitchFilter,
+    .setCTRL = EF_UART0_setCTRL,
+    .getCTRL = EF_UART0_getCTRL,
+    .setDataSize = EF_UART0_setDataSize,
+    .setTwoStopBitsSelect = EF_UART0_setTwoStopBitsSelect,
+    .setParityType = EF_UART0_setParityType,
+    .setTimeoutBits = EF_UART0_setTimeoutBits,
+    .setConfig = EF_UART0_setConfig,
+    .getConfig = EF_UART0_getConfig,
+    .setRxFIFOThreshold = EF_UART0_setRxFIFOThreshold,
+    .getRxFIFOThreshold = EF_UART0_getRxFIFOThreshold,
+    .setTxFIFOThreshold = EF_UART0_setTxFIFOThreshold,
+    .getTxFIFOThreshold = EF_UART0_getTxFIFOThreshold,
+    .setMatchData = EF_UART0_setMatchData,
+    .getMatchData = EF_UART0_getMatchData,
+    .getTxCount = EF_UART0_getTxCount,
+    .getRxCount = EF_UART0_getRxCount,
+    .setPrescaler = EF_UART0_setPrescaler,
+    .getPrescaler = EF_UART0_getPrescaler,
+    .getRIS = EF_UART0_getRIS,
+    .getMIS = EF_UART0_getMIS,
+    .setIM = EF_UART0_setIM,
+    .getIM = EF_UART0_getIM,
+    .setICR = EF_UART0_setICR,
+    .writeCharArr = EF_UART0_writeCharArr,
+    .writeChar = EF_UART0_writeChar,
+    .readChar = EF_UART0_readChar,
+    .initIRQMode = EF_UART0_initIRQMode,
+    .write = EF_UART0_write,
+    .read = EF_UART0_read,
+    .getRxDropped = EF_UART0_getRxDropped,
+    .setTxRefill = EF_UART0_setTxRefill,
+    .getStatus = EF_UART0_getStatus,
+    .writeBuffer = EF_UART0_writeBuffer,
+    .readBuffer = EF_UART0_readBuffer,
+    .applyConfig = EF_UART0_applyConfig,
+    .readConfig = EF_UART0_readConfig,
+    .readUntil = EF_UART0_readUntil,
+    .enableFrameMode = EF_UART0_enableFrameMode,
+    .disableFrameMode = EF_UART0_disableFrameMode,
+    .readFrame = EF_UART0_readFrame,
+    .setPrescalerFraction = EF_UART0_setPrescalerFraction,
+    .getPrescalerFraction = EF_UART0_getPrescalerFraction,
+    .setBaudRate = EF_UART0_setBaudRate,
+    .setOversampling = EF_UART0_setOversampling,
+    .getSamplesPerBit = EF_UART0_getSamplesPerBit,
+    .getFIFODepth = EF_UART0_getFIFODepth,
+    .initDMA = EF_UART0_initDMA,
+    .startTxDMA = EF_UART0_startTxDMA,
+    .startRxDMA = EF_UART0_startRxDMA,
+    .getDMACount = EF_UART0_getDMACount,
+    .completeDMA = EF_UART0_completeDMA,
+    .readBufferTagged = EF_UART0_readBufferTagged,
+    .setFlowControl = EF_UART0_setFlowControl,
+    .setMultidrop = EF_UART0_setMultidrop,
+    .writeAddress = EF_UART0_writeAddress,
+    .setRS485 = EF_UART0_setRS485,
+    .writeBufferAndWait = EF_UART0_writeBufferAndWait,
+    .autoBaud = EF_UART0_autoBaud,
+    .setIRQCoalescing = EF_UART0_setIRQCoalescing,
+    .getStats = EF_UART0_getStats,
+    .setMajorityVote = EF_UART0_setMajorityVote,
+    .setSyncWord = EF_UART0_setSyncWord,
+    .setCRC = EF_UART0_setCRC,
+    .crcReset = EF_UART0_crcReset,
+    .crcGetTx = EF_UART0_crcGetTx,
+    .crcGetRx = EF_UART0_crcGetRx,
+    .setFrameGap = EF_UART0_setFrameGap,
+    .readGapFrame = EF_UART0_readGapFrame,
+    .setSynchronous = EF_UART0_setSynchronous
 };
 
 
 
 
-#endif // EF_UART_C
\ No newline at end of file
+#endif // EF_UART_C
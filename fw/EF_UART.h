@@ -23,9 +23,9 @@
 #ifndef EF_UART_H
 #define EF_UART_H
 
-#include <EF_UART_regs.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <EF_UART_regs.h>
 #include <version.h>
 
 // UART API and Driver version
@@ -35,6 +35,82 @@
 // UART Parity control types
 enum parity_type {NONE = 0, ODD = 1, EVEN = 2, STICKY_0 = 4, STICKY_1 = 5};
 
+// UART oversampling (samples per bit) types; OVERSAMPLING_SC keeps the SC parameter of the IP
+enum oversampling_type {OVERSAMPLING_SC = 0, OVERSAMPLING_16 = 1, OVERSAMPLING_8 = 2, OVERSAMPLING_4 = 3};
+
+// Direction of a DMA transfer; DMA_TX moves memory to TXDATA, DMA_RX moves RXDATA to memory
+enum dma_direction {DMA_TX = 0, DMA_RX = 1};
+
+// Base address of the UART behind EF_DRIVER_UART0
+// This is a dummy address, the actual address should be defined in the linker script
+#ifndef EF_UART0_BASE
+#define EF_UART0_BASE ((uint32_t) 0x10000000)
+#endif
+
+// Depth of the TX and RX FIFOs (2^FAW) assumed by the inline fast path; EF_UART_writeBuffer and the
+// interrupt driven mode read the actual depth from the CAP register
+#ifndef EF_UART_FIFO_DEPTH
+#define EF_UART_FIFO_DEPTH (1 << EF_UART_FAW)
+#endif
+
+// STATUS holds 8-bit FIFO levels; a full 256-entry FIFO reads as 255
+#define EF_UART_STATUS_LEVEL_MAX 0xFF
+
+// RXDATA tags that mark a byte as received with an error; MATCH is a tag but not an error
+#define EF_UART_RXDATA_ERROR_MASK (EF_UART_RXDATA_REG_FE_MASK | EF_UART_RXDATA_REG_PE_MASK | EF_UART_RXDATA_REG_BRK_MASK)
+#define EF_UART_RXDATA_TAGS_MASK (EF_UART_RXDATA_ERROR_MASK | EF_UART_RXDATA_REG_MATCH_MASK)
+
+// Address window of one channel of an EF_UART_MULTI_* top; channel i is at base + i * EF_UART_MULTI_WINDOW
+#define EF_UART_MULTI_WINDOW 0x10000
+#define EF_UART_MULTI_CHANNEL(base, i) ((EF_UART_REGS *)((uintptr_t)(base) + (uint32_t)(i) * EF_UART_MULTI_WINDOW))
+
+// Ninth data bit that marks an address frame in the 9-bit multidrop mode
+#define EF_UART_ADDRESS_FLAG 0x100
+
+// Called by EF_UART_readUntil while it waits for an event, with that event enabled in IM so that the UART interrupt
+// wakes the CPU; define it to the wait for interrupt instruction, e.g. __asm__ volatile ("wfi"). The wait works with
+// interrupts disabled, or with a UART handler that leaves the flags alone. The default returns at once, which polls MIS.
+#ifndef EF_UART_WAIT_FOR_IRQ
+#define EF_UART_WAIT_FOR_IRQ(uart)
+#endif
+
+// Samples per bit when CFG.osr is OVERSAMPLING_SC (the SC parameter of the IP)
+#ifndef EF_UART_SAMPLES
+#define EF_UART_SAMPLES 8
+#endif
+
+// The prescaler fraction (PRF) is in 1/EF_UART_PRF_STEPS
+#define EF_UART_PRF_STEPS 16
+
+// FIFO thresholds programmed by EF_UART_initIRQMode for the FIFO depth read from CAP
+#ifndef EF_UART_IRQ_TX_THRESHOLD_OF
+#define EF_UART_IRQ_TX_THRESHOLD_OF(depth) ((depth) / 2)
+#endif
+#ifndef EF_UART_IRQ_RX_THRESHOLD_OF
+#define EF_UART_IRQ_RX_THRESHOLD_OF(depth) (((depth) * 3) / 4 - 1)
+#endif
+#define EF_UART_IRQ_TX_THRESHOLD EF_UART_IRQ_TX_THRESHOLD_OF(EF_UART_FIFO_DEPTH)
+#define EF_UART_IRQ_RX_THRESHOLD EF_UART_IRQ_RX_THRESHOLD_OF(EF_UART_FIFO_DEPTH)
+
+// Entries moved per DMA burst request for the FIFO depth read from CAP; 2 to the depth
+#ifndef EF_UART_DMA_BURST_OF
+#define EF_UART_DMA_BURST_OF(depth) ((depth) / 2)
+#endif
+
+// RTS watermark for the FIFO depth read from CAP; the room above it takes the characters the other side sends before it
+// sees rts_n rise. 0 makes rts_n rise only when the FIFO is full.
+#ifndef EF_UART_RTS_LEVEL_OF
+#define EF_UART_RTS_LEVEL_OF(depth) (((depth) > 4) ? (depth) - 4 : 0)
+#endif
+
+// CRC_RX after a frame and the CRC-32 that the sender appended to it, least significant byte first, when the frame is
+// intact. With an 8 or 16-bit CRC set up without invert, a good frame leaves 0.
+#define EF_UART_CRC32_RESIDUE 0x2144DF1C
+
+// The 1.5 and 3.5 character gaps of Modbus RTU for EF_UART_setFrameGap, in 1/16 character times
+#define EF_UART_GAP_MODBUS_T15 24
+#define EF_UART_GAP_MODBUS_T35 56
+
 
 // Function documentation
 /** 
@@ -42,144 +118,243 @@ enum parity_type {NONE = 0, ODD = 1, EVEN = 2, STICKY_0 = 4, STICKY_1 = 5};
     \brief  Get the version of the UART APIs and driver.
     \return \ref DRIVER_VERSION structure which contains the version of the driver.
 
-    \fn     void EF_UART_enable(void)
+    \fn     void EF_UART_enable(EF_UART_REGS *uart)
     \brief  Enable UART by setting "en" bit in the control register to 1.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_disable(void)
+    \fn     void EF_UART_disable(EF_UART_REGS *uart)
     \brief  Disable UART by clearing "en" bit in the control register.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_setGclkEnable(uint32_t value)
+    \fn     void EF_UART_setGclkEnable(EF_UART_REGS *uart, uint32_t value)
     \brief  Enable the UART clock gating.
+    \param  uart The base address of the UART registers
     \param  a value to set the GCLK register to. 
     \return none
 
-    \fn     void EF_UART_enableRx(void)
+    \fn     void EF_UART_enableRx(EF_UART_REGS *uart)
     \brief  Enable UART RX by setting uart "rxen" bit in the control register to 1.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_disableRx(void)
+    \fn     void EF_UART_disableRx(EF_UART_REGS *uart)
     \brief  Disable UART RX by clearing uart "rxen" bit in the control register.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_enableTx(void)
+    \fn     void EF_UART_enableTx(EF_UART_REGS *uart)
     \brief  Enable UART TX by setting uart "txen" bit in the control register to 1.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_disableTx(void)
+    \fn     void EF_UART_disableTx(EF_UART_REGS *uart)
     \brief  Disable UART TX by clearing uart "txen" bit in the control register.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_enableLoopBack(void)
+    \fn     void EF_UART_enableLoopBack(EF_UART_REGS *uart)
     \brief  Enable loopback (connecting TX to RX signal) by setting "lpen" bit in the control register to 1.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_disableLoopBack(void)
+    \fn     void EF_UART_disableLoopBack(EF_UART_REGS *uart)
     \brief  Disable loopback (connecting TX to RX signal) by clearing "lpen" bit in the control register.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_enableGlitchFilter(void)
+    \fn     void EF_UART_enableGlitchFilter(EF_UART_REGS *uart)
     \brief  Enable glitch filter (filter out noise or glitches on the received signal) by setting "gfen" bit in the control register to 1.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_disableGlitchFilter(void)
+    \fn     void EF_UART_disableGlitchFilter(EF_UART_REGS *uart)
     \brief  Disable glitch filter (filter out noise or glitches on the received signal) by clearing "gfen" bit in the control register.
+    \param  uart The base address of the UART registers
     \return none
 
-    \fn     void EF_UART_setCTRL(uint32_t value)
+    \fn     void EF_UART_setCTRL(EF_UART_REGS *uart, uint32_t value)
     \brief  Set the control register to a certain value where
             *  bit 0: UART enable
             *  bit 1: UART Transmitter enable
             * bit 2: UART Receiver enable
             * bit 3: Loopback (connect RX and TX pins together) enable
             * bit 4: UART Glitch Filer on RX enable
+    \param  uart The base address of the UART registers
     \param  value The value of the control register
     \return none
 
-    \fn     uint32_t EF_UART_getCTRL(void)
+    \fn     uint32_t EF_UART_getCTRL(EF_UART_REGS *uart)
     \brief  Get the value of the control register.
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the control register.
 
-    \fn     void EF_UART_setDataSize(uint32_t value)
+    \fn     void EF_UART_setDataSize(EF_UART_REGS *uart, uint32_t value)
     \brief  Set the Data Size (Data word length: 5-9 bits ) by setting the "wlen" field in configuration register
+    \param  uart The base address of the UART registers
     \param  value The value of the required data word length
     \return none
 
-    \fn     void EF_UART_setTwoStopBitsSelect(bool is_two_bits)
+    \fn     void EF_UART_setTwoStopBitsSelect(EF_UART_REGS *uart, bool is_two_bits)
     \brief  Set the "stp2" bit in configuration register (whether the stop boits are two or one)
+    \param  uart The base address of the UART registers
     \param  is_two_bits bool value, if "true", the stop bits are two and if "false", the stop bit is one
     \return none
 
-    \fn     void EF_UART_setParityType(enum parity_type parity)
+    \fn     void EF_UART_setParityType(EF_UART_REGS *uart, enum parity_type parity)
     \brief  Set the "parity" field  in configuration register (could be none, odd, even, sticky 0 or sticky 1)
+    \param  uart The base address of the UART registers
     \param  parity enum parity_type could be "NONE" , "ODD" , "EVEN" ,  "STICKY_0" , or  "STICKY_1"
     \return none
 
-    \fn     void EF_UART_setTimeoutBits(uint32_t value)
+    \fn     void EF_UART_setTimeoutBits(EF_UART_REGS *uart, uint32_t value)
     \brief  Set the "timeout" field in configuration register which is receiver timeout measured in number of bits at which the timeout flag will be raised
+    \param  uart The base address of the UART registers
     \param  value timeout bits value
     \return none
 
-    \fn     void EF_UART_setConfig(uint32_t config)
+    \fn     void EF_UART_setOversampling(EF_UART_REGS *uart, enum oversampling_type oversampling)
+    \brief  Set the "osr" field in configuration register, the number of samples per bit. 16x tolerates more noise and
+            clock mismatch on long lines, 4x reaches clk/4 on short links. The baud rate scales with it, so set the
+            prescaler again (or call \ref EF_UART_setBaudRate) after changing it, while the UART is disabled.
+    \param  uart The base address of the UART registers
+    \param  oversampling enum oversampling_type could be "OVERSAMPLING_SC", "OVERSAMPLING_16", "OVERSAMPLING_8" or "OVERSAMPLING_4"
+    \return none
+
+    \fn     void EF_UART_setMajorityVote(EF_UART_REGS *uart, bool enable)
+    \brief  Set the "maj" field in configuration register. With it, every received bit is the majority of the samples one
+            tick before, at and one tick after its centre, so a glitch shorter than a sample cannot flip it, and NOISE is
+            raised for a character whose samples disagreed. It reacts within the bit, unlike the glitch filter, whose fixed
+            delay takes a large part of the bit at high baud rates and low oversampling.
+    \param  uart The base address of the UART registers
+    \param  enable true to decide the bits by majority vote, false to take the single centre sample
+    \return none
+
+    \fn     uint32_t EF_UART_getSamplesPerBit(EF_UART_REGS *uart)
+    \brief  Get the number of samples per bit selected by the "osr" field in configuration register, or the 2 ticks of a
+            bit in the synchronous mode (\ref EF_UART_setSynchronous)
+    \param  uart The base address of the UART registers
+    \return 16, 8, 4, \ref EF_UART_SAMPLES, or 2 in the synchronous mode
+
+    \fn     void EF_UART_setConfig(EF_UART_REGS *uart, uint32_t config)
     \brief  Set the configuration register to a certain value where
             *  bit 0-3: Data word length: 5-9 bits
             *  bit 4: Two Stop Bits Select
             *  bit 5-7: Parity Type: 000: None, 001: odd, 010: even, 100: Sticky 0, 101: Sticky 1
             *  bit 8-13: Receiver Timeout measured in number of bits
+            *  bit 14-15: Oversampling: 00: SC, 01: 16, 10: 8, 11: 4 samples per bit
+            *  bit 16: Majority vote of 3 samples per bit
+    \param  uart The base address of the UART registers
     \param  config The value of the configuration register
     \return none
 
 
-    \fn     uint32_t EF_UART_getConfig(void)
+    \fn     uint32_t EF_UART_getConfig(EF_UART_REGS *uart)
     \brief  Get the value of the configuration register.
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the configuration register.
 
-    \fn     void EF_UART_setRxFIFOThreshold(uint32_t threshold)
+    \fn     void EF_UART_setRxFIFOThreshold(EF_UART_REGS *uart, uint32_t threshold)
     \brief  Set the RX FIFO threshold to a certain value at which "RXA" interrupt will be raised
+    \param  uart The base address of the UART registers
     \param  threshold The value of the required threshold
     \return none
 
-    \fn     uint32_t EF_UART_getRxFIFOThreshold(void)
+    \fn     uint32_t EF_UART_getRxFIFOThreshold(EF_UART_REGS *uart)
     \brief  Get the value of the RX FIFO threshold register.
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the RX FIFO threshold register.
 
-    \fn     void EF_UART_setTxFIFOThreshold(uint32_t threshold)
+    \fn     void EF_UART_setTxFIFOThreshold(EF_UART_REGS *uart, uint32_t threshold)
     \brief  Set the TX FIFO threshold to a certain value at which "TXB" interrupt will be raised
+    \param  uart The base address of the UART registers
     \param  threshold The value of the required threshold
     \return none
 
-    \fn     uint32_t EF_UART_getTxFIFOThreshold(void)
+    \fn     uint32_t EF_UART_getTxFIFOThreshold(EF_UART_REGS *uart)
     \brief  Get the value of the TX FIFO threshold register.
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the TX FIFO threshold register.
 
-    \fn     void EF_UART_setMatchData(uint32_t matchData)
+    \fn     void EF_UART_setMatchData(EF_UART_REGS *uart, uint32_t matchData)
     \brief  Set the matchData to a certain value at which "MATCH" interrupt will be raised
+    \param  uart The base address of the UART registers
     \param  matchData The value of the required match data
     \return none
 
-    \fn     uint32_t EF_UART_getMatchData(void)
+    \fn     uint32_t EF_UART_getMatchData(EF_UART_REGS *uart)
     \brief  Get the value of the match data register.
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the match data register.
 
-    \fn     uint32_t EF_UART_getTxCount(void)
+    \fn     uint32_t EF_UART_getTxCount(EF_UART_REGS *uart)
     \brief  Get the TX FIFO level register which is the number of bytes in the FIFO
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the TX FIFO level register.
 
-    \fn     uint32_t EF_UART_getRxCount(void)
+    \fn     uint32_t EF_UART_getRxCount(EF_UART_REGS *uart)
     \brief  Get the RX FIFO level register which is the number of bytes in the FIFO
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the RX FIFO level register.
 
-    \fn     void EF_UART_setPrescaler(uint32_t prescaler)
-    \brief  Set the prescaler to a certain value where Baud_rate = Bus_Clock_Freq/((Prescaler+1)*16)
+    \fn     uint32_t EF_UART_getStatus(EF_UART_REGS *uart)
+    \brief  Get the status snapshot register; the RX FIFO level (rxlvl), the TX FIFO level (txlvl) and RIS in a single read.
+            Unlike the FIFO level registers, the levels read the FIFO depth when a FIFO is full (255 for 256 entries).
+    \param  uart The base address of the UART registers
+    \return A uint32_t value of the status register.
+
+    \fn     uint32_t EF_UART_getCapabilities(EF_UART_REGS *uart)
+    \brief  Get the capability register; the synthesis parameters FAW, MDW and SC of the instance.
+    \param  uart The base address of the UART registers
+    \return A uint32_t value of the capability register.
+
+    \fn     uint32_t EF_UART_getFIFODepth(EF_UART_REGS *uart)
+    \brief  Get the number of entries of each of the TX and RX FIFOs, 2^FAW from the capability register.
+    \param  uart The base address of the UART registers
+    \return The FIFO depth
+
+    \fn     void EF_UART_setPrescaler(EF_UART_REGS *uart, uint32_t prescaler)
+    \brief  Set the prescaler to a certain value where Baud_rate = Bus_Clock_Freq/((Prescaler+1+Fraction/16)*Samples)
+    \param  uart The base address of the UART registers
     \param  prescaler The value of the required prescaler
     \return none
 
-    \fn     uint32_t EF_UART_getPrescaler(void) 
+    \fn     uint32_t EF_UART_getPrescaler(EF_UART_REGS *uart)
     \brief  Get the value of the prescaler register.
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the prescaler register.
 
-    \fn     uint32_t EF_UART_getRIS(void)
+    \fn     void EF_UART_setPrescalerFraction(EF_UART_REGS *uart, uint32_t fraction)
+    \brief  Set the fractional part of the prescaler in 1/16 steps; 0 gives the integer divider
+    \param  uart The base address of the UART registers
+    \param  fraction The fraction of the prescaler, 0 to 15
+    \return none
+
+    \fn     uint32_t EF_UART_getPrescalerFraction(EF_UART_REGS *uart)
+    \brief  Get the value of the prescaler fraction register.
+    \param  uart The base address of the UART registers
+    \return A uint32_t value of the prescaler fraction register.
+
+    \fn     int32_t EF_UART_calcBaudRate(uint32_t clk_hz, uint32_t baud, uint32_t samples, uint32_t *prescaler, uint32_t *fraction)
+    \brief  Find the prescaler and prescaler fraction that give the baud rate closest to the required one. Nothing
+            is written to the UART, so the result can also go into an \ref EF_UART_CONFIG.
+    \param  clk_hz The frequency of the UART clock in Hz
+    \param  baud The required baud rate
+    \param  samples The samples per bit, see \ref EF_UART_getSamplesPerBit
+    \param  prescaler Where to store the prescaler
+    \param  fraction Where to store the prescaler fraction
+    \return The error of the achieved baud rate in parts per million, positive when it is faster than required
+
+    \fn     int32_t EF_UART_setBaudRate(EF_UART_REGS *uart, uint32_t clk_hz, uint32_t baud)
+    \brief  Set the prescaler and the prescaler fraction for the baud rate closest to the required one
+            (see \ref EF_UART_calcBaudRate) at the oversampling currently set in CFG. Call it while the UART is disabled.
+    \param  uart The base address of the UART registers
+    \param  clk_hz The frequency of the UART clock in Hz
+    \param  baud The required baud rate
+    \return The error of the achieved baud rate in parts per million, positive when it is faster than required
+
+    \fn     uint32_t EF_UART_getRIS(EF_UART_REGS *uart)
     \brief  Get the value of the Raw Interrupt Status Register
             *  bit 0 TXE : Transmit FIFO is Empty.
             *  bit 1 RXF :  Receive FIFO is Full.
@@ -191,9 +366,16 @@ enum parity_type {NONE = 0, ODD = 1, EVEN = 2, STICKY_0 = 4, STICKY_1 = 5};
             *  bit 7 PRE : Parity Error; the receiver calculated parity does not match the received one.
             *  bit 8 OR : Overrun; data has been received but the RX FIFO is full.
             *  bit 9 RTO : Receiver Timeout; no data has been received for the time of a specified number of bits.
+            *  bit 10 TC : Transmission Complete; the last stop bit has left the shift register and the TX FIFO is empty.
+            *  bit 11 ABR : Baud Rate measured; the ABR register holds the length of the sync character.
+            *  bit 12 COAL : Coalesced event; the COAL counts were reached or the COAL_TIME bound expired.
+            *  bit 13 NOISE : Noise detected; the majority vote samples of a bit of the received character disagreed.
+            *  bit 14 SYNC : Sync word received; the last characters received match SYNC.
+            *  bit 15 EOF : End of frame; an idle gap of GAP ended a frame and its descriptor can be read from FRAME.
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the RIS register.
 
-    \fn     uint32_t EF_UART_getMIS(void)
+    \fn     uint32_t EF_UART_getMIS(EF_UART_REGS *uart)
     \brief  Get the value of the Masked Interrupt Status Register
             *  bit 0 TXE : Transmit FIFO is Empty.
             *  bit 1 RXF :  Receive FIFO is Full.
@@ -205,9 +387,16 @@ enum parity_type {NONE = 0, ODD = 1, EVEN = 2, STICKY_0 = 4, STICKY_1 = 5};
             *  bit 7 PRE : Parity Error; the receiver calculated parity does not match the received one.
             *  bit 8 OR : Overrun; data has been received but the RX FIFO is full.
             *  bit 9 RTO : Receiver Timeout; no data has been received for the time of a specified number of bits.
+            *  bit 10 TC : Transmission Complete; the last stop bit has left the shift register and the TX FIFO is empty.
+            *  bit 11 ABR : Baud Rate measured; the ABR register holds the length of the sync character.
+            *  bit 12 COAL : Coalesced event; the COAL counts were reached or the COAL_TIME bound expired.
+            *  bit 13 NOISE : Noise detected; the majority vote samples of a bit of the received character disagreed.
+            *  bit 14 SYNC : Sync word received; the last characters received match SYNC.
+            *  bit 15 EOF : End of frame; an idle gap of GAP ended a frame and its descriptor can be read from FRAME.
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the MIS register.
 
-    \fn     void EF_UART_setIM(uint32_t mask)
+    \fn     void EF_UART_setIM(EF_UART_REGS *uart, uint32_t mask)
     \brief  Set the value of the Interrupts Masking Register; which enable and disables interrupts
             *  bit 0 TXE : Transmit FIFO is Empty.
             *  bit 1 RXF :  Receive FIFO is Full.
@@ -219,10 +408,17 @@ enum parity_type {NONE = 0, ODD = 1, EVEN = 2, STICKY_0 = 4, STICKY_1 = 5};
             *  bit 7 PRE : Parity Error; the receiver calculated parity does not match the received one.
             *  bit 8 OR : Overrun; data has been received but the RX FIFO is full.
             *  bit 9 RTO : Receiver Timeout; no data has been received for the time of a specified number of bits.
+            *  bit 10 TC : Transmission Complete; the last stop bit has left the shift register and the TX FIFO is empty.
+            *  bit 11 ABR : Baud Rate measured; the ABR register holds the length of the sync character.
+            *  bit 12 COAL : Coalesced event; the COAL counts were reached or the COAL_TIME bound expired.
+            *  bit 13 NOISE : Noise detected; the majority vote samples of a bit of the received character disagreed.
+            *  bit 14 SYNC : Sync word received; the last characters received match SYNC.
+            *  bit 15 EOF : End of frame; an idle gap of GAP ended a frame and its descriptor can be read from FRAME.
+    \param  uart The base address of the UART registers
     \param  mask The required mask value
     \return none
 
-    \fn     uint32_t EF_UART_getIM(void)
+    \fn     uint32_t EF_UART_getIM(EF_UART_REGS *uart)
     \brief  Get the value of the Interrupts Masking Register; which enable and disables interrupts
             *  bit 0 TXE : Transmit FIFO is Empty.
             *  bit 1 RXF :  Receive FIFO is Full.
@@ -234,9 +430,16 @@ enum parity_type {NONE = 0, ODD = 1, EVEN = 2, STICKY_0 = 4, STICKY_1 = 5};
             *  bit 7 PRE : Parity Error; the receiver calculated parity does not match the received one.
             *  bit 8 OR : Overrun; data has been received but the RX FIFO is full.
             *  bit 9 RTO : Receiver Timeout; no data has been received for the time of a specified number of bits.
+            *  bit 10 TC : Transmission Complete; the last stop bit has left the shift register and the TX FIFO is empty.
+            *  bit 11 ABR : Baud Rate measured; the ABR register holds the length of the sync character.
+            *  bit 12 COAL : Coalesced event; the COAL counts were reached or the COAL_TIME bound expired.
+            *  bit 13 NOISE : Noise detected; the majority vote samples of a bit of the received character disagreed.
+            *  bit 14 SYNC : Sync word received; the last characters received match SYNC.
+            *  bit 15 EOF : End of frame; an idle gap of GAP ended a frame and its descriptor can be read from FRAME.
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the IM register.
 
-    \fn     void EF_UART_setICR(uint32_t mask)
+    \fn     void EF_UART_setICR(EF_UART_REGS *uart, uint32_t mask)
     \brief  sets the value of the Interrupts Clear Register; write 1 to clear the flag
             *  bit 0 TXE : Transmit FIFO is Empty.
             *  bit 1 RXF :  Receive FIFO is Full.
@@ -248,26 +451,494 @@ enum parity_type {NONE = 0, ODD = 1, EVEN = 2, STICKY_0 = 4, STICKY_1 = 5};
             *  bit 7 PRE : Parity Error; the receiver calculated parity does not match the received one.
             *  bit 8 OR : Overrun; data has been received but the RX FIFO is full.
             *  bit 9 RTO : Receiver Timeout; no data has been received for the time of a specified number of bits.
+            *  bit 10 TC : Transmission Complete; the last stop bit has left the shift register and the TX FIFO is empty.
+            *  bit 11 ABR : Baud Rate measured; the ABR register holds the length of the sync character.
+            *  bit 12 COAL : Coalesced event; the COAL counts were reached or the COAL_TIME bound expired.
+            *  bit 13 NOISE : Noise detected; the majority vote samples of a bit of the received character disagreed.
+            *  bit 14 SYNC : Sync word received; the last characters received match SYNC.
+            *  bit 15 EOF : End of frame; an idle gap of GAP ended a frame and its descriptor can be read from FRAME.
+    \param  uart The base address of the UART registers
     \param  mask The required mask value
     \return none
 
-    \fn     void EF_UART_writeCharArr(const char *char_arr)
+    \fn     void EF_UART_writeCharArr(EF_UART_REGS *uart, const char *char_arr)
     \brief  transmit an array of characters through uart
+    \param  uart The base address of the UART registers
     \param  char_arr An array of characters to send
     \return none
 
-    \fn     void EF_UART_writeChar(char data)
+    \fn     void EF_UART_writeChar(EF_UART_REGS *uart, char data)
     \brief  transmit a single character through uart
+    \param  uart The base address of the UART registers
     \param  data The character or byte required to send
     \return none
 
-    \fn     uint32_t EF_UART_readChar(void)
+    \fn     uint32_t EF_UART_readChar(EF_UART_REGS *uart)
     \brief  recieve a single character through uart
+    \param  uart The base address of the UART registers
     \return A uint32_t value of the byte recieved
 
+    \fn     void EF_UART_writeBuffer(EF_UART_REGS *uart, const uint8_t *data, uint32_t length)
+    \brief  transmit a buffer through uart; the status register is read once per batch and the free TX FIFO entries are
+            filled back to back, so each byte costs a single bus write. The FIFO depth is read from the capability
+            register once per call.
+    \param  uart The base address of the UART registers
+    \param  data The bytes to send
+    \param  length Number of bytes in data
+    \return none
+
+    \fn     void EF_UART_readBuffer(EF_UART_REGS *uart, uint8_t *data, uint32_t length)
+    \brief  recieve length bytes through uart; the status register is read once per batch and all the bytes waiting in the
+            RX FIFO are read back to back
+    \param  uart The base address of the UART registers
+    \param  data Destination of the received bytes
+    \param  length Number of bytes to receive
+    \return none
+
+    \fn     uint32_t EF_UART_readBufferTagged(EF_UART_REGS *uart, uint8_t *data, uint32_t *errors, uint32_t length)
+    \brief  recieve length bytes like \ref EF_UART_readBuffer and mark the ones received with a framing error, a parity
+            error or as a break. Every RXDATA read returns a byte together with its tags, so errors cost no extra bus
+            access; the packed RXDATA_PACKED reads have no room for the tags and are not used.
+    \param  uart The base address of the UART registers
+    \param  data Destination of the received bytes
+    \param  errors Bitmap of (length + 31) / 32 words; bit i % 32 of word i / 32 is set when byte i had an error
+    \param  length Number of bytes to receive
+    \return The tags of all the received bytes ORed together, in the RXDATA bit positions (EF_UART_RXDATA_REG_*_MASK)
+
+    \fn     bool EF_UART_initIRQMode(EF_UART_REGS *uart, EF_UART_IRQ_STATE *state, uint8_t *tx_buffer, uint32_t tx_size, uint8_t *rx_buffer, uint32_t rx_size)
+    \brief  Switch the driver to the interrupt driven mode. The TX and RX FIFOs are flushed, the RX FIFO threshold is set to
+            \ref EF_UART_IRQ_RX_THRESHOLD_OF the FIFO depth read from the capability register, and the RXA, RXF, RTO
+            and TXB interrupts are enabled. The TX FIFO threshold is \ref EF_UART_IRQ_TX_THRESHOLD_OF the depth while
+            there is data waiting in the TX ring buffer and 0 otherwise, which keeps TXB low: \ref EF_UART_write raises
+            it and \ref EF_UART_handleIRQ zeroes it.
+    \param  uart The base address of the UART registers
+    \param  state The interrupt driven mode state of this UART; passed to the other interrupt driven mode functions
+    \param  tx_buffer Storage of the TX ring buffer
+    \param  tx_size Size of tx_buffer in bytes; must be a power of two
+    \param  rx_buffer Storage of the RX ring buffer
+    \param  rx_size Size of rx_buffer in bytes; must be a power of two
+    \return false if any of the sizes is not a power of two, true otherwise
+
+    \fn     uint32_t EF_UART_write(EF_UART_IRQ_STATE *state, const uint8_t *data, uint32_t length)
+    \brief  Queue bytes in the TX ring buffer without blocking; they are moved to the TX FIFO by \ref EF_UART_handleIRQ
+    \param  state The interrupt driven mode state of the UART
+    \param  data The bytes to transmit
+    \param  length Number of bytes in data
+    \return The number of bytes accepted, which is less than length when the TX ring buffer is full
+
+    \fn     uint32_t EF_UART_read(EF_UART_IRQ_STATE *state, uint8_t *data, uint32_t length)
+    \brief  Copy received bytes out of the RX ring buffer without blocking
+    \param  state The interrupt driven mode state of the UART
+    \param  data Destination of the received bytes
+    \param  length Maximum number of bytes to copy
+    \return The number of bytes copied
+
+    \fn     uint32_t EF_UART_readUntil(EF_UART_REGS *uart, char delimiter, uint8_t *data, uint32_t length)
+    \brief  Receive a frame ended by a delimiter or by the idle line without an interrupt handler. MATCH is set to the
+            delimiter with MATCH_MASK cleared, the MATCH, RTO and RXF interrupts are enabled, and the function sleeps in
+            \ref EF_UART_WAIT_FOR_IRQ until one of them is raised instead of polling the flags, then reads the whole RX FIFO
+            in one burst. Bytes after the delimiter are left in the RX FIFO for the next call. MATCH, MATCH_MASK and IM are
+            restored before returning. It does not wait for a frame to start: on an idle line it returns 0 after one
+            receiver timeout (\ref EF_UART_setTimeoutBits), so call it again to keep waiting. It returns 0 at once while the
+            multidrop address filter is on (\ref EF_UART_setMultidrop), which needs MATCH and MATCH_MASK for the address.
+    \param  uart The base address of the UART registers
+    \param  delimiter The last byte of a frame, e.g. '\n'
+    \param  data Destination of the frame, including the delimiter
+    \param  length Size of data; a longer frame is returned in pieces
+    \return The number of bytes received; 0 when the line was idle for the receiver timeout without receiving anything
+
+    \fn     void EF_UART_disableFrameMode(EF_UART_IRQ_STATE *state)
+    \brief  Go back from the frame mode to the RXA, RXF and RTO interrupts of \ref EF_UART_initIRQMode, and give MATCH and
+            MATCH_MASK back the values they had before \ref EF_UART_enableFrameMode
+    \param  state The interrupt driven mode state of the UART
+    \return none
+
+    \fn     void EF_UART_enableFrameMode(EF_UART_IRQ_STATE *state, int32_t delimiter)
+    \brief  Make the interrupt driven mode interrupt about once per frame instead of every few bytes. The first byte of a frame
+            interrupts once (RXA with a zero threshold), then only the delimiter (MATCH), the idle line (RTO) or
+            \ref EF_UART_IRQ_RX_THRESHOLD_OF the depth bytes do; RTO is masked between frames since it repeats while the line is idle.
+            Call after \ref EF_UART_initIRQMode and read the frames with \ref EF_UART_readFrame. The state records whether a
+            frame is open; only \ref EF_UART_handleIRQ switches RTO in IM, so \ref EF_UART_write cannot lose the end of a frame.
+    \param  state The interrupt driven mode state of the UART
+    \param  delimiter The last byte of a frame; a negative value ends frames only when the line goes idle for the receiver timeout.
+            The delimiter takes MATCH, with MATCH_MASK cleared, until \ref EF_UART_disableFrameMode; it is not used while
+            the multidrop address filter is on (\ref EF_UART_setMultidrop), which needs them for the address
+    \return none
+
+    \fn     void EF_UART_setIRQCoalescing(EF_UART_IRQ_STATE *state, uint32_t rx_count, uint32_t tx_count, uint32_t time_cycles)
+    \brief  Make the interrupt driven mode interrupt once per rx_count bytes received or tx_count bytes sent (the COAL
+            interrupt) instead of on the RXA and TXB thresholds. A message that stops short of the count interrupts
+            time_cycles after its first byte, or on the receiver timeout (RTO) when there is no time bound; RXF always
+            interrupts. Call after \ref EF_UART_initIRQMode; not combined with \ref EF_UART_enableFrameMode.
+    \param  state The interrupt driven mode state of the UART
+    \param  rx_count Bytes received per interrupt, up to 255; 0 goes back to RXA and RTO
+    \param  tx_count Bytes sent per TX FIFO refill, up to 255; 0 goes back to TXB. The FIFO is also refilled once it runs empty
+    \param  time_cycles Latency bound in clock cycles from the first byte counted, up to 0xFFFFFF; 0 for no bound
+    \return none
+
+    \fn     uint32_t EF_UART_readFrame(EF_UART_IRQ_STATE *state, uint8_t *data, uint32_t length)
+    \brief  Copy the oldest complete frame out of the RX ring buffer without blocking. A frame ends with the delimiter
+            (which is copied as well) or where the line went idle; a frame longer than length is returned in pieces.
+    \param  state The interrupt driven mode state of the UART
+    \param  data Destination of the frame
+    \param  length Size of data
+    \return The number of bytes copied; 0 when no complete frame has been received yet
+
+    \fn     uint32_t EF_UART_getRxDropped(EF_UART_IRQ_STATE *state)
+    \brief  Get the number of received bytes dropped by \ref EF_UART_handleIRQ because the RX ring buffer was full
+    \param  state The interrupt driven mode state of the UART
+    \return The number of dropped bytes since \ref EF_UART_initIRQMode
+
+    \fn     void EF_UART_setTxRefill(EF_UART_IRQ_STATE *state, void (*refill)(void *context), void *context)
+    \brief  Install a hook that \ref EF_UART_handleIRQ calls before every refill of the TX FIFO, so that data produced
+            late (e.g. text formatted by \ref EF_UART_logProcess) can be queued with \ref EF_UART_write from the
+            interrupt and the line keeps going without waiting for the application. The hook then writes the TX ring
+            buffer from the interrupt, so nothing else may write it from the application.
+            Call after \ref EF_UART_initIRQMode, which removes the hook.
+    \param  state The interrupt driven mode state of the UART
+    \param  refill The hook; NULL removes it
+    \param  context Passed to the hook
+    \return none
+
+    \fn     EF_UART_CONFIG *EF_UART_configSetPrescaler(EF_UART_CONFIG *config, uint32_t prescaler)
+    \brief  Set the prescaler in a configuration; the configuration setters only update the structure and return it,
+            so they can be chained: EF_UART_configSetParityType(EF_UART_configSetDataSize(&config, 8), EVEN).
+            EF_UART_configSetPrescalerFraction, EF_UART_configSetCTRL, EF_UART_configSetDataSize, EF_UART_configSetTwoStopBitsSelect, EF_UART_configSetParityType,
+            EF_UART_configSetTimeoutBits, EF_UART_configSetOversampling, EF_UART_configSetMajorityVote, EF_UART_configSetRxFIFOThreshold, EF_UART_configSetTxFIFOThreshold and
+            EF_UART_configSetIM work the same way for the other fields.
+    \param  config The configuration to update
+    \param  prescaler The value of the required prescaler
+    \return config
+
+    \fn     void EF_UART_readConfig(EF_UART_REGS *uart, EF_UART_CONFIG *config)
+    \brief  Read the configuration registers of a UART, e.g. to initialize a shadow after the registers were written directly.
+    \param  uart The base address of the UART registers
+    \param  config Where to store the register values
+    \return none
+
+    \fn     uint32_t EF_UART_applyConfig(EF_UART_REGS *uart, EF_UART_CONFIG *shadow, const EF_UART_CONFIG *config)
+    \brief  Apply a configuration with the minimal set of register writes. Only the registers that differ from the
+            shadow are written. When PR or CFG change while the UART is enabled, it is disabled first and enabled again by the
+            final CTRL write, so the line never runs with a half applied frame format or baud rate.
+    \param  uart The base address of the UART registers
+    \param  shadow The last configuration applied to this UART; updated to config
+    \param  config The required configuration
+    \return The number of register writes issued
+
+    \fn     void EF_UART_handleIRQ(EF_UART_IRQ_STATE *state)
+    \brief  UART interrupt service routine for the interrupt driven mode. On RXA, RXF, RTO, MATCH or COAL it drains the RX FIFO into
+            the RX ring buffer; on TXB it refills the TX FIFO from the TX ring buffer and zeroes the TX FIFO threshold, which turns TXB off, once the
+            ring buffer is empty. With TX coalescing TXB is turned off after the first refill and COAL does the following ones.
+    \param  state The interrupt driven mode state of the UART that raised the interrupt
+    \return none
+
+    \fn     uint32_t EF_UART_handleMultiIRQ(EF_UART_REGS *uart, EF_UART_IRQ_STATE *const states[], uint32_t channels)
+    \brief  Interrupt service routine of an EF_UART_MULTI_* top. One read of IRQ_SUMMARY finds the channels with a pending
+            interrupt, and \ref EF_UART_handleIRQ runs for each of them; the idle channels cost no bus access.
+    \param  uart The registers of any channel of the top, usually channel 0; IRQ_SUMMARY is the same in every window
+    \param  states The interrupt driven mode state of every channel, indexed by channel. A channel that is not in that mode
+            keeps its IM at 0 and never shows in IRQ_SUMMARY, so its entry is not used
+    \param  channels The number of entries in states
+    \return The IRQ_SUMMARY bits that were serviced
+
+    \fn     void EF_UART_initDMA(EF_UART_REGS *uart, EF_UART_DMA_STATE *state, const EF_UART_DMA_CONTROLLER *controller)
+    \brief  Prepare the DMA mode of a UART. The driver does not program the DMA controller itself; it calls the functions of
+            controller, which the application provides for the DMA controller of its SoC. The burst size is
+            \ref EF_UART_DMA_BURST_OF the FIFO depth read from the capability register. Both DMA requests are left disabled.
+    \param  uart The base address of the UART registers
+    \param  state The DMA mode state of the UART
+    \param  controller The DMA controller serving the tx_dma_* and rx_dma_* handshake lines of the UART
+    \return none
+
+    \fn     bool EF_UART_startTxDMA(EF_UART_DMA_STATE *state, const uint8_t *data, uint32_t length)
+    \brief  Start sending a buffer through the DMA controller. The TX FIFO threshold is set so that tx_dma_req means room for a
+            whole burst, the controller channel is started, then the TX DMA request is enabled in CTRL. The controller has
+            to serve tx_dma_single for the last bytes when fewer than a burst are left.
+    \param  state The DMA mode state of the UART
+    \param  data The bytes to send; they must stay untouched until \ref EF_UART_completeDMA
+    \param  length Number of bytes to send
+    \return true when the transfer started; false when a TX transfer is still in progress, length is 0 or the controller refused it
+
+    \fn     bool EF_UART_startRxDMA(EF_UART_DMA_STATE *state, uint8_t *data, uint32_t length)
+    \brief  Start receiving into a buffer through the DMA controller. The RX FIFO threshold is set so that rx_dma_req means a
+            whole burst is waiting; the controller has to serve rx_dma_single for the last bytes of the transfer.
+    \param  state The DMA mode state of the UART
+    \param  data Destination of the received bytes
+    \param  length Number of bytes to receive
+    \return true when the transfer started; false when an RX transfer is still in progress, length is 0 or the controller refused it
+
+    \fn     uint32_t EF_UART_getDMACount(EF_UART_DMA_STATE *state, enum dma_direction direction)
+    \brief  Get the progress of a DMA transfer without stopping it
+    \param  state The DMA mode state of the UART
+    \param  direction DMA_TX or DMA_RX
+    \return The number of bytes moved so far; equals the length passed to the start function once the transfer is done
+
+    \fn     uint32_t EF_UART_completeDMA(EF_UART_DMA_STATE *state, enum dma_direction direction)
+    \brief  Finish a DMA transfer: disable its request in CTRL and stop the controller channel if bytes are still left,
+            e.g. to end an RX transfer when the line went idle (RTO). The bytes of an early ended RX transfer that are short of
+            a burst, and so were never requested, are read from the RX FIFO. A finished TX transfer may still have bytes in the TX FIFO.
+    \param  state The DMA mode state of the UART
+    \param  direction DMA_TX or DMA_RX
+    \return The number of bytes moved by the transfer
+
+    \fn     void EF_UART_setFlowControl(EF_UART_REGS *uart, bool rts, bool cts, uint32_t rts_level)
+    \brief  Set up the RTS/CTS hardware flow control. With rts, rts_n goes high while the RX FIFO holds rts_level characters
+            or more, and with cts, the transmitter does not start a character while cts_n is high; a character already on
+            the line is completed. The bits are cleared in CTRL before the watermark is written.
+    \param  uart The base address of the UART registers
+    \param  rts Drive rts_n from the RX FIFO level; rts_n stays low otherwise
+    \param  cts Pause the transmitter while cts_n is high
+    \param  rts_level The RX FIFO level at which rts_n goes high; \ref EF_UART_RTS_LEVEL_OF gives one for the FIFO depth.
+            0 raises rts_n only when the FIFO is full.
+    \return none
+
+    \fn     void EF_UART_setMultidrop(EF_UART_REGS *uart, bool enable, uint32_t address, uint32_t mask)
+    \brief  Set up the 9-bit multidrop address filter of the receiver. A frame with its ninth bit set is an address; it is
+            received when it equals address in the bits not set in mask, and the data frames after it are received until the
+            next address. Frames for other nodes are dropped by the receiver and raise no interrupt. The matching address
+            frame itself is received (with \ref EF_UART_ADDRESS_FLAG) and raises MATCH. The frames must be 9 bits long
+            (\ref EF_UART_setDataSize).
+    \param  uart The base address of the UART registers
+    \param  enable Filter by address; every frame is received otherwise
+    \param  address The address of this node, written to MATCH with \ref EF_UART_ADDRESS_FLAG
+    \param  mask The address bits that are not compared, written to MATCH_MASK, e.g. for a broadcast group
+    \return none
+
+    \fn     void EF_UART_writeAddress(EF_UART_REGS *uart, uint32_t address)
+    \brief  transmit an address frame of the 9-bit multidrop mode; the address with \ref EF_UART_ADDRESS_FLAG set
+    \param  uart The base address of the UART registers
+    \param  address The address of the node that the following data frames are for
+    \return none
+
+    \fn     void EF_UART_setRS485(EF_UART_REGS *uart, bool enable, uint32_t lead_bits, uint32_t lag_bits)
+    \brief  Set up the RS-485 driver enable output. With enable, de rises lead_bits bit times before the first start bit and
+            falls lag_bits bit times after the last stop bit, so half-duplex transceivers are turned around by the hardware.
+            Characters queued while de is still high go out without a new lead time.
+    \param  uart The base address of the UART registers
+    \param  enable Drive de; it stays low otherwise
+    \param  lead_bits Bit times from de rising to the start bit, 0 to 15
+    \param  lag_bits Bit times from the last stop bit to de falling, 0 to 15
+    \return none
+
+    \fn     void EF_UART_writeBufferAndWait(EF_UART_REGS *uart, const uint8_t *data, uint32_t length)
+    \brief  transmit a buffer through uart and return after its last stop bit has left the shift register (TC), for
+            half-duplex protocols that answer on the same pair. de, if enabled, falls lag bit times later.
+    \param  uart The base address of the UART registers
+    \param  data The bytes to send
+    \param  length The number of bytes to send
+    \return none
+
+    \fn     bool EF_UART_autoBaud(EF_UART_REGS *uart, uint32_t timeout)
+    \brief  Measure the baud rate of the other side and program PR and PRF for it at the oversampling currently set in CFG.
+            The other side has to send a sync character with bit 0 and bit 6 set and bit 7 clear, 0x55 or 0x7F, with 8
+            data bits. The receiver is held while the hardware measures, so the sync character is not received.
+    \param  uart The base address of the UART registers
+    \param  timeout The number of polls of RIS to wait for the sync character; 0 waits forever
+    \return true if PR and PRF were set, false on a timeout or when the character did not look like a sync character
+
+    \fn     bool EF_UART_getStats(EF_UART_REGS *uart, EF_UART_STATS *stats)
+    \brief  Get the traffic and error counts since the previous call and restart them. All the counters are captured in
+            the same clock cycle, so the counts of one call belong to one interval and no event is counted twice or lost.
+            The FIFO high-water marks help to size the FIFO thresholds and the FIFO depth (FAW) from real traffic.
+    \param  uart The base address of the UART registers
+    \param  stats Where to store the counts
+    \return false when the IP was built without the statistics counters (STATS=0), true otherwise
+
+    \fn     void EF_UART_setSyncWord(EF_UART_REGS *uart, bool enable, uint32_t pattern, uint32_t mask, uint32_t length, bool hunt)
+    \brief  Set up the sync word detector of the receiver. SYNC is raised when the last length characters received equal
+            pattern in the bits not set in mask, with no framing or parity error among them. With hunt, the receiver drops
+            every character, the sync word included, until the sync word is seen, so the RX FIFO starts with the first
+            byte after it and the traffic in between raises no FIFO interrupt. A receiver timeout (\ref EF_UART_setTimeoutBits)
+            ends the message and the hunt starts again; so does calling this function.
+    \param  uart The base address of the UART registers
+    \param  enable Look for the sync word; every character is received otherwise
+    \param  pattern The sync word, the first character in bits 7:0, e.g. 0x55AA for 0xAA followed by 0x55. Only the low
+            8 bits of 9-bit characters are compared.
+    \param  mask The pattern bits that are not compared, e.g. 0xFF00 for 0xAA followed by any character
+    \param  length The number of characters in the sync word, 1 to 4
+    \param  hunt Drop the characters before the sync word
+    \return none
+
+    \fn     bool EF_UART_setCRC(EF_UART_REGS *uart, bool enable, uint32_t width, uint32_t poly, uint32_t init, bool reflect, bool invert)
+    \brief  Set up the CRC unit and restart both CRCs. The TX CRC is updated as each character is sent and leaves the
+            TX FIFO, the RX CRC as each character goes into the RX FIFO, with the low 8 bits of the character. The
+            parameters follow the CRC catalogues: CRC-16/CCITT-FALSE is (16, 0x1021, 0xFFFF, false, false),
+            CRC-16/KERMIT (16, 0x1021, 0, true, false) and CRC-32 (32, 0x04C11DB7, 0xFFFFFFFF, true, true).
+    \param  uart The base address of the UART registers
+    \param  enable Update the CRCs with the characters sent and received
+    \param  width The CRC width in bits; 8, 16 or 32
+    \param  poly The polynomial without its top bit
+    \param  init The start value of the CRC register
+    \param  reflect Feed the characters LSB first and reflect the result (refin and refout)
+    \param  invert Complement the result (xorout of all ones)
+    \return false when the IP was built without the CRC unit (CRC=0) or width is not supported, true otherwise
+
+    \fn     void EF_UART_crcReset(EF_UART_REGS *uart, bool tx, bool rx)
+    \brief  Restart the CRC of the characters sent, received, or both from the start value; one register write
+    \param  uart The base address of the UART registers
+    \param  tx Restart the TX CRC
+    \param  rx Restart the RX CRC
+    \return none
+
+    \fn     bool EF_UART_crcGetTx(EF_UART_REGS *uart, uint32_t *crc, uint32_t timeout)
+    \brief  Get the CRC of the characters sent since \ref EF_UART_crcReset. Waits until the TX FIFO is empty, so the value
+            covers every character written before the call; send it after the frame to append the CRC. The FIFO only
+            drains while the transmitter is enabled and, with flow control, CTS is asserted.
+    \param  uart The base address of the UART registers
+    \param  crc Where to store the CRC, in the low width bits
+    \param  timeout The number of polls of STATUS to wait for the TX FIFO to drain; 0 waits forever
+    \return true if crc was stored, false on a timeout
+
+    \fn     uint32_t EF_UART_crcGetRx(EF_UART_REGS *uart)
+    \brief  Get the CRC of the characters received since \ref EF_UART_crcReset. Restart it before a frame; after the frame
+            and the CRC that follows it, the value is 0 for a good frame, or \ref EF_UART_CRC32_RESIDUE for CRC-32.
+    \param  uart The base address of the UART registers
+    \return The CRC, in the low width bits
+
+    \fn     void EF_UART_setFrameGap(EF_UART_REGS *uart, uint32_t gap)
+    \brief  Set the receiver idle time that ends a frame. The gap is counted in receiver samples from the end of the last
+            stop bit, against character times of the frame format in CFG, so it follows the baud rate, the data size,
+            the parity and the stop bits. At each gap after characters, the length and the error summary of the frame
+            go into a FIFO of 4 descriptors and EOF is raised; read the frames with \ref EF_UART_readGapFrame.
+    \param  uart The base address of the UART registers
+    \param  gap The idle time in 1/16 character times, 1 to 255; \ref EF_UART_GAP_MODBUS_T35 for the 3.5 character
+            gap of Modbus RTU. 0 turns the frame delimiting off.
+    \return none
+
+    \fn     uint32_t EF_UART_readGapFrame(EF_UART_REGS *uart, uint8_t *data, uint32_t length, uint32_t *errors)
+    \brief  Read the oldest frame delimited by an idle gap (\ref EF_UART_setFrameGap): pops its descriptor and reads its
+            characters from the RX FIFO. The characters beyond length are dropped, so the next call starts at the
+            next frame. Call it once for each EOF, or until it returns 0.
+    \param  uart The base address of the UART registers
+    \param  data Where to store the characters of the frame
+    \param  length The size of data
+    \param  errors Where to store the error summary of the frame; the FE, PE, OR and MERGED bits of the FRAME register
+    \return The length of the frame, which is more than length when characters were dropped; 0 when no frame ended
+
+    \fn     void EF_UART_setSynchronous(EF_UART_REGS *uart, bool enable, bool external_clock)
+    \brief  Select the synchronous mode, for links where both sides share a bit clock (sclk). Each bit takes one period
+            of sclk instead of 4 to 16 samples: tx changes on the falling edge and rx is sampled on the rising edge, with
+            the frame format, FIFOs and interrupts of the asynchronous mode. The UART drives sclk at
+            clk/(2*(PR+1+PRF/16)), up to clk/2 with PR=0; \ref EF_UART_setBaudRate takes the mode into account, so select
+            it first. The UART is disabled while the mode changes, so no character is cut between the two clocks.
+    \param  uart The base address of the UART registers
+    \param  enable true for the synchronous mode, false for the asynchronous one
+    \param  external_clock Take sclk from sclk_in; it has to stay high and low for 5 clock cycles or more each.
+            The receiver timeout and the frame gap count the periods of sclk
+    \return none
+
+    \fn     EF_UART_IRQ_STATE *EF_UART_getIRQState(void)
+    \brief  The interrupt driven mode state of the UART behind \ref EF_DRIVER_UART0, for the handle based APIs built on
+            that mode (e.g. \ref EF_UART_logInit)
+    \return The state passed to \ref EF_UART_initIRQMode by EF_DRIVER_UART0.initIRQMode
+
+    \fn     void EF_UART_IRQHandler(void)
+    \brief  \ref EF_UART_handleIRQ for the UART behind \ref EF_DRIVER_UART0
+    \return none
+
 */
 
 
+/**
+ * @brief Lock-free single-producer/single-consumer ring buffer used by the interrupt driven mode
+ *
+ * The head index is only written by the producer and the tail index only by the consumer, so the
+ * ring buffer can be shared between the application and \ref EF_UART_IRQHandler without locks.
+ * The registers follow the same rule: once the mode is set up, IM is only changed by the interrupt
+ * handler, and the application only starts a transmission with a plain write of TX_FIFO_THRESHOLD.
+ * A read-modify-write of IM by the application could undo a change the handler made in between;
+ * the set up functions write IM as a whole, so call them with the interrupt handler idle.
+ */
+typedef struct _EF_UART_RING_BUFFER_ {
+    volatile uint8_t    *buffer;                        ///< Storage of the ring buffer, provided by the application.
+    uint32_t            mask;                           ///< Size of the storage minus one; the size is a power of two.
+    volatile uint32_t   head;                           ///< Free running write index; only written by the producer.
+    volatile uint32_t   tail;                           ///< Free running read index; only written by the consumer.
+} EF_UART_RING_BUFFER;
+
+/**
+ * @brief State of the interrupt driven mode
+ */
+typedef struct _EF_UART_IRQ_STATE_ {
+    EF_UART_REGS        *regs;                          ///< The UART this state belongs to; set by \ref EF_UART_initIRQMode.
+    EF_UART_RING_BUFFER tx;                             ///< Bytes waiting to be moved to the TX FIFO.
+    EF_UART_RING_BUFFER rx;                             ///< Bytes drained from the RX FIFO, waiting to be read.
+    volatile uint32_t   rx_dropped;                     ///< Number of received bytes dropped because the RX ring buffer was full.
+    int32_t             delimiter;                      ///< Frame delimiter of the frame mode, negative when frames only end with the idle line.
+    bool                frame_mode;                     ///< Set by \ref EF_UART_enableFrameMode.
+    uint32_t            match;                          ///< MATCH of the application while the frame mode delimiter uses it.
+    uint32_t            match_mask;                     ///< MATCH_MASK of the application while the frame mode delimiter uses it.
+    volatile bool       in_frame;                       ///< Frame mode: a frame started and RTO is enabled to end it; only changed by the interrupt handler.
+    bool                tx_coalescing;                  ///< The COAL interrupt refills the TX FIFO; set by \ref EF_UART_setIRQCoalescing.
+    void                (*tx_refill)(void *context);    ///< Called before every TX FIFO refill; set by \ref EF_UART_setTxRefill.
+    void                *tx_refill_context;             ///< Argument of tx_refill.
+    volatile uint32_t   rx_idle_mark;                   ///< RX ring buffer head when the line last went idle; the end of an undelimited frame.
+    uint32_t            fifo_depth;                     ///< Depth of the FIFOs read from the capability register.
+} EF_UART_IRQ_STATE;
+
+
+
+/**
+ * @brief Interface of the DMA controller that serves the UART, provided by the application
+ *
+ * The controller moves bytes between memory and the TXDATA or RXDATA register, one burst per tx_dma_req or rx_dma_req and
+ * one byte per tx_dma_single or rx_dma_single, and pulses the matching ack line after every request it served.
+ */
+typedef struct _EF_UART_DMA_CONTROLLER_ {
+    /// Program and start the channel of a direction; data_register is the bus address of TXDATA or RXDATA.
+    bool (*start)(void *context, enum dma_direction direction, uintptr_t data_register, uintptr_t memory, uint32_t length, uint32_t burst);
+    uint32_t (*remaining)(void *context, enum dma_direction direction);     ///< Bytes the channel has not moved yet.
+    void (*stop)(void *context, enum dma_direction direction);              ///< Abort the channel.
+    void *context;                                                          ///< Passed to every function, e.g. the controller registers.
+} EF_UART_DMA_CONTROLLER;
+
+/**
+ * @brief State of the DMA mode
+ */
+typedef struct _EF_UART_DMA_STATE_ {
+    EF_UART_REGS        *regs;                          ///< The UART this state belongs to; set by \ref EF_UART_initDMA.
+    const EF_UART_DMA_CONTROLLER *controller;           ///< The DMA controller serving the UART.
+    uint32_t            burst;                          ///< Entries moved per burst request.
+    uint32_t            length[2];                      ///< Length of the transfer in progress per \ref dma_direction, 0 when idle.
+    uint8_t             *rx_data;                       ///< Destination of the RX transfer in progress.
+} EF_UART_DMA_STATE;
+
+
+/**
+ * @brief Images of the UART configuration registers
+ *
+ * Used both as the configuration to apply and as the driver-side shadow of what the registers hold,
+ * see \ref EF_UART_applyConfig. Start from \ref EF_UART_CONFIG_DEFAULT.
+ */
+typedef struct _EF_UART_CONFIG_ {
+    uint32_t            PR;                             ///< Prescaler register.
+    uint32_t            PRF;                            ///< Prescaler fraction register.
+    uint32_t            CTRL;                           ///< Control register.
+    uint32_t            CFG;                            ///< Configuration register.
+    uint32_t            RX_FIFO_THRESHOLD;              ///< RX FIFO level threshold register.
+    uint32_t            TX_FIFO_THRESHOLD;              ///< TX FIFO level threshold register.
+    uint32_t            IM;                             ///< Interrupt mask register.
+} EF_UART_CONFIG;
+
+/**
+ * @brief Traffic and error counts of one interval, see \ref EF_UART_getStats
+ */
+typedef struct _EF_UART_STATS_ {
+    uint32_t            tx_chars;                       ///< Characters sent.
+    uint32_t            rx_chars;                       ///< Characters received, including the ones lost to an overrun.
+    uint32_t            frame_errors;                   ///< Framing errors; the error counts saturate at 0xFFFF.
+    uint32_t            parity_errors;                  ///< Parity errors.
+    uint32_t            overruns;                       ///< Characters lost because the RX FIFO was full.
+    uint32_t            breaks;                         ///< Line breaks.
+    uint32_t            timeouts;                       ///< Receiver timeouts.
+    uint32_t            tx_fifo_max;                    ///< Highest TX FIFO level.
+    uint32_t            rx_fifo_max;                    ///< Highest RX FIFO level.
+} EF_UART_STATS;
+
+// Register reset values
+#define EF_UART_CONFIG_DEFAULT {.PR = 0, .PRF = 0, .CTRL = 0, .CFG = 0x3F08, .RX_FIFO_THRESHOLD = 0, .TX_FIFO_THRESHOLD = 0, .IM = 0}
+
+
 
 /**
  * @brief UART Driver Access Structure
@@ -319,9 +990,160 @@ typedef struct _EF_DRIVER_UART_ {
     void (*writeCharArr)(const char *char_arr);         ///< Pointer to /ref EF_UART_writeCharArr function: Function to transmit an array of characters through UART.
     void (*writeChar)(char data);                       ///< Pointer to /ref EF_UART_writeChar function: Function to transmit a single character through UART.
     uint32_t (*readChar)(void);                          ///< Pointer to /ref EF_UART_readChar function: Function to receive a single character through UART.
+    bool (*initIRQMode)(uint8_t *tx_buffer, uint32_t tx_size, uint8_t *rx_buffer, uint32_t rx_size);   ///< Pointer to /ref EF_UART_initIRQMode function: Function to switch the driver to the interrupt driven mode.
+    uint32_t (*write)(const uint8_t *data, uint32_t length);    ///< Pointer to /ref EF_UART_write function: Function to queue bytes for transmission without blocking.
+    uint32_t (*read)(uint8_t *data, uint32_t length);           ///< Pointer to /ref EF_UART_read function: Function to read received bytes without blocking.
+    uint32_t (*getRxDropped)(void);                      ///< Pointer to /ref EF_UART_getRxDropped function: Function to get the number of received bytes dropped by the interrupt driven mode.
+    void (*setTxRefill)(void (*refill)(void *context), void *context);    ///< Pointer to /ref EF_UART_setTxRefill function: Function to install a hook called before every TX FIFO refill of the interrupt driven mode.
+    uint32_t (*getStatus)(void);                         ///< Pointer to /ref EF_UART_getStatus function: Function to get the FIFO levels and the Raw Interrupt Status in a single read.
+    void (*writeBuffer)(const uint8_t *data, uint32_t length);  ///< Pointer to /ref EF_UART_writeBuffer function: Function to transmit a buffer through UART.
+    void (*readBuffer)(uint8_t *data, uint32_t length);         ///< Pointer to /ref EF_UART_readBuffer function: Function to receive a buffer through UART.
+    uint32_t (*applyConfig)(const EF_UART_CONFIG *config);      ///< Pointer to /ref EF_UART_applyConfig function: Function to apply a configuration with the minimal set of register writes.
+    void (*readConfig)(EF_UART_CONFIG *config);                 ///< Pointer to /ref EF_UART_readConfig function: Function to read the configuration registers, also resynchronizes the shadow used by applyConfig.
+    uint32_t (*readUntil)(char delimiter, uint8_t *data, uint32_t length); ///< Pointer to /ref EF_UART_readUntil function: Function to receive a frame ended by a delimiter or the idle line.
+    void (*enableFrameMode)(int32_t delimiter);                 ///< Pointer to /ref EF_UART_enableFrameMode function: Function to make the interrupt driven mode interrupt once per frame.
+    void (*disableFrameMode)(void);                             ///< Pointer to /ref EF_UART_disableFrameMode function: Function to leave the frame mode.
+    uint32_t (*readFrame)(uint8_t *data, uint32_t length);      ///< Pointer to /ref EF_UART_readFrame function: Function to get a complete frame received in the interrupt driven mode.
+    void (*setPrescalerFraction)(uint32_t fraction);            ///< Pointer to /ref EF_UART_setPrescalerFraction function: Function to set the Prescaler fraction.
+    uint32_t (*getPrescalerFraction)(void);                     ///< Pointer to /ref EF_UART_getPrescalerFraction function: Function to get the Prescaler fraction.
+    int32_t (*setBaudRate)(uint32_t clk_hz, uint32_t baud);     ///< Pointer to /ref EF_UART_setBaudRate function: Function to set the closest baud rate; returns the error in ppm.
+    void (*setOversampling)(enum oversampling_type oversampling);   ///< Pointer to /ref EF_UART_setOversampling function: Function to set the samples per bit.
+    uint32_t (*getSamplesPerBit)(void);                         ///< Pointer to /ref EF_UART_getSamplesPerBit function: Function to get the samples per bit.
+    uint32_t (*getFIFODepth)(void);                             ///< Pointer to /ref EF_UART_getFIFODepth function: Function to get the depth of the FIFOs.
+    void (*initDMA)(const EF_UART_DMA_CONTROLLER *controller);  ///< Pointer to /ref EF_UART_initDMA function: Function to prepare the DMA mode with the DMA controller of the SoC.
+    bool (*startTxDMA)(const uint8_t *data, uint32_t length);   ///< Pointer to /ref EF_UART_startTxDMA function: Function to send a buffer through DMA.
+    bool (*startRxDMA)(uint8_t *data, uint32_t length);         ///< Pointer to /ref EF_UART_startRxDMA function: Function to receive into a buffer through DMA.
+    uint32_t (*getDMACount)(enum dma_direction direction);      ///< Pointer to /ref EF_UART_getDMACount function: Function to get the progress of a DMA transfer.
+    uint32_t (*completeDMA)(enum dma_direction direction);      ///< Pointer to /ref EF_UART_completeDMA function: Function to finish a DMA transfer.
+    uint32_t (*readBufferTagged)(uint8_t *data, uint32_t *errors, uint32_t length); ///< Pointer to /ref EF_UART_readBufferTagged function: Function to receive a buffer with a bitmap of the bytes received with errors.
+    void (*setFlowControl)(bool rts, bool cts, uint32_t rts_level);  ///< Pointer to /ref EF_UART_setFlowControl function: Function to set up the RTS/CTS hardware flow control.
+    void (*setMultidrop)(bool enable, uint32_t address, uint32_t mask);  ///< Pointer to /ref EF_UART_setMultidrop function: Function to set up the 9-bit multidrop address filter.
+    void (*writeAddress)(uint32_t address);              ///< Pointer to /ref EF_UART_writeAddress function: Function to transmit a 9-bit multidrop address frame.
+    void (*setRS485)(bool enable, uint32_t lead_bits, uint32_t lag_bits);   ///< Pointer to /ref EF_UART_setRS485 function: Function to set up the RS-485 driver enable output.
+    void (*writeBufferAndWait)(const uint8_t *data, uint32_t length);      ///< Pointer to /ref EF_UART_writeBufferAndWait function: Function to transmit a buffer and wait for its last stop bit.
+    bool (*autoBaud)(uint32_t timeout);                                    ///< Pointer to /ref EF_UART_autoBaud function: Function to measure and set the baud rate of the other side.
+    void (*setIRQCoalescing)(uint32_t rx_count, uint32_t tx_count, uint32_t time_cycles);  ///< Pointer to /ref EF_UART_setIRQCoalescing function: Function to set the bytes and the latency bound per interrupt in the interrupt driven mode.
+    bool (*getStats)(EF_UART_STATS *stats);                                ///< Pointer to /ref EF_UART_getStats function: Function to get and restart the traffic and error counts.
+    void (*setMajorityVote)(bool enable);                                  ///< Pointer to /ref EF_UART_setMajorityVote function: Function to decide the received bits by a majority of 3 samples.
+    void (*setSyncWord)(bool enable, uint32_t pattern, uint32_t mask, uint32_t length, bool hunt);  ///< Pointer to /ref EF_UART_setSyncWord function: Function to set up the sync word detector and the hunt mode.
+    bool (*setCRC)(bool enable, uint32_t width, uint32_t poly, uint32_t init, bool reflect, bool invert);  ///< Pointer to /ref EF_UART_setCRC function: Function to set up the CRC of the characters sent and received.
+    void (*crcReset)(bool tx, bool rx);                                    ///< Pointer to /ref EF_UART_crcReset function: Function to restart the TX and RX CRCs.
+    bool (*crcGetTx)(uint32_t *crc, uint32_t timeout);                     ///< Pointer to /ref EF_UART_crcGetTx function: Function to get the CRC of the characters sent.
+    uint32_t (*crcGetRx)(void);                                            ///< Pointer to /ref EF_UART_crcGetRx function: Function to get the CRC of the characters received.
+    void (*setFrameGap)(uint32_t gap);                                     ///< Pointer to /ref EF_UART_setFrameGap function: Function to set the idle gap that ends a frame.
+    uint32_t (*readGapFrame)(uint8_t *data, uint32_t length, uint32_t *errors);  ///< Pointer to /ref EF_UART_readGapFrame function: Function to read the oldest frame delimited by an idle gap.
+    void (*setSynchronous)(bool enable, bool external_clock);              ///< Pointer to /ref EF_UART_setSynchronous function: Function to select the synchronous mode and its clock.
 } EF_DRIVER_UART;
 
 
+// Handle based API; every function takes the base address of the UART it works on, so any number of instances can be driven
+DRIVER_VERSION EF_UART_getVersion(void);
+void EF_UART_enable(EF_UART_REGS *uart);
+void EF_UART_setGclkEnable(EF_UART_REGS *uart, uint32_t value);
+void EF_UART_disable(EF_UART_REGS *uart);
+void EF_UART_enableRx(EF_UART_REGS *uart);
+void EF_UART_disableRx(EF_UART_REGS *uart);
+void EF_UART_enableTx(EF_UART_REGS *uart);
+void EF_UART_disableTx(EF_UART_REGS *uart);
+void EF_UART_enableLoopBack(EF_UART_REGS *uart);
+void EF_UART_disableLoopBack(EF_UART_REGS *uart);
+void EF_UART_enableGlitchFilter(EF_UART_REGS *uart);
+void EF_UART_disableGlitchFilter(EF_UART_REGS *uart);
+void EF_UART_setCTRL(EF_UART_REGS *uart, uint32_t value);
+uint32_t EF_UART_getCTRL(EF_UART_REGS *uart);
+void EF_UART_setDataSize(EF_UART_REGS *uart, uint32_t value);
+void EF_UART_setPrescaler(EF_UART_REGS *uart, uint32_t prescaler);
+uint32_t EF_UART_getPrescaler(EF_UART_REGS *uart);
+void EF_UART_setPrescalerFraction(EF_UART_REGS *uart, uint32_t fraction);
+uint32_t EF_UART_getPrescalerFraction(EF_UART_REGS *uart);
+int32_t EF_UART_calcBaudRate(uint32_t clk_hz, uint32_t baud, uint32_t samples, uint32_t *prescaler, uint32_t *fraction);
+int32_t EF_UART_setBaudRate(EF_UART_REGS *uart, uint32_t clk_hz, uint32_t baud);
+void EF_UART_setTwoStopBitsSelect(EF_UART_REGS *uart, bool is_two_bits);
+void EF_UART_setParityType(EF_UART_REGS *uart, enum parity_type parity);
+void EF_UART_setTimeoutBits(EF_UART_REGS *uart, uint32_t value);
+void EF_UART_setOversampling(EF_UART_REGS *uart, enum oversampling_type oversampling);
+void EF_UART_setMajorityVote(EF_UART_REGS *uart, bool enable);
+uint32_t EF_UART_getSamplesPerBit(EF_UART_REGS *uart);
+void EF_UART_setConfig(EF_UART_REGS *uart, uint32_t value);
+uint32_t EF_UART_getConfig(EF_UART_REGS *uart);
+void EF_UART_setRxFIFOThreshold(EF_UART_REGS *uart, uint32_t value);
+uint32_t EF_UART_getRxFIFOThreshold(EF_UART_REGS *uart);
+void EF_UART_setTxFIFOThreshold(EF_UART_REGS *uart, uint32_t value);
+uint32_t EF_UART_getTxFIFOThreshold(EF_UART_REGS *uart);
+uint32_t EF_UART_getTxCount(EF_UART_REGS *uart);
+uint32_t EF_UART_getRxCount(EF_UART_REGS *uart);
+uint32_t EF_UART_getStatus(EF_UART_REGS *uart);
+uint32_t EF_UART_getCapabilities(EF_UART_REGS *uart);
+uint32_t EF_UART_getFIFODepth(EF_UART_REGS *uart);
+void EF_UART_setMatchData(EF_UART_REGS *uart, uint32_t matchData);
+uint32_t EF_UART_getMatchData(EF_UART_REGS *uart);
+uint32_t EF_UART_getRIS(EF_UART_REGS *uart);
+uint32_t EF_UART_getMIS(EF_UART_REGS *uart);
+void EF_UART_setIM(EF_UART_REGS *uart, uint32_t mask);
+uint32_t EF_UART_getIM(EF_UART_REGS *uart);
+void EF_UART_setICR(EF_UART_REGS *uart, uint32_t mask);
+void EF_UART_writeChar(EF_UART_REGS *uart, char data);
+void EF_UART_writeCharArr(EF_UART_REGS *uart, const char *char_arr);
+void EF_UART_writeBuffer(EF_UART_REGS *uart, const uint8_t *data, uint32_t length);
+uint32_t EF_UART_readChar(EF_UART_REGS *uart);
+void EF_UART_readBuffer(EF_UART_REGS *uart, uint8_t *data, uint32_t length);
+uint32_t EF_UART_readBufferTagged(EF_UART_REGS *uart, uint8_t *data, uint32_t *errors, uint32_t length);
+
+bool EF_UART_initIRQMode(EF_UART_REGS *uart, EF_UART_IRQ_STATE *state, uint8_t *tx_buffer, uint32_t tx_size, uint8_t *rx_buffer, uint32_t rx_size);
+uint32_t EF_UART_write(EF_UART_IRQ_STATE *state, const uint8_t *data, uint32_t length);
+uint32_t EF_UART_read(EF_UART_IRQ_STATE *state, uint8_t *data, uint32_t length);
+uint32_t EF_UART_getRxDropped(EF_UART_IRQ_STATE *state);
+void EF_UART_setTxRefill(EF_UART_IRQ_STATE *state, void (*refill)(void *context), void *context);
+uint32_t EF_UART_readUntil(EF_UART_REGS *uart, char delimiter, uint8_t *data, uint32_t length);
+void EF_UART_enableFrameMode(EF_UART_IRQ_STATE *state, int32_t delimiter);
+void EF_UART_disableFrameMode(EF_UART_IRQ_STATE *state);
+uint32_t EF_UART_readFrame(EF_UART_IRQ_STATE *state, uint8_t *data, uint32_t length);
+void EF_UART_setIRQCoalescing(EF_UART_IRQ_STATE *state, uint32_t rx_count, uint32_t tx_count, uint32_t time_cycles);
+void EF_UART_handleIRQ(EF_UART_IRQ_STATE *state);
+uint32_t EF_UART_handleMultiIRQ(EF_UART_REGS *uart, EF_UART_IRQ_STATE *const states[], uint32_t channels);
+void EF_UART_initDMA(EF_UART_REGS *uart, EF_UART_DMA_STATE *state, const EF_UART_DMA_CONTROLLER *controller);
+bool EF_UART_startTxDMA(EF_UART_DMA_STATE *state, const uint8_t *data, uint32_t length);
+bool EF_UART_startRxDMA(EF_UART_DMA_STATE *state, uint8_t *data, uint32_t length);
+uint32_t EF_UART_getDMACount(EF_UART_DMA_STATE *state, enum dma_direction direction);
+uint32_t EF_UART_completeDMA(EF_UART_DMA_STATE *state, enum dma_direction direction);
+void EF_UART_setFlowControl(EF_UART_REGS *uart, bool rts, bool cts, uint32_t rts_level);
+void EF_UART_setMultidrop(EF_UART_REGS *uart, bool enable, uint32_t address, uint32_t mask);
+void EF_UART_writeAddress(EF_UART_REGS *uart, uint32_t address);
+void EF_UART_setRS485(EF_UART_REGS *uart, bool enable, uint32_t lead_bits, uint32_t lag_bits);
+void EF_UART_writeBufferAndWait(EF_UART_REGS *uart, const uint8_t *data, uint32_t length);
+bool EF_UART_autoBaud(EF_UART_REGS *uart, uint32_t timeout);
+bool EF_UART_getStats(EF_UART_REGS *uart, EF_UART_STATS *stats);
+void EF_UART_setSyncWord(EF_UART_REGS *uart, bool enable, uint32_t pattern, uint32_t mask, uint32_t length, bool hunt);
+bool EF_UART_setCRC(EF_UART_REGS *uart, bool enable, uint32_t width, uint32_t poly, uint32_t init, bool reflect, bool invert);
+void EF_UART_crcReset(EF_UART_REGS *uart, bool tx, bool rx);
+bool EF_UART_crcGetTx(EF_UART_REGS *uart, uint32_t *crc, uint32_t timeout);
+uint32_t EF_UART_crcGetRx(EF_UART_REGS *uart);
+void EF_UART_setFrameGap(EF_UART_REGS *uart, uint32_t gap);
+uint32_t EF_UART_readGapFrame(EF_UART_REGS *uart, uint8_t *data, uint32_t length, uint32_t *errors);
+void EF_UART_setSynchronous(EF_UART_REGS *uart, bool enable, bool external_clock);
+
+EF_UART_CONFIG *EF_UART_configSetPrescaler(EF_UART_CONFIG *config, uint32_t prescaler);
+EF_UART_CONFIG *EF_UART_configSetPrescalerFraction(EF_UART_CONFIG *config, uint32_t fraction);
+EF_UART_CONFIG *EF_UART_configSetCTRL(EF_UART_CONFIG *config, uint32_t value);
+EF_UART_CONFIG *EF_UART_configSetDataSize(EF_UART_CONFIG *config, uint32_t value);
+EF_UART_CONFIG *EF_UART_configSetTwoStopBitsSelect(EF_UART_CONFIG *config, bool is_two_bits);
+EF_UART_CONFIG *EF_UART_configSetParityType(EF_UART_CONFIG *config, enum parity_type parity);
+EF_UART_CONFIG *EF_UART_configSetTimeoutBits(EF_UART_CONFIG *config, uint32_t value);
+EF_UART_CONFIG *EF_UART_configSetOversampling(EF_UART_CONFIG *config, enum oversampling_type oversampling);
+EF_UART_CONFIG *EF_UART_configSetMajorityVote(EF_UART_CONFIG *config, bool enable);
+EF_UART_CONFIG *EF_UART_configSetRxFIFOThreshold(EF_UART_CONFIG *config, uint32_t value);
+EF_UART_CONFIG *EF_UART_configSetTxFIFOThreshold(EF_UART_CONFIG *config, uint32_t value);
+EF_UART_CONFIG *EF_UART_configSetIM(EF_UART_CONFIG *config, uint32_t mask);
+void EF_UART_readConfig(EF_UART_REGS *uart, EF_UART_CONFIG *config);
+uint32_t EF_UART_applyConfig(EF_UART_REGS *uart, EF_UART_CONFIG *shadow, const EF_UART_CONFIG *config);
+
+// Driver access structure of the UART at EF_UART0_BASE
+extern EF_DRIVER_UART EF_DRIVER_UART0;
+
+EF_UART_IRQ_STATE *EF_UART_getIRQState(void);
+void EF_UART_IRQHandler(void);
+
+
 
 
 #endif
\ No newline at end of file
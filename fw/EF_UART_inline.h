@@ -0,0 +1,120 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file EF_UART_inline.h
+    \brief Header-only fast path of the UART data transfer APIs.
+
+    The functions have the same behaviour as their counterparts in EF_UART.c but are static inline. When the
+    base address is a compile-time constant, e.g. EF_UART_writeCharInline((EF_UART_REGS*)EF_UART0_BASE, 'a'),
+    the compiler folds the register addresses into the accesses and no call is made at all.
+*/
+
+#ifndef EF_UART_INLINE_H
+#define EF_UART_INLINE_H
+
+#include <EF_UART.h>
+
+static inline uint32_t EF_UART_getStatusInline(EF_UART_REGS *uart){
+
+    return (uart->STATUS);
+}
+
+static inline uint32_t EF_UART_getRISInline(EF_UART_REGS *uart){
+
+    return (uart->RIS);
+}
+
+static inline void EF_UART_setICRInline(EF_UART_REGS *uart, uint32_t mask){
+
+    // IC reads back as 0, a plain write saves the read of a read-modify-write
+    uart->IC = mask;
+}
+
+// Free entries of a TX FIFO of the given depth; a full 256-entry FIFO reads as 255 in STATUS and counts as full
+static inline uint32_t EF_UART_txFreeInline(uint32_t depth, uint32_t status){
+
+    uint32_t level = (status & EF_UART_STATUS_REG_TXLVL_MASK) >> EF_UART_STATUS_REG_TXLVL_BIT;
+    return ((level >= depth) || (level == EF_UART_STATUS_LEVEL_MAX)) ? 0 : depth - level;
+}
+
+// Push count bytes the caller knows fit into the TX FIFO; groups of 4 go through TXDATA_PACKED in one access each
+static inline void EF_UART_writeFIFOInline(EF_UART_REGS *uart, const uint8_t *data, uint32_t count){
+
+    for (; count >= 4; count -= 4, data += 4)
+        uart->TXDATA_PACKED = (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    while (count--)
+        uart->TXDATA = *(data++);
+}
+
+// Pop count bytes the caller knows are waiting in the RX FIFO; RXDATA_PACKED pops 4 of them per access
+static inline void EF_UART_readFIFOInline(EF_UART_REGS *uart, uint8_t *data, uint32_t count){
+
+    for (; count >= 4; count -= 4, data += 4){
+        uint32_t word = uart->RXDATA_PACKED;
+        data[0] = (uint8_t)word;
+        data[1] = (uint8_t)(word >> 8);
+        data[2] = (uint8_t)(word >> 16);
+        data[3] = (uint8_t)(word >> 24);
+    }
+    while (count--)
+        *(data++) = uart->RXDATA;
+}
+
+static inline void EF_UART_writeCharInline(EF_UART_REGS *uart, char data){
+
+    while((uart->RIS & EF_UART_TXE_FLAG) == 0x0); // wait until TX empty flag is 1
+    uart->TXDATA = data;
+    uart->IC = EF_UART_TXE_FLAG;
+}
+
+static inline uint32_t EF_UART_readCharInline(EF_UART_REGS *uart){
+
+    while((uart->RIS & EF_UART_RXA_FLAG) == 0x0); // wait over RX fifo level above flag to be 1
+    uint32_t data = uart->RXDATA & EF_UART_RXDATA_REG_DATA_MASK;    // without the error tags
+    uart->IC = EF_UART_RXA_FLAG;
+
+    return data;
+}
+
+static inline void EF_UART_writeBufferInline(EF_UART_REGS *uart, const uint8_t *data, uint32_t length){
+
+    while (length){
+        // a single status read tells how many entries are free in the TX FIFO
+        uint32_t count = EF_UART_txFreeInline(EF_UART_FIFO_DEPTH, uart->STATUS);
+        if (count > length)
+            count = length;
+        EF_UART_writeFIFOInline(uart, data, count);
+        data += count;
+        length -= count;
+    }
+}
+
+static inline void EF_UART_readBufferInline(EF_UART_REGS *uart, uint8_t *data, uint32_t length){
+
+    while (length){
+        // a single status read tells how many bytes are waiting in the RX FIFO
+        uint32_t count = (uart->STATUS & EF_UART_STATUS_REG_RXLVL_MASK) >> EF_UART_STATUS_REG_RXLVL_BIT;
+        if (count > length)
+            count = length;
+        EF_UART_readFIFOInline(uart, data, count);
+        data += count;
+        length -= count;
+    }
+}
+
+#endif // EF_UART_INLINE_H
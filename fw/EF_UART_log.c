@@ -0,0 +1,238 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file EF_UART_log.c
+    \brief C file of the deferred logging on top of the interrupt driven mode
+
+*/
+
+#ifndef EF_UART_LOG_C
+#define EF_UART_LOG_C
+
+#include <EF_UART_log.h>
+
+
+// Digits of value in the given base, written backwards from end; returns their number
+static uint32_t EF_UART_logDigits(char *end, uintptr_t value, uint32_t base, bool upper){
+
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    uint32_t length = 0;
+
+    do {
+        *--end = digits[value % base];
+        value /= base;
+        length++;
+    } while (value != 0);
+    return length;
+}
+
+// printf subset of EF_UART_LOG into line; returns the length, cut at size
+static uint32_t EF_UART_logFormat(char *line, uint32_t size, const char *format, const uintptr_t *args, uint32_t count){
+
+    uint32_t n = 0;
+    uint32_t next = 0;
+
+    while ((*format != 0) && (n < size)){
+        if (*format != '%'){
+            line[n++] = *format++;
+            continue;
+        }
+        format++;
+
+        bool left = false, zero = false;
+        uint32_t width = 0;
+        for (;; format++){
+            if (*format == '-')
+                left = true;
+            else if (*format == '0')
+                zero = true;
+            else
+                break;
+        }
+        while ((*format >= '0') && (*format <= '9'))
+            width = width * 10 + (uint32_t)(*format++ - '0');
+        while ((*format == 'l') || (*format == 'h') || (*format == 'z'))
+            format++;
+        char conversion = *format;
+        if (conversion == 0)
+            break;
+        format++;
+        if (conversion == '%'){
+            line[n++] = '%';
+            continue;
+        }
+
+        // a missing argument reads as 0 rather than the next record
+        bool taken = next < count;
+        uintptr_t arg = taken ? args[next++] : 0;
+        char digits[2 * sizeof(uintptr_t) + 2];
+        char *end = digits + sizeof(digits);
+        const char *text = end;
+        uint32_t length = 0;
+        char sign = 0;
+
+        switch (conversion){
+        case 'd':
+        case 'i':
+            if ((int32_t)arg < 0){
+                sign = '-';
+                length = EF_UART_logDigits(end, 0u - (uint32_t)arg, 10, false);
+            } else {
+                length = EF_UART_logDigits(end, (uint32_t)arg, 10, false);
+            }
+            break;
+        case 'u':
+            length = EF_UART_logDigits(end, (uint32_t)arg, 10, false);
+            break;
+        case 'x':
+        case 'X':
+            length = EF_UART_logDigits(end, (uint32_t)arg, 16, conversion == 'X');
+            break;
+        case 'p':
+            length = EF_UART_logDigits(end, arg, 16, false) + 2;
+            end[-(int32_t)length] = '0';
+            end[-(int32_t)length + 1] = 'x';
+            zero = false;
+            break;
+        case 'c':
+            end[-1] = (char)arg;
+            length = 1;
+            zero = false;
+            break;
+        case 's':
+            text = arg ? (const char *)arg : "(null)";
+            while (text[length] != 0)
+                length++;
+            zero = false;
+            break;
+        default:
+            // unknown conversion; printed as it is, without taking an argument
+            end[-2] = '%';
+            end[-1] = conversion;
+            length = 2;
+            zero = false;
+            if (taken)
+                next--;
+            break;
+        }
+        if (conversion != 's')
+            text = end - length;
+
+        uint32_t pad = (width > length + (sign != 0)) ? width - length - (sign != 0) : 0;
+        if (!left && !zero)
+            for (; pad && (n < size); pad--)
+                line[n++] = ' ';
+        if (sign && (n < size))
+            line[n++] = sign;
+        if (zero && !left)
+            for (; pad && (n < size); pad--)
+                line[n++] = '0';
+        for (uint32_t i = 0; (i < length) && (n < size); i++)
+            line[n++] = text[i];
+        for (; pad && (n < size); pad--)
+            line[n++] = ' ';
+    }
+    return n;
+}
+
+static void EF_UART_logRefill(void *context){
+
+    EF_UART_logProcess((EF_UART_LOG *)context);
+    return;
+}
+
+bool EF_UART_logInit(EF_UART_LOG *log, EF_UART_IRQ_STATE *irq, uintptr_t *buffer, uint32_t words){
+
+    if ((words == 0) || ((words & (words - 1)) != 0))
+        return false;
+
+    log->irq = irq;
+    log->buffer = buffer;
+    log->mask = words - 1;
+    log->head = 0;
+    log->tail = 0;
+    log->dropped = 0;
+    log->busy = false;
+    log->line_length = 0;
+    log->line_sent = 0;
+    EF_UART_setTxRefill(irq, EF_UART_logRefill, log);
+    return true;
+}
+
+bool EF_UART_logRecord(EF_UART_LOG *log, const char *format, uint32_t count, const uintptr_t *args){
+
+    bool recorded = false;
+
+    if (count > EF_UART_LOG_MAX_ARGS)
+        count = EF_UART_LOG_MAX_ARGS;
+
+    EF_UART_LOG_LOCK();
+    uint32_t head = log->head;
+    if ((log->mask + 1) - (head - log->tail) >= EF_UART_LOG_RECORD_WORDS(count)){
+        log->buffer[head & log->mask] = (uintptr_t)format;
+        log->buffer[(head + 1) & log->mask] = count;
+        for (uint32_t i = 0; i < count; i++)
+            log->buffer[(head + 2 + i) & log->mask] = args[i];
+        // the record is complete before the consumer can see it
+        log->head = head + EF_UART_LOG_RECORD_WORDS(count);
+        recorded = true;
+    } else {
+        log->dropped++;
+    }
+    EF_UART_LOG_UNLOCK();
+    return recorded;
+}
+
+uint32_t EF_UART_logProcess(EF_UART_LOG *log){
+
+    // the TX refill hook interrupted a call from the idle loop, which goes on once the interrupt returns
+    if (log->busy)
+        return log->head - log->tail;
+    log->busy = true;
+
+    for (;;){
+        if (log->line_sent < log->line_length){
+            log->line_sent += EF_UART_write(log->irq, (const uint8_t *)&log->line[log->line_sent], log->line_length - log->line_sent);
+            if (log->line_sent < log->line_length)
+                break;
+        }
+
+        uint32_t tail = log->tail;
+        if (tail == log->head)
+            break;
+        uintptr_t args[EF_UART_LOG_MAX_ARGS];
+        const char *format = (const char *)log->buffer[tail & log->mask];
+        uint32_t count = (uint32_t)log->buffer[(tail + 1) & log->mask];
+        for (uint32_t i = 0; i < count; i++)
+            args[i] = log->buffer[(tail + 2 + i) & log->mask];
+        log->tail = tail + EF_UART_LOG_RECORD_WORDS(count);
+
+        log->line_length = EF_UART_logFormat(log->line, EF_UART_LOG_LINE_MAX, format, args, count);
+        log->line_sent = 0;
+    }
+
+    log->busy = false;
+    return log->head - log->tail;
+}
+
+uint32_t EF_UART_logGetDropped(EF_UART_LOG *log){
+
+    return log->dropped;
+}
+
+#endif // EF_UART_LOG_C
@@ -0,0 +1,146 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file EF_UART_log.h
+    \brief Deferred formatted logging on top of the interrupt driven mode.
+
+    \ref EF_UART_LOG only stores the format string pointer and the raw arguments in a ring buffer of words, in a
+    bounded number of RAM accesses and without touching the UART, so it can be called from interrupts. The text is
+    formatted later by \ref EF_UART_logProcess, from the idle loop or from the TX refill hook of \ref EF_UART_handleIRQ,
+    and queued in the TX ring buffer of the interrupt driven mode.
+*/
+
+#ifndef EF_UART_LOG_H
+#define EF_UART_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <EF_UART.h>
+
+// Longest formatted line; longer lines are cut
+#ifndef EF_UART_LOG_LINE_MAX
+#define EF_UART_LOG_LINE_MAX 128
+#endif
+
+// Critical section around a record, for logs written from more than one context: e.g. define EF_UART_LOG_LOCK() as
+// "uint32_t log_irq = disable_irq()" and EF_UART_LOG_UNLOCK() as "restore_irq(log_irq)". Empty for a single context.
+#ifndef EF_UART_LOG_LOCK
+#define EF_UART_LOG_LOCK()
+#endif
+#ifndef EF_UART_LOG_UNLOCK
+#define EF_UART_LOG_UNLOCK()
+#endif
+
+// Most arguments of one record
+#define EF_UART_LOG_MAX_ARGS 6
+
+// Words of a record: the format string, the number of arguments and the arguments
+#define EF_UART_LOG_RECORD_WORDS(args) (2 + (args))
+
+// Function documentation
+/**
+    \fn     bool EF_UART_logInit(EF_UART_LOG *log, EF_UART_IRQ_STATE *irq, uintptr_t *buffer, uint32_t words)
+    \brief  Start a log on a UART in the interrupt driven mode, and install \ref EF_UART_logProcess as its TX refill hook
+            (\ref EF_UART_setTxRefill), so once a line is on its way the following ones are formatted by the TXB
+            interrupt. The TX ring buffer of that UART then carries the log only.
+    \param  log The log state; passed to the other log functions
+    \param  irq The interrupt driven mode state of the UART, after \ref EF_UART_initIRQMode; \ref EF_UART_getIRQState for
+            \ref EF_DRIVER_UART0
+    \param  buffer Storage of the records
+    \param  words Size of buffer in words; must be a power of two. A record takes \ref EF_UART_LOG_RECORD_WORDS of its
+            number of arguments
+    \return false if words is not a power of two, true otherwise
+
+    \fn     EF_UART_LOG(log, format, ...)
+    \brief  Record a log line without formatting it. Takes up to \ref EF_UART_LOG_MAX_ARGS arguments, stored as uintptr_t.
+            The conversions are %d, %i, %u, %x, %X, %c, %s, %p and %%, with the '-' and '0' flags and a width; the
+            l, h and z length modifiers are ignored, as integers are taken as 32 bits. The format string and the
+            strings of %s are read when the line is formatted, so they have to stay in place, e.g. string literals.
+    \param  log The log state
+    \param  format printf style format string
+    \return true when recorded, false when the record did not fit and was dropped (\ref EF_UART_logGetDropped)
+
+    \fn     bool EF_UART_logRecord(EF_UART_LOG *log, const char *format, uint32_t count, const uintptr_t *args)
+    \brief  The function behind \ref EF_UART_LOG
+    \param  log The log state
+    \param  format printf style format string
+    \param  count Number of arguments, up to \ref EF_UART_LOG_MAX_ARGS
+    \param  args The arguments
+    \return true when recorded, false when dropped
+
+    \fn     uint32_t EF_UART_logProcess(EF_UART_LOG *log)
+    \brief  Format the waiting records and queue them in the TX ring buffer, until it is full or no record is left;
+            a line that does not fit is finished by the next call. Call from the idle loop to start the output after
+            the line went idle; the TX refill hook keeps it going. A call that interrupts another one returns at once.
+    \param  log The log state
+    \return The number of words of records still waiting
+
+    \fn     uint32_t EF_UART_logGetDropped(EF_UART_LOG *log)
+    \brief  Get the number of records dropped because the record buffer was full
+    \param  log The log state
+    \return The number of dropped records since \ref EF_UART_logInit
+
+*/
+
+
+/**
+ * @brief State of a deferred log
+ *
+ * Like \ref EF_UART_RING_BUFFER, head is only written by the producers and tail only by \ref EF_UART_logProcess.
+ */
+typedef struct _EF_UART_LOG_ {
+    EF_UART_IRQ_STATE   *irq;                           ///< UART whose TX ring buffer carries the text.
+    volatile uintptr_t  *buffer;                        ///< Storage of the records, provided by the application.
+    uint32_t            mask;                           ///< Size of the storage in words minus one; the size is a power of two.
+    volatile uint32_t   head;                           ///< Free running write index in words; only written by the producers.
+    volatile uint32_t   tail;                           ///< Free running read index in words; only written by \ref EF_UART_logProcess.
+    volatile uint32_t   dropped;                        ///< Number of records dropped because the buffer was full.
+    volatile bool       busy;                           ///< Set while \ref EF_UART_logProcess runs.
+    uint32_t            line_length;                    ///< Length of the formatted line.
+    uint32_t            line_sent;                      ///< Characters of the line already queued.
+    char                line[EF_UART_LOG_LINE_MAX];     ///< The line being queued.
+} EF_UART_LOG;
+
+
+// The arguments of a record, in an array that lives until the end of the call
+#ifdef __cplusplus
+#include <initializer_list>
+#define EF_UART_LOG_ARRAY(...) (std::initializer_list<uintptr_t>{__VA_ARGS__}.begin())
+#else
+#define EF_UART_LOG_ARRAY(...) ((const uintptr_t[]){__VA_ARGS__})
+#endif
+
+#define EF_UART_LOG_ARG(a) ((uintptr_t)(a))
+#define EF_UART_LOG_0(log, f) EF_UART_logRecord((log), (f), 0, 0)
+#define EF_UART_LOG_1(log, f, a) EF_UART_logRecord((log), (f), 1, EF_UART_LOG_ARRAY(EF_UART_LOG_ARG(a)))
+#define EF_UART_LOG_2(log, f, a, b) EF_UART_logRecord((log), (f), 2, EF_UART_LOG_ARRAY(EF_UART_LOG_ARG(a), EF_UART_LOG_ARG(b)))
+#define EF_UART_LOG_3(log, f, a, b, c) EF_UART_logRecord((log), (f), 3, EF_UART_LOG_ARRAY(EF_UART_LOG_ARG(a), EF_UART_LOG_ARG(b), EF_UART_LOG_ARG(c)))
+#define EF_UART_LOG_4(log, f, a, b, c, d) EF_UART_logRecord((log), (f), 4, EF_UART_LOG_ARRAY(EF_UART_LOG_ARG(a), EF_UART_LOG_ARG(b), EF_UART_LOG_ARG(c), EF_UART_LOG_ARG(d)))
+#define EF_UART_LOG_5(log, f, a, b, c, d, e) EF_UART_logRecord((log), (f), 5, EF_UART_LOG_ARRAY(EF_UART_LOG_ARG(a), EF_UART_LOG_ARG(b), EF_UART_LOG_ARG(c), EF_UART_LOG_ARG(d), EF_UART_LOG_ARG(e)))
+#define EF_UART_LOG_6(log, f, a, b, c, d, e, g) EF_UART_logRecord((log), (f), 6, EF_UART_LOG_ARRAY(EF_UART_LOG_ARG(a), EF_UART_LOG_ARG(b), EF_UART_LOG_ARG(c), EF_UART_LOG_ARG(d), EF_UART_LOG_ARG(e), EF_UART_LOG_ARG(g)))
+#define EF_UART_LOG_SELECT(f, a, b, c, d, e, g, name, ...) name
+
+#define EF_UART_LOG(log, ...) EF_UART_LOG_SELECT(__VA_ARGS__, EF_UART_LOG_6, EF_UART_LOG_5, EF_UART_LOG_4, EF_UART_LOG_3, \
+                                                 EF_UART_LOG_2, EF_UART_LOG_1, EF_UART_LOG_0, 0)(log, __VA_ARGS__)
+
+bool EF_UART_logInit(EF_UART_LOG *log, EF_UART_IRQ_STATE *irq, uintptr_t *buffer, uint32_t words);
+bool EF_UART_logRecord(EF_UART_LOG *log, const char *format, uint32_t count, const uintptr_t *args);
+uint32_t EF_UART_logProcess(EF_UART_LOG *log);
+uint32_t EF_UART_logGetDropped(EF_UART_LOG *log);
+
+#endif // EF_UART_LOG_H
@@ -27,6 +27,22 @@
 #define   __RW    volatile       uint32_t
 #endif
 
+// FIFO address width (the FAW parameter of the IP); the FIFOs are 2^FAW entries deep
+#ifndef EF_UART_FAW
+#define EF_UART_FAW	4
+#endif
+#define EF_UART_FAW_MASK	((1 << EF_UART_FAW) - 1)
+
+#define EF_UART_RXDATA_REG_DATA_BIT	0
+#define EF_UART_RXDATA_REG_DATA_MASK	0x1ff
+#define EF_UART_RXDATA_REG_FE_BIT	9
+#define EF_UART_RXDATA_REG_FE_MASK	0x200
+#define EF_UART_RXDATA_REG_PE_BIT	10
+#define EF_UART_RXDATA_REG_PE_MASK	0x400
+#define EF_UART_RXDATA_REG_BRK_BIT	11
+#define EF_UART_RXDATA_REG_BRK_MASK	0x800
+#define EF_UART_RXDATA_REG_MATCH_BIT	12
+#define EF_UART_RXDATA_REG_MATCH_MASK	0x1000
 #define EF_UART_CTRL_REG_EN_BIT	0
 #define EF_UART_CTRL_REG_EN_MASK	0x1
 #define EF_UART_CTRL_REG_TXEN_BIT	1
@@ -37,6 +53,24 @@
 #define EF_UART_CTRL_REG_LPEN_MASK	0x8
 #define EF_UART_CTRL_REG_GFEN_BIT	4
 #define EF_UART_CTRL_REG_GFEN_MASK	0x10
+#define EF_UART_CTRL_REG_TXDMAEN_BIT	5
+#define EF_UART_CTRL_REG_TXDMAEN_MASK	0x20
+#define EF_UART_CTRL_REG_RXDMAEN_BIT	6
+#define EF_UART_CTRL_REG_RXDMAEN_MASK	0x40
+#define EF_UART_CTRL_REG_RTSEN_BIT	7
+#define EF_UART_CTRL_REG_RTSEN_MASK	0x80
+#define EF_UART_CTRL_REG_CTSEN_BIT	8
+#define EF_UART_CTRL_REG_CTSEN_MASK	0x100
+#define EF_UART_CTRL_REG_ADEN_BIT	9
+#define EF_UART_CTRL_REG_ADEN_MASK	0x200
+#define EF_UART_CTRL_REG_DEEN_BIT	10
+#define EF_UART_CTRL_REG_DEEN_MASK	0x400
+#define EF_UART_CTRL_REG_ABREN_BIT	11
+#define EF_UART_CTRL_REG_ABREN_MASK	0x800
+#define EF_UART_CTRL_REG_SCEN_BIT	12
+#define EF_UART_CTRL_REG_SCEN_MASK	0x1000
+#define EF_UART_CTRL_REG_SCEXT_BIT	13
+#define EF_UART_CTRL_REG_SCEXT_MASK	0x2000
 #define EF_UART_CFG_REG_WLEN_BIT	0
 #define EF_UART_CFG_REG_WLEN_MASK	0xf
 #define EF_UART_CFG_REG_STP2_BIT	4
@@ -45,16 +79,92 @@
 #define EF_UART_CFG_REG_PARITY_MASK	0xe0
 #define EF_UART_CFG_REG_TIMEOUT_BIT	8
 #define EF_UART_CFG_REG_TIMEOUT_MASK	0x3f00
+#define EF_UART_CFG_REG_OSR_BIT	14
+#define EF_UART_CFG_REG_OSR_MASK	0xc000
+#define EF_UART_CFG_REG_MAJ_BIT	16
+#define EF_UART_CFG_REG_MAJ_MASK	0x10000
+#define EF_UART_STATUS_REG_RXLVL_BIT	0
+#define EF_UART_STATUS_REG_RXLVL_MASK	0xff
+#define EF_UART_STATUS_REG_TXLVL_BIT	8
+#define EF_UART_STATUS_REG_TXLVL_MASK	0xff00
+#define EF_UART_STATUS_REG_RIS_BIT	16
+#define EF_UART_STATUS_REG_RIS_MASK	0xffff0000
+#define EF_UART_CAP_REG_FAW_BIT	0
+#define EF_UART_CAP_REG_FAW_MASK	0xf
+#define EF_UART_CAP_REG_MDW_BIT	4
+#define EF_UART_CAP_REG_MDW_MASK	0xf0
+#define EF_UART_CAP_REG_SC_BIT	8
+#define EF_UART_CAP_REG_SC_MASK	0x1f00
+#define EF_UART_CAP_REG_STATS_BIT	13
+#define EF_UART_CAP_REG_STATS_MASK	0x2000
+#define EF_UART_CAP_REG_CRC_BIT	14
+#define EF_UART_CAP_REG_CRC_MASK	0x4000
+#define EF_UART_RTS_REG_LEVEL_BIT	0
+#define EF_UART_RTS_REG_LEVEL_MASK	EF_UART_FAW_MASK
+#define EF_UART_DE_REG_LEAD_BIT	0
+#define EF_UART_DE_REG_LEAD_MASK	0xf
+#define EF_UART_DE_REG_LAG_BIT	4
+#define EF_UART_DE_REG_LAG_MASK	0xf0
+#define EF_UART_ABR_REG_COUNT_BIT	0
+#define EF_UART_ABR_REG_COUNT_MASK	0xffffff
+#define EF_UART_COAL_REG_RXCNT_BIT	0
+#define EF_UART_COAL_REG_RXCNT_MASK	0xff
+#define EF_UART_COAL_REG_TXCNT_BIT	8
+#define EF_UART_COAL_REG_TXCNT_MASK	0xff00
+#define EF_UART_STATS_SNAP_REG_SNAP_BIT	0
+#define EF_UART_STATS_SNAP_REG_SNAP_MASK	0x1
+#define EF_UART_STATS_FE_PE_REG_FE_BIT	0
+#define EF_UART_STATS_FE_PE_REG_FE_MASK	0xffff
+#define EF_UART_STATS_FE_PE_REG_PE_BIT	16
+#define EF_UART_STATS_FE_PE_REG_PE_MASK	0xffff0000
+#define EF_UART_STATS_OR_BRK_REG_OR_BIT	0
+#define EF_UART_STATS_OR_BRK_REG_OR_MASK	0xffff
+#define EF_UART_STATS_OR_BRK_REG_BRK_BIT	16
+#define EF_UART_STATS_OR_BRK_REG_BRK_MASK	0xffff0000
+#define EF_UART_STATS_MAX_REG_RXMAX_BIT	0
+#define EF_UART_STATS_MAX_REG_RXMAX_MASK	0xff
+#define EF_UART_STATS_MAX_REG_TXMAX_BIT	8
+#define EF_UART_STATS_MAX_REG_TXMAX_MASK	0xff00
+#define EF_UART_SYNC_CTRL_REG_LEN_BIT	0
+#define EF_UART_SYNC_CTRL_REG_LEN_MASK	0x3
+#define EF_UART_SYNC_CTRL_REG_EN_BIT	2
+#define EF_UART_SYNC_CTRL_REG_EN_MASK	0x4
+#define EF_UART_SYNC_CTRL_REG_HUNT_BIT	3
+#define EF_UART_SYNC_CTRL_REG_HUNT_MASK	0x8
+#define EF_UART_CRC_CTRL_REG_EN_BIT	0
+#define EF_UART_CRC_CTRL_REG_EN_MASK	0x1
+#define EF_UART_CRC_CTRL_REG_SIZE_BIT	1
+#define EF_UART_CRC_CTRL_REG_SIZE_MASK	0x6
+#define EF_UART_CRC_CTRL_REG_REFIN_BIT	3
+#define EF_UART_CRC_CTRL_REG_REFIN_MASK	0x8
+#define EF_UART_CRC_CTRL_REG_REFOUT_BIT	4
+#define EF_UART_CRC_CTRL_REG_REFOUT_MASK	0x10
+#define EF_UART_CRC_CTRL_REG_INV_BIT	5
+#define EF_UART_CRC_CTRL_REG_INV_MASK	0x20
+#define EF_UART_CRC_RST_REG_TX_BIT	0
+#define EF_UART_CRC_RST_REG_TX_MASK	0x1
+#define EF_UART_CRC_RST_REG_RX_BIT	1
+#define EF_UART_CRC_RST_REG_RX_MASK	0x2
+#define EF_UART_FRAME_REG_LEN_BIT	0
+#define EF_UART_FRAME_REG_LEN_MASK	0xFFFF
+#define EF_UART_FRAME_REG_FE_BIT	16
+#define EF_UART_FRAME_REG_FE_MASK	0x10000
+#define EF_UART_FRAME_REG_PE_BIT	17
+#define EF_UART_FRAME_REG_PE_MASK	0x20000
+#define EF_UART_FRAME_REG_OR_BIT	18
+#define EF_UART_FRAME_REG_OR_MASK	0x40000
+#define EF_UART_FRAME_REG_MERGED_BIT	19
+#define EF_UART_FRAME_REG_MERGED_MASK	0x80000
 #define EF_UART_RX_FIFO_LEVEL_REG_LEVEL_BIT	0
-#define EF_UART_RX_FIFO_LEVEL_REG_LEVEL_MASK	0xf
+#define EF_UART_RX_FIFO_LEVEL_REG_LEVEL_MASK	EF_UART_FAW_MASK
 #define EF_UART_RX_FIFO_THRESHOLD_REG_THRESHOLD_BIT	0
-#define EF_UART_RX_FIFO_THRESHOLD_REG_THRESHOLD_MASK	0xf
+#define EF_UART_RX_FIFO_THRESHOLD_REG_THRESHOLD_MASK	EF_UART_FAW_MASK
 #define EF_UART_RX_FIFO_FLUSH_REG_FLUSH_BIT	0
 #define EF_UART_RX_FIFO_FLUSH_REG_FLUSH_MASK	0x1
 #define EF_UART_TX_FIFO_LEVEL_REG_LEVEL_BIT	0
-#define EF_UART_TX_FIFO_LEVEL_REG_LEVEL_MASK	0xf
+#define EF_UART_TX_FIFO_LEVEL_REG_LEVEL_MASK	EF_UART_FAW_MASK
 #define EF_UART_TX_FIFO_THRESHOLD_REG_THRESHOLD_BIT	0
-#define EF_UART_TX_FIFO_THRESHOLD_REG_THRESHOLD_MASK	0xf
+#define EF_UART_TX_FIFO_THRESHOLD_REG_THRESHOLD_MASK	EF_UART_FAW_MASK
 #define EF_UART_TX_FIFO_FLUSH_REG_FLUSH_BIT	0
 #define EF_UART_TX_FIFO_FLUSH_REG_FLUSH_MASK	0x1
 
@@ -68,6 +178,12 @@
 #define EF_UART_PRE_FLAG	0x80
 #define EF_UART_OR_FLAG	0x100
 #define EF_UART_RTO_FLAG	0x200
+#define EF_UART_TC_FLAG	0x400
+#define EF_UART_ABR_FLAG	0x800
+#define EF_UART_COAL_FLAG	0x1000
+#define EF_UART_NOISE_FLAG	0x2000
+#define EF_UART_SYNC_FLAG	0x4000
+#define EF_UART_EOF_FLAG	0x8000
 
 typedef struct _EF_UART_REGS_ {
 	__R 	RXDATA;
@@ -77,7 +193,36 @@ typedef struct _EF_UART_REGS_ {
 	__W 	CFG;
 	__R 	reserved_0[2];
 	__W 	MATCH;
-	__R 	reserved_1[16248];
+	__R 	STATUS;
+	__W 	PRF;
+	__R 	CAP;
+	__W 	TXDATA_PACKED;
+	__R 	RXDATA_PACKED;
+	__W 	RTS;
+	__W 	MATCH_MASK;
+	__W 	DE;
+	__R 	ABR;
+	__W 	COAL;
+	__W 	COAL_TIME;
+	__W 	STATS_SNAP;
+	__R 	STATS_TX;
+	__R 	STATS_RX;
+	__R 	STATS_FE_PE;
+	__R 	STATS_OR_BRK;
+	__R 	STATS_RTO;
+	__R 	STATS_MAX;
+	__W 	SYNC;
+	__W 	SYNC_MASK;
+	__W 	SYNC_CTRL;
+	__W 	CRC_POLY;
+	__W 	CRC_INIT;
+	__W 	CRC_CTRL;
+	__W 	CRC_RST;
+	__R 	CRC_TX;
+	__R 	CRC_RX;
+	__W 	GAP;
+	__R 	FRAME;
+	__R 	reserved_1[16219];
 	__R 	RX_FIFO_LEVEL;
 	__W 	RX_FIFO_THRESHOLD;
 	__W 	RX_FIFO_FLUSH;
@@ -91,6 +236,8 @@ typedef struct _EF_UART_REGS_ {
 	__R 	RIS;
 	__W 	IC;
 	__W 	GCLK;
+	__R 	reserved_4[3];
+	__R 	IRQ_SUMMARY;	// EF_UART_MULTI_* tops only; one bit per channel with its IRQ high
 } EF_UART_REGS;
 
 #endif
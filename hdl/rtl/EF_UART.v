@@ -19,11 +19,28 @@
     - Programmable frame format
         - Data: 5-9 bits
         - Parity: None, Odd, Even, or Sticky at 0/1
-    - TX and RX FIFOs with programmable thresholds
+    - TX and RX FIFOs with programmable thresholds, 4 to 256 entries deep (FAW)
+    - Packed FIFO access: 4 bytes pushed or popped in one bus transfer
+    - Per character frame error, parity error, break, and match tags in the RX FIFO
     - 16-bit prescaler (PR) for programable baud rate generation
-    - Baudrate = CLK/((PR+1)*NUM_SAMPLES)
+    - 4-bit prescaler fraction (PRF) in 1/16 steps
+    - Baudrate = CLK/((PR+1+PRF/16)*Samples)
+    - Samples per bit (oversampling) selectable at runtime: SC, 16, 8 or 4
     - RX synchronizer
+    - DMA request/acknowledge handshake per direction (burst and single requests)
+    - RTS/CTS hardware flow control; RTS follows an RX FIFO level watermark
+    - 9-bit multidrop address filtering against MATCH and a mask
+    - RS-485 driver enable (de) with programmable lead and lag times in bits
+    - Automatic baud rate detection: measures 8 bit times of a 0x55 or 0x7F sync character
+    - Interrupt coalescing: one event per N characters received or sent, bounded by a timer
+    - Optional statistics (STATS): character, error and FIFO high-water mark counters with snapshot-and-clear
     - RX Glich Filter
+    - Majority vote of 3 samples around the bit centre, with a noise flag when they disagree
+    - Sync word detector: up to 4 characters with a bit mask; optionally drops RX data until the sync word (hunt)
+    - Optional CRC (CRC): 8, 16 or 32-bit CRC of the characters sent and received, any polynomial and reflection
+    - Idle gap frame delimiting in 1/16 character times, with a 4 entry FIFO of frame lengths and error summaries
+    - Synchronous mode: one bit per period of a bit clock (sclk), driven from the baud generator up to clk/2 or
+      taken from the other side, with the same frame format, FIFOs and interrupts
     - Interrupt Sources:
         + TX fifo not full
         + RX fifo not empty
@@ -35,6 +52,12 @@
         + Timeout: Nothing received for the time of 4 frames!
         + Overrun
         + Receiving a specific frame
+        + Transmission complete: the last stop bit has left the shift register
+        + Baud rate measured
+        + Coalesced RX/TX event
+        + Noise: the samples of a received bit disagreed
+        + Sync word received
+        + End of frame: an idle gap ended a frame and its descriptor is waiting
 */
 
 `timescale			1ns/1ps
@@ -42,41 +65,89 @@
 
 
 module EF_UART #(parameter  MDW = 9,        // Max data size/width
-                                FAW = 4,        // FIFO Address width; Depth=2^AW
-                                SC = 8,         // Number of samples per bit/baud
-                                GFLEN = 8       // Length (number of stages) of the glitch filter
+                                FAW = 4,        // FIFO Address width; Depth=2^AW, 2 to 8
+                                SC = 8,         // Number of samples per bit/baud when osr is 0
+                                GFLEN = 8,      // Length (number of stages) of the glitch filter
+                                STATS = 1,      // Statistics counters; 0 ties the stats_* outputs to 0
+                                CRC = 1         // CRC of the TX and RX characters; 0 ties the crc_* outputs to 0
 ) (
     input   wire            clk,
     input   wire            rst_n,
     
     input   wire [15:0]     prescaler,
+    input   wire [3:0]      prescaler_frac,     // fraction of the prescaler in 1/16
     input   wire            en,
     input   wire            tx_en,
     input   wire            rx_en,
     input   wire            rd,
     input   wire            wr,
     input   wire [MDW-1:0]  wdata,
+    input   wire            rd_packed,          // pop 4 bytes; nothing unless 4 are waiting
+    input   wire            wr_packed,          // push 4 bytes
+    input   wire [31:0]     wdata_packed,       // byte 0 in bits 7:0 is sent first
     input   wire [3:0]      data_size,          // 5 - 9
     input   wire            stop_bits_count,    // 0: 1, 1: 2
     input   wire [2:0]      parity_type,        // 000: None, 001: odd, 010: even, 100: Sticky 0, 101: Sticky 1
-    input   wire [3:0]      txfifotr,
-    input   wire [3:0]      rxfifotr,
+    input   wire [FAW-1:0]  txfifotr,
+    input   wire [FAW-1:0]  rxfifotr,
     input   wire [MDW-1:0]  match_data,
+    input   wire [MDW-1:0]  match_mask,         // bits set are not compared with match_data
+    input   wire            addr_en,            // 9-bit multidrop; only frames after a matching address are received
     input   wire [5:0]      timeout_bits,
+    input   wire [1:0]      osr,                // samples per bit; 00: SC, 01: 16, 10: 8, 11: 4
     input   wire            loopback_en,
     input   wire            glitch_filter_en,
+    input   wire            majority_en,        // each bit is the majority of 3 samples around its centre
     input   wire            tx_fifo_flush,
     input   wire            rx_fifo_flush,
+    input   wire            tx_dma_en,
+    input   wire            rx_dma_en,
+    input   wire            tx_dma_ack,         // the DMA controller completed a TX request
+    input   wire            rx_dma_ack,         // the DMA controller completed an RX request
+    input   wire            rts_en,             // rts_n follows the RX FIFO level; asserted (0) otherwise
+    input   wire            cts_en,             // no character is started while cts_n is high
+    input   wire [FAW-1:0]  rts_level,          // rts_n goes high at this RX FIFO level; 0: only when full
+    input   wire            de_en,              // drive de around the transmitted characters
+    input   wire [3:0]      de_lead,            // bit times from de rising to the start bit
+    input   wire [3:0]      de_lag,             // bit times from the last stop bit to de falling
+    input   wire            abr_en,             // measure the next sync character; the receiver is held meanwhile
+    input   wire [7:0]      coal_rx_count,      // characters received per coalesced event; 0: RX not coalesced
+    input   wire [7:0]      coal_tx_count,      // characters sent per coalesced event; 0: TX not coalesced
+    input   wire [23:0]     coal_time,          // clk cycles from the first counted character to the event; 0: no bound
+    input   wire            stats_snap_wr,      // STATS_SNAP write
+    input   wire [0:0]      stats_snap_wdata,   // 1: copy the statistics counters to the stats_* outputs and restart them
+    input   wire [31:0]     sync_pattern,       // sync word; the first character in bits 7:0
+    input   wire [31:0]     sync_mask,          // bits set are not compared with sync_pattern
+    input   wire [1:0]      sync_len,           // characters in the sync word minus 1
+    input   wire            sync_en,
+    input   wire            sync_hunt,          // drop the received characters until the sync word
+    input   wire [31:0]     crc_poly,           // CRC polynomial without the top bit, e.g. 32'h1021 for CRC-16/CCITT
+    input   wire [31:0]     crc_init,           // loaded by crc_rst_wr
+    input   wire [1:0]      crc_size,           // 00: 8, 01: 16, 1x: 32 bits
+    input   wire            crc_en,
+    input   wire            crc_refin,          // feed the characters LSB first
+    input   wire            crc_refout,         // reflect the crc_tx and crc_rx outputs
+    input   wire            crc_inv,            // complement the crc_tx and crc_rx outputs
+    input   wire            crc_rst_wr,         // CRC_RST write
+    input   wire [1:0]      crc_rst_wdata,      // bit 0 restarts the TX CRC, bit 1 the RX CRC from crc_init
+    input   wire [7:0]      frame_gap,          // idle time that ends a frame, in 1/16 character times; 0: off
+    input   wire            frame_rd,           // pop the frame descriptor
+    input   wire            usart_en,           // synchronous mode; one bit per sclk period
+    input   wire            sclk_ext,           // take sclk from sclk_in instead of driving it
             
     output  wire            tx_empty,
     output  wire            tx_full,
     output  wire [FAW-1:0]  tx_level,
     output  wire            tx_level_below,
-    output  wire [MDW-1:0]  rdata,
+    output  wire [12:0]     rdata,              // {match, break, parity error, frame error} in bits 12:9 over the character
+    output  wire [31:0]     rdata_packed,       // byte 0 in bits 7:0 was received first; 0 unless 4 are waiting
     output  wire            rx_empty,
     output  wire            rx_full,
     output  wire [FAW-1:0]  rx_level,
     output  wire            rx_level_above,
+    output  wire [7:0]      rx_fifo_count,      // RX FIFO entries; 2^FAW when full, saturating at 255
+    output  wire [7:0]      tx_fifo_count,      // TX FIFO entries; 2^FAW when full, saturating at 255
+    output  wire [14:0]     cap,                // {CRC, STATS, SC, MDW, FAW}, for the firmware to size its FIFO bursts
 
     output  wire            break_flag,
     output  wire            match_flag,
@@ -84,28 +155,68 @@ module EF_UART #(parameter  MDW = 9,        // Max data size/width
     output  wire            parity_error_flag,
     output  wire            overrun_flag,
     output  wire            timeout_flag,
+    output  wire            tx_complete_flag,   // the last stop bit has been sent and the TX FIFO is empty
+    output  wire            noise_flag,         // the samples of a bit of the received character disagreed
+    output  wire            sync_flag,          // the sync word has been received
+    output  wire            frame_flag,         // a frame descriptor has been pushed
+    output  wire [19:0]     frame_desc,         // {merged, overrun, parity error, frame error, length}; 0 when none
+    output  wire            abr_flag,           // abr_count holds a new measurement
+    output  reg  [23:0]     abr_count,          // clk cycles of 8 bits of the sync character; 0 when it did not fit
+    output  wire            coal_flag,          // coalesced RX/TX event
+    output  wire [31:0]     stats_tx,           // characters sent
+    output  wire [31:0]     stats_rx,           // characters received, including the ones lost to an overrun
+    output  wire [15:0]     stats_fe,           // framing errors
+    output  wire [15:0]     stats_pe,           // parity errors
+    output  wire [15:0]     stats_or,           // overruns
+    output  wire [15:0]     stats_brk,          // line breaks
+    output  wire [15:0]     stats_rto,          // receiver timeouts
+    output  wire [7:0]      stats_tx_max,       // highest TX FIFO level, counted like tx_fifo_count
+    output  wire [7:0]      stats_rx_max,       // highest RX FIFO level, counted like rx_fifo_count
+    output  wire [31:0]     crc_tx,             // CRC of the characters sent since the TX CRC restart
+    output  wire [31:0]     crc_rx,             // CRC of the characters received since the RX CRC restart
 
+    output  wire            tx_dma_req,         // TX FIFO level below the threshold; room for a burst
+    output  wire            tx_dma_single,      // TX FIFO not full; room for one entry
+    output  wire            rx_dma_req,         // RX FIFO level above the threshold; a burst is waiting
+    output  wire            rx_dma_single,      // RX FIFO not empty; one entry is waiting
+
+    output  reg             rts_n,
+    output  wire            de,                 // RS-485 driver enable, active high
+    input   wire            cts_n,
+    input   wire            sclk_in,            // bit clock of the other side, with sclk_ext
+    output  wire            sclk_out,           // bit clock driven in the synchronous mode without sclk_ext
+    output  wire            sclk_oe,            // sclk_out enable
     input   wire            rx,
     output  wire            tx
 );
 
     (* keep *) wire        tx_done;
+    wire                    tx_busy;
     (* keep *) wire        rx_done;
+    wire                    rx_accept;
+    wire                    rx_push;            // rx_accept unless the sync hunt drops the character
+    wire                    rx_idle;            // the receiver waits for a start bit
 
     wire        b_tick;
+    wire        tx_b_tick;          // b_tick, or the sclk edge that shifts the next bit out in the synchronous mode
+    wire        rx_b_tick;          // b_tick, or the sclk edge that samples the next bit in the synchronous mode
+    wire [4:0]  samples;
 
     wire [MDW-1:0]  tx_data;
     wire [MDW-1:0]  rx_data;
     
     parameter FIFO_DW = MDW;
+    // RX FIFO entries carry the error and match tags of their character
+    localparam RX_FIFO_DW = FIFO_DW + 4;
 
     wire        rx_synched;
     wire        rx_filtered;
     wire        rx_in;
 
+    // In the synchronous mode the loopback goes through the synchronizer as well, in step with sclk
     aucohl_sync rx_sync (
         .clk(clk),
-        .in(rx),
+        .in((usart_en & loopback_en) ? tx : rx),
         .out(rx_synched)
     );
 
@@ -117,71 +228,188 @@ module EF_UART #(parameter  MDW = 9,        // Max data size/width
         .out(rx_filtered)
     );
 
-    assign rx_in =  loopback_en         ? tx            : 
+    assign rx_in =  usart_en            ? rx_synched    :
+                    loopback_en         ? tx            : 
                     glitch_filter_en    ? rx_filtered   : 
                     rx_synched;
 
+    assign samples =    usart_en        ? 5'd1  :
+                        (osr == 2'b01)  ? 5'd16 :
+                        (osr == 2'b10)  ? 5'd8  :
+                        (osr == 2'b11)  ? 5'd4  :
+                        SC;
+
     BAUDGEN buad_gen (
         .clk(clk),
         .rst_n(rst_n),
         .prescale(prescaler),
+        .frac(prescaler_frac),
         .en(en),
         .baudtick(b_tick)
     );
+
+    // Synchronous mode. sclk toggles on every b_tick, so a bit takes 2*(PR+1+PRF/16) clk cycles. The transmitter
+    // shifts on the falling edge and the receiver samples on the rising edge, one sample per bit; the frame starts
+    // with the first low sample. sclk_out is registered once more to leave with tx. The receiver takes the edges of
+    // sclk after the same synchronizer as rx, from sclk_out or from sclk_in, so both arrive in step at any rate.
+    reg         sclk_reg;
+    reg         sclk_q;
+    reg         sclk_synched_d;
+    wire        sclk_synched;
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n) begin
+            sclk_reg <= 1'b1;
+            sclk_q <= 1'b1;
+        end else begin
+            if(~usart_en | sclk_ext)
+                sclk_reg <= 1'b1;
+            else if(b_tick)
+                sclk_reg <= ~sclk_reg;
+            sclk_q <= sclk_reg;
+        end
+
+    aucohl_sync sclk_sync (
+        .clk(clk),
+        .in(sclk_ext ? sclk_in : sclk_q),
+        .out(sclk_synched)
+    );
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n)
+            sclk_synched_d <= 1'b1;
+        else
+            sclk_synched_d <= sclk_synched;
+
+    assign sclk_out = sclk_q;
+    assign sclk_oe = usart_en & ~sclk_ext;
+    assign tx_b_tick =  ~usart_en   ? b_tick :
+                        sclk_ext    ? (~sclk_synched & sclk_synched_d) :
+                        (b_tick & sclk_reg);
+    assign rx_b_tick = usart_en ? (sclk_synched & ~sclk_synched_d) : b_tick;
   
-    aucohl_fifo #(.DW(FIFO_DW), .AW(FAW)) fifo_tx (
+    // Packed accesses move 4 characters of 8 bits; the ninth bit of MDW=9 is 0 on TX and dropped on RX
+    wire [2:0]          tx_push = wr_packed ? 3'd4 : {2'b0, wr};
+    reg  [4*FIFO_DW-1:0] tx_push_data;
+    wire [4*FIFO_DW-1:0] tx_head;
+    wire [4*RX_FIFO_DW-1:0] rx_pop_data;
+    wire                rx_has_4 = rx_full | (rx_level > 3);
+    wire [2:0]          rx_pop = rd_packed ? (rx_has_4 ? 3'd4 : 3'd0) : {2'b0, rd};
+
+    integer k;
+    always @* begin
+        tx_push_data = {(4*FIFO_DW){1'b0}};
+        if(wr_packed)
+            for(k = 0; k < 4; k = k + 1)
+                tx_push_data[k*FIFO_DW +: 8] = wdata_packed[k*8 +: 8];
+        else
+            tx_push_data[FIFO_DW-1:0] = wdata;
+    end
+
+    genvar b;
+    generate
+        for(b = 0; b < 4; b = b + 1) begin : packed_rdata
+            assign rdata_packed[b*8 +: 8] = rx_has_4 ? rx_pop_data[b*RX_FIFO_DW +: 8] : 8'h00;
+        end
+    endgenerate
+
+    UART_FIFO #(.DW(FIFO_DW), .AW(FAW)) fifo_tx (
         .clk(clk),
         .rst_n(rst_n),
-        .rd(tx_done),
-        .wr(wr),
-        .wdata(wdata),
+        .rd_n({2'b0, tx_done}),
+        .wr_n(tx_push),
+        .wdata(tx_push_data),
         .empty(tx_empty),
         .full(tx_full),
-        .rdata(tx_data),
+        .rdata(tx_head),
         .level(tx_level),
         .flush(tx_fifo_flush)
     );
+    assign tx_data = tx_head[FIFO_DW-1:0];
+
+    // CTS is looked at by the idle transmitter only, so a character in flight is always completed
+    wire        cts_n_synched;
+    wire        tx_stop = cts_en & cts_n_synched;
+    wire        tx_pending = ~tx_empty & ~tx_stop;
+    wire        de_ready;
+    // another character waits behind the one being sent; the synchronous transmitter sends it without an idle bit
+    wire        tx_more = (tx_full | (tx_level > 1)) & ~tx_stop & (~de_en | de_ready);
 
-    UART_TX #(.MDW(MDW), .NUM_SAMPLES(SC)) uart_tx (
+    aucohl_sync cts_sync (
+        .clk(clk),
+        .in(cts_n),
+        .out(cts_n_synched)
+    );
+
+    UART_TX #(.MDW(MDW)) uart_tx (
         .clk(clk),
         .resetn(rst_n),
-        .tx_start(~tx_empty),
-        .b_tick(b_tick & tx_en),
+        .num_samples(samples),
+        .tx_start(tx_pending & (~de_en | de_ready)),
+        .tx_more(tx_more),
+        .clocked(usart_en),
+        .b_tick(tx_b_tick & tx_en),
         .data_size(data_size),
         .parity_type(parity_type),
         .stop_bits_count(stop_bits_count),
         .d_in(tx_data),
         .tx_done(tx_done),
+        .tx_busy(tx_busy),
         .tx(tx)
     );
 
-    aucohl_fifo #(.DW(FIFO_DW), .AW(FAW)) fifo_rx (
+    // A break is reported by the receiver as a character of zeros with a framing error
+    wire [3:0] rx_tags = {match_flag, frame_error_flag & (rx_data == 0), parity_error_flag, frame_error_flag};
+
+    UART_FIFO #(.DW(RX_FIFO_DW), .AW(FAW)) fifo_rx (
         .clk(clk),
         .rst_n(rst_n),
-        .rd(rd),
-        .wr(rx_done),
-        .wdata(rx_data),
+        .rd_n(rx_pop),
+        .wr_n({2'b0, rx_push}),
+        .wdata({{(3*RX_FIFO_DW){1'b0}}, rx_tags, rx_data}),
         .empty(rx_empty),
         .full(rx_full),
-        .rdata(rdata),
+        .rdata(rx_pop_data),
         .level(rx_level),
         .flush(rx_fifo_flush)
     );
+    // the tags sit above the widest character, at the same bits for every MDW
+    assign rdata = {rx_pop_data[RX_FIFO_DW-1:FIFO_DW], 9'd0} | rx_pop_data[FIFO_DW-1:0];
+
+    // FIFO levels of the STATUS and STATS_MAX registers; 8 bits, so a full 256 entry FIFO reads as 255
+    localparam [7:0] FIFO_FULL_COUNT = (FAW > 7) ? 8'hFF : (8'd1 << FAW);
+
+    assign rx_fifo_count = rx_full ? FIFO_FULL_COUNT : rx_level;
+    assign tx_fifo_count = tx_full ? FIFO_FULL_COUNT : tx_level;
 
-    UART_RX #(.MDW(MDW), .NUM_SAMPLES(SC)) uart_rx (
+    assign cap[3:0] = FAW;
+    assign cap[7:4] = MDW;
+    assign cap[12:8] = SC;
+    assign cap[13] = (STATS != 0);
+    assign cap[14] = (CRC != 0);
+
+    UART_RX #(.MDW(MDW)) uart_rx (
         .clk(clk),
         .resetn(rst_n),
-        .b_tick(b_tick & rx_en),
+        .num_samples(samples),
+        .b_tick(rx_b_tick & rx_en & ~abr_en),
+        .clocked(usart_en),
         .data_size(data_size),
         .parity_type(parity_type),
         .stop_bits_count(stop_bits_count),
         .match_data(match_data),
+        .match_mask(match_mask),
+        .addr_en(addr_en),
+        .majority_en(majority_en & ~usart_en),
         .rx(rx_in),
         .break_flag(break_flag),
         .match_flag(match_flag),
         .parity_error(parity_error_flag),
         .frame_error(frame_error_flag),
+        .noise(noise_flag),
         .rx_done(rx_done),
+        .rx_accept(rx_accept),
+        .idle(rx_idle),
         .dout(rx_data)
     );
 
@@ -192,9 +420,9 @@ module EF_UART #(parameter  MDW = 9,        // Max data size/width
             bits_count <= 0;
             samples_count <= 0;
         end
-        else if(b_tick)
+        else if(rx_b_tick)
             if(rx_done) bits_count <= 0;
-            else if(samples_count == (SC - 1)) begin
+            else if(samples_count == (samples - 1'b1)) begin
                 samples_count <= 0;
                 if(timeout_flag)
                     bits_count <= 0;
@@ -206,9 +434,506 @@ module EF_UART #(parameter  MDW = 9,        // Max data size/width
 
     assign tx_level_below = (tx_level < txfifotr) & ~tx_full;
     assign rx_level_above = (rx_level > rxfifotr) | rx_full;
-    assign overrun_flag = rx_full & rx_done;
+    assign overrun_flag = rx_full & rx_push;
     assign timeout_flag = (bits_count == timeout_bits);
 
+    // The character that ends with tx_done is popped at the same time, so level 1 means it was the last one,
+    // unless a write pushes the next one in the same cycle
+    wire        tx_last_done = tx_done & (tx_level == 1) & ~tx_full & ~|tx_push;
+    assign tx_complete_flag = tx_last_done;
+
+    // RS-485 driver enable. de rises de_lead bit times before the first start bit and falls de_lag bit
+    // times after the last stop bit; characters written in the meantime go out without a new lead time.
+    // The encoding only changes one bit between states that both drive de, so de does not glitch.
+    localparam [1:0] de_idle_st = 2'b00;
+    localparam [1:0] de_lead_st = 2'b01;
+    localparam [1:0] de_tx_st   = 2'b11;
+    localparam [1:0] de_lag_st  = 2'b10;
+
+    reg [1:0]   de_state;
+    reg [3:0]   de_bits;
+    reg [4:0]   de_samples;
+    wire        de_counting = (de_state == de_lead_st) | (de_state == de_lag_st);
+    wire        de_bit_tick = tx_b_tick & tx_en & (de_samples == (samples - 1'b1));
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n)
+            de_samples <= 0;
+        else if(~de_counting)
+            de_samples <= 0;
+        else if(tx_b_tick & tx_en)
+            de_samples <= de_bit_tick ? 5'd0 : de_samples + 1'b1;
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n) begin
+            de_state <= de_idle_st;
+            de_bits <= 0;
+        end else if(~de_en)
+            de_state <= de_idle_st;
+        else
+            case(de_state)
+                de_idle_st:
+                    if(tx_pending) begin
+                        de_state <= (de_lead == 0) ? de_tx_st : de_lead_st;
+                        de_bits <= 0;
+                    end
+                de_lead_st:
+                    if(de_bit_tick) begin
+                        if(de_bits == (de_lead - 1'b1))
+                            de_state <= de_tx_st;
+                        de_bits <= de_bits + 1'b1;
+                    end
+                de_tx_st:
+                    // a flushed FIFO ends the transmission without tx_done
+                    if(tx_last_done | (tx_empty & ~tx_busy)) begin
+                        de_state <= (de_lag == 0) ? de_idle_st : de_lag_st;
+                        de_bits <= 0;
+                    end
+                de_lag_st:
+                    if(tx_pending)
+                        de_state <= de_tx_st;
+                    else if(de_bit_tick) begin
+                        if(de_bits == (de_lag - 1'b1))
+                            de_state <= de_idle_st;
+                        de_bits <= de_bits + 1'b1;
+                    end
+            endcase
+
+    assign de = de_state[0] | de_state[1];
+    assign de_ready = (de_state == de_tx_st);
+
+    // Automatic baud rate detection. From the falling edge of the start bit, the last falling edge
+    // within 9.5 start bit times is the start of data bit 7 for a sync character with bit 0 and 6 set
+    // and bit 7 clear (0x55, 0x7F), so abr_count is 8 bit times. The firmware derives PR and PRF from it.
+    localparam [1:0] abr_arm_st     = 2'b00;
+    localparam [1:0] abr_wait_st    = 2'b01;
+    localparam [1:0] abr_measure_st = 2'b11;
+    localparam [1:0] abr_done_st    = 2'b10;
+
+    reg [1:0]   abr_state;
+    reg [23:0]  abr_cycles;
+    reg [23:0]  abr_start_bit;
+    reg         abr_rx_d;
+    wire        abr_fall = abr_rx_d & ~rx_in;
+    wire        abr_rise = ~abr_rx_d & rx_in;
+    wire [27:0] abr_window = {abr_start_bit, 3'b0} + abr_start_bit + abr_start_bit[23:1];
+    wire        abr_end = ((abr_start_bit != 0) & ({4'b0, abr_cycles} > abr_window)) | (&abr_cycles);
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n)
+            abr_rx_d <= 1'b1;
+        else
+            abr_rx_d <= rx_in;
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n) begin
+            abr_state <= abr_arm_st;
+            abr_cycles <= 0;
+            abr_start_bit <= 0;
+            abr_count <= 0;
+        end else if(~abr_en)
+            abr_state <= abr_arm_st;
+        else
+            case(abr_state)
+                abr_arm_st:
+                    // do not start in the middle of a character
+                    if(rx_in)
+                        abr_state <= abr_wait_st;
+                abr_wait_st:
+                    if(abr_fall) begin
+                        abr_state <= abr_measure_st;
+                        abr_cycles <= 1;
+                        abr_start_bit <= 0;
+                        abr_count <= 0;
+                    end
+                abr_measure_st:
+                    if(abr_end)
+                        abr_state <= abr_done_st;
+                    else begin
+                        abr_cycles <= abr_cycles + 1'b1;
+                        if(abr_rise & (abr_start_bit == 0))
+                            abr_start_bit <= abr_cycles;
+                        if(abr_fall)
+                            abr_count <= abr_cycles;
+                    end
+                abr_done_st: ;
+            endcase
+
+    assign abr_flag = (abr_state == abr_measure_st) & abr_end;
+
+    // Sync word detector. The last sync_len+1 characters, the oldest in bits 7:0, are compared with sync_pattern
+    // except for the bits set in sync_mask; 9-bit characters are compared by their low 8 bits. A character with a
+    // framing or parity error restarts the search, and so does a receiver timeout. With sync_hunt the characters
+    // are dropped, the sync word included, until the sync word has been seen; a receiver timeout ends the message
+    // and the hunt starts again.
+    reg  [23:0] sync_hist;          // the 3 characters before the current one, the last one in bits 7:0
+    reg  [1:0]  sync_n;             // characters in sync_hist since the search started
+    reg         sync_locked;
+    reg  [31:0] sync_window;
+    wire [31:0] sync_used = ~(32'hFFFFFF00 << {sync_len, 3'b0});
+    wire        sync_char = rx_accept & ~frame_error_flag & ~parity_error_flag;
+    wire        sync_match = sync_en & sync_char & (sync_n >= sync_len) &
+                             (((sync_window ^ sync_pattern) & ~sync_mask & sync_used) == 0);
+    wire        sync_hunting = sync_en & sync_hunt & ~sync_locked;
+
+    always @*
+        case(sync_len)
+            2'd0:       sync_window = {24'b0, rx_data[7:0]};
+            2'd1:       sync_window = {16'b0, rx_data[7:0], sync_hist[7:0]};
+            2'd2:       sync_window = {8'b0, rx_data[7:0], sync_hist[7:0], sync_hist[15:8]};
+            default:    sync_window = {rx_data[7:0], sync_hist[7:0], sync_hist[15:8], sync_hist[23:16]};
+        endcase
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n) begin
+            sync_hist <= 0;
+            sync_n <= 0;
+            sync_locked <= 1'b0;
+        end else if(~sync_en | timeout_flag) begin
+            sync_n <= 0;
+            sync_locked <= 1'b0;
+        end else begin
+            if(~sync_hunt)
+                sync_locked <= 1'b0;
+            else if(sync_match)
+                sync_locked <= 1'b1;
+            if(rx_accept) begin
+                sync_hist <= {sync_hist[15:0], rx_data[7:0]};
+                sync_n <= ~sync_char ? 2'd0 : (&sync_n) ? sync_n : sync_n + 1'b1;
+            end
+        end
+
+    assign sync_flag = sync_match & ~(sync_hunt & sync_locked);
+    assign rx_push = rx_accept & ~sync_hunting;
+
+    // Interrupt coalescing. One event for coal_rx_count characters received or coal_tx_count characters sent,
+    // whichever comes first; with TX coalescing also when the TX FIFO runs empty, and in any case coal_time clk
+    // cycles after the first character counted, so a short message does not wait for the count.
+    reg  [7:0]  coal_rx_n;
+    reg  [7:0]  coal_tx_n;
+    reg  [23:0] coal_timer;
+    wire        coal_rx_on = (coal_rx_count != 0);
+    wire        coal_tx_on = (coal_tx_count != 0);
+    wire        coal_rx_inc = coal_rx_on & rx_push;
+    wire        coal_tx_inc = coal_tx_on & tx_done;
+    wire        coal_pending = (coal_rx_n != 0) | (coal_tx_n != 0);
+
+    assign coal_flag =  (coal_rx_inc & (({1'b0, coal_rx_n} + 9'd1) >= {1'b0, coal_rx_count})) |
+                        (coal_tx_inc & ((({1'b0, coal_tx_n} + 9'd1) >= {1'b0, coal_tx_count}) | tx_last_done)) |
+                        (coal_pending & (coal_time != 0) & (coal_timer >= coal_time));
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n) begin
+            coal_rx_n <= 0;
+            coal_tx_n <= 0;
+            coal_timer <= 0;
+        end else if(coal_flag) begin
+            coal_rx_n <= 0;
+            coal_tx_n <= 0;
+            coal_timer <= 0;
+        end else begin
+            coal_rx_n <= coal_rx_on ? coal_rx_n + coal_rx_inc : 8'd0;
+            coal_tx_n <= coal_tx_on ? coal_tx_n + coal_tx_inc : 8'd0;
+            coal_timer <= coal_pending ? coal_timer + 1'b1 : 24'd0;
+        end
+
+    // a STATS_SNAP write with bit 0 set takes a snapshot of the statistics and restarts the counters
+    wire        stats_snap = stats_snap_wr & stats_snap_wdata[0];
+
+    // Statistics since the last stats_snap. The counters are copied to the stats_* outputs and restart in the same
+    // cycle, so the outputs always describe one whole interval and no event falls between two of them. The error
+    // counters saturate; breaks and timeouts are counted once per occurrence, not per cycle that they last.
+    generate
+        if(STATS) begin : stats
+            reg  [31:0]     tx_n, rx_n, tx_s, rx_s;
+            reg  [15:0]     fe_n, pe_n, or_n, brk_n, rto_n;
+            reg  [15:0]     fe_s, pe_s, or_s, brk_s, rto_s;
+            reg  [FAW:0]    tx_max_n, rx_max_n, tx_max_s, rx_max_s;
+            reg             brk_d, rto_d;
+            wire [FAW:0]    tx_fill = tx_full ? (1'b1 << FAW) : {1'b0, tx_level};
+            wire [FAW:0]    rx_fill = rx_full ? (1'b1 << FAW) : {1'b0, rx_level};
+            wire [15:0]     fe_next = fe_n + (frame_error_flag & ~&fe_n);
+            wire [15:0]     pe_next = pe_n + (parity_error_flag & ~&pe_n);
+            wire [15:0]     or_next = or_n + (overrun_flag & ~&or_n);
+            wire [15:0]     brk_next = brk_n + (break_flag & ~brk_d & ~&brk_n);
+            wire [15:0]     rto_next = rto_n + (timeout_flag & ~rto_d & ~&rto_n);
+            wire [FAW:0]    tx_max_next = (tx_fill > tx_max_n) ? tx_fill : tx_max_n;
+            wire [FAW:0]    rx_max_next = (rx_fill > rx_max_n) ? rx_fill : rx_max_n;
+
+            always @ (posedge clk, negedge rst_n)
+                if(!rst_n) begin
+                    {tx_n, rx_n, tx_s, rx_s} <= 0;
+                    {fe_n, pe_n, or_n, brk_n, rto_n} <= 0;
+                    {fe_s, pe_s, or_s, brk_s, rto_s} <= 0;
+                    {tx_max_n, rx_max_n, tx_max_s, rx_max_s} <= 0;
+                    brk_d <= 1'b0;
+                    rto_d <= 1'b0;
+                end else begin
+                    brk_d <= break_flag;
+                    rto_d <= timeout_flag;
+                    if(stats_snap) begin
+                        tx_s <= tx_n + tx_done;
+                        rx_s <= rx_n + rx_push;
+                        fe_s <= fe_next;
+                        pe_s <= pe_next;
+                        or_s <= or_next;
+                        brk_s <= brk_next;
+                        rto_s <= rto_next;
+                        tx_max_s <= tx_max_next;
+                        rx_max_s <= rx_max_next;
+                        {tx_n, rx_n} <= 0;
+                        {fe_n, pe_n, or_n, brk_n, rto_n} <= 0;
+                        tx_max_n <= tx_fill;
+                        rx_max_n <= rx_fill;
+                    end else begin
+                        tx_n <= tx_n + tx_done;
+                        rx_n <= rx_n + rx_push;
+                        fe_n <= fe_next;
+                        pe_n <= pe_next;
+                        or_n <= or_next;
+                        brk_n <= brk_next;
+                        rto_n <= rto_next;
+                        tx_max_n <= tx_max_next;
+                        rx_max_n <= rx_max_next;
+                    end
+                end
+
+            assign stats_tx = tx_s;
+            assign stats_rx = rx_s;
+            assign stats_fe = fe_s;
+            assign stats_pe = pe_s;
+            assign stats_or = or_s;
+            assign stats_brk = brk_s;
+            assign stats_rto = rto_s;
+            assign stats_tx_max = tx_max_s[FAW] ? FIFO_FULL_COUNT : tx_max_s[FAW-1:0];
+            assign stats_rx_max = rx_max_s[FAW] ? FIFO_FULL_COUNT : rx_max_s[FAW-1:0];
+        end else begin : no_stats
+            assign {stats_tx, stats_rx} = 0;
+            assign {stats_fe, stats_pe, stats_or, stats_brk, stats_rto} = 0;
+            assign {stats_tx_max, stats_rx_max} = 0;
+        end
+    endgenerate
+
+    // Idle gap frame delimiting. The receiver is idle from the middle of the last stop bit, so the gap is counted
+    // in samples from there, against frame_gap/16 character times of the current frame format plus half a bit. A gap
+    // after characters pushes the descriptor of the frame: the characters it put into the RX FIFO and whether any of
+    // them had a framing or parity error or was lost to an overrun. While the descriptor FIFO is full the frame stays
+    // open; if it goes on, it is merged with the next frame and the descriptor says so.
+    wire        rx_tick = rx_b_tick & rx_en & ~abr_en;
+    wire [8:0]  char_samples = (4'd2 + data_size + (parity_type != 3'b000) + stop_bits_count) * samples;
+    wire [16:0] gap_product = frame_gap * char_samples;
+    wire [12:0] gap_limit = gap_product[16:4] + (samples >> 1);
+    reg  [12:0] gap_n;
+    reg  [15:0] frame_n;
+    reg  [3:0]  frame_err;          // {merged, overrun, parity error, frame error}
+    reg         frame_late;         // the gap has been reached while the descriptor FIFO was full
+    wire        frame_full;
+    wire        frame_empty;
+    wire [79:0] frame_head;
+    wire        gap_reached = (frame_gap != 0) & rx_idle & (gap_n >= gap_limit);
+    wire        frame_open = (frame_n != 0) | frame_err[2];
+    wire        frame_push = gap_reached & frame_open & ~frame_full;
+    wire        frame_char = rx_push & ~rx_full;
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n) begin
+            gap_n <= 0;
+            frame_n <= 0;
+            frame_err <= 0;
+            frame_late <= 1'b0;
+        end else begin
+            if(~rx_idle)
+                gap_n <= 0;
+            else if(rx_tick & ~&gap_n)
+                gap_n <= gap_n + 1'b1;
+            if(frame_push | rx_fifo_flush) begin
+                frame_n <= 0;
+                frame_err <= 0;
+                frame_late <= 1'b0;
+            end else begin
+                frame_n <= frame_n + (frame_char & ~&frame_n);
+                frame_err <= frame_err | {frame_late & frame_char, overrun_flag,
+                                          rx_push & parity_error_flag, rx_push & frame_error_flag};
+                frame_late <= frame_late | (gap_reached & frame_open);
+            end
+        end
+
+    UART_FIFO #(.DW(20), .AW(2)) fifo_frame (
+        .clk(clk),
+        .rst_n(rst_n),
+        .rd_n({2'b0, frame_rd}),
+        .wr_n({2'b0, frame_push}),
+        .wdata({60'b0, frame_err, frame_n}),
+        .empty(frame_empty),
+        .full(frame_full),
+        .rdata(frame_head),
+        .level(),
+        .flush(rx_fifo_flush)
+    );
+    assign frame_desc = frame_empty ? 20'd0 : frame_head[19:0];
+    assign frame_flag = frame_push;
+
+    // CRC of the characters sent, as each one is done and popped from the TX FIFO, and of the characters that go
+    // into the RX FIFO, the low 8 bits of each. It follows the model of the CRC catalogues: the register is shifted
+    // MSB first, crc_refin feeds each character LSB first, crc_refout and crc_inv reflect and complement the result.
+    // The register is kept left aligned in 32 bits, so the same update serves the 8, 16 and 32-bit CRCs.
+    function [31:0] crc_update;
+        input [31:0]    value;
+        input [7:0]     data;
+        input [31:0]    poly;
+        input           refin;
+        integer         i;
+        begin
+            crc_update = value;
+            for(i = 7; i >= 0; i = i - 1)
+                crc_update = {crc_update[30:0], 1'b0} ^
+                             ((crc_update[31] ^ (refin ? data[7-i] : data[i])) ? poly : 32'b0);
+        end
+    endfunction
+
+    // a CRC_RST write restarts the CRC of each direction whose bit is set from crc_init
+    wire        crc_tx_rst = crc_rst_wr & crc_rst_wdata[0];
+    wire        crc_rx_rst = crc_rst_wr & crc_rst_wdata[1];
+
+    generate
+        if(CRC) begin : crc
+            reg  [31:0]     tx_r, rx_r;
+            reg  [31:0]     tx_rev, rx_rev;
+            wire [4:0]      shift = crc_size[1] ? 5'd0 : crc_size[0] ? 5'd16 : 5'd24;
+            wire [31:0]     poly = crc_poly << shift;
+            wire [31:0]     init = crc_init << shift;
+            wire [31:0]     inv = crc_inv ? (32'hFFFFFFFF >> shift) : 32'b0;
+
+            always @ (posedge clk, negedge rst_n)
+                if(!rst_n) begin
+                    tx_r <= 0;
+                    rx_r <= 0;
+                end else begin
+                    if(crc_tx_rst)
+                        tx_r <= init;
+                    else if(crc_en & tx_done)
+                        tx_r <= crc_update(tx_r, tx_data[7:0], poly, crc_refin);
+                    if(crc_rx_rst)
+                        rx_r <= init;
+                    else if(crc_en & rx_push)
+                        rx_r <= crc_update(rx_r, rx_data[7:0], poly, crc_refin);
+                end
+
+            // reflecting all 32 bits moves a left aligned value to the low bits
+            integer j;
+            always @*
+                for(j = 0; j < 32; j = j + 1) begin
+                    tx_rev[j] = tx_r[31-j];
+                    rx_rev[j] = rx_r[31-j];
+                end
+
+            assign crc_tx = (crc_refout ? tx_rev : (tx_r >> shift)) ^ inv;
+            assign crc_rx = (crc_refout ? rx_rev : (rx_r >> shift)) ^ inv;
+        end else begin : no_crc
+            assign {crc_tx, crc_rx} = 0;
+        end
+    endgenerate
+
+    // RTS asks the other side to stop once the RX FIFO reaches the watermark. Leave room below the
+    // full level for the characters that the other side sends before it sees rts_n go high.
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n)
+            rts_n <= 1'b0;
+        else
+            rts_n <= rts_en & (rx_full | ((rts_level != 0) & (rx_level >= rts_level)));
+
+    // DMA handshake. The requests are the threshold (burst) and not full/not empty (single) conditions.
+    // They are withdrawn while ack is high and for the cycle after, so the controller always decides on
+    // the next request with the FIFO level that includes its own transfer.
+    reg tx_dma_ack_d;
+    reg rx_dma_ack_d;
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n) begin
+            tx_dma_ack_d <= 1'b0;
+            rx_dma_ack_d <= 1'b0;
+        end else begin
+            tx_dma_ack_d <= tx_dma_ack;
+            rx_dma_ack_d <= rx_dma_ack;
+        end
+
+    wire tx_dma_hold = ~tx_dma_en | tx_dma_ack | tx_dma_ack_d;
+    wire rx_dma_hold = ~rx_dma_en | rx_dma_ack | rx_dma_ack_d;
+
+    assign tx_dma_req = tx_level_below & ~tx_dma_hold;
+    assign tx_dma_single = ~tx_full & ~tx_dma_hold;
+    assign rx_dma_req = rx_level_above & ~rx_dma_hold;
+    assign rx_dma_single = ~rx_empty & ~rx_dma_hold;
+
+endmodule
+
+
+/*
+    FIFO with up to 4 pushes and 4 pops per cycle; aucohl_fifo with entry counts
+    instead of the rd and wr strobes. Entry i from the head/tail is in bits
+    i*DW +: DW of rdata/wdata. Pushes beyond the free entries and pops beyond
+    the level are ignored. level wraps to 0 when the FIFO is full.
+*/
+module UART_FIFO #(parameter DW = 8, AW = 4) (
+    input   wire            clk,
+    input   wire            rst_n,
+    input   wire [2:0]      rd_n,               // entries to pop, 0 - 4
+    input   wire [2:0]      wr_n,               // entries to push, 0 - 4
+    input   wire [4*DW-1:0] wdata,
+    input   wire            flush,
+    output  wire            empty,
+    output  wire            full,
+    output  wire [4*DW-1:0] rdata,              // the 4 entries at the head
+    output  wire [AW-1:0]   level
+);
+
+    localparam DEPTH = 1 << AW;
+
+    reg [DW-1:0]    mem [0:DEPTH-1];
+    reg [AW-1:0]    wp;
+    reg [AW-1:0]    rp;
+    reg [AW:0]      count;
+
+    wire [AW:0]     space = DEPTH - count;
+    wire [AW:0]     pushes = (wr_n > space) ? space : wr_n;
+    wire [AW:0]     pops = (rd_n > count) ? count : rd_n;
+
+    always @ (posedge clk, negedge rst_n)
+        if(!rst_n) begin
+            wp <= 0;
+            rp <= 0;
+            count <= 0;
+        end else if(flush) begin
+            wp <= 0;
+            rp <= 0;
+            count <= 0;
+        end else begin
+            wp <= wp + pushes[AW-1:0];
+            rp <= rp + pops[AW-1:0];
+            count <= count + pushes - pops;
+        end
+
+    integer i;
+    reg [AW-1:0] waddr;
+    always @ (posedge clk)
+        if(!flush)
+            for(i = 0; i < 4; i = i + 1) begin
+                waddr = wp + i;
+                if(i < pushes)
+                    mem[waddr] <= wdata[i*DW +: DW];
+            end
+
+    genvar g;
+    generate
+        for(g = 0; g < 4; g = g + 1) begin : head
+            wire [AW-1:0] raddr = rp + g;
+            assign rdata[g*DW +: DW] = mem[raddr];
+        end
+    endgenerate
+
+    assign empty = (count == 0);
+    assign full = count[AW];
+    assign level = count[AW-1:0];
+
 endmodule
 
 
@@ -217,12 +942,21 @@ module BAUDGEN
     input   wire        clk,
     input   wire        rst_n,
     input   wire [15:0] prescale, 
+    input   wire [3:0]  frac,
     input   wire        en,
     output  wire        baudtick
 );
 
-    reg [15:0]  count_reg;
-    wire [15:0] count_next;
+    reg [16:0]  count_reg;
+    wire [16:0] count_next;
+    reg [3:0]   frac_acc;
+    wire [4:0]  frac_sum;
+    wire [16:0] count_last;
+
+    // Fractional accumulator: every time it overflows the period is one clock longer,
+    // so the average period is prescale+1+frac/16 clocks
+    assign frac_sum = frac_acc + frac;
+    assign count_last = prescale + frac_sum[4];
 
     //Counter
     always @ (posedge clk, negedge rst_n) begin
@@ -232,27 +966,42 @@ module BAUDGEN
             count_reg <= count_next;
     end
 
-    assign count_next = ((count_reg == prescale) ? 0 : count_reg + 1'b1);
-    assign baudtick = ((count_reg == prescale) ? 1'b1 : 1'b0);
+    always @ (posedge clk, negedge rst_n) begin
+        if(!rst_n)
+            frac_acc <= 0;
+        else if(en & baudtick)
+            frac_acc <= frac_sum[3:0];
+    end
+
+    assign count_next = ((count_reg == count_last) ? 0 : count_reg + 1'b1);
+    assign baudtick = ((count_reg == count_last) ? 1'b1 : 1'b0);
 
 endmodule
 
 /*
     UART Receiver
 */
-module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
+module UART_RX #(parameter MDW = 8)(
     input   wire            clk,
     input   wire            resetn,
+    input   wire [4:0]      num_samples,        // 4, 8 or 16
     input   wire            b_tick,             // Baud generator tick
+    input   wire            clocked,            // one b_tick per bit; the start bit is the first low sample
     input   wire [3:0]      data_size,          // 5 - 9
     input   wire            stop_bits_count,    // 0: 1, 1: 2
     input   wire [2:0]      parity_type,        // 000: None, 001: odd, 010: even, 
                                                 // 100: Sticky 0, 101: Sticky 1
     input   wire            rx,                 // RS-232 data port
     input   wire [MDW-1:0]  match_data,
+    input   wire [MDW-1:0]  match_mask,         // bits set are not compared with match_data
+    input   wire            addr_en,            // 9-bit multidrop address filtering
+    input   wire            majority_en,        // 2 of the 3 samples around the bit centre decide the bit
     output  reg             rx_done,            // Transfer completed
+    output  wire            rx_accept,          // Transfer completed and the frame is for this receiver
+    output  wire            idle,               // Waiting for a start bit
     output  wire            parity_error,       // Parity Error
     output  wire            frame_error,        // Framing Error
+    output  wire            noise,              // Samples of a bit disagreed (majority_en only)
     output  wire            break_flag,         // Break flag
     output  wire            match_flag,
     output  wire [MDW-1:0]  dout                // Received data
@@ -268,8 +1017,8 @@ module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
     //Internal Signals  
     reg [2:0]   current_state;
     reg [2:0]   next_state;
-    reg [3:0]   b_reg;            //baud-rate/over sampling counter
-    reg [3:0]   b_next;
+    reg [4:0]   b_reg;            //baud-rate/over sampling counter
+    reg [4:0]   b_next;
     reg [3:0]   count_reg;        //data-bit counter
     reg [3:0]   count_next;
     reg [8:0]   data_reg;         //data register
@@ -278,6 +1027,21 @@ module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
     reg         p_error_next;
     reg         f_error_reg;
     reg         f_error_next;
+    reg         n_error_reg;
+    reg         n_error_next;
+
+    // Majority vote: the start bit ends one tick later, so that every bit is decided one tick past its centre,
+    // from that sample and the samples of the two ticks before it
+    reg [1:0]   samples_reg;
+    always @ (posedge clk, negedge resetn)
+        if(!resetn)
+            samples_reg <= 2'b11;
+        else if(b_tick)
+            samples_reg <= {samples_reg[0], rx};
+
+    wire [2:0]  votes   = {samples_reg, rx};
+    wire        rx_bit  = majority_en ? ((votes[0] & votes[1]) | (votes[0] & votes[2]) | (votes[1] & votes[2])) : rx;
+    wire        rx_noisy = majority_en & (|votes) & ~(&votes);
 
     //State Machine  
     always @ (posedge clk, negedge resetn) begin
@@ -287,6 +1051,7 @@ module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
             count_reg <= 0;
             data_reg <= 0;
             p_error_reg <= 0;
+            n_error_reg <= 0;
         end else begin
             current_state <= next_state;
             b_reg <= b_next;
@@ -302,6 +1067,10 @@ module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
                 else 
                     if(f_error_next) 
                         f_error_reg <= f_error_next;
+            if(current_state == idle_st)
+                n_error_reg <= 0;
+            else if(n_error_next)
+                n_error_reg <= 1'b1;
         end
     end
 
@@ -314,18 +1083,20 @@ module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
         rx_done = 1'b0;
         p_error_next = 1'b0;
         f_error_next = 1'b0;
+        n_error_next = 1'b0;
             
         case(current_state)
             idle_st:
                 if(~rx & b_tick)
                 begin
-                    next_state = start_st;
+                    next_state = clocked ? data_st : start_st;
                     b_next = 0;
+                    count_next = 0;
                 end
                 
             start_st:
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES/2 - 1)) begin
+                    if(b_reg == ((num_samples >> 1) - !majority_en)) begin
                         next_state = data_st;
                         b_next = 0;
                         count_next = 0;
@@ -334,9 +1105,10 @@ module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
                     
             data_st:
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES - 1)) begin
+                    if(b_reg == (num_samples - 1'b1)) begin
                         b_next = 0;
-                        data_next = {rx, data_reg [(MDW-1):1]};
+                        data_next = {rx_bit, data_reg [(MDW-1):1]};
+                        n_error_next = rx_noisy;
                         if(count_next == (data_size - 1)) 
                             if(parity_type == 3'b000)         
                                 next_state = stop0_st;
@@ -349,26 +1121,28 @@ module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
             
             parity_st:
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES - 1)) begin
+                    if(b_reg == (num_samples - 1'b1)) begin
                         b_next = 0;
                         next_state = stop0_st;
+                        n_error_next = rx_noisy;
                         case (parity_type)
                             3'b001 : //Odd parity
-                                if(~^dout != rx) p_error_next = 1;
+                                if(~^dout != rx_bit) p_error_next = 1;
                             3'b010 : //Even parity
-                                if(^dout != rx) p_error_next = 1;
+                                if(^dout != rx_bit) p_error_next = 1;
                             3'b100 : //Sticky 0 parity
-                                if(1'b0 != rx) p_error_next = 1;
+                                if(1'b0 != rx_bit) p_error_next = 1;
                             3'b101 : //Sticky 1 parity
-                                if(1'b1 != rx) p_error_next = 1;
+                                if(1'b1 != rx_bit) p_error_next = 1;
                         endcase
                     end else
                         b_next = b_reg + 1;  
             stop0_st:
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES - 1)) begin 
+                    if(b_reg == (num_samples - 1'b1)) begin 
                         b_next = 0;
-                        if(!rx) f_error_next = 1;
+                        if(!rx_bit) f_error_next = 1;
+                        n_error_next = rx_noisy;
                         if(stop_bits_count)         //Two stop bits
                             next_state = stop1_st;
                         else begin                  //One stop bit 
@@ -379,11 +1153,12 @@ module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
                         b_next = b_reg + 1;
             stop1_st:
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES - 1)) begin //Two stop bits
+                    if(b_reg == (num_samples - 1'b1)) begin //Two stop bits
                         b_next = 0;
                         next_state = idle_st;
                         rx_done = 1'b1;
-                        if(!rx) f_error_next = 1;
+                        if(!rx_bit) f_error_next = 1;
+                        n_error_next = rx_noisy;
                     end else
                         b_next = b_reg + 1;
         endcase
@@ -395,29 +1170,49 @@ module UART_RX #(parameter NUM_SAMPLES = 16, MDW = 8)(
         if(!resetn) 
             brk <= 12'hFFF;
         else if(b_tick)
-            if(b_reg == (NUM_SAMPLES - 1)) begin
+            if(b_reg == (num_samples - 1'b1)) begin
                 if(current_state == idle_st)
                     brk <= 12'hFFF;
                 else
-                    brk <= {brk[10:0], rx};
+                    brk <= {brk[10:0], rx_bit};
             end
     end
 
     assign      dout            =   data_reg >> (9-data_size);
-    assign      parity_error    =   p_error_reg & rx_done;
-    assign      frame_error     =   f_error_reg & rx_done;
+    // Multidrop address filtering. With addr_en, a 9-bit frame with its ninth bit set is an address.
+    // A matching address selects the receiver and is accepted; any other address deselects it.
+    // Data frames are accepted only while selected, so traffic for other nodes never reaches the FIFO.
+    reg         selected;
+    wire        match           =   (((match_data ^ dout) & ~match_mask) == 0);
+    wire        addr_frame      =   addr_en & (data_size == 4'd9) & dout[MDW-1];
+    always @ (posedge clk, negedge resetn)
+        if(!resetn)
+            selected <= 1'b0;
+        else if(~addr_en)
+            selected <= 1'b0;
+        else if(rx_done & addr_frame)
+            selected <= match;
+
+    assign      rx_accept       =   rx_done & (~addr_en | (addr_frame ? match : selected));
+    assign      parity_error    =   p_error_reg & rx_accept;
+    assign      frame_error     =   f_error_reg & rx_accept;
+    assign      noise           =   (n_error_reg | n_error_next) & rx_accept;   // the last stop bit counts too
     assign      break_flag      =   (brk == 0);
-    assign      match_flag      =   (match_data == dout) & rx_done;
+    assign      idle            =   (current_state == idle_st);
+    assign      match_flag      =   match & rx_done & (~addr_en | addr_frame);
 
 endmodule
 
 /*
     UART Transmitter
 */
-module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
+module UART_TX #(parameter MDW = 8)(
     input   wire                clk,
     input   wire                resetn,
+    input   wire [4:0]          num_samples,        // 4, 8 or 16
     input   wire                tx_start,        
+    input   wire                tx_more,            // another character follows d_in in the FIFO
+    input   wire                clocked,            // one b_tick per bit; the start bit begins on a b_tick
     input   wire                b_tick,             //baud rate tick
     input   wire [3:0]          data_size,          // 5 - 9
     input   wire                stop_bits_count,    // 0: 1, 1: 2
@@ -425,6 +1220,7 @@ module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
                                                     // 100: Sticky 0, 101: Sticky 1
     input   wire [MDW-1:0]      d_in,               // input data to transmit
     output  reg                 tx_done,            // Transfer finished
+    output  wire                tx_busy,            // A character is being sent
     output  wire                tx                  // output data to RS-232
 );
   
@@ -445,8 +1241,8 @@ module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
     //Internal Signals  
     reg [2:0]   current_state;
     reg [2:0]   next_state;
-    reg [3:0]   b_reg;          // baud tick counter
-    reg [3:0]   b_next;
+    reg [4:0]   b_reg;          // baud tick counter
+    reg [4:0]   b_next;
     reg [3:0]   count_reg;      // data bit counter
     reg [3:0]   count_next;
     reg [8:0]   data_reg;       // data register
@@ -487,7 +1283,7 @@ module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
         case(current_state)
             idle_st: begin
                 tx_next = 1'b1;
-                if(tx_start) begin
+                if(tx_start & (b_tick | ~clocked)) begin
                     next_state = start_st;
                     b_next = 0;
                     data_next = d_in;
@@ -497,10 +1293,13 @@ module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
             start_st: begin //send start bit
                 tx_next = 1'b0;
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES)) begin
+                    if(b_reg == (num_samples - clocked)) begin
                         next_state = data_st;
                         b_next = 0;
                         count_next = 0;
+                        // a character sent back to back was popped from the FIFO as its start bit began
+                        if(clocked)
+                            data_next = d_in;
                     end
                     else
                         b_next = b_reg + 1;
@@ -509,7 +1308,7 @@ module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
             data_st: begin //send data serially
                 tx_next = data_reg[0];
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES - 1)) begin
+                    if(b_reg == (num_samples - 1'b1)) begin
                         b_next = 0;
                         data_next = data_reg >> 1;
                         if(count_next == (data_size - 1)) 
@@ -537,7 +1336,7 @@ module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
                         tx_next = 1;
                 endcase
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES - 1)) begin
+                    if(b_reg == (num_samples - 1'b1)) begin
                         b_next = 0;
                         next_state = stop0_st;
                     end else
@@ -547,12 +1346,12 @@ module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
             stop0_st: begin //send stop bit
                 tx_next = 1'b1;
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES - 1)) begin
+                    if(b_reg == (num_samples - 1'b1)) begin
                         b_next = 0;
                         if(stop_bits_count)         //Two stop bits
                                 next_state = stop1_st;
                         else begin                  //One stop bit 
-                            next_state = idle_st;
+                            next_state = (clocked & tx_more) ? start_st : idle_st;
                             tx_done = 1'b1;
                         end        
                     end
@@ -563,9 +1362,9 @@ module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
             stop1_st: begin
                 tx_next = 1'b1;
                 if(b_tick)
-                    if(b_reg == (NUM_SAMPLES - 1)) begin //Two stop bits
+                    if(b_reg == (num_samples - 1'b1)) begin //Two stop bits
                         b_next = 0;
-                        next_state = idle_st;
+                        next_state = (clocked & tx_more) ? start_st : idle_st;
                         tx_done = 1'b1;
                     end else
                         b_next = b_reg + 1;
@@ -574,5 +1373,6 @@ module UART_TX #(parameter NUM_SAMPLES = 16, MDW = 8)(
     end
   
     assign tx = tx_reg;
+    assign tx_busy = (current_state != idle_st);
   
 endmodule
@@ -0,0 +1,426 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+/*
+    EF_UART_MULTI: the registers of CH EF_UART cores behind one register interface
+
+    - Channel i has the register map of EF_UART_APB in the 64 KB window at i * 0x10000
+    - One decoder: the register offset is compared once for all the channels, and the channel field of the address
+      picks the bank that a write goes to
+    - One read multiplexer: every readable register goes through a CH:1 multiplexer on the channel field, ahead of
+      the single multiplexer on the offset
+    - Per channel: the register bank, the clock gate that GCLK controls, and the EF_UART core
+    - IRQ_SUMMARY at offset 0xFF20 of every window has one bit per channel, set while the IRQ of the channel is high
+    - The bus tops (EF_UART_MULTI_APB, EF_UART_MULTI_AHBL, EF_UART_MULTI_WB) turn their bus into bus_we, bus_re,
+      bus_addr and bus_wdata. A register write may last more than one cycle; bus_strobe marks the one cycle of an
+      access that pushes or pops a FIFO
+*/
+
+`timescale			1ns/1ps
+`default_nettype	none
+
+// A register of every channel: CH copies of size bits side by side, written by the channel of the address
+`define EF_UART_MULTI_REG(name, offs, init, size) \
+	reg [CH*(size)-1:0]	name; \
+	always @(posedge clk or negedge rst_n) \
+		if(~rst_n) \
+			name <= {CH{init}}; \
+		else if(bus_we & ch_valid & (offset == offs)) \
+			name[channel*(size) +: (size)] <= bus_wdata[(size)-1:0];
+
+// Same, cleared in the cycle after the write
+`define EF_UART_MULTI_REG_AC(name, offs, size) \
+	reg [CH*(size)-1:0]	name; \
+	always @(posedge clk or negedge rst_n) \
+		if(~rst_n) \
+			name <= 0; \
+		else begin \
+			name <= 0; \
+			if(bus_we & ch_valid & (offset == offs)) \
+				name[channel*(size) +: (size)] <= bus_wdata[(size)-1:0]; \
+		end
+
+// The size bits of the channel of the address in a register of every channel
+`define EF_UART_MULTI_SEL(name, size) name[channel*(size) +: (size)]
+
+module EF_UART_MULTI #(
+	parameter
+		CH = 8,             // Number of channels, 1 to 32
+		SC = 8,
+		MDW = 9,
+		GFLEN = 8,
+		FAW = 4,
+		STATS = 1,
+		CRC = 1
+) (
+`ifdef USE_POWER_PINS
+	inout VPWR,
+	inout VGND,
+`endif
+	input	wire			clk,
+	input	wire			rst_n,
+	input	wire			bus_we,
+	input	wire			bus_re,
+	input	wire			bus_strobe,
+	input	wire	[31:0]		bus_addr,
+	input	wire	[31:0]		bus_wdata,
+	output	wire	[31:0]		bus_rdata,
+	output	wire			irq,
+	input	wire	[CH-1:0]	rx,
+	output	wire	[CH-1:0]	tx,
+	output	wire	[CH-1:0]	tx_dma_req,
+	output	wire	[CH-1:0]	tx_dma_single,
+	input	wire	[CH-1:0]	tx_dma_ack,
+	output	wire	[CH-1:0]	rx_dma_req,
+	output	wire	[CH-1:0]	rx_dma_single,
+	input	wire	[CH-1:0]	rx_dma_ack,
+	output	wire	[CH-1:0]	rts_n,
+	input	wire	[CH-1:0]	cts_n,
+	output	wire	[CH-1:0]	de,
+	input	wire	[CH-1:0]	sclk_in,
+	output	wire	[CH-1:0]	sclk_out,
+	output	wire	[CH-1:0]	sclk_oe
+);
+
+	localparam	CHW = (CH > 1) ? $clog2(CH) : 1;
+
+	localparam	RXDATA_REG_OFFSET = 16'h0000;
+	localparam	TXDATA_REG_OFFSET = 16'h0004;
+	localparam	PR_REG_OFFSET = 16'h0008;
+	localparam	CTRL_REG_OFFSET = 16'h000C;
+	localparam	CFG_REG_OFFSET = 16'h0010;
+	localparam	MATCH_REG_OFFSET = 16'h001C;
+	localparam	STATUS_REG_OFFSET = 16'h0020;
+	localparam	PRF_REG_OFFSET = 16'h0024;
+	localparam	CAP_REG_OFFSET = 16'h0028;
+	localparam	TXDATA_PACKED_REG_OFFSET = 16'h002C;
+	localparam	RXDATA_PACKED_REG_OFFSET = 16'h0030;
+	localparam	RTS_REG_OFFSET = 16'h0034;
+	localparam	MATCH_MASK_REG_OFFSET = 16'h0038;
+	localparam	DE_REG_OFFSET = 16'h003C;
+	localparam	ABR_REG_OFFSET = 16'h0040;
+	localparam	COAL_REG_OFFSET = 16'h0044;
+	localparam	COAL_TIME_REG_OFFSET = 16'h0048;
+	localparam	STATS_SNAP_REG_OFFSET = 16'h004C;
+	localparam	STATS_TX_REG_OFFSET = 16'h0050;
+	localparam	STATS_RX_REG_OFFSET = 16'h0054;
+	localparam	STATS_FE_PE_REG_OFFSET = 16'h0058;
+	localparam	STATS_OR_BRK_REG_OFFSET = 16'h005C;
+	localparam	STATS_RTO_REG_OFFSET = 16'h0060;
+	localparam	STATS_MAX_REG_OFFSET = 16'h0064;
+	localparam	SYNC_REG_OFFSET = 16'h0068;
+	localparam	SYNC_MASK_REG_OFFSET = 16'h006C;
+	localparam	SYNC_CTRL_REG_OFFSET = 16'h0070;
+	localparam	CRC_POLY_REG_OFFSET = 16'h0074;
+	localparam	CRC_INIT_REG_OFFSET = 16'h0078;
+	localparam	CRC_CTRL_REG_OFFSET = 16'h007C;
+	localparam	CRC_RST_REG_OFFSET = 16'h0080;
+	localparam	CRC_TX_REG_OFFSET = 16'h0084;
+	localparam	CRC_RX_REG_OFFSET = 16'h0088;
+	localparam	GAP_REG_OFFSET = 16'h008C;
+	localparam	FRAME_REG_OFFSET = 16'h0090;
+	localparam	RX_FIFO_LEVEL_REG_OFFSET = 16'hFE00;
+	localparam	RX_FIFO_THRESHOLD_REG_OFFSET = 16'hFE04;
+	localparam	RX_FIFO_FLUSH_REG_OFFSET = 16'hFE08;
+	localparam	TX_FIFO_LEVEL_REG_OFFSET = 16'hFE10;
+	localparam	TX_FIFO_THRESHOLD_REG_OFFSET = 16'hFE14;
+	localparam	TX_FIFO_FLUSH_REG_OFFSET = 16'hFE18;
+	localparam	IM_REG_OFFSET = 16'hFF00;
+	localparam	MIS_REG_OFFSET = 16'hFF04;
+	localparam	RIS_REG_OFFSET = 16'hFF08;
+	localparam	IC_REG_OFFSET = 16'hFF0C;
+	localparam	GCLK_REG_OFFSET = 16'hFF10;
+	localparam	IRQ_SUMMARY_REG_OFFSET = 16'hFF20;
+
+	wire	[15:0]		offset = bus_addr[15:0];
+	wire	[CHW-1:0]	channel = bus_addr[16 +: CHW];
+	wire			ch_valid = (channel < CH);
+
+	// FIFO accesses; the channel of the address takes them
+	wire			rd_hit = bus_strobe & bus_re & (offset == RXDATA_REG_OFFSET);
+	wire			wr_hit = bus_strobe & bus_we & (offset == TXDATA_REG_OFFSET);
+	wire			rd_packed_hit = bus_strobe & bus_re & (offset == RXDATA_PACKED_REG_OFFSET);
+	wire			wr_packed_hit = bus_strobe & bus_we & (offset == TXDATA_PACKED_REG_OFFSET);
+	wire			stats_snap_hit = bus_strobe & bus_we & (offset == STATS_SNAP_REG_OFFSET);
+	wire			crc_rst_hit = bus_strobe & bus_we & (offset == CRC_RST_REG_OFFSET);
+	wire			frame_rd_hit = bus_strobe & bus_re & (offset == FRAME_REG_OFFSET);
+
+	`EF_UART_MULTI_REG(PR_REG, PR_REG_OFFSET, 16'h0, 16)
+	`EF_UART_MULTI_REG(CTRL_REG, CTRL_REG_OFFSET, 14'h0, 14)
+	`EF_UART_MULTI_REG(CFG_REG, CFG_REG_OFFSET, 17'h3F08, 17)
+	`EF_UART_MULTI_REG(MATCH_REG, MATCH_REG_OFFSET, {MDW{1'b0}}, MDW)
+	`EF_UART_MULTI_REG(PRF_REG, PRF_REG_OFFSET, 4'h0, 4)
+	`EF_UART_MULTI_REG(RTS_REG, RTS_REG_OFFSET, {FAW{1'b0}}, FAW)
+	`EF_UART_MULTI_REG(MATCH_MASK_REG, MATCH_MASK_REG_OFFSET, {MDW{1'b0}}, MDW)
+	`EF_UART_MULTI_REG(DE_REG, DE_REG_OFFSET, 8'h0, 8)
+	`EF_UART_MULTI_REG(COAL_REG, COAL_REG_OFFSET, 16'h0, 16)
+	`EF_UART_MULTI_REG(COAL_TIME_REG, COAL_TIME_REG_OFFSET, 24'h0, 24)
+	`EF_UART_MULTI_REG(SYNC_REG, SYNC_REG_OFFSET, 32'h0, 32)
+	`EF_UART_MULTI_REG(SYNC_MASK_REG, SYNC_MASK_REG_OFFSET, 32'h0, 32)
+	`EF_UART_MULTI_REG(SYNC_CTRL_REG, SYNC_CTRL_REG_OFFSET, 4'h0, 4)
+	`EF_UART_MULTI_REG(CRC_POLY_REG, CRC_POLY_REG_OFFSET, 32'h0, 32)
+	`EF_UART_MULTI_REG(CRC_INIT_REG, CRC_INIT_REG_OFFSET, 32'h0, 32)
+	`EF_UART_MULTI_REG(CRC_CTRL_REG, CRC_CTRL_REG_OFFSET, 6'h0, 6)
+	`EF_UART_MULTI_REG(GAP_REG, GAP_REG_OFFSET, 8'h0, 8)
+	`EF_UART_MULTI_REG(RX_FIFO_THRESHOLD_REG, RX_FIFO_THRESHOLD_REG_OFFSET, {FAW{1'b0}}, FAW)
+	`EF_UART_MULTI_REG_AC(RX_FIFO_FLUSH_REG, RX_FIFO_FLUSH_REG_OFFSET, 1)
+	`EF_UART_MULTI_REG(TX_FIFO_THRESHOLD_REG, TX_FIFO_THRESHOLD_REG_OFFSET, {FAW{1'b0}}, FAW)
+	`EF_UART_MULTI_REG_AC(TX_FIFO_FLUSH_REG, TX_FIFO_FLUSH_REG_OFFSET, 1)
+	`EF_UART_MULTI_REG(GCLK_REG, GCLK_REG_OFFSET, 1'b0, 1)
+	`EF_UART_MULTI_REG(IM_REG, IM_REG_OFFSET, 16'h0, 16)
+	`EF_UART_MULTI_REG_AC(IC_REG, IC_REG_OFFSET, 16)
+
+	// Outputs of the cores, CH copies side by side
+	wire	[CH*13-1:0]	rdata;
+	wire	[CH*32-1:0]	rdata_packed;
+	wire	[CH*8-1:0]	rx_fifo_count;
+	wire	[CH*8-1:0]	tx_fifo_count;
+	wire	[CH*15-1:0]	cap;
+	wire	[CH*FAW-1:0]	rx_level;
+	wire	[CH*FAW-1:0]	tx_level;
+	wire	[CH*24-1:0]	abr_count;
+	wire	[CH*32-1:0]	stats_tx;
+	wire	[CH*32-1:0]	stats_rx;
+	wire	[CH*16-1:0]	stats_fe;
+	wire	[CH*16-1:0]	stats_pe;
+	wire	[CH*16-1:0]	stats_or;
+	wire	[CH*16-1:0]	stats_brk;
+	wire	[CH*16-1:0]	stats_rto;
+	wire	[CH*8-1:0]	stats_tx_max;
+	wire	[CH*8-1:0]	stats_rx_max;
+	wire	[CH*32-1:0]	crc_tx;
+	wire	[CH*32-1:0]	crc_rx;
+	wire	[CH*20-1:0]	frame_desc;
+	wire	[CH*16-1:0]	flags;          // the interrupt sources of each channel, in RIS order
+
+	reg	[CH*16-1:0]	RIS_REG;
+	wire	[CH*16-1:0]	MIS_REG = RIS_REG & IM_REG;
+	wire	[CH-1:0]	ch_irq;
+
+	always @(posedge clk or negedge rst_n)
+		if(~rst_n)
+			RIS_REG <= 0;
+		else
+			RIS_REG <= (RIS_REG | flags) & ~IC_REG;
+
+	generate
+		genvar i;
+		for(i = 0; i < CH; i = i + 1) begin : ch
+			wire		sel = ch_valid & (channel == i);
+			wire		clk_g;
+			wire	[13:0]	ctrl = CTRL_REG[i*14 +: 14];
+			wire	[16:0]	cfg = CFG_REG[i*17 +: 17];
+			wire	[7:0]	de_cfg = DE_REG[i*8 +: 8];
+			wire	[15:0]	coal = COAL_REG[i*16 +: 16];
+			wire	[3:0]	sync_ctrl = SYNC_CTRL_REG[i*4 +: 4];
+			wire	[5:0]	crc_ctrl = CRC_CTRL_REG[i*6 +: 6];
+
+			ef_gating_cell clk_gate_cell (
+			`ifdef USE_POWER_PINS
+				.vpwr(VPWR),
+				.vgnd(VGND),
+			`endif
+				.clk(clk),
+				.clk_en(GCLK_REG[i]),
+				.clk_o(clk_g)
+			);
+
+			EF_UART #(
+				.SC(SC),
+				.MDW(MDW),
+				.GFLEN(GFLEN),
+				.FAW(FAW),
+				.STATS(STATS),
+				.CRC(CRC)
+			) uart (
+				.clk(clk_g),
+				.rst_n(rst_n),
+				.prescaler(PR_REG[i*16 +: 16]),
+				.prescaler_frac(PRF_REG[i*4 +: 4]),
+				.en(ctrl[0]),
+				.tx_en(ctrl[1]),
+				.rx_en(ctrl[2]),
+				.rd(sel & rd_hit),
+				.wr(sel & wr_hit),
+				.wdata(bus_wdata[MDW-1:0]),
+				.rd_packed(sel & rd_packed_hit),
+				.wr_packed(sel & wr_packed_hit),
+				.wdata_packed(bus_wdata),
+				.data_size(cfg[3:0]),
+				.stop_bits_count(cfg[4]),
+				.parity_type(cfg[7:5]),
+				.txfifotr(TX_FIFO_THRESHOLD_REG[i*FAW +: FAW]),
+				.rxfifotr(RX_FIFO_THRESHOLD_REG[i*FAW +: FAW]),
+				.match_data(MATCH_REG[i*MDW +: MDW]),
+				.match_mask(MATCH_MASK_REG[i*MDW +: MDW]),
+				.addr_en(ctrl[9]),
+				.timeout_bits(cfg[13:8]),
+				.osr(cfg[15:14]),
+				.loopback_en(ctrl[3]),
+				.glitch_filter_en(ctrl[4]),
+				.majority_en(cfg[16]),
+				.tx_fifo_flush(TX_FIFO_FLUSH_REG[i]),
+				.rx_fifo_flush(RX_FIFO_FLUSH_REG[i]),
+				.tx_dma_en(ctrl[5]),
+				.rx_dma_en(ctrl[6]),
+				.tx_dma_ack(tx_dma_ack[i]),
+				.rx_dma_ack(rx_dma_ack[i]),
+				.rts_en(ctrl[7]),
+				.cts_en(ctrl[8]),
+				.rts_level(RTS_REG[i*FAW +: FAW]),
+				.de_en(ctrl[10]),
+				.de_lead(de_cfg[3:0]),
+				.de_lag(de_cfg[7:4]),
+				.abr_en(ctrl[11]),
+				.coal_rx_count(coal[7:0]),
+				.coal_tx_count(coal[15:8]),
+				.coal_time(COAL_TIME_REG[i*24 +: 24]),
+				.stats_snap_wr(sel & stats_snap_hit),
+				.stats_snap_wdata(bus_wdata[0]),
+				.sync_pattern(SYNC_REG[i*32 +: 32]),
+				.sync_mask(SYNC_MASK_REG[i*32 +: 32]),
+				.sync_len(sync_ctrl[1:0]),
+				.sync_en(sync_ctrl[2]),
+				.sync_hunt(sync_ctrl[3]),
+				.crc_poly(CRC_POLY_REG[i*32 +: 32]),
+				.crc_init(CRC_INIT_REG[i*32 +: 32]),
+				.crc_size(crc_ctrl[2:1]),
+				.crc_en(crc_ctrl[0]),
+				.crc_refin(crc_ctrl[3]),
+				.crc_refout(crc_ctrl[4]),
+				.crc_inv(crc_ctrl[5]),
+				.crc_rst_wr(sel & crc_rst_hit),
+				.crc_rst_wdata(bus_wdata[1:0]),
+				.frame_gap(GAP_REG[i*8 +: 8]),
+				.frame_rd(sel & frame_rd_hit),
+				.usart_en(ctrl[12]),
+				.sclk_ext(ctrl[13]),
+				.tx_empty(flags[i*16 + 0]),
+				.tx_full(),
+				.tx_level(tx_level[i*FAW +: FAW]),
+				.tx_level_below(flags[i*16 + 2]),
+				.rdata(rdata[i*13 +: 13]),
+				.rdata_packed(rdata_packed[i*32 +: 32]),
+				.rx_empty(),
+				.rx_full(flags[i*16 + 1]),
+				.rx_level(rx_level[i*FAW +: FAW]),
+				.rx_level_above(flags[i*16 + 3]),
+				.rx_fifo_count(rx_fifo_count[i*8 +: 8]),
+				.tx_fifo_count(tx_fifo_count[i*8 +: 8]),
+				.cap(cap[i*15 +: 15]),
+				.break_flag(flags[i*16 + 4]),
+				.match_flag(flags[i*16 + 5]),
+				.frame_error_flag(flags[i*16 + 6]),
+				.parity_error_flag(flags[i*16 + 7]),
+				.overrun_flag(flags[i*16 + 8]),
+				.timeout_flag(flags[i*16 + 9]),
+				.tx_complete_flag(flags[i*16 + 10]),
+				.noise_flag(flags[i*16 + 13]),
+				.sync_flag(flags[i*16 + 14]),
+				.frame_flag(flags[i*16 + 15]),
+				.frame_desc(frame_desc[i*20 +: 20]),
+				.abr_flag(flags[i*16 + 11]),
+				.abr_count(abr_count[i*24 +: 24]),
+				.coal_flag(flags[i*16 + 12]),
+				.stats_tx(stats_tx[i*32 +: 32]),
+				.stats_rx(stats_rx[i*32 +: 32]),
+				.stats_fe(stats_fe[i*16 +: 16]),
+				.stats_pe(stats_pe[i*16 +: 16]),
+				.stats_or(stats_or[i*16 +: 16]),
+				.stats_brk(stats_brk[i*16 +: 16]),
+				.stats_rto(stats_rto[i*16 +: 16]),
+				.stats_tx_max(stats_tx_max[i*8 +: 8]),
+				.stats_rx_max(stats_rx_max[i*8 +: 8]),
+				.crc_tx(crc_tx[i*32 +: 32]),
+				.crc_rx(crc_rx[i*32 +: 32]),
+				.tx_dma_req(tx_dma_req[i]),
+				.tx_dma_single(tx_dma_single[i]),
+				.rx_dma_req(rx_dma_req[i]),
+				.rx_dma_single(rx_dma_single[i]),
+				.rts_n(rts_n[i]),
+				.de(de[i]),
+				.cts_n(cts_n[i]),
+				.sclk_in(sclk_in[i]),
+				.sclk_out(sclk_out[i]),
+				.sclk_oe(sclk_oe[i]),
+				.rx(rx[i]),
+				.tx(tx[i])
+			);
+
+			assign	ch_irq[i] = |MIS_REG[i*16 +: 16];
+		end
+	endgenerate
+
+	wire	[31:0]	IRQ_SUMMARY_WIRE = ch_irq;
+
+	// The parameters are the same for every channel
+	wire	[14:0]	CAP_WIRE = cap[14:0];
+
+	assign	bus_rdata =
+			(offset == IRQ_SUMMARY_REG_OFFSET)	? IRQ_SUMMARY_WIRE :
+			~ch_valid				? 32'hDEADBEEF :
+			(offset == RXDATA_REG_OFFSET)		? `EF_UART_MULTI_SEL(rdata, 13) :
+			(offset == PR_REG_OFFSET)		? `EF_UART_MULTI_SEL(PR_REG, 16) :
+			(offset == CTRL_REG_OFFSET)		? `EF_UART_MULTI_SEL(CTRL_REG, 14) :
+			(offset == CFG_REG_OFFSET)		? `EF_UART_MULTI_SEL(CFG_REG, 17) :
+			(offset == MATCH_REG_OFFSET)		? `EF_UART_MULTI_SEL(MATCH_REG, MDW) :
+			(offset == STATUS_REG_OFFSET)		? {`EF_UART_MULTI_SEL(RIS_REG, 16), `EF_UART_MULTI_SEL(tx_fifo_count, 8), `EF_UART_MULTI_SEL(rx_fifo_count, 8)} :
+			(offset == PRF_REG_OFFSET)		? `EF_UART_MULTI_SEL(PRF_REG, 4) :
+			(offset == CAP_REG_OFFSET)		? CAP_WIRE :
+			(offset == RXDATA_PACKED_REG_OFFSET)	? `EF_UART_MULTI_SEL(rdata_packed, 32) :
+			(offset == RTS_REG_OFFSET)		? `EF_UART_MULTI_SEL(RTS_REG, FAW) :
+			(offset == MATCH_MASK_REG_OFFSET)	? `EF_UART_MULTI_SEL(MATCH_MASK_REG, MDW) :
+			(offset == DE_REG_OFFSET)		? `EF_UART_MULTI_SEL(DE_REG, 8) :
+			(offset == ABR_REG_OFFSET)		? `EF_UART_MULTI_SEL(abr_count, 24) :
+			(offset == COAL_REG_OFFSET)		? `EF_UART_MULTI_SEL(COAL_REG, 16) :
+			(offset == COAL_TIME_REG_OFFSET)	? `EF_UART_MULTI_SEL(COAL_TIME_REG, 24) :
+			(offset == STATS_TX_REG_OFFSET)		? `EF_UART_MULTI_SEL(stats_tx, 32) :
+			(offset == STATS_RX_REG_OFFSET)		? `EF_UART_MULTI_SEL(stats_rx, 32) :
+			(offset == STATS_FE_PE_REG_OFFSET)	? {`EF_UART_MULTI_SEL(stats_pe, 16), `EF_UART_MULTI_SEL(stats_fe, 16)} :
+			(offset == STATS_OR_BRK_REG_OFFSET)	? {`EF_UART_MULTI_SEL(stats_brk, 16), `EF_UART_MULTI_SEL(stats_or, 16)} :
+			(offset == STATS_RTO_REG_OFFSET)	? `EF_UART_MULTI_SEL(stats_rto, 16) :
+			(offset == STATS_MAX_REG_OFFSET)	? {`EF_UART_MULTI_SEL(stats_tx_max, 8), `EF_UART_MULTI_SEL(stats_rx_max, 8)} :
+			(offset == SYNC_REG_OFFSET)		? `EF_UART_MULTI_SEL(SYNC_REG, 32) :
+			(offset == SYNC_MASK_REG_OFFSET)	? `EF_UART_MULTI_SEL(SYNC_MASK_REG, 32) :
+			(offset == SYNC_CTRL_REG_OFFSET)	? `EF_UART_MULTI_SEL(SYNC_CTRL_REG, 4) :
+			(offset == CRC_POLY_REG_OFFSET)		? `EF_UART_MULTI_SEL(CRC_POLY_REG, 32) :
+			(offset == CRC_INIT_REG_OFFSET)		? `EF_UART_MULTI_SEL(CRC_INIT_REG, 32) :
+			(offset == CRC_CTRL_REG_OFFSET)		? `EF_UART_MULTI_SEL(CRC_CTRL_REG, 6) :
+			(offset == CRC_TX_REG_OFFSET)		? `EF_UART_MULTI_SEL(crc_tx, 32) :
+			(offset == CRC_RX_REG_OFFSET)		? `EF_UART_MULTI_SEL(crc_rx, 32) :
+			(offset == GAP_REG_OFFSET)		? `EF_UART_MULTI_SEL(GAP_REG, 8) :
+			(offset == FRAME_REG_OFFSET)		? `EF_UART_MULTI_SEL(frame_desc, 20) :
+			(offset == RX_FIFO_LEVEL_REG_OFFSET)	? `EF_UART_MULTI_SEL(rx_level, FAW) :
+			(offset == RX_FIFO_THRESHOLD_REG_OFFSET)	? `EF_UART_MULTI_SEL(RX_FIFO_THRESHOLD_REG, FAW) :
+			(offset == RX_FIFO_FLUSH_REG_OFFSET)	? `EF_UART_MULTI_SEL(RX_FIFO_FLUSH_REG, 1) :
+			(offset == TX_FIFO_LEVEL_REG_OFFSET)	? `EF_UART_MULTI_SEL(tx_level, FAW) :
+			(offset == TX_FIFO_THRESHOLD_REG_OFFSET)	? `EF_UART_MULTI_SEL(TX_FIFO_THRESHOLD_REG, FAW) :
+			(offset == TX_FIFO_FLUSH_REG_OFFSET)	? `EF_UART_MULTI_SEL(TX_FIFO_FLUSH_REG, 1) :
+			(offset == IM_REG_OFFSET)		? `EF_UART_MULTI_SEL(IM_REG, 16) :
+			(offset == MIS_REG_OFFSET)		? `EF_UART_MULTI_SEL(MIS_REG, 16) :
+			(offset == RIS_REG_OFFSET)		? `EF_UART_MULTI_SEL(RIS_REG, 16) :
+			(offset == IC_REG_OFFSET)		? `EF_UART_MULTI_SEL(IC_REG, 16) :
+			(offset == GCLK_REG_OFFSET)		? `EF_UART_MULTI_SEL(GCLK_REG, 1) :
+			32'hDEADBEEF;
+
+	assign	irq = |ch_irq;
+
+endmodule
+
+`undef EF_UART_MULTI_REG
+`undef EF_UART_MULTI_REG_AC
+`undef EF_UART_MULTI_SEL
@@ -102,7 +102,9 @@ module EF_UART_APB #(
 		SC = 8,
 		MDW = 9,
 		GFLEN = 8,
-		FAW = 4
+		FAW = 4,
+		STATS = 1,
+		CRC = 1
 ) (
 
 
@@ -120,7 +122,19 @@ module EF_UART_APB #(
                                         output wire         IRQ
 ,
 	input	wire	[1-1:0]	rx,
-	output	wire	[1-1:0]	tx
+	output	wire	[1-1:0]	tx,
+	output	wire	[1-1:0]	tx_dma_req,
+	output	wire	[1-1:0]	tx_dma_single,
+	input	wire	[1-1:0]	tx_dma_ack,
+	output	wire	[1-1:0]	rx_dma_req,
+	output	wire	[1-1:0]	rx_dma_single,
+	input	wire	[1-1:0]	rx_dma_ack,
+	output	wire	[1-1:0]	rts_n,
+	input	wire	[1-1:0]	cts_n,
+	output	wire	[1-1:0]	de,
+	input	wire	[1-1:0]	sclk_in,
+	output	wire	[1-1:0]	sclk_out,
+	output	wire	[1-1:0]	sclk_oe
 );
 
 	localparam	RXDATA_REG_OFFSET = 16'h0000;
@@ -129,6 +143,35 @@ module EF_UART_APB #(
 	localparam	CTRL_REG_OFFSET = 16'h000C;
 	localparam	CFG_REG_OFFSET = 16'h0010;
 	localparam	MATCH_REG_OFFSET = 16'h001C;
+	localparam	STATUS_REG_OFFSET = 16'h0020;
+	localparam	PRF_REG_OFFSET = 16'h0024;
+	localparam	CAP_REG_OFFSET = 16'h0028;
+	localparam	TXDATA_PACKED_REG_OFFSET = 16'h002C;
+	localparam	RXDATA_PACKED_REG_OFFSET = 16'h0030;
+	localparam	RTS_REG_OFFSET = 16'h0034;
+	localparam	MATCH_MASK_REG_OFFSET = 16'h0038;
+	localparam	DE_REG_OFFSET = 16'h003C;
+	localparam	ABR_REG_OFFSET = 16'h0040;
+	localparam	COAL_REG_OFFSET = 16'h0044;
+	localparam	COAL_TIME_REG_OFFSET = 16'h0048;
+	localparam	STATS_SNAP_REG_OFFSET = 16'h004C;
+	localparam	STATS_TX_REG_OFFSET = 16'h0050;
+	localparam	STATS_RX_REG_OFFSET = 16'h0054;
+	localparam	STATS_FE_PE_REG_OFFSET = 16'h0058;
+	localparam	STATS_OR_BRK_REG_OFFSET = 16'h005C;
+	localparam	STATS_RTO_REG_OFFSET = 16'h0060;
+	localparam	STATS_MAX_REG_OFFSET = 16'h0064;
+	localparam	SYNC_REG_OFFSET = 16'h0068;
+	localparam	SYNC_MASK_REG_OFFSET = 16'h006C;
+	localparam	SYNC_CTRL_REG_OFFSET = 16'h0070;
+	localparam	CRC_POLY_REG_OFFSET = 16'h0074;
+	localparam	CRC_INIT_REG_OFFSET = 16'h0078;
+	localparam	CRC_CTRL_REG_OFFSET = 16'h007C;
+	localparam	CRC_RST_REG_OFFSET = 16'h0080;
+	localparam	CRC_TX_REG_OFFSET = 16'h0084;
+	localparam	CRC_RX_REG_OFFSET = 16'h0088;
+	localparam	GAP_REG_OFFSET = 16'h008C;
+	localparam	FRAME_REG_OFFSET = 16'h0090;
 	localparam	RX_FIFO_LEVEL_REG_OFFSET = 16'hFE00;
 	localparam	RX_FIFO_THRESHOLD_REG_OFFSET = 16'hFE04;
 	localparam	RX_FIFO_FLUSH_REG_OFFSET = 16'hFE08;
@@ -162,17 +205,23 @@ module EF_UART_APB #(
                                         wire		apb_re	    = ~PWRITE & apb_valid;
 
 	wire [16-1:0]	prescaler;
+	wire [4-1:0]	prescaler_frac;
 	wire [1-1:0]	en;
 	wire [1-1:0]	tx_en;
 	wire [1-1:0]	rx_en;
 	wire [MDW-1:0]	wdata;
 	wire [6-1:0]	timeout_bits;
+	wire [2-1:0]	osr;
 	wire [1-1:0]	loopback_en;
 	wire [1-1:0]	glitch_filter_en;
+	wire [1-1:0]	majority_en;
 	wire [FAW-1:0]	tx_level;
 	wire [FAW-1:0]	rx_level;
 	wire [1-1:0]	rd;
 	wire [1-1:0]	wr;
+	wire [1-1:0]	rd_packed;
+	wire [1-1:0]	wr_packed;
+	wire [32-1:0]	wdata_packed;
 	wire [1-1:0]	tx_fifo_flush;
 	wire [1-1:0]	rx_fifo_flush;
 	wire [4-1:0]	data_size;
@@ -184,7 +233,11 @@ module EF_UART_APB #(
 	wire [1-1:0]	tx_empty;
 	wire [1-1:0]	tx_full;
 	wire [1-1:0]	tx_level_below;
-	wire [MDW-1:0]	rdata;
+	wire [13-1:0]	rdata;
+	wire [32-1:0]	rdata_packed;
+	wire [8-1:0]	rx_fifo_count;
+	wire [8-1:0]	tx_fifo_count;
+	wire [15-1:0]	cap;
 	wire [1-1:0]	rx_empty;
 	wire [1-1:0]	rx_full;
 	wire [1-1:0]	rx_level_above;
@@ -194,36 +247,110 @@ module EF_UART_APB #(
 	wire [1-1:0]	parity_error_flag;
 	wire [1-1:0]	overrun_flag;
 	wire [1-1:0]	timeout_flag;
+	wire [1-1:0]	tx_dma_en;
+	wire [1-1:0]	rx_dma_en;
+	wire [1-1:0]	rts_en;
+	wire [1-1:0]	cts_en;
+	wire [FAW-1:0]	rts_level;
+	wire [MDW-1:0]	match_mask;
+	wire [1-1:0]	addr_en;
+	wire [1-1:0]	de_en;
+	wire [4-1:0]	de_lead;
+	wire [4-1:0]	de_lag;
+	wire [1-1:0]	tx_complete_flag;
+	wire [1-1:0]	abr_en;
+	wire [1-1:0]	usart_en;
+	wire [1-1:0]	sclk_ext;
+	wire [24-1:0]	abr_count;
+	wire [1-1:0]	abr_flag;
+	wire [8-1:0]	coal_rx_count;
+	wire [8-1:0]	coal_tx_count;
+	wire [24-1:0]	coal_time;
+	wire [1-1:0]	coal_flag;
+	wire [1-1:0]	noise_flag;
+	wire [1-1:0]	stats_snap_wr;
+	wire [1-1:0]	stats_snap_wdata;
+	wire [32-1:0]	stats_tx;
+	wire [32-1:0]	stats_rx;
+	wire [16-1:0]	stats_fe;
+	wire [16-1:0]	stats_pe;
+	wire [16-1:0]	stats_or;
+	wire [16-1:0]	stats_brk;
+	wire [16-1:0]	stats_rto;
+	wire [8-1:0]	stats_tx_max;
+	wire [8-1:0]	stats_rx_max;
+	wire [32-1:0]	sync_pattern;
+	wire [32-1:0]	sync_mask;
+	wire [2-1:0]	sync_len;
+	wire [1-1:0]	sync_en;
+	wire [1-1:0]	sync_hunt;
+	wire [1-1:0]	sync_flag;
+	wire [32-1:0]	crc_poly;
+	wire [32-1:0]	crc_init;
+	wire [2-1:0]	crc_size;
+	wire [1-1:0]	crc_en;
+	wire [1-1:0]	crc_refin;
+	wire [1-1:0]	crc_refout;
+	wire [1-1:0]	crc_inv;
+	wire [1-1:0]	crc_rst_wr;
+	wire [2-1:0]	crc_rst_wdata;
+	wire [32-1:0]	crc_tx;
+	wire [32-1:0]	crc_rx;
+	wire [8-1:0]	frame_gap;
+	wire [1-1:0]	frame_rd;
+	wire [1-1:0]	frame_flag;
+	wire [20-1:0]	frame_desc;
 
 	// Register Definitions
-	wire	[MDW-1:0]	RXDATA_WIRE;
+	wire	[13-1:0]	RXDATA_WIRE;
 
 	wire	[MDW-1:0]	TXDATA_WIRE;
 
+	wire	[32-1:0]	TXDATA_PACKED_WIRE;
+
+	wire	[32-1:0]	RXDATA_PACKED_WIRE;
+
+	wire	[1-1:0]	STATS_SNAP_WIRE;
+
+	wire	[2-1:0]	CRC_RST_WIRE;
+
+	wire	[20-1:0]	FRAME_WIRE;
+
 	reg [15:0]	PR_REG;
 	assign	prescaler = PR_REG;
 	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) PR_REG <= 0;
                                         else if(apb_we & (PADDR[16-1:0]==PR_REG_OFFSET))
                                             PR_REG <= PWDATA[16-1:0];
 
-	reg [4:0]	CTRL_REG;
+	reg [13:0]	CTRL_REG;
 	assign	en	=	CTRL_REG[0 : 0];
 	assign	tx_en	=	CTRL_REG[1 : 1];
 	assign	rx_en	=	CTRL_REG[2 : 2];
 	assign	loopback_en	=	CTRL_REG[3 : 3];
 	assign	glitch_filter_en	=	CTRL_REG[4 : 4];
+	assign	tx_dma_en	=	CTRL_REG[5 : 5];
+	assign	rx_dma_en	=	CTRL_REG[6 : 6];
+	assign	rts_en	=	CTRL_REG[7 : 7];
+	assign	cts_en	=	CTRL_REG[8 : 8];
+	assign	addr_en	=	CTRL_REG[9 : 9];
+	assign	de_en	=	CTRL_REG[10 : 10];
+	assign	abr_en	=	CTRL_REG[11 : 11];
+	assign	usart_en	=	CTRL_REG[12 : 12];
+	assign	sclk_ext	=	CTRL_REG[13 : 13];
 	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) CTRL_REG <= 0;
                                         else if(apb_we & (PADDR[16-1:0]==CTRL_REG_OFFSET))
-                                            CTRL_REG <= PWDATA[5-1:0];
+                                            CTRL_REG <= PWDATA[14-1:0];
 
-	reg [13:0]	CFG_REG;
+	reg [16:0]	CFG_REG;
 	assign	data_size	=	CFG_REG[3 : 0];
 	assign	stop_bits_count	=	CFG_REG[4 : 4];
 	assign	parity_type	=	CFG_REG[7 : 5];
 	assign	timeout_bits	=	CFG_REG[13 : 8];
+	assign	osr	=	CFG_REG[15 : 14];
+	assign	majority_en	=	CFG_REG[16 : 16];
 	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) CFG_REG <= 'h3F08;
                                         else if(apb_we & (PADDR[16-1:0]==CFG_REG_OFFSET))
-                                            CFG_REG <= PWDATA[14-1:0];
+                                            CFG_REG <= PWDATA[17-1:0];
 
 	reg [MDW-1:0]	MATCH_REG;
 	assign	match_data = MATCH_REG;
@@ -231,6 +358,130 @@ module EF_UART_APB #(
                                         else if(apb_we & (PADDR[16-1:0]==MATCH_REG_OFFSET))
                                             MATCH_REG <= PWDATA[MDW-1:0];
 
+	wire [32-1:0]	STATUS_WIRE;
+	assign	STATUS_WIRE[7 : 0] = rx_fifo_count;
+	assign	STATUS_WIRE[15 : 8] = tx_fifo_count;
+	assign	STATUS_WIRE[31 : 16] = RIS_REG;
+
+	reg [3:0]	PRF_REG;
+	assign	prescaler_frac = PRF_REG;
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) PRF_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==PRF_REG_OFFSET))
+                                            PRF_REG <= PWDATA[4-1:0];
+
+	wire [15-1:0]	CAP_WIRE;
+	assign	CAP_WIRE[14 : 0] = cap;
+
+	reg [FAW-1:0]	RTS_REG;
+	assign	rts_level = RTS_REG;
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) RTS_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==RTS_REG_OFFSET))
+                                            RTS_REG <= PWDATA[FAW-1:0];
+
+	reg [MDW-1:0]	MATCH_MASK_REG;
+	assign	match_mask = MATCH_MASK_REG;
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) MATCH_MASK_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==MATCH_MASK_REG_OFFSET))
+                                            MATCH_MASK_REG <= PWDATA[MDW-1:0];
+
+	reg [7:0]	DE_REG;
+	assign	de_lead	=	DE_REG[3 : 0];
+	assign	de_lag	=	DE_REG[7 : 4];
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) DE_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==DE_REG_OFFSET))
+                                            DE_REG <= PWDATA[8-1:0];
+
+	wire [24-1:0]	ABR_WIRE;
+	assign	ABR_WIRE[23 : 0] = abr_count;
+
+	reg [15:0]	COAL_REG;
+	assign	coal_rx_count	=	COAL_REG[7 : 0];
+	assign	coal_tx_count	=	COAL_REG[15 : 8];
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) COAL_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==COAL_REG_OFFSET))
+                                            COAL_REG <= PWDATA[16-1:0];
+
+	reg [23:0]	COAL_TIME_REG;
+	assign	coal_time = COAL_TIME_REG;
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) COAL_TIME_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==COAL_TIME_REG_OFFSET))
+                                            COAL_TIME_REG <= PWDATA[24-1:0];
+
+	wire [32-1:0]	STATS_TX_WIRE;
+	assign	STATS_TX_WIRE[31 : 0] = stats_tx;
+
+	wire [32-1:0]	STATS_RX_WIRE;
+	assign	STATS_RX_WIRE[31 : 0] = stats_rx;
+
+	wire [32-1:0]	STATS_FE_PE_WIRE;
+	assign	STATS_FE_PE_WIRE[15 : 0] = stats_fe;
+	assign	STATS_FE_PE_WIRE[31 : 16] = stats_pe;
+
+	wire [32-1:0]	STATS_OR_BRK_WIRE;
+	assign	STATS_OR_BRK_WIRE[15 : 0] = stats_or;
+	assign	STATS_OR_BRK_WIRE[31 : 16] = stats_brk;
+
+	wire [16-1:0]	STATS_RTO_WIRE;
+	assign	STATS_RTO_WIRE[15 : 0] = stats_rto;
+
+	wire [16-1:0]	STATS_MAX_WIRE;
+	assign	STATS_MAX_WIRE[7 : 0] = stats_rx_max;
+	assign	STATS_MAX_WIRE[15 : 8] = stats_tx_max;
+
+	reg [31:0]	SYNC_REG;
+	assign	sync_pattern = SYNC_REG;
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) SYNC_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==SYNC_REG_OFFSET))
+                                            SYNC_REG <= PWDATA[32-1:0];
+
+	reg [31:0]	SYNC_MASK_REG;
+	assign	sync_mask = SYNC_MASK_REG;
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) SYNC_MASK_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==SYNC_MASK_REG_OFFSET))
+                                            SYNC_MASK_REG <= PWDATA[32-1:0];
+
+	reg [3:0]	SYNC_CTRL_REG;
+	assign	sync_len	=	SYNC_CTRL_REG[1 : 0];
+	assign	sync_en	=	SYNC_CTRL_REG[2 : 2];
+	assign	sync_hunt	=	SYNC_CTRL_REG[3 : 3];
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) SYNC_CTRL_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==SYNC_CTRL_REG_OFFSET))
+                                            SYNC_CTRL_REG <= PWDATA[4-1:0];
+
+	reg [31:0]	CRC_POLY_REG;
+	assign	crc_poly = CRC_POLY_REG;
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) CRC_POLY_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==CRC_POLY_REG_OFFSET))
+                                            CRC_POLY_REG <= PWDATA[32-1:0];
+
+	reg [31:0]	CRC_INIT_REG;
+	assign	crc_init = CRC_INIT_REG;
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) CRC_INIT_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==CRC_INIT_REG_OFFSET))
+                                            CRC_INIT_REG <= PWDATA[32-1:0];
+
+	reg [5:0]	CRC_CTRL_REG;
+	assign	crc_en	=	CRC_CTRL_REG[0 : 0];
+	assign	crc_size	=	CRC_CTRL_REG[2 : 1];
+	assign	crc_refin	=	CRC_CTRL_REG[3 : 3];
+	assign	crc_refout	=	CRC_CTRL_REG[4 : 4];
+	assign	crc_inv	=	CRC_CTRL_REG[5 : 5];
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) CRC_CTRL_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==CRC_CTRL_REG_OFFSET))
+                                            CRC_CTRL_REG <= PWDATA[6-1:0];
+
+	wire [32-1:0]	CRC_TX_WIRE;
+	assign	CRC_TX_WIRE[31 : 0] = crc_tx;
+
+	wire [32-1:0]	CRC_RX_WIRE;
+	assign	CRC_RX_WIRE[31 : 0] = crc_rx;
+
+	reg [7:0]	GAP_REG;
+	assign	frame_gap = GAP_REG;
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) GAP_REG <= 0;
+                                        else if(apb_we & (PADDR[16-1:0]==GAP_REG_OFFSET))
+                                            GAP_REG <= PWDATA[8-1:0];
+
 	wire [FAW-1:0]	RX_FIFO_LEVEL_WIRE;
 	assign	RX_FIFO_LEVEL_WIRE[(FAW - 1) : 0] = rx_level;
 
@@ -270,19 +521,19 @@ module EF_UART_APB #(
                                         else if(apb_we & (PADDR[16-1:0]==GCLK_REG_OFFSET))
                                             GCLK_REG <= PWDATA[1-1:0];
 
-	reg [9:0] IM_REG;
-	reg [9:0] IC_REG;
-	reg [9:0] RIS_REG;
+	reg [15:0] IM_REG;
+	reg [15:0] IC_REG;
+	reg [15:0] RIS_REG;
 
-	wire[10-1:0]      MIS_REG	= RIS_REG & IM_REG;
+	wire[16-1:0]      MIS_REG	= RIS_REG & IM_REG;
 	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) IM_REG <= 0;
                                         else if(apb_we & (PADDR[16-1:0]==IM_REG_OFFSET))
-                                            IM_REG <= PWDATA[10-1:0];
-	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) IC_REG <= 10'b0;
+                                            IM_REG <= PWDATA[16-1:0];
+	always @(posedge PCLK or negedge PRESETn) if(~PRESETn) IC_REG <= 16'b0;
                                         else if(apb_we & (PADDR[16-1:0]==IC_REG_OFFSET))
-                                            IC_REG <= PWDATA[10-1:0];
+                                            IC_REG <= PWDATA[16-1:0];
                                         else
-                                            IC_REG <= 10'd0;
+                                            IC_REG <= 16'd0;
 
 	wire [0:0] TXE = tx_empty;
 	wire [0:0] RXF = rx_full;
@@ -294,6 +545,12 @@ module EF_UART_APB #(
 	wire [0:0] PRE = parity_error_flag;
 	wire [0:0] OR = overrun_flag;
 	wire [0:0] RTO = timeout_flag;
+	wire [0:0] TC = tx_complete_flag;
+	wire [0:0] ABR = abr_flag;
+	wire [0:0] COAL = coal_flag;
+	wire [0:0] NOISE = noise_flag;
+	wire [0:0] SYNC = sync_flag;
+	wire [0:0] EOF = frame_flag;
 
 
 	integer _i_;
@@ -328,6 +585,24 @@ module EF_UART_APB #(
 		for(_i_ = 9; _i_ < 10; _i_ = _i_ + 1) begin
 			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(RTO[_i_ - 9] == 1'b1) RIS_REG[_i_] <= 1'b1;
 		end
+		for(_i_ = 10; _i_ < 11; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(TC[_i_ - 10] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 11; _i_ < 12; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(ABR[_i_ - 11] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 12; _i_ < 13; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(COAL[_i_ - 12] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 13; _i_ < 14; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(NOISE[_i_ - 13] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 14; _i_ < 15; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(SYNC[_i_ - 14] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 15; _i_ < 16; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(EOF[_i_ - 15] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
 	end
 
 	assign IRQ = |MIS_REG;
@@ -336,18 +611,26 @@ module EF_UART_APB #(
 		.SC(SC),
 		.MDW(MDW),
 		.GFLEN(GFLEN),
-		.FAW(FAW)
+		.FAW(FAW),
+		.STATS(STATS),
+		.CRC(CRC)
 	) instance_to_wrap (
 		.clk(clk),
 		.rst_n(rst_n),
 		.prescaler(prescaler),
+		.prescaler_frac(prescaler_frac),
 		.en(en),
 		.tx_en(tx_en),
 		.rx_en(rx_en),
 		.wdata(wdata),
+		.rd_packed(rd_packed),
+		.wr_packed(wr_packed),
+		.wdata_packed(wdata_packed),
 		.timeout_bits(timeout_bits),
+		.osr(osr),
 		.loopback_en(loopback_en),
 		.glitch_filter_en(glitch_filter_en),
+		.majority_en(majority_en),
 		.tx_level(tx_level),
 		.rx_level(rx_level),
 		.rd(rd),
@@ -360,10 +643,43 @@ module EF_UART_APB #(
 		.txfifotr(txfifotr),
 		.rxfifotr(rxfifotr),
 		.match_data(match_data),
+		.match_mask(match_mask),
+		.addr_en(addr_en),
+		.de_en(de_en),
+		.de_lead(de_lead),
+		.de_lag(de_lag),
+		.abr_en(abr_en),
+		.coal_rx_count(coal_rx_count),
+		.coal_tx_count(coal_tx_count),
+		.coal_time(coal_time),
+		.stats_snap_wr(stats_snap_wr),
+		.stats_snap_wdata(stats_snap_wdata),
+		.sync_pattern(sync_pattern),
+		.sync_mask(sync_mask),
+		.sync_len(sync_len),
+		.sync_en(sync_en),
+		.sync_hunt(sync_hunt),
+		.crc_poly(crc_poly),
+		.crc_init(crc_init),
+		.crc_size(crc_size),
+		.crc_en(crc_en),
+		.crc_refin(crc_refin),
+		.crc_refout(crc_refout),
+		.crc_inv(crc_inv),
+		.crc_rst_wr(crc_rst_wr),
+		.crc_rst_wdata(crc_rst_wdata),
+		.frame_gap(frame_gap),
+		.frame_rd(frame_rd),
+		.usart_en(usart_en),
+		.sclk_ext(sclk_ext),
 		.tx_empty(tx_empty),
 		.tx_full(tx_full),
 		.tx_level_below(tx_level_below),
 		.rdata(rdata),
+		.rdata_packed(rdata_packed),
+		.rx_fifo_count(rx_fifo_count),
+		.tx_fifo_count(tx_fifo_count),
+		.cap(cap),
 		.rx_empty(rx_empty),
 		.rx_full(rx_full),
 		.rx_level_above(rx_level_above),
@@ -373,6 +689,42 @@ module EF_UART_APB #(
 		.parity_error_flag(parity_error_flag),
 		.overrun_flag(overrun_flag),
 		.timeout_flag(timeout_flag),
+		.tx_complete_flag(tx_complete_flag),
+		.abr_flag(abr_flag),
+		.abr_count(abr_count),
+		.coal_flag(coal_flag),
+		.noise_flag(noise_flag),
+		.sync_flag(sync_flag),
+		.frame_flag(frame_flag),
+		.frame_desc(frame_desc),
+		.stats_tx(stats_tx),
+		.stats_rx(stats_rx),
+		.stats_fe(stats_fe),
+		.stats_pe(stats_pe),
+		.stats_or(stats_or),
+		.stats_brk(stats_brk),
+		.stats_rto(stats_rto),
+		.stats_tx_max(stats_tx_max),
+		.stats_rx_max(stats_rx_max),
+		.crc_tx(crc_tx),
+		.crc_rx(crc_rx),
+		.tx_dma_en(tx_dma_en),
+		.rx_dma_en(rx_dma_en),
+		.rts_en(rts_en),
+		.cts_en(cts_en),
+		.rts_level(rts_level),
+		.tx_dma_ack(tx_dma_ack),
+		.rx_dma_ack(rx_dma_ack),
+		.tx_dma_req(tx_dma_req),
+		.tx_dma_single(tx_dma_single),
+		.rx_dma_req(rx_dma_req),
+		.rx_dma_single(rx_dma_single),
+		.rts_n(rts_n),
+		.cts_n(cts_n),
+		.de(de),
+		.sclk_in(sclk_in),
+		.sclk_out(sclk_out),
+		.sclk_oe(sclk_oe),
 		.rx(rx),
 		.tx(tx)
 	);
@@ -384,6 +736,35 @@ module EF_UART_APB #(
 			(PADDR[16-1:0] == CTRL_REG_OFFSET)	? CTRL_REG :
 			(PADDR[16-1:0] == CFG_REG_OFFSET)	? CFG_REG :
 			(PADDR[16-1:0] == MATCH_REG_OFFSET)	? MATCH_REG :
+			(PADDR[16-1:0] == STATUS_REG_OFFSET)	? STATUS_WIRE :
+			(PADDR[16-1:0] == PRF_REG_OFFSET)	? PRF_REG :
+			(PADDR[16-1:0] == CAP_REG_OFFSET)	? CAP_WIRE :
+			(PADDR[16-1:0] == TXDATA_PACKED_REG_OFFSET)	? TXDATA_PACKED_WIRE :
+			(PADDR[16-1:0] == RXDATA_PACKED_REG_OFFSET)	? RXDATA_PACKED_WIRE :
+			(PADDR[16-1:0] == RTS_REG_OFFSET)	? RTS_REG :
+			(PADDR[16-1:0] == MATCH_MASK_REG_OFFSET)	? MATCH_MASK_REG :
+			(PADDR[16-1:0] == DE_REG_OFFSET)	? DE_REG :
+			(PADDR[16-1:0] == ABR_REG_OFFSET)	? ABR_WIRE :
+			(PADDR[16-1:0] == COAL_REG_OFFSET)	? COAL_REG :
+			(PADDR[16-1:0] == COAL_TIME_REG_OFFSET)	? COAL_TIME_REG :
+			(PADDR[16-1:0] == STATS_SNAP_REG_OFFSET)	? STATS_SNAP_WIRE :
+			(PADDR[16-1:0] == STATS_TX_REG_OFFSET)	? STATS_TX_WIRE :
+			(PADDR[16-1:0] == STATS_RX_REG_OFFSET)	? STATS_RX_WIRE :
+			(PADDR[16-1:0] == STATS_FE_PE_REG_OFFSET)	? STATS_FE_PE_WIRE :
+			(PADDR[16-1:0] == STATS_OR_BRK_REG_OFFSET)	? STATS_OR_BRK_WIRE :
+			(PADDR[16-1:0] == STATS_RTO_REG_OFFSET)	? STATS_RTO_WIRE :
+			(PADDR[16-1:0] == STATS_MAX_REG_OFFSET)	? STATS_MAX_WIRE :
+			(PADDR[16-1:0] == SYNC_REG_OFFSET)	? SYNC_REG :
+			(PADDR[16-1:0] == SYNC_MASK_REG_OFFSET)	? SYNC_MASK_REG :
+			(PADDR[16-1:0] == SYNC_CTRL_REG_OFFSET)	? SYNC_CTRL_REG :
+			(PADDR[16-1:0] == CRC_POLY_REG_OFFSET)	? CRC_POLY_REG :
+			(PADDR[16-1:0] == CRC_INIT_REG_OFFSET)	? CRC_INIT_REG :
+			(PADDR[16-1:0] == CRC_CTRL_REG_OFFSET)	? CRC_CTRL_REG :
+			(PADDR[16-1:0] == CRC_RST_REG_OFFSET)	? CRC_RST_WIRE :
+			(PADDR[16-1:0] == CRC_TX_REG_OFFSET)	? CRC_TX_WIRE :
+			(PADDR[16-1:0] == CRC_RX_REG_OFFSET)	? CRC_RX_WIRE :
+			(PADDR[16-1:0] == GAP_REG_OFFSET)	? GAP_REG :
+			(PADDR[16-1:0] == FRAME_REG_OFFSET)	? FRAME_WIRE :
 			(PADDR[16-1:0] == RX_FIFO_LEVEL_REG_OFFSET)	? RX_FIFO_LEVEL_WIRE :
 			(PADDR[16-1:0] == RX_FIFO_THRESHOLD_REG_OFFSET)	? RX_FIFO_THRESHOLD_REG :
 			(PADDR[16-1:0] == RX_FIFO_FLUSH_REG_OFFSET)	? RX_FIFO_FLUSH_REG :
@@ -403,4 +784,14 @@ module EF_UART_APB #(
 	assign	rd = (apb_re & (PADDR[16-1:0] == RXDATA_REG_OFFSET));
 	assign	wdata = PWDATA;
 	assign	wr = (apb_we & (PADDR[16-1:0] == TXDATA_REG_OFFSET));
+	assign	RXDATA_PACKED_WIRE = rdata_packed;
+	assign	rd_packed = (apb_re & (PADDR[16-1:0] == RXDATA_PACKED_REG_OFFSET));
+	assign	wdata_packed = PWDATA;
+	assign	wr_packed = (apb_we & (PADDR[16-1:0] == TXDATA_PACKED_REG_OFFSET));
+	assign	stats_snap_wdata = PWDATA;
+	assign	stats_snap_wr = (apb_we & (PADDR[16-1:0] == STATS_SNAP_REG_OFFSET));
+	assign	crc_rst_wdata = PWDATA;
+	assign	crc_rst_wr = (apb_we & (PADDR[16-1:0] == CRC_RST_REG_OFFSET));
+	assign	FRAME_WIRE = frame_desc;
+	assign	frame_rd = (apb_re & (PADDR[16-1:0] == FRAME_REG_OFFSET));
 endmodule
@@ -31,7 +31,9 @@ module EF_UART_APB #(
 		SC = 8,
 		MDW = 9,
 		GFLEN = 8,
-		FAW = 4
+		FAW = 4,
+		STATS = 1,
+		CRC = 1
 ) (
 `ifdef USE_POWER_PINS
 	inout VPWR,
@@ -39,7 +41,19 @@ module EF_UART_APB #(
 `endif
 	`APB_SLAVE_PORTS,
 	input	wire	[1-1:0]	rx,
-	output	wire	[1-1:0]	tx
+	output	wire	[1-1:0]	tx,
+	output	wire	[1-1:0]	tx_dma_req,
+	output	wire	[1-1:0]	tx_dma_single,
+	input	wire	[1-1:0]	tx_dma_ack,
+	output	wire	[1-1:0]	rx_dma_req,
+	output	wire	[1-1:0]	rx_dma_single,
+	input	wire	[1-1:0]	rx_dma_ack,
+	output	wire	[1-1:0]	rts_n,
+	input	wire	[1-1:0]	cts_n,
+	output	wire	[1-1:0]	de,
+	input	wire	[1-1:0]	sclk_in,
+	output	wire	[1-1:0]	sclk_out,
+	output	wire	[1-1:0]	sclk_oe
 );
 
 	localparam	RXDATA_REG_OFFSET = `APB_AW'h0000;
@@ -48,6 +62,35 @@ module EF_UART_APB #(
 	localparam	CTRL_REG_OFFSET = `APB_AW'h000C;
 	localparam	CFG_REG_OFFSET = `APB_AW'h0010;
 	localparam	MATCH_REG_OFFSET = `APB_AW'h001C;
+	localparam	STATUS_REG_OFFSET = `APB_AW'h0020;
+	localparam	PRF_REG_OFFSET = `APB_AW'h0024;
+	localparam	CAP_REG_OFFSET = `APB_AW'h0028;
+	localparam	TXDATA_PACKED_REG_OFFSET = `APB_AW'h002C;
+	localparam	RXDATA_PACKED_REG_OFFSET = `APB_AW'h0030;
+	localparam	RTS_REG_OFFSET = `APB_AW'h0034;
+	localparam	MATCH_MASK_REG_OFFSET = `APB_AW'h0038;
+	localparam	DE_REG_OFFSET = `APB_AW'h003C;
+	localparam	ABR_REG_OFFSET = `APB_AW'h0040;
+	localparam	COAL_REG_OFFSET = `APB_AW'h0044;
+	localparam	COAL_TIME_REG_OFFSET = `APB_AW'h0048;
+	localparam	STATS_SNAP_REG_OFFSET = `APB_AW'h004C;
+	localparam	STATS_TX_REG_OFFSET = `APB_AW'h0050;
+	localparam	STATS_RX_REG_OFFSET = `APB_AW'h0054;
+	localparam	STATS_FE_PE_REG_OFFSET = `APB_AW'h0058;
+	localparam	STATS_OR_BRK_REG_OFFSET = `APB_AW'h005C;
+	localparam	STATS_RTO_REG_OFFSET = `APB_AW'h0060;
+	localparam	STATS_MAX_REG_OFFSET = `APB_AW'h0064;
+	localparam	SYNC_REG_OFFSET = `APB_AW'h0068;
+	localparam	SYNC_MASK_REG_OFFSET = `APB_AW'h006C;
+	localparam	SYNC_CTRL_REG_OFFSET = `APB_AW'h0070;
+	localparam	CRC_POLY_REG_OFFSET = `APB_AW'h0074;
+	localparam	CRC_INIT_REG_OFFSET = `APB_AW'h0078;
+	localparam	CRC_CTRL_REG_OFFSET = `APB_AW'h007C;
+	localparam	CRC_RST_REG_OFFSET = `APB_AW'h0080;
+	localparam	CRC_TX_REG_OFFSET = `APB_AW'h0084;
+	localparam	CRC_RX_REG_OFFSET = `APB_AW'h0088;
+	localparam	GAP_REG_OFFSET = `APB_AW'h008C;
+	localparam	FRAME_REG_OFFSET = `APB_AW'h0090;
 	localparam	RX_FIFO_LEVEL_REG_OFFSET = `APB_AW'hFE00;
 	localparam	RX_FIFO_THRESHOLD_REG_OFFSET = `APB_AW'hFE04;
 	localparam	RX_FIFO_FLUSH_REG_OFFSET = `APB_AW'hFE08;
@@ -79,17 +122,23 @@ module EF_UART_APB #(
 	`APB_CTRL_SIGNALS
 
 	wire [16-1:0]	prescaler;
+	wire [4-1:0]	prescaler_frac;
 	wire [1-1:0]	en;
 	wire [1-1:0]	tx_en;
 	wire [1-1:0]	rx_en;
 	wire [MDW-1:0]	wdata;
 	wire [6-1:0]	timeout_bits;
+	wire [2-1:0]	osr;
 	wire [1-1:0]	loopback_en;
 	wire [1-1:0]	glitch_filter_en;
+	wire [1-1:0]	majority_en;
 	wire [FAW-1:0]	tx_level;
 	wire [FAW-1:0]	rx_level;
 	wire [1-1:0]	rd;
 	wire [1-1:0]	wr;
+	wire [1-1:0]	rd_packed;
+	wire [1-1:0]	wr_packed;
+	wire [32-1:0]	wdata_packed;
 	wire [1-1:0]	tx_fifo_flush;
 	wire [1-1:0]	rx_fifo_flush;
 	wire [4-1:0]	data_size;
@@ -101,7 +150,11 @@ module EF_UART_APB #(
 	wire [1-1:0]	tx_empty;
 	wire [1-1:0]	tx_full;
 	wire [1-1:0]	tx_level_below;
-	wire [MDW-1:0]	rdata;
+	wire [13-1:0]	rdata;
+	wire [32-1:0]	rdata_packed;
+	wire [8-1:0]	rx_fifo_count;
+	wire [8-1:0]	tx_fifo_count;
+	wire [15-1:0]	cap;
 	wire [1-1:0]	rx_empty;
 	wire [1-1:0]	rx_full;
 	wire [1-1:0]	rx_level_above;
@@ -111,35 +164,207 @@ module EF_UART_APB #(
 	wire [1-1:0]	parity_error_flag;
 	wire [1-1:0]	overrun_flag;
 	wire [1-1:0]	timeout_flag;
+	wire [1-1:0]	tx_dma_en;
+	wire [1-1:0]	rx_dma_en;
+	wire [1-1:0]	rts_en;
+	wire [1-1:0]	cts_en;
+	wire [FAW-1:0]	rts_level;
+	wire [MDW-1:0]	match_mask;
+	wire [1-1:0]	addr_en;
+	wire [1-1:0]	de_en;
+	wire [4-1:0]	de_lead;
+	wire [4-1:0]	de_lag;
+	wire [1-1:0]	tx_complete_flag;
+	wire [1-1:0]	abr_en;
+	wire [1-1:0]	usart_en;
+	wire [1-1:0]	sclk_ext;
+	wire [24-1:0]	abr_count;
+	wire [1-1:0]	abr_flag;
+	wire [8-1:0]	coal_rx_count;
+	wire [8-1:0]	coal_tx_count;
+	wire [24-1:0]	coal_time;
+	wire [1-1:0]	coal_flag;
+	wire [1-1:0]	noise_flag;
+	wire [1-1:0]	stats_snap_wr;
+	wire [1-1:0]	stats_snap_wdata;
+	wire [32-1:0]	stats_tx;
+	wire [32-1:0]	stats_rx;
+	wire [16-1:0]	stats_fe;
+	wire [16-1:0]	stats_pe;
+	wire [16-1:0]	stats_or;
+	wire [16-1:0]	stats_brk;
+	wire [16-1:0]	stats_rto;
+	wire [8-1:0]	stats_tx_max;
+	wire [8-1:0]	stats_rx_max;
+	wire [32-1:0]	sync_pattern;
+	wire [32-1:0]	sync_mask;
+	wire [2-1:0]	sync_len;
+	wire [1-1:0]	sync_en;
+	wire [1-1:0]	sync_hunt;
+	wire [1-1:0]	sync_flag;
+	wire [32-1:0]	crc_poly;
+	wire [32-1:0]	crc_init;
+	wire [2-1:0]	crc_size;
+	wire [1-1:0]	crc_en;
+	wire [1-1:0]	crc_refin;
+	wire [1-1:0]	crc_refout;
+	wire [1-1:0]	crc_inv;
+	wire [1-1:0]	crc_rst_wr;
+	wire [2-1:0]	crc_rst_wdata;
+	wire [32-1:0]	crc_tx;
+	wire [32-1:0]	crc_rx;
+	wire [8-1:0]	frame_gap;
+	wire [1-1:0]	frame_rd;
+	wire [1-1:0]	frame_flag;
+	wire [20-1:0]	frame_desc;
 
 	// Register Definitions
-	wire	[MDW-1:0]	RXDATA_WIRE;
+	wire	[13-1:0]	RXDATA_WIRE;
 
 	wire	[MDW-1:0]	TXDATA_WIRE;
 
+	wire	[32-1:0]	TXDATA_PACKED_WIRE;
+
+	wire	[32-1:0]	RXDATA_PACKED_WIRE;
+
+	wire	[1-1:0]	STATS_SNAP_WIRE;
+
+	wire	[2-1:0]	CRC_RST_WIRE;
+
+	wire	[20-1:0]	FRAME_WIRE;
+
 	reg [15:0]	PR_REG;
 	assign	prescaler = PR_REG;
 	`APB_REG(PR_REG, 0, 16)
 
-	reg [4:0]	CTRL_REG;
+	reg [13:0]	CTRL_REG;
 	assign	en	=	CTRL_REG[0 : 0];
 	assign	tx_en	=	CTRL_REG[1 : 1];
 	assign	rx_en	=	CTRL_REG[2 : 2];
 	assign	loopback_en	=	CTRL_REG[3 : 3];
 	assign	glitch_filter_en	=	CTRL_REG[4 : 4];
-	`APB_REG(CTRL_REG, 0, 5)
-
-	reg [13:0]	CFG_REG;
+	assign	tx_dma_en	=	CTRL_REG[5 : 5];
+	assign	rx_dma_en	=	CTRL_REG[6 : 6];
+	assign	rts_en	=	CTRL_REG[7 : 7];
+	assign	cts_en	=	CTRL_REG[8 : 8];
+	assign	addr_en	=	CTRL_REG[9 : 9];
+	assign	de_en	=	CTRL_REG[10 : 10];
+	assign	abr_en	=	CTRL_REG[11 : 11];
+	assign	usart_en	=	CTRL_REG[12 : 12];
+	assign	sclk_ext	=	CTRL_REG[13 : 13];
+	`APB_REG(CTRL_REG, 0, 14)
+
+	reg [16:0]	CFG_REG;
 	assign	data_size	=	CFG_REG[3 : 0];
 	assign	stop_bits_count	=	CFG_REG[4 : 4];
 	assign	parity_type	=	CFG_REG[7 : 5];
 	assign	timeout_bits	=	CFG_REG[13 : 8];
-	`APB_REG(CFG_REG, 'h3F08, 14)
+	assign	osr	=	CFG_REG[15 : 14];
+	assign	majority_en	=	CFG_REG[16 : 16];
+	`APB_REG(CFG_REG, 'h3F08, 17)
 
 	reg [MDW-1:0]	MATCH_REG;
 	assign	match_data = MATCH_REG;
 	`APB_REG(MATCH_REG, 0, MDW)
 
+	wire [32-1:0]	STATUS_WIRE;
+	assign	STATUS_WIRE[7 : 0] = rx_fifo_count;
+	assign	STATUS_WIRE[15 : 8] = tx_fifo_count;
+	assign	STATUS_WIRE[31 : 16] = RIS_REG;
+
+	reg [3:0]	PRF_REG;
+	assign	prescaler_frac = PRF_REG;
+	`APB_REG(PRF_REG, 0, 4)
+
+	wire [15-1:0]	CAP_WIRE;
+	assign	CAP_WIRE[14 : 0] = cap;
+
+	reg [FAW-1:0]	RTS_REG;
+	assign	rts_level = RTS_REG;
+	`APB_REG(RTS_REG, 0, FAW)
+
+	reg [MDW-1:0]	MATCH_MASK_REG;
+	assign	match_mask = MATCH_MASK_REG;
+	`APB_REG(MATCH_MASK_REG, 0, MDW)
+
+	reg [7:0]	DE_REG;
+	assign	de_lead	=	DE_REG[3 : 0];
+	assign	de_lag	=	DE_REG[7 : 4];
+	`APB_REG(DE_REG, 0, 8)
+
+	wire [24-1:0]	ABR_WIRE;
+	assign	ABR_WIRE[23 : 0] = abr_count;
+
+	reg [15:0]	COAL_REG;
+	assign	coal_rx_count	=	COAL_REG[7 : 0];
+	assign	coal_tx_count	=	COAL_REG[15 : 8];
+	`APB_REG(COAL_REG, 0, 16)
+
+	reg [23:0]	COAL_TIME_REG;
+	assign	coal_time = COAL_TIME_REG;
+	`APB_REG(COAL_TIME_REG, 0, 24)
+
+	wire [32-1:0]	STATS_TX_WIRE;
+	assign	STATS_TX_WIRE[31 : 0] = stats_tx;
+
+	wire [32-1:0]	STATS_RX_WIRE;
+	assign	STATS_RX_WIRE[31 : 0] = stats_rx;
+
+	wire [32-1:0]	STATS_FE_PE_WIRE;
+	assign	STATS_FE_PE_WIRE[15 : 0] = stats_fe;
+	assign	STATS_FE_PE_WIRE[31 : 16] = stats_pe;
+
+	wire [32-1:0]	STATS_OR_BRK_WIRE;
+	assign	STATS_OR_BRK_WIRE[15 : 0] = stats_or;
+	assign	STATS_OR_BRK_WIRE[31 : 16] = stats_brk;
+
+	wire [16-1:0]	STATS_RTO_WIRE;
+	assign	STATS_RTO_WIRE[15 : 0] = stats_rto;
+
+	wire [16-1:0]	STATS_MAX_WIRE;
+	assign	STATS_MAX_WIRE[7 : 0] = stats_rx_max;
+	assign	STATS_MAX_WIRE[15 : 8] = stats_tx_max;
+
+	reg [31:0]	SYNC_REG;
+	assign	sync_pattern = SYNC_REG;
+	`APB_REG(SYNC_REG, 0, 32)
+
+	reg [31:0]	SYNC_MASK_REG;
+	assign	sync_mask = SYNC_MASK_REG;
+	`APB_REG(SYNC_MASK_REG, 0, 32)
+
+	reg [3:0]	SYNC_CTRL_REG;
+	assign	sync_len	=	SYNC_CTRL_REG[1 : 0];
+	assign	sync_en	=	SYNC_CTRL_REG[2 : 2];
+	assign	sync_hunt	=	SYNC_CTRL_REG[3 : 3];
+	`APB_REG(SYNC_CTRL_REG, 0, 4)
+
+	reg [31:0]	CRC_POLY_REG;
+	assign	crc_poly = CRC_POLY_REG;
+	`APB_REG(CRC_POLY_REG, 0, 32)
+
+	reg [31:0]	CRC_INIT_REG;
+	assign	crc_init = CRC_INIT_REG;
+	`APB_REG(CRC_INIT_REG, 0, 32)
+
+	reg [5:0]	CRC_CTRL_REG;
+	assign	crc_en	=	CRC_CTRL_REG[0 : 0];
+	assign	crc_size	=	CRC_CTRL_REG[2 : 1];
+	assign	crc_refin	=	CRC_CTRL_REG[3 : 3];
+	assign	crc_refout	=	CRC_CTRL_REG[4 : 4];
+	assign	crc_inv	=	CRC_CTRL_REG[5 : 5];
+	`APB_REG(CRC_CTRL_REG, 0, 6)
+
+	wire [32-1:0]	CRC_TX_WIRE;
+	assign	CRC_TX_WIRE[31 : 0] = crc_tx;
+
+	wire [32-1:0]	CRC_RX_WIRE;
+	assign	CRC_RX_WIRE[31 : 0] = crc_rx;
+
+	reg [7:0]	GAP_REG;
+	assign	frame_gap = GAP_REG;
+	`APB_REG(GAP_REG, 0, 8)
+
 	wire [FAW-1:0]	RX_FIFO_LEVEL_WIRE;
 	assign	RX_FIFO_LEVEL_WIRE[(FAW - 1) : 0] = rx_level;
 
@@ -165,13 +390,13 @@ module EF_UART_APB #(
 	localparam	GCLK_REG_OFFSET = `APB_AW'hFF10;
 	`APB_REG(GCLK_REG, 0, 1)
 
-	reg [9:0] IM_REG;
-	reg [9:0] IC_REG;
-	reg [9:0] RIS_REG;
+	reg [15:0] IM_REG;
+	reg [15:0] IC_REG;
+	reg [15:0] RIS_REG;
 
-	`APB_MIS_REG(10)
-	`APB_REG(IM_REG, 0, 10)
-	`APB_IC_REG(10)
+	`APB_MIS_REG(16)
+	`APB_REG(IM_REG, 0, 16)
+	`APB_IC_REG(16)
 
 	wire [0:0] TXE = tx_empty;
 	wire [0:0] RXF = rx_full;
@@ -183,6 +408,12 @@ module EF_UART_APB #(
 	wire [0:0] PRE = parity_error_flag;
 	wire [0:0] OR = overrun_flag;
 	wire [0:0] RTO = timeout_flag;
+	wire [0:0] TC = tx_complete_flag;
+	wire [0:0] ABR = abr_flag;
+	wire [0:0] COAL = coal_flag;
+	wire [0:0] NOISE = noise_flag;
+	wire [0:0] SYNC = sync_flag;
+	wire [0:0] EOF = frame_flag;
 
 
 	integer _i_;
@@ -217,6 +448,24 @@ module EF_UART_APB #(
 		for(_i_ = 9; _i_ < 10; _i_ = _i_ + 1) begin
 			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(RTO[_i_ - 9] == 1'b1) RIS_REG[_i_] <= 1'b1;
 		end
+		for(_i_ = 10; _i_ < 11; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(TC[_i_ - 10] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 11; _i_ < 12; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(ABR[_i_ - 11] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 12; _i_ < 13; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(COAL[_i_ - 12] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 13; _i_ < 14; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(NOISE[_i_ - 13] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 14; _i_ < 15; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(SYNC[_i_ - 14] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
+		for(_i_ = 15; _i_ < 16; _i_ = _i_ + 1) begin
+			if(IC_REG[_i_]) RIS_REG[_i_] <= 1'b0; else if(EOF[_i_ - 15] == 1'b1) RIS_REG[_i_] <= 1'b1;
+		end
 	end
 
 	assign IRQ = |MIS_REG;
@@ -225,18 +474,26 @@ module EF_UART_APB #(
 		.SC(SC),
 		.MDW(MDW),
 		.GFLEN(GFLEN),
-		.FAW(FAW)
+		.FAW(FAW),
+		.STATS(STATS),
+		.CRC(CRC)
 	) instance_to_wrap (
 		.clk(clk),
 		.rst_n(rst_n),
 		.prescaler(prescaler),
+		.prescaler_frac(prescaler_frac),
 		.en(en),
 		.tx_en(tx_en),
 		.rx_en(rx_en),
 		.wdata(wdata),
+		.rd_packed(rd_packed),
+		.wr_packed(wr_packed),
+		.wdata_packed(wdata_packed),
 		.timeout_bits(timeout_bits),
+		.osr(osr),
 		.loopback_en(loopback_en),
 		.glitch_filter_en(glitch_filter_en),
+		.majority_en(majority_en),
 		.tx_level(tx_level),
 		.rx_level(rx_level),
 		.rd(rd),
@@ -249,10 +506,43 @@ module EF_UART_APB #(
 		.txfifotr(txfifotr),
 		.rxfifotr(rxfifotr),
 		.match_data(match_data),
+		.match_mask(match_mask),
+		.addr_en(addr_en),
+		.de_en(de_en),
+		.de_lead(de_lead),
+		.de_lag(de_lag),
+		.abr_en(abr_en),
+		.coal_rx_count(coal_rx_count),
+		.coal_tx_count(coal_tx_count),
+		.coal_time(coal_time),
+		.stats_snap_wr(stats_snap_wr),
+		.stats_snap_wdata(stats_snap_wdata),
+		.sync_pattern(sync_pattern),
+		.sync_mask(sync_mask),
+		.sync_len(sync_len),
+		.sync_en(sync_en),
+		.sync_hunt(sync_hunt),
+		.crc_poly(crc_poly),
+		.crc_init(crc_init),
+		.crc_size(crc_size),
+		.crc_en(crc_en),
+		.crc_refin(crc_refin),
+		.crc_refout(crc_refout),
+		.crc_inv(crc_inv),
+		.crc_rst_wr(crc_rst_wr),
+		.crc_rst_wdata(crc_rst_wdata),
+		.frame_gap(frame_gap),
+		.frame_rd(frame_rd),
+		.usart_en(usart_en),
+		.sclk_ext(sclk_ext),
 		.tx_empty(tx_empty),
 		.tx_full(tx_full),
 		.tx_level_below(tx_level_below),
 		.rdata(rdata),
+		.rdata_packed(rdata_packed),
+		.rx_fifo_count(rx_fifo_count),
+		.tx_fifo_count(tx_fifo_count),
+		.cap(cap),
 		.rx_empty(rx_empty),
 		.rx_full(rx_full),
 		.rx_level_above(rx_level_above),
@@ -262,6 +552,42 @@ module EF_UART_APB #(
 		.parity_error_flag(parity_error_flag),
 		.overrun_flag(overrun_flag),
 		.timeout_flag(timeout_flag),
+		.tx_complete_flag(tx_complete_flag),
+		.abr_flag(abr_flag),
+		.abr_count(abr_count),
+		.coal_flag(coal_flag),
+		.noise_flag(noise_flag),
+		.sync_flag(sync_flag),
+		.frame_flag(frame_flag),
+		.frame_desc(frame_desc),
+		.stats_tx(stats_tx),
+		.stats_rx(stats_rx),
+		.stats_fe(stats_fe),
+		.stats_pe(stats_pe),
+		.stats_or(stats_or),
+		.stats_brk(stats_brk),
+		.stats_rto(stats_rto),
+		.stats_tx_max(stats_tx_max),
+		.stats_rx_max(stats_rx_max),
+		.crc_tx(crc_tx),
+		.crc_rx(crc_rx),
+		.tx_dma_en(tx_dma_en),
+		.rx_dma_en(rx_dma_en),
+		.rts_en(rts_en),
+		.cts_en(cts_en),
+		.rts_level(rts_level),
+		.tx_dma_ack(tx_dma_ack),
+		.rx_dma_ack(rx_dma_ack),
+		.tx_dma_req(tx_dma_req),
+		.tx_dma_single(tx_dma_single),
+		.rx_dma_req(rx_dma_req),
+		.rx_dma_single(rx_dma_single),
+		.rts_n(rts_n),
+		.cts_n(cts_n),
+		.de(de),
+		.sclk_in(sclk_in),
+		.sclk_out(sclk_out),
+		.sclk_oe(sclk_oe),
 		.rx(rx),
 		.tx(tx)
 	);
@@ -273,6 +599,35 @@ module EF_UART_APB #(
 			(PADDR[`APB_AW-1:0] == CTRL_REG_OFFSET)	? CTRL_REG :
 			(PADDR[`APB_AW-1:0] == CFG_REG_OFFSET)	? CFG_REG :
 			(PADDR[`APB_AW-1:0] == MATCH_REG_OFFSET)	? MATCH_REG :
+			(PADDR[`APB_AW-1:0] == STATUS_REG_OFFSET)	? STATUS_WIRE :
+			(PADDR[`APB_AW-1:0] == PRF_REG_OFFSET)	? PRF_REG :
+			(PADDR[`APB_AW-1:0] == CAP_REG_OFFSET)	? CAP_WIRE :
+			(PADDR[`APB_AW-1:0] == TXDATA_PACKED_REG_OFFSET)	? TXDATA_PACKED_WIRE :
+			(PADDR[`APB_AW-1:0] == RXDATA_PACKED_REG_OFFSET)	? RXDATA_PACKED_WIRE :
+			(PADDR[`APB_AW-1:0] == RTS_REG_OFFSET)	? RTS_REG :
+			(PADDR[`APB_AW-1:0] == MATCH_MASK_REG_OFFSET)	? MATCH_MASK_REG :
+			(PADDR[`APB_AW-1:0] == DE_REG_OFFSET)	? DE_REG :
+			(PADDR[`APB_AW-1:0] == ABR_REG_OFFSET)	? ABR_WIRE :
+			(PADDR[`APB_AW-1:0] == COAL_REG_OFFSET)	? COAL_REG :
+			(PADDR[`APB_AW-1:0] == COAL_TIME_REG_OFFSET)	? COAL_TIME_REG :
+			(PADDR[`APB_AW-1:0] == STATS_SNAP_REG_OFFSET)	? STATS_SNAP_WIRE :
+			(PADDR[`APB_AW-1:0] == STATS_TX_REG_OFFSET)	? STATS_TX_WIRE :
+			(PADDR[`APB_AW-1:0] == STATS_RX_REG_OFFSET)	? STATS_RX_WIRE :
+			(PADDR[`APB_AW-1:0] == STATS_FE_PE_REG_OFFSET)	? STATS_FE_PE_WIRE :
+			(PADDR[`APB_AW-1:0] == STATS_OR_BRK_REG_OFFSET)	? STATS_OR_BRK_WIRE :
+			(PADDR[`APB_AW-1:0] == STATS_RTO_REG_OFFSET)	? STATS_RTO_WIRE :
+			(PADDR[`APB_AW-1:0] == STATS_MAX_REG_OFFSET)	? STATS_MAX_WIRE :
+			(PADDR[`APB_AW-1:0] == SYNC_REG_OFFSET)	? SYNC_REG :
+			(PADDR[`APB_AW-1:0] == SYNC_MASK_REG_OFFSET)	? SYNC_MASK_REG :
+			(PADDR[`APB_AW-1:0] == SYNC_CTRL_REG_OFFSET)	? SYNC_CTRL_REG :
+			(PADDR[`APB_AW-1:0] == CRC_POLY_REG_OFFSET)	? CRC_POLY_REG :
+			(PADDR[`APB_AW-1:0] == CRC_INIT_REG_OFFSET)	? CRC_INIT_REG :
+			(PADDR[`APB_AW-1:0] == CRC_CTRL_REG_OFFSET)	? CRC_CTRL_REG :
+			(PADDR[`APB_AW-1:0] == CRC_RST_REG_OFFSET)	? CRC_RST_WIRE :
+			(PADDR[`APB_AW-1:0] == CRC_TX_REG_OFFSET)	? CRC_TX_WIRE :
+			(PADDR[`APB_AW-1:0] == CRC_RX_REG_OFFSET)	? CRC_RX_WIRE :
+			(PADDR[`APB_AW-1:0] == GAP_REG_OFFSET)	? GAP_REG :
+			(PADDR[`APB_AW-1:0] == FRAME_REG_OFFSET)	? FRAME_WIRE :
 			(PADDR[`APB_AW-1:0] == RX_FIFO_LEVEL_REG_OFFSET)	? RX_FIFO_LEVEL_WIRE :
 			(PADDR[`APB_AW-1:0] == RX_FIFO_THRESHOLD_REG_OFFSET)	? RX_FIFO_THRESHOLD_REG :
 			(PADDR[`APB_AW-1:0] == RX_FIFO_FLUSH_REG_OFFSET)	? RX_FIFO_FLUSH_REG :
@@ -292,4 +647,14 @@ module EF_UART_APB #(
 	assign	rd = (apb_re & (PADDR[`APB_AW-1:0] == RXDATA_REG_OFFSET));
 	assign	wdata = PWDATA;
 	assign	wr = (apb_we & (PADDR[`APB_AW-1:0] == TXDATA_REG_OFFSET));
+	assign	RXDATA_PACKED_WIRE = rdata_packed;
+	assign	rd_packed = (apb_re & (PADDR[`APB_AW-1:0] == RXDATA_PACKED_REG_OFFSET));
+	assign	wdata_packed = PWDATA;
+	assign	wr_packed = (apb_we & (PADDR[`APB_AW-1:0] == TXDATA_PACKED_REG_OFFSET));
+	assign	stats_snap_wdata = PWDATA;
+	assign	stats_snap_wr = (apb_we & (PADDR[`APB_AW-1:0] == STATS_SNAP_REG_OFFSET));
+	assign	crc_rst_wdata = PWDATA;
+	assign	crc_rst_wr = (apb_we & (PADDR[`APB_AW-1:0] == CRC_RST_REG_OFFSET));
+	assign	FRAME_WIRE = frame_desc;
+	assign	frame_rd = (apb_re & (PADDR[`APB_AW-1:0] == FRAME_REG_OFFSET));
 endmodule
@@ -0,0 +1,134 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+/*
+    EF_UART_MULTI_AHBL: CH UART channels behind one AHBL slave and one IRQ line
+
+    - Channel i has the register map of EF_UART_AHBL in the 64 KB window at i * 0x10000
+    - IRQ_SUMMARY at offset 0xFF20 of every window has one bit per channel, set while the IRQ of the channel is
+      high, so one read tells the interrupt handler which channels to service instead of one MIS read per channel
+    - IRQ is the OR of the channel IRQs
+    - EF_UART_MULTI holds the registers and the cores: one address decoder and one read multiplexer for all the
+      channels, and per channel only the register bank, the clock gate and the EF_UART core
+*/
+
+`timescale			1ns/1ps
+`default_nettype	none
+
+module EF_UART_MULTI_AHBL #(
+	parameter
+		CH = 8,             // Number of channels, 1 to 32
+		SC = 8,
+		MDW = 9,
+		GFLEN = 8,
+		FAW = 4,
+		STATS = 1,
+		CRC = 1
+) (
+`ifdef USE_POWER_PINS
+	inout VPWR,
+	inout VGND,
+`endif
+	input	wire			HCLK,
+	input	wire			HRESETn,
+	input	wire			HWRITE,
+	input	wire	[31:0]		HWDATA,
+	input	wire	[31:0]		HADDR,
+	input	wire	[1:0]		HTRANS,
+	input	wire			HSEL,
+	input	wire			HREADY,
+	output	wire			HREADYOUT,
+	output	wire	[31:0]		HRDATA,
+	output	wire			IRQ,
+	input	wire	[CH-1:0]	rx,
+	output	wire	[CH-1:0]	tx,
+	output	wire	[CH-1:0]	tx_dma_req,
+	output	wire	[CH-1:0]	tx_dma_single,
+	input	wire	[CH-1:0]	tx_dma_ack,
+	output	wire	[CH-1:0]	rx_dma_req,
+	output	wire	[CH-1:0]	rx_dma_single,
+	input	wire	[CH-1:0]	rx_dma_ack,
+	output	wire	[CH-1:0]	rts_n,
+	input	wire	[CH-1:0]	cts_n,
+	output	wire	[CH-1:0]	de,
+	input	wire	[CH-1:0]	sclk_in,
+	output	wire	[CH-1:0]	sclk_out,
+	output	wire	[CH-1:0]	sclk_oe
+);
+
+	reg		last_HSEL, last_HWRITE;
+	reg	[31:0]	last_HADDR;
+	reg	[1:0]	last_HTRANS;
+
+	always @(posedge HCLK or negedge HRESETn)
+		if(~HRESETn) begin
+			last_HSEL <= 1'b0;
+			last_HADDR <= 32'b0;
+			last_HWRITE <= 1'b0;
+			last_HTRANS <= 2'b0;
+		end else if(HREADY) begin
+			last_HSEL <= HSEL;
+			last_HADDR <= HADDR;
+			last_HWRITE <= HWRITE;
+			last_HTRANS <= HTRANS;
+		end
+
+	wire	ahbl_valid = last_HSEL & last_HTRANS[1];
+	wire	ahbl_we = last_HWRITE & ahbl_valid;
+	wire	ahbl_re = ~last_HWRITE & ahbl_valid;
+
+	EF_UART_MULTI #(
+		.CH(CH),
+		.SC(SC),
+		.MDW(MDW),
+		.GFLEN(GFLEN),
+		.FAW(FAW),
+		.STATS(STATS),
+		.CRC(CRC)
+	) channels (
+	`ifdef USE_POWER_PINS
+		.VPWR(VPWR),
+		.VGND(VGND),
+	`endif
+		.clk(HCLK),
+		.rst_n(HRESETn),
+		.bus_we(ahbl_we),
+		.bus_re(ahbl_re),
+		.bus_strobe(1'b1),
+		.bus_addr(last_HADDR),
+		.bus_wdata(HWDATA),
+		.bus_rdata(HRDATA),
+		.irq(IRQ),
+		.rx(rx),
+		.tx(tx),
+		.tx_dma_req(tx_dma_req),
+		.tx_dma_single(tx_dma_single),
+		.tx_dma_ack(tx_dma_ack),
+		.rx_dma_req(rx_dma_req),
+		.rx_dma_single(rx_dma_single),
+		.rx_dma_ack(rx_dma_ack),
+		.rts_n(rts_n),
+		.cts_n(cts_n),
+		.de(de),
+		.sclk_in(sclk_in),
+		.sclk_out(sclk_out),
+		.sclk_oe(sclk_oe)
+	);
+
+	assign	HREADYOUT = 1'b1;
+
+endmodule
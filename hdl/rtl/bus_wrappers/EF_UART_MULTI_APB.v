@@ -0,0 +1,116 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+/*
+    EF_UART_MULTI_APB: CH UART channels behind one APB slave and one IRQ line
+
+    - Channel i has the register map of EF_UART_APB in the 64 KB window at i * 0x10000
+    - IRQ_SUMMARY at offset 0xFF20 of every window has one bit per channel, set while the IRQ of the channel is
+      high, so one read tells the interrupt handler which channels to service instead of one MIS read per channel
+    - IRQ is the OR of the channel IRQs
+    - EF_UART_MULTI holds the registers and the cores: one address decoder and one read multiplexer for all the
+      channels, and per channel only the register bank, the clock gate and the EF_UART core
+*/
+
+`timescale			1ns/1ps
+`default_nettype	none
+
+module EF_UART_MULTI_APB #(
+	parameter
+		CH = 8,             // Number of channels, 1 to 32
+		SC = 8,
+		MDW = 9,
+		GFLEN = 8,
+		FAW = 4,
+		STATS = 1,
+		CRC = 1
+) (
+`ifdef USE_POWER_PINS
+	inout VPWR,
+	inout VGND,
+`endif
+	input	wire			PCLK,
+	input	wire			PRESETn,
+	input	wire			PWRITE,
+	input	wire	[31:0]		PWDATA,
+	input	wire	[31:0]		PADDR,
+	input	wire			PENABLE,
+	input	wire			PSEL,
+	output	wire			PREADY,
+	output	wire	[31:0]		PRDATA,
+	output	wire			IRQ,
+	input	wire	[CH-1:0]	rx,
+	output	wire	[CH-1:0]	tx,
+	output	wire	[CH-1:0]	tx_dma_req,
+	output	wire	[CH-1:0]	tx_dma_single,
+	input	wire	[CH-1:0]	tx_dma_ack,
+	output	wire	[CH-1:0]	rx_dma_req,
+	output	wire	[CH-1:0]	rx_dma_single,
+	input	wire	[CH-1:0]	rx_dma_ack,
+	output	wire	[CH-1:0]	rts_n,
+	input	wire	[CH-1:0]	cts_n,
+	output	wire	[CH-1:0]	de,
+	input	wire	[CH-1:0]	sclk_in,
+	output	wire	[CH-1:0]	sclk_out,
+	output	wire	[CH-1:0]	sclk_oe
+);
+
+	wire	apb_valid = PSEL & PENABLE;
+	wire	apb_we = PWRITE & apb_valid;
+	wire	apb_re = ~PWRITE & apb_valid;
+
+	EF_UART_MULTI #(
+		.CH(CH),
+		.SC(SC),
+		.MDW(MDW),
+		.GFLEN(GFLEN),
+		.FAW(FAW),
+		.STATS(STATS),
+		.CRC(CRC)
+	) channels (
+	`ifdef USE_POWER_PINS
+		.VPWR(VPWR),
+		.VGND(VGND),
+	`endif
+		.clk(PCLK),
+		.rst_n(PRESETn),
+		.bus_we(apb_we),
+		.bus_re(apb_re),
+		.bus_strobe(1'b1),
+		.bus_addr(PADDR),
+		.bus_wdata(PWDATA),
+		.bus_rdata(PRDATA),
+		.irq(IRQ),
+		.rx(rx),
+		.tx(tx),
+		.tx_dma_req(tx_dma_req),
+		.tx_dma_single(tx_dma_single),
+		.tx_dma_ack(tx_dma_ack),
+		.rx_dma_req(rx_dma_req),
+		.rx_dma_single(rx_dma_single),
+		.rx_dma_ack(rx_dma_ack),
+		.rts_n(rts_n),
+		.cts_n(cts_n),
+		.de(de),
+		.sclk_in(sclk_in),
+		.sclk_out(sclk_out),
+		.sclk_oe(sclk_oe)
+	);
+
+	assign	PREADY = 1'b1;
+
+endmodule
@@ -0,0 +1,502 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file EF_UART_cosim.cpp
+    \brief Bus functional models of APB, AHB-Lite and Wishbone driving the Verilated EF_UART bus wrappers.
+
+*/
+
+#include <EF_UART_cosim.h>
+#include <verilated.h>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(EF_UART_COSIM_AHBL)
+#include "VEF_UART_AHBL.h"
+typedef VEF_UART_AHBL EF_UART_Top;
+#elif defined(EF_UART_COSIM_WB)
+#include "VEF_UART_WB.h"
+typedef VEF_UART_WB EF_UART_Top;
+#else
+#include "VEF_UART_APB.h"
+typedef VEF_UART_APB EF_UART_Top;
+#endif
+
+class EF_UART_Cosim_Model {
+public:
+    VerilatedContext context;
+    EF_UART_Top top;
+
+    EF_UART_Cosim_Model() : top(&context) {}
+    ~EF_UART_Cosim_Model() { top.final(); }
+};
+
+EF_UART_Cosim ef_uart_cosim0;
+
+
+//
+//   Register cells
+//
+
+static uint32_t ef_uart_cosim_offset(const void *cell){
+
+    const char *address = static_cast<const char *>(cell);
+    const char *base = reinterpret_cast<const char *>(&ef_uart_cosim0.regs);
+    if ((address < base) || (address >= base + sizeof(EF_UART_REGS))){
+        fprintf(stderr, "EF_UART_Cosim: access to %p is outside of the register space\n", cell);
+        abort();
+    }
+    return static_cast<uint32_t>(address - base);
+}
+
+ef_uart_cosim_reg::operator uint32_t() const{
+
+    return ef_uart_cosim0.bus_read(ef_uart_cosim_offset(this));
+}
+
+ef_uart_cosim_reg &ef_uart_cosim_reg::operator=(uint32_t value){
+
+    ef_uart_cosim0.bus_write(ef_uart_cosim_offset(this), value);
+    return *this;
+}
+
+
+//
+//   Software UART peer
+//
+
+EF_UART_Peer::EF_UART_Peer(){
+
+    reset(8);
+}
+
+void EF_UART_Peer::reset(uint32_t cycles_per_bit){
+
+    bit_cycles = cycles_per_bit;
+    to_send.clear();
+    received.clear();
+    received_at.clear();
+    paused = false;
+    tx_bit = -1;
+    tx_count = 0;
+    tx_frame = 0;
+    rx_bit = -1;
+    rx_count = 0;
+    rx_frame = 0;
+}
+
+bool EF_UART_Peer::idle() const{
+
+    return to_send.empty() && (tx_bit < 0) && (rx_bit < 0);
+}
+
+bool EF_UART_Peer::step(bool tx, uint64_t cycle){
+
+    // receiver: sample the middle of every bit after the falling edge of the start bit
+    if (rx_bit < 0){
+        if (!tx){
+            rx_bit = 0;
+            rx_count = 0;
+            rx_frame = 0;
+        }
+    } else if (++rx_count == rx_bit * bit_cycles + bit_cycles / 2){
+        rx_frame |= (tx ? 1 : 0) << rx_bit;
+        if ((rx_bit == 0) && tx)
+            rx_bit = -1;                    // glitch, not a start bit
+        else if (++rx_bit == 10){
+            received.push_back((rx_frame >> 1) & 0xFF);
+            received_at.push_back(cycle);
+            rx_bit = -1;
+        }
+    }
+
+    // transmitter: start bit, 8 data bits LSB first, stop bit
+    if ((tx_bit < 0) && !to_send.empty() && !paused){
+        tx_frame = (1 << 9) | (to_send.front() << 1);
+        to_send.pop_front();
+        tx_bit = 0;
+        tx_count = 0;
+    }
+    if (tx_bit < 0)
+        return true;
+    bool level = (tx_frame >> tx_bit) & 1;
+    if (++tx_count == bit_cycles){
+        tx_count = 0;
+        if (++tx_bit == 10)
+            tx_bit = -1;
+    }
+    return level;
+}
+
+
+//
+//   Bus wrapper
+//
+
+EF_UART_Cosim::EF_UART_Cosim() : model(new EF_UART_Cosim_Model){
+
+    loopback = false;
+    irq_handler = nullptr;
+    dma = nullptr;
+    irq_entry_cycles = 12;
+    reset();
+}
+
+EF_UART_Cosim::~EF_UART_Cosim(){
+
+    delete model;
+}
+
+const char *EF_UART_Cosim::bus_name() const{
+
+#if defined(EF_UART_COSIM_AHBL)
+    return "AHBL";
+#elif defined(EF_UART_COSIM_WB)
+    return "WB";
+#else
+    return "APB";
+#endif
+}
+
+// One rising edge of the bus clock; the inputs set before the call are sampled by it
+void EF_UART_Cosim::tick(){
+
+    EF_UART_Top &top = model->top;
+
+#if defined(EF_UART_COSIM_AHBL)
+    top.HCLK = 0;
+    top.eval();
+    top.HCLK = 1;
+    top.eval();
+#elif defined(EF_UART_COSIM_WB)
+    top.clk_i = 0;
+    top.ext_clk = 0;
+    top.eval();
+    top.clk_i = 1;
+    top.ext_clk = 1;
+    top.eval();
+#else
+    top.PCLK = 0;
+    top.eval();
+    top.PCLK = 1;
+    top.eval();
+#endif
+    cycle++;
+    model->context.timeInc(1);
+
+    bool tx = top.tx;
+    peer.paused = top.rts_n;
+    bool rx = peer.step(tx, cycle);
+    top.rx = loopback ? tx : rx;
+    top.eval();
+
+    bool level = top.IRQ;
+    if (level && !irq_last)
+        irq_rise = cycle;
+    if (!level && irq_last)
+        irq_latency.push_back(cycle - irq_rise);
+    irq_last = level;
+}
+
+void EF_UART_Cosim::reset(){
+
+    EF_UART_Top &top = model->top;
+
+    cycle = 0;
+    bus_reads = 0;
+    bus_writes = 0;
+    bus_busy = 0;
+    in_handler = false;
+    in_dma = false;
+    dma_accesses = 0;
+    irq_last = false;
+    irq_rise = 0;
+    irq_latency.clear();
+    peer.reset(peer.bit_cycles);
+
+    top.rx = 1;
+    top.tx_dma_ack = 0;
+    top.rx_dma_ack = 0;
+    top.cts_n = 0;
+#if defined(EF_UART_COSIM_AHBL)
+    top.HSEL = 0;
+    top.HTRANS = 0;
+    top.HREADY = 1;
+    top.HRESETn = 0;
+    for (int i = 0; i < 4; i++)
+        tick();
+    top.HRESETn = 1;
+#elif defined(EF_UART_COSIM_WB)
+    top.cyc_i = 0;
+    top.stb_i = 0;
+    top.we_i = 0;
+    top.sel_i = 0;
+    top.rst_i = 1;
+    for (int i = 0; i < 4; i++)
+        tick();
+    top.rst_i = 0;
+#else
+    top.PSEL = 0;
+    top.PENABLE = 0;
+    top.PRESETn = 0;
+    for (int i = 0; i < 4; i++)
+        tick();
+    top.PRESETn = 1;
+#endif
+    tick();
+    cycle = 0;
+}
+
+uint32_t EF_UART_Cosim::bus_read(uint32_t offset){
+
+    EF_UART_Top &top = model->top;
+    uint64_t start = cycle;
+    uint32_t data;
+
+#if defined(EF_UART_COSIM_AHBL)
+    // address phase, then the data phase; HRDATA is valid before the edge that ends it
+    top.HSEL = 1;
+    top.HTRANS = 2;
+    top.HWRITE = 0;
+    top.HADDR = offset;
+    tick();
+    top.HSEL = 0;
+    top.HTRANS = 0;
+    top.eval();
+    while (!top.HREADYOUT)
+        tick();
+    data = top.HRDATA;
+    tick();
+#elif defined(EF_UART_COSIM_WB)
+    top.cyc_i = 1;
+    top.stb_i = 1;
+    top.we_i = 0;
+    top.sel_i = 0xF;
+    top.adr_i = offset;
+    do {
+        tick();
+    } while (!top.ack_o);
+    data = top.dat_o;
+    tick();
+    top.cyc_i = 0;
+    top.stb_i = 0;
+#else
+    // setup phase, then access phases until PREADY
+    top.PSEL = 1;
+    top.PENABLE = 0;
+    top.PWRITE = 0;
+    top.PADDR = offset;
+    tick();
+    top.PENABLE = 1;
+    top.eval();
+    while (!top.PREADY)
+        tick();
+    data = top.PRDATA;
+    tick();
+    top.PSEL = 0;
+    top.PENABLE = 0;
+#endif
+    top.eval();
+    if (in_dma){
+        dma_accesses++;
+        return data;
+    }
+    bus_reads++;
+    bus_busy += cycle - start;
+    return data;
+}
+
+void EF_UART_Cosim::bus_write(uint32_t offset, uint32_t value){
+
+    EF_UART_Top &top = model->top;
+    uint64_t start = cycle;
+
+#if defined(EF_UART_COSIM_AHBL)
+    top.HSEL = 1;
+    top.HTRANS = 2;
+    top.HWRITE = 1;
+    top.HADDR = offset;
+    tick();
+    top.HSEL = 0;
+    top.HTRANS = 0;
+    top.HWDATA = value;
+    top.eval();
+    while (!top.HREADYOUT)
+        tick();
+    tick();
+#elif defined(EF_UART_COSIM_WB)
+    top.cyc_i = 1;
+    top.stb_i = 1;
+    top.we_i = 1;
+    top.sel_i = 0xF;
+    top.adr_i = offset;
+    top.dat_i = value;
+    do {
+        tick();
+    } while (!top.ack_o);
+    tick();
+    top.cyc_i = 0;
+    top.stb_i = 0;
+#else
+    top.PSEL = 1;
+    top.PENABLE = 0;
+    top.PWRITE = 1;
+    top.PADDR = offset;
+    top.PWDATA = value;
+    tick();
+    top.PENABLE = 1;
+    top.eval();
+    while (!top.PREADY)
+        tick();
+    tick();
+    top.PSEL = 0;
+    top.PENABLE = 0;
+#endif
+    top.eval();
+    if (in_dma){
+        dma_accesses++;
+        return;
+    }
+    bus_writes++;
+    bus_busy += cycle - start;
+}
+
+bool EF_UART_Cosim::irq() const{
+
+    return model->top.IRQ;
+}
+
+bool EF_UART_Cosim::dma_request(enum dma_direction direction, bool single) const{
+
+    EF_UART_Top &top = model->top;
+    if (direction == DMA_TX)
+        return single ? top.tx_dma_single : top.tx_dma_req;
+    return single ? top.rx_dma_single : top.rx_dma_req;
+}
+
+// Acknowledges the request that was just served with a one cycle pulse
+void EF_UART_Cosim::dma_ack(enum dma_direction direction){
+
+    EF_UART_Top &top = model->top;
+    if (direction == DMA_TX)
+        top.tx_dma_ack = 1;
+    else
+        top.rx_dma_ack = 1;
+    tick();
+    top.tx_dma_ack = 0;
+    top.rx_dma_ack = 0;
+    top.eval();
+}
+
+// A bus transfer of the DMA controller; it is not charged to the CPU
+uint32_t EF_UART_Cosim::dma_transfer(enum dma_direction direction, uint32_t offset, uint32_t value){
+
+    in_dma = true;
+    if (direction == DMA_TX)
+        bus_write(offset, value);
+    else
+        value = bus_read(offset);
+    in_dma = false;
+    return value;
+}
+
+// Lets the CPU idle; the DMA controller owns the bus meanwhile and the interrupt handler runs whenever IRQ is high
+void EF_UART_Cosim::advance(uint64_t cycles){
+
+    uint64_t end = cycle + cycles;
+    while (cycle < end){
+        tick();
+        if ((dma != nullptr) && !in_handler)
+            dma->serve();
+        if ((irq_handler != nullptr) && !in_handler && irq()){
+            in_handler = true;
+            for (uint32_t i = 0; i < irq_entry_cycles; i++)
+                tick();
+            irq_handler();
+            in_handler = false;
+        }
+    }
+}
+
+
+//
+//   DMA controller
+//
+
+EF_UART_Cosim_DMA::EF_UART_Cosim_DMA(EF_UART_Cosim &cosim) : requests(0), uart(cosim){
+
+    controller.start = start;
+    controller.remaining = remaining;
+    controller.stop = stop;
+    controller.context = this;
+    channels[DMA_TX] = {};
+    channels[DMA_RX] = {};
+    uart.dma = this;
+}
+
+EF_UART_Cosim_DMA::~EF_UART_Cosim_DMA(){
+
+    uart.dma = nullptr;
+}
+
+bool EF_UART_Cosim_DMA::start(void *context, enum dma_direction direction, uintptr_t data_register, uintptr_t memory, uint32_t length, uint32_t burst){
+
+    EF_UART_Cosim_DMA *dma = static_cast<EF_UART_Cosim_DMA *>(context);
+    uint32_t offset = ef_uart_cosim_offset(reinterpret_cast<const void *>(data_register));
+    if (dma->channels[direction].active)
+        return false;
+    dma->channels[direction] = {true, offset, reinterpret_cast<uint8_t *>(memory), length, 0, burst};
+    return true;
+}
+
+uint32_t EF_UART_Cosim_DMA::remaining(void *context, enum dma_direction direction){
+
+    const channel &ch = static_cast<EF_UART_Cosim_DMA *>(context)->channels[direction];
+    return ch.length - ch.done;
+}
+
+void EF_UART_Cosim_DMA::stop(void *context, enum dma_direction direction){
+
+    static_cast<EF_UART_Cosim_DMA *>(context)->channels[direction].active = false;
+}
+
+void EF_UART_Cosim_DMA::serve(){
+
+    for (int d = DMA_TX; d <= DMA_RX; d++){
+        enum dma_direction direction = static_cast<enum dma_direction>(d);
+        channel &ch = channels[direction];
+        if (!ch.active || (ch.done == ch.length))
+            continue;
+
+        // bursts while a whole burst is left, single transfers for the tail
+        bool tail = (ch.length - ch.done) < ch.burst;
+        if (!uart.dma_request(direction, tail))
+            continue;
+        uint32_t count = tail ? 1 : ch.burst;
+        for (uint32_t i = 0; i < count; i++, ch.done++){
+            if (direction == DMA_TX)
+                uart.dma_transfer(direction, ch.offset, ch.memory[ch.done]);
+            else
+                ch.memory[ch.done] = uart.dma_transfer(direction, ch.offset, 0);
+        }
+        uart.dma_ack(direction);
+        requests++;
+        if (ch.done == ch.length)
+            ch.active = false;
+    }
+}
@@ -0,0 +1,180 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file EF_UART_cosim.h
+    \brief Runs the firmware driver against the Verilated RTL of the EF_UART bus wrappers.
+
+    Like verify/fw/EF_UART_mock.h, the header overrides the IO_TYPES of EF_UART_regs.h with a C++ register
+    cell. Here every read and write of EF_UART_REGS becomes a bus transaction on the Verilated
+    EF_UART_APB, EF_UART_AHBL or EF_UART_WB model, selected at build time with EF_UART_COSIM_APB,
+    EF_UART_COSIM_AHBL or EF_UART_COSIM_WB. It has to be included before EF_UART.h.
+*/
+
+#ifndef EF_UART_COSIM_H
+#define EF_UART_COSIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+#include <vector>
+
+/**
+ * @brief A 32-bit register cell; reads and writes become bus transactions of \ref ef_uart_cosim0
+ */
+class ef_uart_cosim_reg {
+public:
+    operator uint32_t() const;
+    ef_uart_cosim_reg &operator=(uint32_t value);
+    ef_uart_cosim_reg &operator|=(uint32_t value) { return *this = static_cast<uint32_t>(*this) | value; }
+    ef_uart_cosim_reg &operator&=(uint32_t value) { return *this = static_cast<uint32_t>(*this) & value; }
+    ef_uart_cosim_reg &operator^=(uint32_t value) { return *this = static_cast<uint32_t>(*this) ^ value; }
+
+private:
+    uint32_t storage;       // keeps the cell 32 bits wide so that the offsets match the hardware
+};
+
+#define IO_TYPES
+#define   __R     ef_uart_cosim_reg
+#define   __W     ef_uart_cosim_reg
+#define   __RW    ef_uart_cosim_reg
+
+class EF_UART_Cosim;
+extern EF_UART_Cosim ef_uart_cosim0;
+
+#define EF_UART_REG_SPACE (ef_uart_cosim_regs(&ef_uart_cosim0))
+
+#include <EF_UART.h>
+
+class EF_UART_Cosim_Model;
+class EF_UART_Cosim_DMA;
+
+/**
+ * @brief Software UART on the other end of the line
+ *
+ * Sends the queued bytes on the rx pin of the IP and collects what the IP transmits on its tx pin,
+ * 8 data bits, no parity, one stop bit, at \ref bit_cycles clock cycles per bit.
+ */
+class EF_UART_Peer {
+public:
+    uint32_t bit_cycles;                    ///< Clock cycles per bit; (PR+1)*SC to match the IP.
+    std::deque<uint8_t> to_send;            ///< Bytes waiting to be sent to the IP.
+    std::vector<uint8_t> received;          ///< Bytes received from the IP, in order.
+    std::vector<uint64_t> received_at;      ///< Cycle at which each byte of received ended.
+    bool paused;                            ///< The rts_n pin of the IP; no byte is started while it is high.
+
+    EF_UART_Peer();
+    void reset(uint32_t cycles_per_bit);
+    bool step(bool tx, uint64_t cycle);     ///< Advances one clock cycle; returns the level to drive on the rx pin.
+    bool idle() const;
+
+private:
+    int tx_bit;                             // bit being sent, -1 when idle
+    uint32_t tx_count;
+    uint16_t tx_frame;
+    int rx_bit;                             // bit being received, -1 when waiting for a start bit
+    uint32_t rx_count;
+    uint16_t rx_frame;
+};
+
+/**
+ * @brief One Verilated bus wrapper, clocked by the register accesses of the driver
+ *
+ * Time is counted in bus clock cycles. Register accesses take as many cycles as the bus protocol
+ * needs, and \ref advance lets time pass while the CPU does something else. When \ref loopback is set,
+ * the tx pin is wired back to the rx pin; otherwise \ref peer is on the line.
+ */
+class EF_UART_Cosim {
+public:
+    EF_UART_REGS regs;                      ///< Register space handed to the driver.
+
+    uint64_t cycle;                         ///< Current time in bus clock cycles.
+    uint64_t bus_reads;                     ///< Number of register reads issued by the driver.
+    uint64_t bus_writes;                    ///< Number of register writes issued by the driver.
+    uint64_t bus_busy;                      ///< Cycles spent in bus transactions.
+    bool loopback;                          ///< Wire tx back to rx outside of the IP.
+    EF_UART_Peer peer;                      ///< The other end of the line when loopback is not set.
+
+    void (*irq_handler)(void);              ///< Called from \ref advance while IRQ is high.
+    uint32_t irq_entry_cycles;              ///< Cycles from IRQ to the first instruction of the handler.
+    std::vector<uint64_t> irq_latency;      ///< Cycles from every rising edge of IRQ until it was low again.
+    EF_UART_Cosim_DMA *dma;                 ///< DMA controller on the handshake lines, served from \ref advance; nullptr when none.
+    uint64_t dma_accesses;                  ///< Register accesses made by the DMA controller; not counted in bus_reads, bus_writes or bus_busy.
+
+    EF_UART_Cosim();
+    ~EF_UART_Cosim();
+
+    void reset();
+    const char *bus_name() const;
+
+    uint32_t bus_read(uint32_t offset);
+    void bus_write(uint32_t offset, uint32_t value);
+
+    void advance(uint64_t cycles);
+    bool irq() const;
+
+    bool dma_request(enum dma_direction direction, bool single) const;
+    void dma_ack(enum dma_direction direction);
+    uint32_t dma_transfer(enum dma_direction direction, uint32_t offset, uint32_t value);
+
+private:
+    EF_UART_Cosim_Model *model;
+    bool in_handler;
+    bool in_dma;
+    bool irq_last;
+    uint64_t irq_rise;
+
+    void tick();
+};
+
+/**
+ * @brief Behavioural DMA controller on the tx_dma_* and rx_dma_* lines of the Verilated wrapper
+ *
+ * While the CPU idles in \ref EF_UART_Cosim::advance, a channel answers a burst request with a burst of bus transfers
+ * and, once fewer than a burst are left, a single request with one, then pulses ack for a cycle.
+ */
+class EF_UART_Cosim_DMA {
+public:
+    EF_UART_DMA_CONTROLLER controller;      ///< Handed to EF_UART_initDMA.
+    uint64_t requests;                      ///< Requests served, i.e. ack pulses.
+
+    explicit EF_UART_Cosim_DMA(EF_UART_Cosim &cosim);
+    ~EF_UART_Cosim_DMA();
+
+    void serve();                           ///< Serves at most one pending request per direction.
+
+private:
+    struct channel {
+        bool active;
+        uint32_t offset;                    // of TXDATA or RXDATA
+        uint8_t *memory;
+        uint32_t length;
+        uint32_t done;
+        uint32_t burst;
+    };
+
+    EF_UART_Cosim &uart;
+    channel channels[2];
+
+    static bool start(void *context, enum dma_direction direction, uintptr_t data_register, uintptr_t memory, uint32_t length, uint32_t burst);
+    static uint32_t remaining(void *context, enum dma_direction direction);
+    static void stop(void *context, enum dma_direction direction);
+};
+
+static inline EF_UART_REGS *ef_uart_cosim_regs(EF_UART_Cosim *cosim) { return &cosim->regs; }
+
+#endif // EF_UART_COSIM_H
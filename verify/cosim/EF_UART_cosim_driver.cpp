@@ -0,0 +1,27 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file EF_UART_cosim_driver.cpp
+    \brief Builds fw/EF_UART.c as C++ with its register accesses going through the co-simulation.
+
+    The Verilator generated makefile compiles the --exe sources as C++; this unit stands in for the
+    -x c++ -include EF_UART_mock.h of verify/fw/Makefile.
+*/
+
+#include <EF_UART_cosim.h>
+#include <EF_UART.c>
@@ -0,0 +1,254 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file bench_EF_UART_cosim.cpp
+    \brief Measures the driver APIs against the RTL: throughput, bus cycles per byte and interrupt service latency.
+
+    The driver runs on the host and every register access is a bus transaction on the Verilated bus wrapper,
+    so the bus cycles are those of the real hardware. CPU cycles spent between the accesses are not modelled.
+    Bytes per second assume a bus clock of EF_UART_COSIM_CLK_HZ.
+*/
+
+#include <EF_UART_cosim.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#ifndef EF_UART_COSIM_CLK_HZ
+#define EF_UART_COSIM_CLK_HZ    50000000
+#endif
+
+#define BENCH_BYTES             1024
+#define BENCH_PRESCALER         0
+#define BENCH_SC                8
+
+static EF_UART_Cosim &uart = ef_uart_cosim0;
+
+struct bench_result {
+    uint64_t cycles;                        // until the last byte was moved
+    uint64_t bus_busy;
+    bool ok;
+};
+
+static void setup(bool loopback){
+
+    uart.loopback = loopback;
+    uart.irq_handler = nullptr;
+    uart.peer.bit_cycles = (BENCH_PRESCALER + 1) * BENCH_SC;
+    uart.reset();
+    EF_DRIVER_UART0.setPrescaler(BENCH_PRESCALER);
+    EF_DRIVER_UART0.setCTRL(EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_TXEN_MASK | EF_UART_CTRL_REG_RXEN_MASK);
+}
+
+static std::vector<uint8_t> pattern(void){
+
+    std::vector<uint8_t> data(BENCH_BYTES);
+    for (unsigned i = 0; i < BENCH_BYTES; i++)
+        data[i] = 'A' + (i % 26);
+    return data;
+}
+
+static void print(const char *name, const bench_result &r){
+
+    double seconds = (double)r.cycles / EF_UART_COSIM_CLK_HZ;
+    double latency = 0;
+    uint64_t latency_max = 0;
+    for (uint64_t l : uart.irq_latency){
+        latency += l;
+        latency_max = (l > latency_max) ? l : latency_max;
+    }
+    if (!uart.irq_latency.empty())
+        latency /= uart.irq_latency.size();
+
+    printf("%-12s %12.0f %10.2f %8.1f%% %10.1f %8llu %6s\n", name,
+           BENCH_BYTES / seconds, (double)r.bus_busy / BENCH_BYTES, 100.0 * r.bus_busy / r.cycles,
+           latency, (unsigned long long)latency_max, r.ok ? "ok" : "FAIL");
+}
+
+// Waits until the peer has received count bytes
+static void wait_peer(size_t count){
+
+    while (uart.peer.received.size() < count)
+        uart.advance(1);
+}
+
+static bench_result tx_polled(void){
+
+    std::vector<uint8_t> data = pattern();
+    std::vector<char> text(data.begin(), data.end());
+    text.push_back(0);
+
+    setup(false);
+    EF_DRIVER_UART0.setTxFIFOThreshold(EF_UART_IRQ_TX_THRESHOLD);
+    uint64_t start = uart.cycle;
+    EF_DRIVER_UART0.writeCharArr(text.data());
+    wait_peer(BENCH_BYTES);
+    return {uart.cycle - start, uart.bus_busy, uart.peer.received == data};
+}
+
+static bench_result tx_buffer(void){
+
+    std::vector<uint8_t> data = pattern();
+
+    setup(false);
+    uint64_t start = uart.cycle;
+    EF_DRIVER_UART0.writeBuffer(data.data(), data.size());
+    wait_peer(BENCH_BYTES);
+    return {uart.cycle - start, uart.bus_busy, uart.peer.received == data};
+}
+
+static bench_result tx_irq(void){
+
+    static uint8_t tx[256], rx[16];
+    std::vector<uint8_t> data = pattern();
+
+    setup(false);
+    EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+    uart.irq_handler = EF_UART_IRQHandler;
+    uint64_t start = uart.cycle;
+    uint64_t busy = uart.bus_busy;
+    uint32_t sent = 0;
+    while (uart.peer.received.size() < BENCH_BYTES){
+        if (sent < BENCH_BYTES)
+            sent += EF_DRIVER_UART0.write(&data[sent], BENCH_BYTES - sent);
+        uart.advance(16);
+    }
+    return {uart.cycle - start, uart.bus_busy - busy, uart.peer.received == data};
+}
+
+static bench_result tx_dma(void){
+
+    std::vector<uint8_t> data = pattern();
+    EF_UART_Cosim_DMA dma(uart);
+
+    setup(false);
+    EF_DRIVER_UART0.initDMA(&dma.controller);
+    uint64_t start = uart.cycle;
+    uint64_t busy = uart.bus_busy;
+    bool ok = EF_DRIVER_UART0.startTxDMA(data.data(), data.size());
+    wait_peer(BENCH_BYTES);
+    ok = ok && (EF_DRIVER_UART0.completeDMA(DMA_TX) == BENCH_BYTES);
+    return {uart.cycle - start, uart.bus_busy - busy, ok && (uart.peer.received == data) && (uart.dma_accesses == BENCH_BYTES)};
+}
+
+static bench_result rx_polled(void){
+
+    std::vector<uint8_t> data = pattern();
+    std::vector<uint8_t> out(BENCH_BYTES);
+
+    setup(false);
+    uart.peer.to_send.assign(data.begin(), data.end());
+    uint64_t start = uart.cycle;
+    for (unsigned i = 0; i < BENCH_BYTES; i++)
+        out[i] = EF_DRIVER_UART0.readChar();
+    return {uart.cycle - start, uart.bus_busy, out == data};
+}
+
+static bench_result rx_buffer(void){
+
+    std::vector<uint8_t> data = pattern();
+    std::vector<uint8_t> out(BENCH_BYTES);
+
+    setup(false);
+    uart.peer.to_send.assign(data.begin(), data.end());
+    uint64_t start = uart.cycle;
+    EF_DRIVER_UART0.readBuffer(out.data(), out.size());
+    return {uart.cycle - start, uart.bus_busy, out == data};
+}
+
+static bench_result rx_irq(void){
+
+    static uint8_t tx[16], rx[256];
+    std::vector<uint8_t> data = pattern();
+    std::vector<uint8_t> out(BENCH_BYTES);
+
+    setup(false);
+    EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+    uart.irq_handler = EF_UART_IRQHandler;
+    uint64_t busy = uart.bus_busy;
+    uart.peer.to_send.assign(data.begin(), data.end());
+    uint64_t start = uart.cycle;
+    uint32_t received = 0;
+    while (received < BENCH_BYTES){
+        received += EF_DRIVER_UART0.read(&out[received], BENCH_BYTES - received);
+        uart.advance(16);
+    }
+    return {uart.cycle - start, uart.bus_busy - busy, (out == data) && (EF_DRIVER_UART0.getRxDropped() == 0)};
+}
+
+static bench_result rx_dma(void){
+
+    std::vector<uint8_t> data = pattern();
+    std::vector<uint8_t> out(BENCH_BYTES);
+    EF_UART_Cosim_DMA dma(uart);
+
+    setup(false);
+    EF_DRIVER_UART0.initDMA(&dma.controller);
+    uint64_t busy = uart.bus_busy;
+    uart.peer.to_send.assign(data.begin(), data.end());
+    uint64_t start = uart.cycle;
+    bool ok = EF_DRIVER_UART0.startRxDMA(out.data(), out.size());
+    while (ok && (EF_DRIVER_UART0.getDMACount(DMA_RX) < BENCH_BYTES))
+        uart.advance(uart.peer.bit_cycles * 10);
+    ok = ok && (EF_DRIVER_UART0.completeDMA(DMA_RX) == BENCH_BYTES);
+    return {uart.cycle - start, uart.bus_busy - busy, ok && (out == data)};
+}
+
+// TX wired to RX: the driver sends and receives the same bytes
+static bench_result loopback_buffer(void){
+
+    std::vector<uint8_t> data = pattern();
+    std::vector<uint8_t> out(BENCH_BYTES);
+
+    setup(true);
+    uint64_t start = uart.cycle;
+    for (unsigned i = 0; i < BENCH_BYTES; i += EF_UART_FIFO_DEPTH){
+        EF_DRIVER_UART0.writeBuffer(&data[i], EF_UART_FIFO_DEPTH);
+        EF_DRIVER_UART0.readBuffer(&out[i], EF_UART_FIFO_DEPTH);
+    }
+    return {uart.cycle - start, uart.bus_busy, out == data};
+}
+
+int main(void){
+
+    bool ok = true;
+    struct {
+        const char *name;
+        bench_result (*run)(void);
+    } benches[] = {
+        {"tx polled", tx_polled},
+        {"tx buffer", tx_buffer},
+        {"tx irq", tx_irq},
+        {"tx dma", tx_dma},
+        {"rx polled", rx_polled},
+        {"rx buffer", rx_buffer},
+        {"rx irq", rx_irq},
+        {"rx dma", rx_dma},
+        {"loopback", loopback_buffer},
+    };
+
+    printf("EF_UART_%s, %d bytes, PR=%d, %.0f MHz bus clock, %u cycles to enter the handler\n", uart.bus_name(),
+           BENCH_BYTES, BENCH_PRESCALER, EF_UART_COSIM_CLK_HZ / 1e6, uart.irq_entry_cycles);
+    printf("%-12s %12s %10s %9s %10s %8s %6s\n", "api", "bytes/s", "bus cyc/B", "bus busy", "irq avg", "irq max", "data");
+    for (auto &b : benches){
+        bench_result r = b.run();
+        print(b.name, r);
+        ok = ok && r.ok;
+    }
+    return ok ? 0 : 1;
+}
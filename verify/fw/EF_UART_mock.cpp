@@ -0,0 +1,881 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file EF_UART_mock.cpp
+    \brief Behavioural model of the EF_UART registers, FIFOs and flags as seen from the bus wrappers.
+
+*/
+
+#include <EF_UART_mock.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+// Marks a character on the model line that carries a glitch; above the RXDATA tags
+#define EF_UART_MOCK_NOISY 0x8000
+
+static std::vector<EF_UART_Mock *> &ef_uart_mock_instances(void){
+
+    static std::vector<EF_UART_Mock *> instances;
+    return instances;
+}
+
+EF_UART_Mock ef_uart_mock0;
+
+
+//
+//   Register cells
+//
+
+ef_uart_mock_reg::operator uint32_t() const{
+
+    uint32_t offset;
+    EF_UART_Mock *mock = EF_UART_Mock::owner(this, &offset);
+    return mock->bus_read(offset);
+}
+
+ef_uart_mock_reg &ef_uart_mock_reg::operator=(uint32_t value){
+
+    uint32_t offset;
+    EF_UART_Mock *mock = EF_UART_Mock::owner(this, &offset);
+    mock->bus_write(offset, value);
+    return *this;
+}
+
+EF_UART_Mock *EF_UART_Mock::owner(const void *cell, uint32_t *offset){
+
+    const char *address = static_cast<const char *>(cell);
+    for (EF_UART_Mock *mock : ef_uart_mock_instances()){
+        const char *base = reinterpret_cast<const char *>(&mock->regs);
+        if ((address >= base) && (address < base + sizeof(EF_UART_REGS))){
+            *offset = static_cast<uint32_t>(address - base);
+            return mock;
+        }
+    }
+    fprintf(stderr, "EF_UART_Mock: access to %p is outside of every register space\n", cell);
+    abort();
+}
+
+
+//
+//   Device model
+//
+
+EF_UART_Mock::EF_UART_Mock(unsigned fifo_depth, unsigned samples) : dma(nullptr), depth(fifo_depth), sc(samples){
+
+    ef_uart_mock_instances().push_back(this);
+    reset();
+}
+
+EF_UART_Mock::~EF_UART_Mock(){
+
+    std::vector<EF_UART_Mock *> &instances = ef_uart_mock_instances();
+    instances.erase(std::remove(instances.begin(), instances.end(), this), instances.end());
+}
+
+void EF_UART_Mock::reset(){
+
+    cycle = 0;
+    bus_reads = 0;
+    bus_writes = 0;
+    wakeups = 0;
+    bus_cycles = 2;                         // APB setup and access phases
+    tx_line.clear();
+
+    pr = 0;
+    prf = 0;
+    ctrl = 0;
+    cfg = 0x3F08;                           // reset values from EF_UART.yaml
+    match = 0;
+    match_mask = 0;
+    selected = false;
+    de_timing = 0;
+    de_on = false;
+    de_ready_at = 0;
+    de_off_at = 0;
+    abr = 0;
+    sync_pending = false;
+    sync_data = 0;
+    sync_bit_cycles = 0;
+    abr_measured = false;
+    abr_done_at = 0;
+    abr_result = 0;
+    coal = 0;
+    coal_time = 0;
+    coal_rx_n = 0;
+    coal_tx_n = 0;
+    coal_due_at = 0;
+    stats = {};
+    stats_snap = {};
+    sync = 0;
+    sync_mask = 0;
+    sync_ctrl = 0;
+    sync_hist = 0;
+    sync_n = 0;
+    sync_locked = false;
+    crc_poly = 0;
+    crc_init = 0;
+    crc_ctrl = 0;
+    crc_tx = 0;
+    crc_rx = 0;
+    gap = 0;
+    gap_at = 0;
+    frame_n = 0;
+    frame_err = 0;
+    frame_late = false;
+    frames.clear();
+    rts = 0;
+    rx_threshold = 0;
+    tx_threshold = 0;
+    im = 0;
+    ris = 0;
+    gclk = 0;
+    cts_n = false;
+
+    tx_fifo.clear();
+    rx_fifo.clear();
+    rx_line.clear();
+    tx_shift = 0;
+    tx_done_at = 0;
+    rx_done_at = 0;
+    restart_timeout();
+    update_flags();
+}
+
+// Samples per bit selected by CFG.osr; 0 keeps the SC parameter. A synchronous bit is two ticks, one per edge of sclk
+unsigned EF_UART_Mock::samples() const{
+
+    if (ctrl & EF_UART_CTRL_REG_SCEN_MASK)
+        return 2;
+    static const unsigned osr[4] = {0, 16, 8, 4};
+    unsigned selected = osr[(cfg & EF_UART_CFG_REG_OSR_MASK) >> EF_UART_CFG_REG_OSR_BIT];
+    return selected ? selected : sc;
+}
+
+// Average length of a bit; the fractional prescaler spreads the 1/16 steps over the bits of a character
+uint64_t EF_UART_Mock::bit_cycles() const{
+
+    return (((static_cast<uint64_t>(pr + 1) * 16 + prf) * samples()) + 8) / 16;
+}
+
+uint64_t EF_UART_Mock::char_cycles() const{
+
+    uint32_t wlen = cfg & EF_UART_CFG_REG_WLEN_MASK;
+    uint32_t parity = (cfg & EF_UART_CFG_REG_PARITY_MASK) >> EF_UART_CFG_REG_PARITY_BIT;
+    uint32_t stp2 = (cfg & EF_UART_CFG_REG_STP2_MASK) ? 1 : 0;
+    uint32_t bits = 1 + wlen + (parity ? 1 : 0) + 1 + stp2;
+    return (((static_cast<uint64_t>(pr + 1) * 16 + prf) * samples() * bits) + 8) / 16;
+}
+
+bool EF_UART_Mock::tx_idle() const{
+
+    return tx_fifo.empty() && (tx_done_at == 0);
+}
+
+bool EF_UART_Mock::de() const{
+
+    return de_on;
+}
+
+// rts_n is high at the watermark; the other side finishes the character it is sending and waits
+bool EF_UART_Mock::rts_n() const{
+
+    bool full = rx_fifo.size() == depth;
+    return (ctrl & EF_UART_CTRL_REG_RTSEN_MASK) && (full || ((rts != 0) && (rx_fifo.size() % depth >= rts)));
+}
+
+bool EF_UART_Mock::rx_idle() const{
+
+    return rx_line.empty() && (rx_done_at == 0);
+}
+
+void EF_UART_Mock::restart_timeout(){
+
+    uint32_t timeout = (cfg & EF_UART_CFG_REG_TIMEOUT_MASK) >> EF_UART_CFG_REG_TIMEOUT_BIT;
+    rto_at = cycle + timeout * bit_cycles();
+    if (rto_at == cycle)
+        rto_at += bit_cycles();
+}
+
+// Level sensitive flags are set every cycle their condition holds, just like the RTL
+void EF_UART_Mock::update_flags(){
+
+    if (dma != nullptr)
+        dma->serve();
+
+    size_t tx_level = tx_fifo.size() % depth;
+    size_t rx_level = rx_fifo.size() % depth;
+    bool tx_full = tx_fifo.size() == depth;
+    bool rx_full = rx_fifo.size() == depth;
+
+    if (tx_fifo.empty())
+        ris |= EF_UART_TXE_FLAG;
+    if (rx_full)
+        ris |= EF_UART_RXF_FLAG;
+    stats.tx_fifo_max = std::max<uint32_t>(stats.tx_fifo_max, tx_fifo.size());
+    stats.rx_fifo_max = std::max<uint32_t>(stats.rx_fifo_max, rx_fifo.size());
+
+    if ((tx_level < tx_threshold) && !tx_full)
+        ris |= EF_UART_TXB_FLAG;
+    if ((rx_level > rx_threshold) || rx_full)
+        ris |= EF_UART_RXA_FLAG;
+}
+
+// Counts a character towards the next COAL event; last is the character that emptied the TX FIFO
+void EF_UART_Mock::coal_count(bool rx, bool last){
+
+    uint32_t count = rx ? ((coal & EF_UART_COAL_REG_RXCNT_MASK) >> EF_UART_COAL_REG_RXCNT_BIT)
+                        : ((coal & EF_UART_COAL_REG_TXCNT_MASK) >> EF_UART_COAL_REG_TXCNT_BIT);
+    uint32_t &n = rx ? coal_rx_n : coal_tx_n;
+
+    if (count == 0)
+        return;
+    if ((++n >= count) || last){
+        ris |= EF_UART_COAL_FLAG;
+        coal_rx_n = 0;
+        coal_tx_n = 0;
+        coal_due_at = 0;
+    } else if ((coal_due_at == 0) && (coal_time != 0)){
+        coal_due_at = cycle + coal_time + 1;
+    }
+}
+
+// Sync word detector for a character accepted by the receiver; returns true when the hunt drops it
+bool EF_UART_Mock::sync_detect(uint16_t data){
+
+    if (!(sync_ctrl & EF_UART_SYNC_CTRL_REG_EN_MASK))
+        return false;
+    unsigned len = (sync_ctrl & EF_UART_SYNC_CTRL_REG_LEN_MASK) >> EF_UART_SYNC_CTRL_REG_LEN_BIT;
+    bool hunt = sync_ctrl & EF_UART_SYNC_CTRL_REG_HUNT_MASK;
+    bool clean = !(data & (EF_UART_RXDATA_REG_FE_MASK | EF_UART_RXDATA_REG_PE_MASK));
+    bool drop = hunt && !sync_locked;
+    // the oldest character of the window in bits 7:0
+    uint32_t window = 0;
+    for (unsigned i = 0; i <= len; i++){
+        uint32_t c = (i == 0) ? (data & 0xFF) : ((sync_hist >> ((i - 1) * 8)) & 0xFF);
+        window |= c << ((len - i) * 8);
+    }
+    uint32_t used = (len == 3) ? 0xFFFFFFFF : ((1u << ((len + 1) * 8)) - 1);
+    if (clean && (sync_n >= len) && (((window ^ sync) & ~sync_mask & used) == 0)){
+        if (!(hunt && sync_locked))
+            ris |= EF_UART_SYNC_FLAG;
+        if (hunt)
+            sync_locked = true;
+    }
+    sync_hist = (sync_hist << 8) | (data & 0xFF);
+    sync_n = !clean ? 0 : (sync_n < 3) ? sync_n + 1 : 3;
+    return drop;
+}
+
+// The CRC register is kept left aligned, so the same update serves every width
+unsigned EF_UART_Mock::crc_shift() const{
+
+    uint32_t size = (crc_ctrl & EF_UART_CRC_CTRL_REG_SIZE_MASK) >> EF_UART_CRC_CTRL_REG_SIZE_BIT;
+    return (size & 2) ? 0 : (size & 1) ? 16 : 24;
+}
+
+// One character, MSB first unless refin
+uint32_t EF_UART_Mock::crc_update(uint32_t crc, uint16_t data) const{
+
+    if (!(crc_ctrl & EF_UART_CRC_CTRL_REG_EN_MASK))
+        return crc;
+    uint32_t poly = crc_poly << crc_shift();
+    for (int i = 7; i >= 0; i--){
+        unsigned bit = (crc_ctrl & EF_UART_CRC_CTRL_REG_REFIN_MASK) ? (data >> (7 - i)) & 1 : (data >> i) & 1;
+        crc = (crc << 1) ^ (((crc >> 31) ^ bit) ? poly : 0);
+    }
+    return crc;
+}
+
+uint32_t EF_UART_Mock::crc_out(uint32_t crc) const{
+
+    uint32_t value = crc >> crc_shift();
+    if (crc_ctrl & EF_UART_CRC_CTRL_REG_REFOUT_MASK){
+        value = 0;
+        for (int i = 0; i < 32; i++)
+            value |= ((crc >> (31 - i)) & 1) << i;
+    }
+    if (crc_ctrl & EF_UART_CRC_CTRL_REG_INV_MASK)
+        value ^= 0xFFFFFFFF >> crc_shift();
+    return value;
+}
+
+// The idle gap has been reached; pushes the descriptor of the open frame unless the descriptor FIFO is full
+void EF_UART_Mock::frame_end(){
+
+    if ((frame_n == 0) && !(frame_err & EF_UART_FRAME_REG_OR_MASK)){
+        gap_at = 0;
+        return;
+    }
+    if (frames.size() == 4){
+        // the gap stays reached; the descriptor goes in as soon as one is read, unless a character comes first
+        frame_late = true;
+        return;
+    }
+    frames.push_back(frame_n | frame_err);
+    ris |= EF_UART_EOF_FLAG;
+    frame_n = 0;
+    frame_err = 0;
+    frame_late = false;
+    gap_at = 0;
+}
+
+// The error counters saturate at 16 bits
+void EF_UART_Mock::count_error(uint32_t &counter){
+
+    if (counter < 0xFFFF)
+        counter++;
+}
+
+// Runs the transmitter and the receiver up to the given cycle
+void EF_UART_Mock::step(uint64_t until){
+
+    bool enabled = ctrl & EF_UART_CTRL_REG_EN_MASK;
+    bool tx_enabled = enabled && (ctrl & EF_UART_CTRL_REG_TXEN_MASK);
+    bool abr_enabled = ctrl & EF_UART_CTRL_REG_ABREN_MASK;
+    bool rx_enabled = enabled && (ctrl & EF_UART_CTRL_REG_RXEN_MASK) && !abr_enabled;
+    bool loopback = ctrl & EF_UART_CTRL_REG_LPEN_MASK;
+    bool cts_stop = (ctrl & EF_UART_CTRL_REG_CTSEN_MASK) && cts_n;
+    bool de_enabled = ctrl & EF_UART_CTRL_REG_DEEN_MASK;
+
+    if (!de_enabled)
+        de_on = false;
+    while (true){
+        if (tx_enabled && (tx_done_at == 0) && !tx_fifo.empty() && !cts_stop){
+            // de rises a lead time before the first character; the following ones keep it up
+            uint64_t start = cycle;
+            if (de_enabled){
+                if (!de_on){
+                    de_on = true;
+                    de_ready_at = cycle + ((de_timing & EF_UART_DE_REG_LEAD_MASK) >> EF_UART_DE_REG_LEAD_BIT) * bit_cycles();
+                }
+                de_off_at = 0;
+                start = std::max(cycle, de_ready_at);
+            }
+            // the transmitter pops the FIFO when it loads the shift register. The RTL pops it, and updates the CRC,
+            // when the character is done; either way the CRC covers all the characters once the FIFO is empty.
+            tx_shift = tx_fifo.front();
+            tx_fifo.pop_front();
+            crc_tx = crc_update(crc_tx, tx_shift);
+            tx_done_at = start + char_cycles();
+        }
+        if (rx_enabled && (rx_done_at == 0) && !rx_line.empty() && !rts_n()){
+            rx_done_at = cycle + char_cycles();
+            gap_at = 0;
+        }
+        if (abr_enabled && sync_pending && !abr_measured && (abr_done_at == 0)){
+            // the line levels of start, 8 data bits and stop; the unit times the last falling edge within 9.5 start bit times
+            int level[10];
+            level[0] = 0;
+            for (int i = 0; i < 8; i++)
+                level[i + 1] = (sync_data >> i) & 1;
+            level[9] = 1;
+            int start_bits = 0;
+            while (level[start_bits] == 0)
+                start_bits++;
+            uint64_t start_cycles = start_bits * sync_bit_cycles;
+            uint64_t window = (9 * start_cycles) + (start_cycles / 2);
+            abr_result = 0;
+            for (int i = 1; i < 10; i++)
+                if (level[i - 1] && !level[i] && (i * sync_bit_cycles <= window))
+                    abr_result = i * sync_bit_cycles;
+            abr_done_at = cycle + window + 1;
+        }
+
+        uint64_t next = until;
+        if (tx_done_at != 0)
+            next = std::min(next, tx_done_at);
+        if (rx_done_at != 0)
+            next = std::min(next, rx_done_at);
+        if (rx_enabled)
+            next = std::min(next, rto_at);
+        if (de_on && (de_off_at != 0))
+            next = std::min(next, de_off_at);
+        if (abr_done_at != 0)
+            next = std::min(next, abr_done_at);
+        if (coal_due_at != 0)
+            next = std::min(next, coal_due_at);
+        if (rx_enabled && (gap_at != 0) && !frame_late)
+            next = std::min(next, gap_at);
+        cycle = std::max(cycle, next);
+
+        if ((tx_done_at != 0) && (tx_done_at <= cycle)){
+            tx_line.push_back(tx_shift);
+            if (loopback)
+                rx_line.push_back(tx_shift);
+            tx_done_at = 0;
+            stats.tx_chars++;
+            coal_count(false, tx_fifo.empty());
+            if (tx_fifo.empty()){
+                // the last stop bit has left; de falls a lag time later, or a cycle later without one
+                ris |= EF_UART_TC_FLAG;
+                if (de_on)
+                    de_off_at = cycle + ((de_timing & EF_UART_DE_REG_LAG_MASK) >> EF_UART_DE_REG_LAG_BIT) * bit_cycles() + 1;
+            }
+        }
+        if (de_on && (de_off_at != 0) && (de_off_at <= cycle) && (tx_done_at == 0) && tx_fifo.empty()){
+            de_on = false;
+            de_off_at = 0;
+        }
+        if ((abr_done_at != 0) && (abr_done_at <= cycle)){
+            abr = abr_result & EF_UART_ABR_REG_COUNT_MASK;
+            ris |= EF_UART_ABR_FLAG;
+            sync_pending = false;
+            abr_measured = true;
+            abr_done_at = 0;
+        }
+        if ((rx_done_at != 0) && (rx_done_at <= cycle)){
+            // the line carries the error tags of a character in the RXDATA bit positions
+            uint16_t data = rx_line.front();
+            rx_line.pop_front();
+            // the majority vote outvotes the glitch and reports it; a single sample takes it as the bit
+            bool noisy = data & EF_UART_MOCK_NOISY;
+            data &= ~EF_UART_MOCK_NOISY;
+            if (noisy && !(cfg & EF_UART_CFG_REG_MAJ_MASK))
+                data ^= 1;
+            uint32_t value = data & EF_UART_RXDATA_REG_DATA_MASK;
+            bool hit = (((value ^ match) & ~match_mask) == 0);
+            bool accept = true;
+            if (ctrl & EF_UART_CTRL_REG_ADEN_MASK){
+                // multidrop: an address frame (re)selects the receiver, data frames follow the selection
+                bool address = ((cfg & EF_UART_CFG_REG_WLEN_MASK) == 9) && (value & EF_UART_ADDRESS_FLAG);
+                if (address)
+                    selected = hit;
+                else
+                    hit = false;
+                accept = address ? hit : selected;
+            }
+            if (hit)
+                data |= EF_UART_RXDATA_REG_MATCH_MASK;
+            // the hunt drops the character after the line errors are reported, like a full FIFO
+            bool push = accept && !sync_detect(data);
+            if (push){
+                crc_rx = crc_update(crc_rx, data);
+                if (rx_fifo.size() == depth){
+                    ris |= EF_UART_OR_FLAG;
+                    count_error(stats.overruns);
+                    frame_err |= EF_UART_FRAME_REG_OR_MASK;
+                } else {
+                    rx_fifo.push_back(data);
+                    // a character after a gap that found the descriptor FIFO full joins the open frame
+                    if (frame_late)
+                        frame_err |= EF_UART_FRAME_REG_MERGED_MASK;
+                    if (frame_n < 0xFFFF)
+                        frame_n++;
+                }
+                if (data & EF_UART_RXDATA_REG_FE_MASK)
+                    frame_err |= EF_UART_FRAME_REG_FE_MASK;
+                if (data & EF_UART_RXDATA_REG_PE_MASK)
+                    frame_err |= EF_UART_FRAME_REG_PE_MASK;
+                stats.rx_chars++;
+                coal_count(true, false);
+            }
+            if (accept){
+                if (data & EF_UART_RXDATA_REG_FE_MASK){
+                    ris |= EF_UART_FE_FLAG;
+                    count_error(stats.frame_errors);
+                }
+                if (data & EF_UART_RXDATA_REG_PE_MASK){
+                    ris |= EF_UART_PRE_FLAG;
+                    count_error(stats.parity_errors);
+                }
+                if (noisy && (cfg & EF_UART_CFG_REG_MAJ_MASK))
+                    ris |= EF_UART_NOISE_FLAG;
+            }
+            if (hit)
+                ris |= EF_UART_MATCH_FLAG;
+            if (data & EF_UART_RXDATA_REG_BRK_MASK){
+                ris |= EF_UART_BRK_FLAG;
+                count_error(stats.breaks);
+            }
+            rx_done_at = 0;
+            restart_timeout();
+            // the gap is counted from the end of the stop bit, in character times of the current format
+            if (gap != 0)
+                gap_at = cycle + (gap * char_cycles()) / 16;
+        }
+        if (rx_enabled && (gap_at != 0) && (gap_at <= cycle) && (rx_done_at == 0))
+            frame_end();
+        if ((coal_due_at != 0) && (coal_due_at <= cycle)){
+            ris |= EF_UART_COAL_FLAG;
+            coal_rx_n = 0;
+            coal_tx_n = 0;
+            coal_due_at = 0;
+        }
+        if (rx_enabled && (rto_at <= cycle)){
+            ris |= EF_UART_RTO_FLAG;
+            count_error(stats.timeouts);
+            // the timeout ends the message; the search and the hunt start again
+            sync_n = 0;
+            sync_locked = false;
+            uint32_t timeout = (cfg & EF_UART_CFG_REG_TIMEOUT_MASK) >> EF_UART_CFG_REG_TIMEOUT_BIT;
+            rto_at += (timeout + 1) * bit_cycles();
+        }
+        update_flags();
+
+        if (cycle >= until)
+            break;
+    }
+    if (!rx_enabled)
+        restart_timeout();
+}
+
+// DMA handshake lines; the ack cycles are not modelled, a request is served as soon as it rises
+bool EF_UART_Mock::tx_dma_req() const{
+
+    return (ctrl & EF_UART_CTRL_REG_TXDMAEN_MASK) && (tx_fifo.size() < tx_threshold);
+}
+
+bool EF_UART_Mock::tx_dma_single() const{
+
+    return (ctrl & EF_UART_CTRL_REG_TXDMAEN_MASK) && (tx_fifo.size() < depth);
+}
+
+bool EF_UART_Mock::rx_dma_req() const{
+
+    return (ctrl & EF_UART_CTRL_REG_RXDMAEN_MASK) && ((rx_fifo.size() > rx_threshold) || (rx_fifo.size() == depth));
+}
+
+bool EF_UART_Mock::rx_dma_single() const{
+
+    return (ctrl & EF_UART_CTRL_REG_RXDMAEN_MASK) && !rx_fifo.empty();
+}
+
+void EF_UART_Mock::dma_write(uint32_t value){
+
+    if (tx_fifo.size() < depth)
+        tx_fifo.push_back(value & 0x1FF);
+}
+
+uint32_t EF_UART_Mock::dma_read(){
+
+    if (rx_fifo.empty())
+        return 0;
+    uint32_t data = rx_fifo.front();
+    rx_fifo.pop_front();
+    return data;
+}
+
+void EF_UART_Mock::advance(uint64_t cycles){
+
+    step(cycle + cycles);
+}
+
+void EF_UART_Mock::receive(const uint8_t *data, size_t length){
+
+    for (size_t i = 0; i < length; i++)
+        rx_line.push_back(data[i]);
+}
+
+void EF_UART_Mock::receive_error(uint8_t data, uint32_t tags){
+
+    rx_line.push_back(data | (tags & (EF_UART_RXDATA_REG_FE_MASK | EF_UART_RXDATA_REG_PE_MASK | EF_UART_RXDATA_REG_BRK_MASK)));
+}
+
+void EF_UART_Mock::receive_address(uint8_t address){
+
+    rx_line.push_back(EF_UART_ADDRESS_FLAG | address);
+}
+
+void EF_UART_Mock::receive_noisy(uint8_t data){
+
+    rx_line.push_back(EF_UART_MOCK_NOISY | data);
+}
+
+void EF_UART_Mock::receive_sync(uint8_t data, uint64_t bit_cycles){
+
+    sync_pending = true;
+    sync_data = data;
+    sync_bit_cycles = bit_cycles;
+}
+
+bool EF_UART_Mock::irq(){
+
+    step(cycle);
+    return (ris & im) != 0;
+}
+
+void EF_UART_Mock::wait_irq(){
+
+    while (!irq())
+        advance(16);
+    wakeups++;
+}
+
+uint32_t EF_UART_Mock::bus_read(uint32_t offset){
+
+    bus_reads++;
+    step(cycle + bus_cycles);
+
+    switch (offset){
+    case offsetof(EF_UART_REGS, RXDATA):{
+        if (rx_fifo.empty())
+            return 0;
+        uint32_t data = rx_fifo.front();
+        rx_fifo.pop_front();
+        update_flags();
+        return data;
+    }
+    case offsetof(EF_UART_REGS, RXDATA_PACKED):{
+        // nothing is popped unless 4 characters are waiting
+        if (rx_fifo.size() < 4)
+            return 0;
+        uint32_t data = 0;
+        for (int i = 0; i < 4; i++){
+            data |= (uint32_t)(rx_fifo.front() & 0xFF) << (8 * i);
+            rx_fifo.pop_front();
+        }
+        update_flags();
+        return data;
+    }
+    case offsetof(EF_UART_REGS, PR):                return pr;
+    case offsetof(EF_UART_REGS, PRF):               return prf;
+    case offsetof(EF_UART_REGS, CTRL):              return ctrl;
+    case offsetof(EF_UART_REGS, CFG):               return cfg;
+    case offsetof(EF_UART_REGS, MATCH):             return match;
+    case offsetof(EF_UART_REGS, RTS):               return rts;
+    case offsetof(EF_UART_REGS, MATCH_MASK):        return match_mask;
+    case offsetof(EF_UART_REGS, DE):                return de_timing;
+    case offsetof(EF_UART_REGS, ABR):               return abr;
+    case offsetof(EF_UART_REGS, COAL):              return coal;
+    case offsetof(EF_UART_REGS, COAL_TIME):         return coal_time;
+    case offsetof(EF_UART_REGS, SYNC):              return sync;
+    case offsetof(EF_UART_REGS, SYNC_MASK):         return sync_mask;
+    case offsetof(EF_UART_REGS, SYNC_CTRL):         return sync_ctrl;
+    case offsetof(EF_UART_REGS, CRC_POLY):          return crc_poly;
+    case offsetof(EF_UART_REGS, CRC_INIT):          return crc_init;
+    case offsetof(EF_UART_REGS, CRC_CTRL):          return crc_ctrl;
+    case offsetof(EF_UART_REGS, CRC_TX):            return crc_out(crc_tx);
+    case offsetof(EF_UART_REGS, CRC_RX):            return crc_out(crc_rx);
+    case offsetof(EF_UART_REGS, GAP):               return gap;
+    case offsetof(EF_UART_REGS, FRAME):{
+        if (frames.empty())
+            return 0;
+        uint32_t frame = frames.front();
+        frames.pop_front();
+        if (frame_late)
+            frame_end();
+        return frame;
+    }
+    case offsetof(EF_UART_REGS, STATS_TX):          return stats_snap.tx_chars;
+    case offsetof(EF_UART_REGS, STATS_RX):          return stats_snap.rx_chars;
+    case offsetof(EF_UART_REGS, STATS_FE_PE):       return stats_snap.frame_errors | (stats_snap.parity_errors << EF_UART_STATS_FE_PE_REG_PE_BIT);
+    case offsetof(EF_UART_REGS, STATS_OR_BRK):      return stats_snap.overruns | (stats_snap.breaks << EF_UART_STATS_OR_BRK_REG_BRK_BIT);
+    case offsetof(EF_UART_REGS, STATS_RTO):         return stats_snap.timeouts;
+    case offsetof(EF_UART_REGS, STATS_MAX):
+        return std::min<uint32_t>(stats_snap.rx_fifo_max, EF_UART_STATUS_LEVEL_MAX)
+             | (std::min<uint32_t>(stats_snap.tx_fifo_max, EF_UART_STATUS_LEVEL_MAX) << EF_UART_STATS_MAX_REG_TXMAX_BIT);
+    case offsetof(EF_UART_REGS, STATUS):{
+        // the 8-bit levels saturate for a 256-entry FIFO
+        uint32_t rx_level = std::min<size_t>(rx_fifo.size(), EF_UART_STATUS_LEVEL_MAX);
+        uint32_t tx_level = std::min<size_t>(tx_fifo.size(), EF_UART_STATUS_LEVEL_MAX);
+        return rx_level | (tx_level << EF_UART_STATUS_REG_TXLVL_BIT) | (ris << EF_UART_STATUS_REG_RIS_BIT);
+    }
+    case offsetof(EF_UART_REGS, CAP):{
+        uint32_t faw = 0;
+        while ((1u << faw) < depth)
+            faw++;
+        return (faw << EF_UART_CAP_REG_FAW_BIT) | (9 << EF_UART_CAP_REG_MDW_BIT) | (sc << EF_UART_CAP_REG_SC_BIT) | EF_UART_CAP_REG_STATS_MASK | EF_UART_CAP_REG_CRC_MASK;
+    }
+    case offsetof(EF_UART_REGS, RX_FIFO_LEVEL):     return rx_fifo.size() % depth;
+    case offsetof(EF_UART_REGS, RX_FIFO_THRESHOLD): return rx_threshold;
+    case offsetof(EF_UART_REGS, TX_FIFO_LEVEL):     return tx_fifo.size() % depth;
+    case offsetof(EF_UART_REGS, TX_FIFO_THRESHOLD): return tx_threshold;
+    case offsetof(EF_UART_REGS, IM):                return im;
+    case offsetof(EF_UART_REGS, MIS):               return ris & im;
+    case offsetof(EF_UART_REGS, RIS):               return ris;
+    case offsetof(EF_UART_REGS, GCLK):              return gclk;
+    case offsetof(EF_UART_REGS, IRQ_SUMMARY):{
+        uint32_t summary = 0;
+        for (size_t i = 0; i < multi.size(); i++)
+            if (multi[i]->irq())
+                summary |= 1u << i;
+        return summary;
+    }
+    default:                                        return 0;
+    }
+}
+
+void EF_UART_Mock::bus_write(uint32_t offset, uint32_t value){
+
+    bus_writes++;
+    // a character written in the cycle the previous one ends is already in the FIFO then, as in the RTL, so no TC
+    bool tx_write = (offset == offsetof(EF_UART_REGS, TXDATA)) || (offset == offsetof(EF_UART_REGS, TXDATA_PACKED));
+    uint64_t done = cycle + bus_cycles;
+    step(tx_write ? done - 1 : done);
+    cycle = done;
+
+    switch (offset){
+    case offsetof(EF_UART_REGS, TXDATA):
+        if (tx_fifo.size() < depth)
+            tx_fifo.push_back(value & 0x1FF);
+        break;
+    case offsetof(EF_UART_REGS, TXDATA_PACKED):
+        for (int i = 0; (i < 4) && (tx_fifo.size() < depth); i++)
+            tx_fifo.push_back((value >> (8 * i)) & 0xFF);
+        break;
+    case offsetof(EF_UART_REGS, PR):                pr = value & 0xFFFF; break;
+    case offsetof(EF_UART_REGS, PRF):               prf = value & 0xF; break;
+    case offsetof(EF_UART_REGS, CTRL):
+        ctrl = value & 0x3FFF;
+        if (!(ctrl & EF_UART_CTRL_REG_ADEN_MASK))
+            selected = false;
+        if (!(ctrl & EF_UART_CTRL_REG_ABREN_MASK)){
+            abr_measured = false;
+            abr_done_at = 0;
+        }
+        break;
+    case offsetof(EF_UART_REGS, CFG):               cfg = value & 0x1FFFF; restart_timeout(); break;
+    case offsetof(EF_UART_REGS, MATCH):             match = value & 0x1FF; break;
+    case offsetof(EF_UART_REGS, RTS):               rts = value & (depth - 1); break;
+    case offsetof(EF_UART_REGS, MATCH_MASK):        match_mask = value & 0x1FF; break;
+    case offsetof(EF_UART_REGS, DE):                de_timing = value & 0xFF; break;
+    case offsetof(EF_UART_REGS, COAL):
+        // a direction that is switched off drops its count, like the RTL
+        coal = value & 0xFFFF;
+        if (!(coal & EF_UART_COAL_REG_RXCNT_MASK))
+            coal_rx_n = 0;
+        if (!(coal & EF_UART_COAL_REG_TXCNT_MASK))
+            coal_tx_n = 0;
+        if ((coal_rx_n == 0) && (coal_tx_n == 0))
+            coal_due_at = 0;
+        break;
+    case offsetof(EF_UART_REGS, COAL_TIME):         coal_time = value & 0xFFFFFF; break;
+    case offsetof(EF_UART_REGS, SYNC):              sync = value; break;
+    case offsetof(EF_UART_REGS, SYNC_MASK):         sync_mask = value; break;
+    case offsetof(EF_UART_REGS, SYNC_CTRL):
+        sync_ctrl = value & 0xF;
+        if (!(sync_ctrl & EF_UART_SYNC_CTRL_REG_EN_MASK))
+            sync_n = 0;
+        if (!(sync_ctrl & EF_UART_SYNC_CTRL_REG_EN_MASK) || !(sync_ctrl & EF_UART_SYNC_CTRL_REG_HUNT_MASK))
+            sync_locked = false;
+        break;
+    case offsetof(EF_UART_REGS, CRC_POLY):          crc_poly = value; break;
+    case offsetof(EF_UART_REGS, CRC_INIT):          crc_init = value; break;
+    case offsetof(EF_UART_REGS, CRC_CTRL):          crc_ctrl = value & 0x3F; break;
+    case offsetof(EF_UART_REGS, GAP):               gap = value & 0xFF; break;
+    case offsetof(EF_UART_REGS, CRC_RST):
+        if (value & EF_UART_CRC_RST_REG_TX_MASK)
+            crc_tx = crc_init << crc_shift();
+        if (value & EF_UART_CRC_RST_REG_RX_MASK)
+            crc_rx = crc_init << crc_shift();
+        break;
+    case offsetof(EF_UART_REGS, STATS_SNAP):
+        // the live counters restart from this cycle; the high-water marks from the current levels
+        if (value & EF_UART_STATS_SNAP_REG_SNAP_MASK){
+            stats_snap = stats;
+            stats = {};
+            stats.tx_fifo_max = tx_fifo.size();
+            stats.rx_fifo_max = rx_fifo.size();
+        }
+        break;
+    case offsetof(EF_UART_REGS, RX_FIFO_THRESHOLD): rx_threshold = value & (depth - 1); break;
+    case offsetof(EF_UART_REGS, RX_FIFO_FLUSH):
+        // the frame descriptors go with the characters they describe
+        if (value & 1){
+            rx_fifo.clear();
+            frames.clear();
+            frame_n = 0;
+            frame_err = 0;
+            frame_late = false;
+        }
+        break;
+    case offsetof(EF_UART_REGS, TX_FIFO_THRESHOLD): tx_threshold = value & (depth - 1); break;
+    case offsetof(EF_UART_REGS, TX_FIFO_FLUSH):     if (value & 1) tx_fifo.clear(); break;
+    case offsetof(EF_UART_REGS, IM):                im = value & 0xFFFF; break;
+    case offsetof(EF_UART_REGS, IC):                ris &= ~value; return;      // flags that still hold are set again on the next cycle
+    case offsetof(EF_UART_REGS, GCLK):              gclk = value & 1; break;
+    default:                                        break;
+    }
+    if (tx_write)
+        step(cycle);
+    update_flags();
+}
+
+
+//
+//   DMA controller model
+//
+
+EF_UART_Mock_DMA::EF_UART_Mock_DMA(EF_UART_Mock &mock) : accesses(0), requests(0), refuse(false), uart(mock){
+
+    controller.start = start;
+    controller.remaining = remaining;
+    controller.stop = stop;
+    controller.context = this;
+    channels[DMA_TX] = {};
+    channels[DMA_RX] = {};
+    uart.dma = this;
+}
+
+EF_UART_Mock_DMA::~EF_UART_Mock_DMA(){
+
+    uart.dma = nullptr;
+}
+
+bool EF_UART_Mock_DMA::start(void *context, enum dma_direction direction, uintptr_t data_register, uintptr_t memory, uint32_t length, uint32_t burst){
+
+    EF_UART_Mock_DMA *dma = static_cast<EF_UART_Mock_DMA *>(context);
+    uintptr_t expected = (direction == DMA_TX) ? reinterpret_cast<uintptr_t>(&dma->uart.regs.TXDATA)
+                                               : reinterpret_cast<uintptr_t>(&dma->uart.regs.RXDATA);
+    if (dma->refuse || (data_register != expected) || dma->channels[direction].active)
+        return false;
+    dma->channels[direction] = {true, reinterpret_cast<uint8_t *>(memory), length, 0, burst};
+    return true;
+}
+
+uint32_t EF_UART_Mock_DMA::remaining(void *context, enum dma_direction direction){
+
+    const channel &ch = static_cast<EF_UART_Mock_DMA *>(context)->channels[direction];
+    return ch.length - ch.done;
+}
+
+void EF_UART_Mock_DMA::stop(void *context, enum dma_direction direction){
+
+    static_cast<EF_UART_Mock_DMA *>(context)->channels[direction].active = false;
+}
+
+bool EF_UART_Mock_DMA::serve(){
+
+    bool moved = false;
+
+    for (int direction = DMA_TX; direction <= DMA_RX; direction++){
+        channel &ch = channels[direction];
+        while (ch.active && (ch.done < ch.length)){
+            // bursts while a whole burst is left, single transfers for the tail
+            bool tail = (ch.length - ch.done) < ch.burst;
+            bool req = (direction == DMA_TX) ? uart.tx_dma_req() : uart.rx_dma_req();
+            bool single = (direction == DMA_TX) ? uart.tx_dma_single() : uart.rx_dma_single();
+            uint32_t count = tail ? (single ? 1 : 0) : (req ? ch.burst : 0);
+            if (count == 0)
+                break;
+            for (uint32_t i = 0; i < count; i++, ch.done++){
+                if (direction == DMA_TX)
+                    uart.dma_write(ch.memory[ch.done]);
+                else
+                    ch.memory[ch.done] = uart.dma_read();
+            }
+            accesses += count;
+            requests++;
+            moved = true;
+        }
+        if (ch.done == ch.length)
+            ch.active = false;
+    }
+    return moved;
+}
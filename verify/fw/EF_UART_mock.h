@@ -0,0 +1,208 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file EF_UART_mock.h
+    \brief Host-side model of the EF_UART registers used to run the firmware driver on Linux.
+
+    The header overrides the IO_TYPES of EF_UART_regs.h with a C++ register cell that forwards every
+    read and write of EF_UART_REGS to a behavioural model of the UART (FIFOs, flags, baud timing).
+    It has to be included before EF_UART.h; the Makefile force-includes it when compiling fw/EF_UART.c.
+*/
+
+#ifndef EF_UART_MOCK_H
+#define EF_UART_MOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+#include <vector>
+
+/**
+ * @brief A 32-bit register cell; reads and writes are forwarded to the \ref EF_UART_Mock that owns the cell
+ */
+class ef_uart_mock_reg {
+public:
+    operator uint32_t() const;
+    ef_uart_mock_reg &operator=(uint32_t value);
+    ef_uart_mock_reg &operator|=(uint32_t value) { return *this = static_cast<uint32_t>(*this) | value; }
+    ef_uart_mock_reg &operator&=(uint32_t value) { return *this = static_cast<uint32_t>(*this) & value; }
+    ef_uart_mock_reg &operator^=(uint32_t value) { return *this = static_cast<uint32_t>(*this) ^ value; }
+
+private:
+    uint32_t storage;       // keeps the cell 32 bits wide so that the offsets match the hardware
+};
+
+#define IO_TYPES
+#define   __R     ef_uart_mock_reg
+#define   __W     ef_uart_mock_reg
+#define   __RW    ef_uart_mock_reg
+
+class EF_UART_Mock;
+extern EF_UART_Mock ef_uart_mock0;
+
+#define EF_UART_REG_SPACE (ef_uart_mock_regs(&ef_uart_mock0))
+#define EF_UART_WAIT_FOR_IRQ(uart) ef_uart_mock_wait_irq(uart)
+
+#include <EF_UART.h>
+
+class EF_UART_Mock_DMA;
+
+/**
+ * @brief Behavioural model of one EF_UART instance behind a bus wrapper
+ *
+ * Time is counted in bus clock cycles. Every register access costs \ref bus_cycles cycles, and
+ * \ref advance lets time pass while the CPU does something else. Characters take
+ * (PR+1+PRF/16)*Samples cycles per bit on the line, using the frame format and oversampling programmed in CFG.
+ */
+class EF_UART_Mock {
+public:
+    EF_UART_REGS regs;                      ///< Register space handed to the driver.
+
+    uint64_t cycle;                         ///< Current time in bus clock cycles.
+    uint64_t bus_reads;                     ///< Number of register reads issued by the driver.
+    uint64_t bus_writes;                    ///< Number of register writes issued by the driver.
+    uint64_t wakeups;                       ///< Number of times the driver slept in EF_UART_WAIT_FOR_IRQ until irq() rose.
+    unsigned bus_cycles;                    ///< Cycles charged for every register access.
+    std::vector<uint16_t> tx_line;          ///< Characters that left the transmitter, in order.
+    EF_UART_Mock_DMA *dma;                  ///< DMA controller on the handshake lines, nullptr when none is attached.
+    bool cts_n;                             ///< Clear to send input; the other side holds the transmitter while it is high.
+    std::vector<EF_UART_Mock *> multi;      ///< Channels of the EF_UART_MULTI top this window belongs to; IRQ_SUMMARY reads their irq().
+
+    explicit EF_UART_Mock(unsigned fifo_depth = EF_UART_FIFO_DEPTH, unsigned samples = 8);
+    ~EF_UART_Mock();
+
+    void reset();
+
+    uint32_t bus_read(uint32_t offset);
+    void bus_write(uint32_t offset, uint32_t value);
+
+    void advance(uint64_t cycles);
+    void receive(const uint8_t *data, size_t length);
+    void receive_error(uint8_t data, uint32_t tags);   ///< Receives a character with the FE, PE and BRK tags of RXDATA.
+    void receive_address(uint8_t address);            ///< Receives a 9-bit multidrop address frame.
+    void receive_noisy(uint8_t data);                 ///< Receives a character with a glitch on the centre sample of bit 0.
+    void receive_sync(uint8_t data, uint64_t bit_cycles);   ///< Sends an 8N1 character at a rate of its own to the autobaud unit, once it is armed.
+    bool irq();
+    void wait_irq();                        ///< Lets time pass until irq() rises, like a CPU in a wait for interrupt instruction.
+    bool tx_idle() const;
+    bool rx_idle() const;
+    bool rts_n() const;                     ///< Request to send output; the other side only starts characters while it is low.
+    bool de() const;                        ///< RS-485 driver enable output.
+    uint64_t char_cycles() const;
+
+    bool tx_dma_req() const;
+    bool tx_dma_single() const;
+    bool rx_dma_req() const;
+    bool rx_dma_single() const;
+    void dma_write(uint32_t value);         ///< TXDATA write of the DMA controller; runs in parallel to the CPU.
+    uint32_t dma_read();                    ///< RXDATA read of the DMA controller; runs in parallel to the CPU.
+
+    static EF_UART_Mock *owner(const void *cell, uint32_t *offset);
+
+private:
+    unsigned depth;
+    unsigned sc;
+
+    uint32_t pr, prf, ctrl, cfg, match, match_mask, rts, de_timing, abr, coal, coal_time, sync, sync_mask, sync_ctrl, crc_poly, crc_init, crc_ctrl, gap, rx_threshold, tx_threshold, im, ris, gclk;
+
+    std::deque<uint16_t> tx_fifo;
+    std::deque<uint16_t> rx_fifo;
+    std::deque<uint16_t> rx_line;           // characters waiting to be sent to the receiver
+    uint16_t tx_shift;                      // character in the transmit shift register
+    uint64_t tx_done_at;                    // 0 when the transmitter is idle
+    uint64_t rx_done_at;                    // 0 when the receiver is idle
+    uint64_t rto_at;                        // next time the receiver timeout flag is raised
+    bool selected;                          // multidrop: the last address frame matched
+    bool de_on;
+    uint64_t de_ready_at;                   // end of the lead time of de
+    uint64_t de_off_at;                     // end of the lag time of de; 0 while characters are sent
+    bool sync_pending;                      // a sync character waits for the autobaud unit
+    uint8_t sync_data;
+    uint64_t sync_bit_cycles;
+    bool abr_measured;                      // the autobaud unit is done until CTRL.abren is cleared
+    uint64_t abr_done_at;                   // end of the measurement window; 0 while not measuring
+    uint32_t abr_result;
+    uint32_t coal_rx_n;                     // characters counted towards the next COAL event
+    uint32_t coal_tx_n;
+    uint64_t coal_due_at;                   // end of the COAL_TIME bound; 0 while nothing is counted or without a bound
+    EF_UART_STATS stats;                    // live counters
+    EF_UART_STATS stats_snap;               // counters captured by the last STATS_SNAP write
+    uint32_t sync_hist;                     // the 3 characters before the current one, the last one in bits 7:0
+    unsigned sync_n;                        // characters in sync_hist since the search started
+    bool sync_locked;                       // hunt mode: the sync word has been seen
+    uint32_t crc_tx;                        // CRC registers, left aligned in 32 bits like the RTL
+    uint32_t crc_rx;
+    uint64_t gap_at;                        // end of the idle gap after the last character; 0 when none is counted
+    uint32_t frame_n;                       // characters of the open frame in the RX FIFO
+    uint32_t frame_err;                     // FE, PE, OR and MERGED bits of the open frame
+    bool frame_late;                        // the gap was reached while the descriptor FIFO was full
+    std::deque<uint32_t> frames;            // frame descriptors, 4 at most
+
+    uint64_t bit_cycles() const;
+    unsigned samples() const;
+    void restart_timeout();
+    void update_flags();
+    void coal_count(bool rx, bool last);
+    bool sync_detect(uint16_t data);
+    unsigned crc_shift() const;
+    uint32_t crc_update(uint32_t crc, uint16_t data) const;
+    uint32_t crc_out(uint32_t crc) const;
+    void frame_end();
+    static void count_error(uint32_t &counter);
+    void step(uint64_t until);
+};
+
+/**
+ * @brief Behavioural DMA controller wired to the handshake lines of an \ref EF_UART_Mock
+ *
+ * A channel moves a whole burst on every burst request and, once fewer than a burst are left, one byte on every
+ * single request. Requests are served as soon as they rise, and the accesses do not cost CPU bus cycles.
+ */
+class EF_UART_Mock_DMA {
+public:
+    EF_UART_DMA_CONTROLLER controller;      ///< Handed to EF_UART_initDMA.
+    uint64_t accesses;                      ///< Data register accesses made by the controller.
+    uint64_t requests;                      ///< Requests served, i.e. ack pulses.
+    bool refuse;                            ///< Makes start fail.
+
+    explicit EF_UART_Mock_DMA(EF_UART_Mock &mock);
+    ~EF_UART_Mock_DMA();
+
+    bool serve();                           ///< Serves the pending requests; true when anything was moved.
+
+private:
+    struct channel {
+        bool active;
+        uint8_t *memory;
+        uint32_t length;
+        uint32_t done;
+        uint32_t burst;
+    };
+
+    EF_UART_Mock &uart;
+    channel channels[2];
+
+    static bool start(void *context, enum dma_direction direction, uintptr_t data_register, uintptr_t memory, uint32_t length, uint32_t burst);
+    static uint32_t remaining(void *context, enum dma_direction direction);
+    static void stop(void *context, enum dma_direction direction);
+};
+
+static inline EF_UART_REGS *ef_uart_mock_regs(EF_UART_Mock *mock) { return &mock->regs; }
+static inline void ef_uart_mock_wait_irq(EF_UART_REGS *regs) { uint32_t offset; EF_UART_Mock::owner(regs, &offset)->wait_irq(); }
+
+#endif // EF_UART_MOCK_H
@@ -0,0 +1,974 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file bench_EF_UART.cpp
+    \brief Compares the bus traffic and the CPU time spent in the driver for the polled and the interrupt driven modes.
+
+    Cycles are bus clock cycles of the register model; "busy" counts the cycles the CPU spends inside
+    driver calls, "total" the time until the last byte is on the line.
+*/
+
+#include <EF_UART_mock.h>
+#include <EF_UART_log.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#define BENCH_BYTES 4096
+
+static EF_UART_Mock &uart = ef_uart_mock0;
+
+struct bench_result {
+    uint64_t accesses;
+    uint64_t busy;
+    uint64_t total;
+    double host_ns;
+};
+
+static void setup(void){
+
+    uart.reset();
+    EF_DRIVER_UART0.setPrescaler(0);
+    EF_DRIVER_UART0.setCTRL(EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_TXEN_MASK | EF_UART_CTRL_REG_RXEN_MASK);
+}
+
+static void print(const char *name, const bench_result &r){
+
+    printf("%-10s %10.2f %14.1f %14.1f %8.1f%% %12.1f\n", name,
+           (double)r.accesses / BENCH_BYTES, (double)r.busy / BENCH_BYTES, (double)r.total / BENCH_BYTES,
+           100.0 * r.busy / r.total, r.host_ns / BENCH_BYTES);
+}
+
+static bench_result tx_polled(void){
+
+    std::vector<char> text(BENCH_BYTES + 1, 'a');
+    text[BENCH_BYTES] = 0;
+
+    setup();
+    EF_DRIVER_UART0.setTxFIFOThreshold(EF_UART_IRQ_TX_THRESHOLD);
+    uint64_t start = uart.cycle;
+    auto t0 = std::chrono::steady_clock::now();
+    EF_DRIVER_UART0.writeCharArr(text.data());
+    auto t1 = std::chrono::steady_clock::now();
+    uint64_t busy = uart.cycle - start;
+    while (!uart.tx_idle())
+        uart.advance(16);
+    return {uart.bus_reads + uart.bus_writes, busy, uart.cycle - start,
+            (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()};
+}
+
+static bench_result tx_buffer(void){
+
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+
+    setup();
+    uint64_t start = uart.cycle;
+    auto t0 = std::chrono::steady_clock::now();
+    EF_DRIVER_UART0.writeBuffer(data.data(), data.size());
+    auto t1 = std::chrono::steady_clock::now();
+    uint64_t busy = uart.cycle - start;
+    while (!uart.tx_idle())
+        uart.advance(16);
+    return {uart.bus_reads + uart.bus_writes, busy, uart.cycle - start,
+            (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()};
+}
+
+static bench_result tx_irq(void){
+
+    static uint8_t tx[256], rx[16];
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+
+    setup();
+    EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    uint64_t start = uart.cycle;
+    uint64_t busy = 0;
+    uint32_t sent = 0;
+    std::chrono::nanoseconds host(0);
+    while ((sent < BENCH_BYTES) || !uart.tx_idle()){
+        uint64_t before = uart.cycle;
+        auto t0 = std::chrono::steady_clock::now();
+        if (sent < BENCH_BYTES)
+            sent += EF_DRIVER_UART0.write(&data[sent], BENCH_BYTES - sent);
+        if (uart.irq())
+            EF_UART_IRQHandler();
+        host += std::chrono::steady_clock::now() - t0;
+        busy += uart.cycle - before;
+        uart.advance(16);
+    }
+    return {uart.bus_reads + uart.bus_writes - accesses, busy, uart.cycle - start, (double)host.count()};
+}
+
+static bench_result rx_polled(void){
+
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+
+    setup();
+    uart.receive(data.data(), data.size());
+    uint64_t start = uart.cycle;
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < BENCH_BYTES; i++)
+        EF_DRIVER_UART0.readChar();
+    auto t1 = std::chrono::steady_clock::now();
+    return {uart.bus_reads + uart.bus_writes, uart.cycle - start, uart.cycle - start,
+            (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()};
+}
+
+static bench_result rx_buffer(void){
+
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+
+    setup();
+    uart.receive(data.data(), data.size());
+    uint64_t start = uart.cycle;
+    auto t0 = std::chrono::steady_clock::now();
+    EF_DRIVER_UART0.readBuffer(data.data(), data.size());
+    auto t1 = std::chrono::steady_clock::now();
+    return {uart.bus_reads + uart.bus_writes, uart.cycle - start, uart.cycle - start,
+            (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()};
+}
+
+static bench_result rx_irq(void){
+
+    static uint8_t tx[16], rx[256];
+    uint8_t out[256];
+
+    setup();
+    EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+    uart.receive(data.data(), data.size());
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    uint64_t start = uart.cycle;
+    uint64_t busy = 0;
+    uint32_t received = 0;
+    std::chrono::nanoseconds host(0);
+    while (received < BENCH_BYTES){
+        uint64_t before = uart.cycle;
+        auto t0 = std::chrono::steady_clock::now();
+        if (uart.irq())
+            EF_UART_IRQHandler();
+        received += EF_DRIVER_UART0.read(out, sizeof(out));
+        host += std::chrono::steady_clock::now() - t0;
+        busy += uart.cycle - before;
+        uart.advance(16);
+    }
+    return {uart.bus_reads + uart.bus_writes - accesses, busy, uart.cycle - start, (double)host.count()};
+}
+
+// The CPU starts the transfer and polls its progress once per character time; the DMA controller moves the data
+static bench_result tx_dma(void){
+
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+    EF_UART_Mock_DMA dma(uart);
+
+    setup();
+    EF_DRIVER_UART0.initDMA(&dma.controller);
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    uint64_t start = uart.cycle;
+    uint64_t busy = 0;
+    std::chrono::nanoseconds host(0);
+    bool done = false;
+    while (!done || !uart.tx_idle()){
+        uint64_t before = uart.cycle;
+        auto t0 = std::chrono::steady_clock::now();
+        if (before == start)
+            EF_DRIVER_UART0.startTxDMA(data.data(), data.size());
+        else if (!done && (EF_DRIVER_UART0.getDMACount(DMA_TX) == BENCH_BYTES))
+            done = EF_DRIVER_UART0.completeDMA(DMA_TX) == BENCH_BYTES;
+        host += std::chrono::steady_clock::now() - t0;
+        busy += uart.cycle - before;
+        uart.advance(uart.char_cycles());
+    }
+    return {uart.bus_reads + uart.bus_writes - accesses, busy, uart.cycle - start, (double)host.count()};
+}
+
+static bench_result rx_dma(void){
+
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+    std::vector<uint8_t> out(BENCH_BYTES);
+    EF_UART_Mock_DMA dma(uart);
+
+    setup();
+    EF_DRIVER_UART0.initDMA(&dma.controller);
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    uint64_t start = uart.cycle;
+    uint64_t busy = 0;
+    std::chrono::nanoseconds host(0);
+    auto t0 = std::chrono::steady_clock::now();
+    EF_DRIVER_UART0.startRxDMA(out.data(), out.size());
+    host += std::chrono::steady_clock::now() - t0;
+    busy += uart.cycle - start;
+    uart.receive(data.data(), data.size());
+    bool done = false;
+    while (!done){
+        uart.advance(uart.char_cycles());
+        uint64_t before = uart.cycle;
+        t0 = std::chrono::steady_clock::now();
+        if (EF_DRIVER_UART0.getDMACount(DMA_RX) == BENCH_BYTES)
+            done = EF_DRIVER_UART0.completeDMA(DMA_RX) == BENCH_BYTES;
+        host += std::chrono::steady_clock::now() - t0;
+        busy += uart.cycle - before;
+    }
+    return {uart.bus_reads + uart.bus_writes - accesses, busy, uart.cycle - start, (double)host.count()};
+}
+
+// Bus accesses needed to move one FIFO worth of data when the CPU never waits for the line
+static double tx_burst(bool buffer){
+
+    const uint32_t count = EF_UART_FIFO_DEPTH - 1;
+    char text[EF_UART_FIFO_DEPTH] = {0};
+
+    setup();
+    EF_DRIVER_UART0.disableTx();
+    EF_DRIVER_UART0.setTxFIFOThreshold(count);
+    for (uint32_t i = 0; i < count; i++)
+        text[i] = 'a';
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    if (buffer)
+        EF_DRIVER_UART0.writeBuffer((const uint8_t *)text, count);
+    else
+        EF_DRIVER_UART0.writeCharArr(text);
+    return (double)(uart.bus_reads + uart.bus_writes - accesses) / count;
+}
+
+static double rx_burst(bool buffer){
+
+    const uint32_t count = EF_UART_FIFO_DEPTH;
+    uint8_t data[EF_UART_FIFO_DEPTH] = {0};
+
+    setup();
+    uart.receive(data, count);
+    uart.advance((count + 1) * uart.char_cycles());
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    if (buffer)
+        EF_DRIVER_UART0.readBuffer(data, count);
+    else
+        for (uint32_t i = 0; i < count; i++)
+            EF_DRIVER_UART0.readChar();
+    return (double)(uart.bus_reads + uart.bus_writes - accesses) / count;
+}
+
+// The same with the bytes that had an error identified; RIS after every character against the RXDATA tags
+static double rx_burst_errors(bool tagged){
+
+    const uint32_t count = EF_UART_FIFO_DEPTH;
+    uint8_t data[EF_UART_FIFO_DEPTH] = {0};
+    uint32_t errors[(EF_UART_FIFO_DEPTH + 31) / 32] = {0};
+
+    setup();
+    uart.receive(data, count);
+    uart.advance((count + 1) * uart.char_cycles());
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    if (tagged)
+        EF_DRIVER_UART0.readBufferTagged(data, errors, count);
+    else
+        for (uint32_t i = 0; i < count; i++){
+            data[i] = EF_DRIVER_UART0.readChar();
+            if (EF_DRIVER_UART0.getRIS() & (EF_UART_FE_FLAG | EF_UART_PRE_FLAG | EF_UART_BRK_FLAG)){
+                errors[i / 32] |= 1u << (i % 32);
+                EF_DRIVER_UART0.setICR(EF_UART_FE_FLAG | EF_UART_PRE_FLAG | EF_UART_BRK_FLAG);
+            }
+        }
+    return (double)(uart.bus_reads + uart.bus_writes - accesses) / count;
+}
+
+// Bus accesses to switch a running UART to another baud rate and frame format
+static uint64_t reconfigure(bool apply){
+
+    setup();
+    EF_DRIVER_UART0.setTxFIFOThreshold(EF_UART_IRQ_TX_THRESHOLD);
+    EF_UART_CONFIG config;
+    EF_DRIVER_UART0.readConfig(&config);
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    if (apply){
+        EF_UART_configSetPrescaler(&config, 7);
+        EF_UART_configSetParityType(EF_UART_configSetDataSize(&config, 7), EVEN);
+        EF_UART_configSetTwoStopBitsSelect(&config, true);
+        EF_DRIVER_UART0.applyConfig(&config);
+    } else {
+        EF_DRIVER_UART0.disable();
+        EF_DRIVER_UART0.setPrescaler(7);
+        EF_DRIVER_UART0.setDataSize(7);
+        EF_DRIVER_UART0.setParityType(EVEN);
+        EF_DRIVER_UART0.setTwoStopBitsSelect(true);
+        EF_DRIVER_UART0.enable();
+    }
+    return uart.bus_reads + uart.bus_writes - accesses;
+}
+
+// Interrupts and bus accesses per received line, for lines with idle gaps in between
+#define BENCH_FRAMES 64
+
+static void frames(const char *name, int mode){
+
+    static uint8_t tx[16], rx[256];
+    const char *line = "status 12\n";
+    const uint32_t length = 10;
+    uint8_t out[64];
+    uint32_t received = 0;
+    uint64_t interrupts = 0;
+
+    setup();
+    if (mode != 0){
+        EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+        if (mode == 2)
+            EF_DRIVER_UART0.enableFrameMode('\n');
+    }
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    for (unsigned f = 0; f < BENCH_FRAMES; f++){
+        uart.receive((const uint8_t *)line, length);
+        if (mode == 0){
+            // readUntil sleeps on the interrupt line; every wakeup is an interrupt
+            uint64_t wakeups = uart.wakeups;
+            received += EF_DRIVER_UART0.readUntil('\n', out, sizeof(out));
+            interrupts += uart.wakeups - wakeups;
+            uart.advance(10 * length * uart.char_cycles());
+            continue;
+        }
+        // the line is idle for ten times as long as the frame took
+        for (uint64_t end = uart.cycle + 11 * length * uart.char_cycles(); uart.cycle < end; uart.advance(16)){
+            if (uart.irq()){
+                EF_UART_IRQHandler();
+                interrupts++;
+            }
+        }
+        received += (mode == 1) ? EF_DRIVER_UART0.read(out, sizeof(out)) : EF_DRIVER_UART0.readFrame(out, sizeof(out));
+    }
+    printf("%-10s %10.2f %10.2f %10s\n", name, (double)interrupts / BENCH_FRAMES,
+           (double)(uart.bus_reads + uart.bus_writes - accesses) / BENCH_FRAMES, received == BENCH_FRAMES * length ? "ok" : "lost");
+}
+
+// Baud rate error of the integer prescaler alone and with the prescaler fraction, in ppm
+static void baud_error(uint32_t clk_hz, uint32_t baud){
+
+    uint32_t pr, prf;
+    int32_t fractional = EF_UART_calcBaudRate(clk_hz, baud, EF_UART_SAMPLES, &pr, &prf);
+    // the best integer prescaler is one of the two around the fractional one
+    int32_t integer = INT32_MAX;
+    for (uint32_t candidate = (pr > 0) ? pr - 1 : 0; candidate <= pr + 1; candidate++){
+        double achieved = (double)clk_hz / ((candidate + 1.0) * EF_UART_SAMPLES);
+        int32_t error = (int32_t)((achieved - baud) * 1e6 / baud);
+        if (abs(error) < abs(integer))
+            integer = error;
+    }
+    printf("%-10u %10d %10d %6u.%-2u\n", baud, integer, fractional, pr, prf);
+}
+
+// Highest baud rate and the measured receive throughput of readBuffer at PR=0 for one oversampling ratio,
+// or for the synchronous mode with the UART driving sclk
+static void oversampling(const char *name, enum oversampling_type osr, bool synchronous, uint32_t clk_hz){
+
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+
+    setup();
+    EF_DRIVER_UART0.setOversampling(osr);
+    EF_DRIVER_UART0.setSynchronous(synchronous, false);
+    uint32_t samples = EF_DRIVER_UART0.getSamplesPerBit();
+    uart.receive(data.data(), data.size());
+    uint64_t start = uart.cycle;
+    EF_DRIVER_UART0.readBuffer(data.data(), data.size());
+    double seconds = (double)(uart.cycle - start) / clk_hz;
+    printf("%-10s %10u %12u %12.0f\n", name, samples, clk_hz / samples, BENCH_BYTES / seconds);
+}
+
+// Receive interrupts in the interrupt driven mode for one FIFO depth, and their interval at 3 Mbaud 8N1
+static void rx_irq_depth(unsigned depth){
+
+    EF_UART_Mock mock(depth);
+    static uint8_t tx[16], rx[2 * BENCH_BYTES];
+    static EF_UART_IRQ_STATE state;
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+
+    EF_UART_setCTRL(&mock.regs, EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_RXEN_MASK);
+    EF_UART_initIRQMode(&mock.regs, &state, tx, sizeof(tx), rx, sizeof(rx));
+    mock.receive(data.data(), data.size());
+    uint64_t interrupts = 0;
+    while (state.rx.head - state.rx.tail < BENCH_BYTES){
+        mock.advance(16);
+        if (mock.irq()){
+            EF_UART_handleIRQ(&state);
+            interrupts++;
+        }
+    }
+    double interval_us = (double)BENCH_BYTES / interrupts * 10 / 3e6 * 1e6;
+    printf("%-10u %10.3f %14.1f\n", depth, (double)interrupts / BENCH_BYTES, interval_us);
+}
+
+// Interrupt driven receive with the handler entered the given number of character times after the interrupt
+static void rx_irq_latency(unsigned latency){
+
+    static uint8_t tx[16], rx[2 * BENCH_BYTES];
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+    uint64_t lost[2], cycles[2];
+
+    for (int rts = 0; rts < 2; rts++){
+        setup();
+        EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+        EF_DRIVER_UART0.setFlowControl(rts, false, EF_UART_RTS_LEVEL_OF(EF_UART_FIFO_DEPTH));
+        uart.receive(data.data(), data.size());
+        uint64_t start = uart.cycle;
+        uint64_t received = 0;
+        while (!uart.rx_idle() || (uart.bus_read(offsetof(EF_UART_REGS, STATUS)) & EF_UART_STATUS_REG_RXLVL_MASK)){
+            uart.advance(16);
+            if (uart.irq()){
+                uart.advance(latency * uart.char_cycles());
+                EF_UART_IRQHandler();
+            }
+            received += EF_DRIVER_UART0.read(rx, sizeof(rx));
+        }
+        lost[rts] = BENCH_BYTES - received;
+        cycles[rts] = uart.cycle - start;
+    }
+    printf("%-10u %10llu %10llu %14.2f\n", latency, (unsigned long long)lost[0], (unsigned long long)lost[1],
+           (double)cycles[1] / BENCH_BYTES / uart.char_cycles());
+}
+
+// Interrupt driven receive on a shared 9-bit multidrop bus; every node gets a packet of an address and 10 bytes in turn
+#define BENCH_NODES 30
+#define BENCH_PACKETS 16
+
+static void multidrop(const char *name, bool filter){
+
+    static uint8_t tx[16], rx[8192];
+    const uint8_t payload[10] = {'p', 'a', 'y', 'l', 'o', 'a', 'd', '0', '1', '2'};
+    uint64_t interrupts = 0;
+    uint64_t received = 0;
+
+    setup();
+    EF_DRIVER_UART0.setDataSize(9);
+    EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+    EF_DRIVER_UART0.setMultidrop(filter, 5, 0);
+    for (unsigned p = 0; p < BENCH_PACKETS; p++)
+        for (unsigned node = 0; node < BENCH_NODES; node++){
+            uart.receive_address(node);
+            uart.receive(payload, sizeof(payload));
+        }
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    while (!uart.rx_idle() || (uart.bus_read(offsetof(EF_UART_REGS, STATUS)) & EF_UART_STATUS_REG_RXLVL_MASK)){
+        uart.advance(16);
+        if (uart.irq()){
+            EF_UART_IRQHandler();
+            interrupts++;
+        }
+        received += EF_DRIVER_UART0.read(rx, sizeof(rx));
+    }
+    // the bytes of node 5, its address included
+    double own = BENCH_PACKETS * (1 + sizeof(payload));
+    printf("%-10s %10.3f %10.2f %10llu\n", name, interrupts / own, (uart.bus_reads + uart.bus_writes - accesses) / own,
+           (unsigned long long)received);
+}
+
+// Interrupt driven full duplex traffic: messages of BENCH_MSG_BYTES arrive with idle gaps of BENCH_MSG_GAP characters
+// while BENCH_BYTES are streamed out; the latency is from the last stop bit of a message to its last byte in the ring buffer
+#define BENCH_MSG_BYTES 16
+#define BENCH_MSG_GAP 20
+
+static void coalescing(const char *name, uint32_t rx_count, uint32_t tx_count, uint32_t time_chars){
+
+    static uint8_t tx[256], rx[256];
+    std::vector<uint8_t> data(BENCH_BYTES, 'a');
+    uint8_t out[256];
+    uint64_t interrupts = 0;
+    uint64_t latency = 0;
+    uint64_t worst = 0;
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    uint32_t messages = 0;
+
+    setup();
+    EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+    if ((rx_count != 0) || (tx_count != 0))
+        EF_DRIVER_UART0.setIRQCoalescing(rx_count, tx_count, time_chars * uart.char_cycles());
+    uint64_t next = uart.cycle;
+    uint64_t end = 0;
+    while ((received < BENCH_BYTES) || (sent < BENCH_BYTES) || !uart.tx_idle()){
+        if ((received == messages * BENCH_MSG_BYTES) && (received < BENCH_BYTES) && (uart.cycle >= next)){
+            uart.receive(data.data(), BENCH_MSG_BYTES);
+            end = uart.cycle + BENCH_MSG_BYTES * uart.char_cycles();
+            messages++;
+        }
+        if (sent < BENCH_BYTES)
+            sent += EF_DRIVER_UART0.write(data.data() + sent, BENCH_BYTES - sent);
+        uart.advance(16);
+        if (uart.irq()){
+            EF_UART_IRQHandler();
+            interrupts++;
+        }
+        uint32_t count = EF_DRIVER_UART0.read(out, sizeof(out));
+        received += count;
+        if ((count != 0) && (received == messages * BENCH_MSG_BYTES)){
+            latency += uart.cycle - end;
+            worst = std::max(worst, uart.cycle - end);
+            next = end + BENCH_MSG_GAP * uart.char_cycles();
+        }
+    }
+    printf("%-10s %10.1f %12.2f %12.2f\n", name, interrupts * 1024.0 / (2 * BENCH_BYTES),
+           (double)latency / messages / uart.char_cycles(), (double)worst / uart.char_cycles());
+}
+
+// Channels of an EF_UART_MULTI top, all in the interrupt driven mode; BENCH_MSG_BYTES messages arrive on one channel
+// after the other. The handler either reads MIS of every channel or IRQ_SUMMARY once; the idle channels still raise
+// their receiver timeouts, as the RTL does
+#define BENCH_MULTI_MESSAGES 64
+
+static void multi_channel(unsigned channels, bool summary){
+
+    std::vector<std::unique_ptr<EF_UART_Mock>> uarts;
+    std::vector<EF_UART_IRQ_STATE> states(channels);
+    std::vector<EF_UART_IRQ_STATE *> pointers;
+    std::vector<uint8_t> buffers(channels * 64);
+    const uint8_t message[BENCH_MSG_BYTES] = {0};
+    uint8_t out[32];
+    uint64_t interrupts = 0;
+    uint64_t accesses = 0;
+
+    for (unsigned i = 0; i < channels; i++){
+        uarts.push_back(std::make_unique<EF_UART_Mock>());
+        uarts[0]->multi.push_back(uarts[i].get());
+        pointers.push_back(&states[i]);
+        EF_UART_setCTRL(&uarts[i]->regs, EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_TXEN_MASK | EF_UART_CTRL_REG_RXEN_MASK);
+        EF_UART_initIRQMode(&uarts[i]->regs, &states[i], &buffers[i * 64], 32, &buffers[i * 64 + 32], 32);
+    }
+    auto bus = [&](){
+        uint64_t count = 0;
+        for (auto &u : uarts)
+            count += u->bus_reads + u->bus_writes;
+        return count;
+    };
+
+    for (unsigned m = 0; m < BENCH_MULTI_MESSAGES; m++){
+        unsigned ch = m % channels;
+        uarts[ch]->receive(message, sizeof(message));
+        for (uint32_t count = 0; count < sizeof(message); ){
+            bool irq = false;
+            for (auto &u : uarts){
+                u->advance(16);
+                irq |= u->irq();
+            }
+            if (irq){
+                uint64_t before = bus();
+                if (summary){
+                    EF_UART_handleMultiIRQ(&uarts[0]->regs, pointers.data(), channels);
+                } else {
+                    for (unsigned i = 0; i < channels; i++)
+                        if (EF_UART_getMIS(&uarts[i]->regs))
+                            EF_UART_handleIRQ(&states[i]);
+                }
+                accesses += bus() - before;
+                interrupts++;
+            }
+            count += EF_UART_read(&states[ch], out, sizeof(out));
+        }
+    }
+    printf("%-10u %-10s %10.2f %12.1f %12.1f\n", channels, summary ? "summary" : "MIS scan", (double)interrupts / BENCH_MULTI_MESSAGES,
+           (double)accesses / interrupts, (double)accesses * uarts[0]->bus_cycles / interrupts);
+}
+
+// A line shared with other traffic: every BENCH_SYNC_OTHER bytes for others, a 0xAA 0x55 preamble and a 10 byte message
+// for this node, each burst followed by an idle gap. Without the hunt the handler takes every byte and the firmware
+// scans them for the preamble; with it the receiver drops everything before the preamble, and the gap re-arms the hunt
+#define BENCH_SYNC_OTHER 48
+#define BENCH_SYNC_GAP 3
+
+static void sync_hunt(const char *name, bool hunt){
+
+    static uint8_t tx[16], rx[8192];
+    const uint8_t message[12] = {0xAA, 0x55, 'p', 'a', 'y', 'l', 'o', 'a', 'd', '0', '1', '2'};
+    uint8_t other[BENCH_SYNC_OTHER];
+    uint64_t interrupts = 0;
+    uint64_t received = 0;
+
+    for (unsigned i = 0; i < sizeof(other); i++)
+        other[i] = (i * 7 + 3) & 0x7F;
+    setup();
+    EF_DRIVER_UART0.setTimeoutBits(20);
+    EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+    EF_DRIVER_UART0.setSyncWord(hunt, 0x55AA, 0, 2, true);
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    for (unsigned p = 0; p < 2 * BENCH_PACKETS; p++){
+        uint32_t length = (p & 1) ? sizeof(message) : sizeof(other);
+        uart.receive((p & 1) ? message : other, length);
+        for (uint64_t end = uart.cycle + (length + BENCH_SYNC_GAP) * uart.char_cycles(); uart.cycle < end; ){
+            uart.advance(16);
+            if (uart.irq()){
+                EF_UART_IRQHandler();
+                interrupts++;
+            }
+            received += EF_DRIVER_UART0.read(rx, sizeof(rx));
+        }
+    }
+    printf("%-10s %10.2f %10.1f %12.1f\n", name, (double)interrupts / BENCH_PACKETS,
+           (double)(uart.bus_reads + uart.bus_writes - accesses) / BENCH_PACKETS, (double)received / BENCH_PACKETS);
+}
+
+// CRC-32 of BENCH_CRC_FRAMES frames of BENCH_CRC_BYTES bytes: appended to the frames sent, checked on the frames
+// received. In software, bit by bit as on a core without room for a table, or with a 256 entry table; with the offload,
+// a restart before the frame and one read after it. CRC_TX is complete once the frame has left the FIFO, so the CPU
+// reads it after the TXE or TC interrupt rather than polling for it. The frame itself is moved by the same driver calls
+// in every mode, so only the CRC work is counted: the register accesses of the offload, and the host time of the
+// software loops.
+#define BENCH_CRC_FRAMES 64
+#define BENCH_CRC_BYTES 64
+
+static uint32_t crc32_table[256];
+
+static uint32_t crc32_bitwise(const uint8_t *data, uint32_t length){
+
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < length; i++){
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++)
+            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+    }
+    return ~crc;
+}
+
+static uint32_t crc32_tabled(const uint8_t *data, uint32_t length){
+
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < length; i++)
+        crc = (crc >> 8) ^ crc32_table[(crc ^ data[i]) & 0xFF];
+    return ~crc;
+}
+
+static void crc(const char *name, int mode){
+
+    uint8_t frame[BENCH_CRC_BYTES + 4];
+    uint8_t out[BENCH_CRC_BYTES + 4];
+    uint64_t accesses = 0;
+    std::chrono::nanoseconds host(0);
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < 256; i++){
+        uint32_t c = i;
+        for (int b = 0; b < 8; b++)
+            c = (c >> 1) ^ ((c & 1) ? 0xEDB88320 : 0);
+        crc32_table[i] = c;
+    }
+    setup();
+    EF_DRIVER_UART0.setCRC(mode == 2, 32, 0x04C11DB7, 0xFFFFFFFF, true, true);
+    for (unsigned f = 0; f < BENCH_CRC_FRAMES; f++){
+        for (unsigned i = 0; i < BENCH_CRC_BYTES; i++)
+            frame[i] = (f * 31 + i * 7) & 0xFF;
+
+        // send the frame and append its CRC
+        uint32_t value = 0;
+        uint64_t before = uart.bus_reads + uart.bus_writes;
+        auto t0 = std::chrono::steady_clock::now();
+        if (mode == 0)
+            value = crc32_bitwise(frame, BENCH_CRC_BYTES);
+        else if (mode == 1)
+            value = crc32_tabled(frame, BENCH_CRC_BYTES);
+        else
+            EF_DRIVER_UART0.crcReset(true, false);
+        host += std::chrono::steady_clock::now() - t0;
+        accesses += uart.bus_reads + uart.bus_writes - before;
+        EF_DRIVER_UART0.writeBuffer(frame, BENCH_CRC_BYTES);
+        if (mode == 2){
+            while (!uart.tx_idle())
+                uart.advance(16);
+            before = uart.bus_reads + uart.bus_writes;
+            EF_DRIVER_UART0.crcGetTx(&value, 0);
+            accesses += uart.bus_reads + uart.bus_writes - before;
+        }
+        for (int i = 0; i < 4; i++)
+            frame[BENCH_CRC_BYTES + i] = value >> (8 * i);
+        EF_DRIVER_UART0.writeBuffer(frame + BENCH_CRC_BYTES, 4);
+
+        // receive it back and check it
+        if (mode == 2){
+            before = uart.bus_reads + uart.bus_writes;
+            EF_DRIVER_UART0.crcReset(false, true);
+            accesses += uart.bus_reads + uart.bus_writes - before;
+        }
+        uart.receive(frame, sizeof(frame));
+        EF_DRIVER_UART0.readBuffer(out, sizeof(out));
+        before = uart.bus_reads + uart.bus_writes;
+        t0 = std::chrono::steady_clock::now();
+        bool good;
+        if (mode == 0)
+            good = crc32_bitwise(out, BENCH_CRC_BYTES) == (out[64] | out[65] << 8 | out[66] << 16 | (uint32_t)out[67] << 24);
+        else if (mode == 1)
+            good = crc32_tabled(out, BENCH_CRC_BYTES) == (out[64] | out[65] << 8 | out[66] << 16 | (uint32_t)out[67] << 24);
+        else
+            good = EF_DRIVER_UART0.crcGetRx() == EF_UART_CRC32_RESIDUE;
+        host += std::chrono::steady_clock::now() - t0;
+        accesses += uart.bus_reads + uart.bus_writes - before;
+        errors += !good;
+    }
+    printf("%-10s %10.1f %12.1f %12.1f %8u\n", name, (double)accesses / BENCH_CRC_FRAMES,
+           (double)accesses * uart.bus_cycles / BENCH_CRC_FRAMES,
+           (mode == 2) ? 0.0 : (double)std::chrono::duration_cast<std::chrono::nanoseconds>(host).count() / BENCH_CRC_FRAMES, errors);
+}
+
+// Modbus RTU style traffic: BENCH_GAP_FRAMES frames of 4 to 16 bytes with a pause of one character inside, 4
+// character times apart. In software the interrupt driven frame mode ends a frame on the receiver timeout, set to
+// 3.5 characters of 8N1; in hardware the EOF interrupt reads each frame with its descriptor in one burst.
+#define BENCH_GAP_FRAMES 64
+
+static void gap_frames(const char *name, bool descriptor){
+
+    static uint8_t tx[16], rx[256];
+    uint8_t frame[16], out[64];
+    uint64_t interrupts = 0;
+    uint32_t good = 0;
+    uint32_t errors;
+
+    setup();
+    if (descriptor){
+        EF_DRIVER_UART0.setFrameGap(EF_UART_GAP_MODBUS_T35);
+        EF_DRIVER_UART0.setIM(EF_UART_EOF_FLAG);
+    } else {
+        EF_DRIVER_UART0.setTimeoutBits(35);
+        EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+        EF_DRIVER_UART0.enableFrameMode(-1);
+    }
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    for (unsigned f = 0; f < BENCH_GAP_FRAMES; f++){
+        uint32_t length = 4 + (f * 5) % 13;
+        for (uint32_t i = 0; i < length; i++)
+            frame[i] = (f * 31 + i * 7) & 0xFF;
+        // two bytes, a pause of one character, the rest, and the line idle for 4 characters
+        for (int part = 0; part < 2; part++){
+            uint32_t n = part ? length - 2 : 2;
+            uart.receive(part ? frame + 2 : frame, n);
+            for (uint64_t end = uart.cycle + (n + (part ? 4 : 1)) * uart.char_cycles(); uart.cycle < end; ){
+                uart.advance(16);
+                if (!uart.irq())
+                    continue;
+                interrupts++;
+                if (!descriptor){
+                    EF_UART_IRQHandler();
+                    continue;
+                }
+                EF_DRIVER_UART0.setICR(EF_UART_EOF_FLAG);
+                uint32_t count;
+                while ((count = EF_DRIVER_UART0.readGapFrame(out, sizeof(out), &errors)) != 0)
+                    good += (count == length) && (memcmp(out, frame, length) == 0);
+            }
+        }
+        if (!descriptor){
+            uint32_t n;
+            while ((n = EF_DRIVER_UART0.readFrame(out, sizeof(out))) != 0)
+                good += (n == length) && (memcmp(out, frame, length) == 0);
+        }
+    }
+    printf("%-10s %10.2f %10.2f %10u\n", name, (double)interrupts / BENCH_GAP_FRAMES,
+           (double)(uart.bus_reads + uart.bus_writes - accesses) / BENCH_GAP_FRAMES, good);
+}
+
+#define BENCH_LOG_LINES 2000
+#define BENCH_LOG_FORMAT "t=%u adc=%d state=%s\n"
+
+// Cost of a burst of log lines at the call site: formatted and sent with writeCharArr, or recorded by EF_UART_LOG
+// and sent later by the idle hook and the TX refill hook
+static void log_call(const char *name, bool deferred){
+
+    static uint8_t tx[256], rx[16];
+    static uintptr_t records[16384];
+    EF_UART_LOG log;
+    char line[64];
+    uint64_t busy = 0, drain_accesses = 0;
+    std::chrono::nanoseconds host(0);
+
+    setup();
+    EF_DRIVER_UART0.setTxFIFOThreshold(EF_UART_IRQ_TX_THRESHOLD);
+    if (deferred){
+        EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+        EF_UART_logInit(&log, EF_UART_getIRQState(), records, sizeof(records) / sizeof(records[0]));
+    }
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    uint64_t start = uart.cycle;
+    for (uint32_t i = 0; i < BENCH_LOG_LINES; i++){
+        uint64_t before = uart.cycle;
+        auto t0 = std::chrono::steady_clock::now();
+        if (deferred){
+            EF_UART_LOG(&log, BENCH_LOG_FORMAT, i, -(int32_t)i, "idle");
+        } else {
+            snprintf(line, sizeof(line), BENCH_LOG_FORMAT, i, -(int32_t)i, "idle");
+            EF_DRIVER_UART0.writeCharArr(line);
+        }
+        host += std::chrono::steady_clock::now() - t0;
+        busy += uart.cycle - before;
+    }
+    uint64_t call_accesses = uart.bus_reads + uart.bus_writes - accesses;
+    if (deferred){
+        while (!uart.tx_idle() || (EF_UART_logProcess(&log) != 0)){
+            uint64_t before = uart.bus_reads + uart.bus_writes;
+            EF_UART_logProcess(&log);
+            if (uart.irq())
+                EF_UART_IRQHandler();
+            drain_accesses += uart.bus_reads + uart.bus_writes - before;
+            uart.advance(16);
+        }
+    }
+    while (!uart.tx_idle())
+        uart.advance(16);
+    printf("%-10s %10.2f %12.1f %12.1f %12.2f %12.1f\n", name, (double)call_accesses / BENCH_LOG_LINES,
+           (double)busy / BENCH_LOG_LINES, (double)host.count() / BENCH_LOG_LINES, (double)drain_accesses / BENCH_LOG_LINES,
+           (double)(uart.cycle - start) / BENCH_LOG_LINES);
+}
+
+// One deferred log line every interval cycles with a buffer of 1024 words; lines sent per second at 50 MHz and drops
+static void log_rate(uint64_t interval){
+
+    static uint8_t tx[256], rx[16];
+    static uintptr_t records[1024];
+    EF_UART_LOG log;
+
+    setup();
+    EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx));
+    EF_UART_logInit(&log, EF_UART_getIRQState(), records, sizeof(records) / sizeof(records[0]));
+    uint64_t start = uart.cycle;
+    uint32_t i = 0;
+    while ((i < BENCH_LOG_LINES) || !uart.tx_idle() || (EF_UART_logProcess(&log) != 0)){
+        if ((i < BENCH_LOG_LINES) && (uart.cycle - start >= i * interval)){
+            EF_UART_LOG(&log, BENCH_LOG_FORMAT, i, -(int32_t)i, "idle");
+            i++;
+        }
+        EF_UART_logProcess(&log);
+        if (uart.irq())
+            EF_UART_IRQHandler();
+        uart.advance(16);
+    }
+    uint32_t lines = BENCH_LOG_LINES - EF_UART_logGetDropped(&log);
+    double seconds = (double)(uart.cycle - start) / 50e6;
+    printf("%-10llu %12.0f %12.0f %10u %9.1f%%\n", (unsigned long long)interval, 50e6 / interval, lines / seconds,
+           EF_UART_logGetDropped(&log), 100.0 * uart.tx_line.size() * uart.char_cycles() / (uart.cycle - start));
+}
+
+int main(void){
+
+    printf("One FIFO burst, bus accesses per byte\n");
+    printf("%-10s %10s %10s\n", "", "per char", "buffer");
+    printf("%-10s %10.2f %10.2f\n", "tx", tx_burst(false), tx_burst(true));
+    printf("%-10s %10.2f %10.2f\n", "rx", rx_burst(false), rx_burst(true));
+    printf("%-10s %10.2f %10.2f\n\n", "rx errors", rx_burst_errors(false), rx_burst_errors(true));
+
+    printf("Baud rate error at 50 MHz, ppm\n");
+    printf("%-10s %10s %10s %9s\n", "baud", "PR only", "PR+PRF", "PR.PRF");
+    const uint32_t bauds[] = {9600, 19200, 57600, 115200, 230400, 460800, 921600, 1000000, 3000000};
+    for (uint32_t baud : bauds)
+        baud_error(50000000, baud);
+    printf("\n");
+
+    printf("Oversampling at 50 MHz, PR=0\n");
+    printf("%-10s %10s %12s %12s\n", "osr", "samples", "max baud", "rx bytes/s");
+    oversampling("16x", OVERSAMPLING_16, false, 50000000);
+    oversampling("8x", OVERSAMPLING_8, false, 50000000);
+    oversampling("4x", OVERSAMPLING_4, false, 50000000);
+    oversampling("sync", OVERSAMPLING_16, true, 50000000);
+    printf("\n");
+
+    printf("FIFO depth, interrupt driven receive\n");
+    printf("%-10s %10s %14s\n", "depth", "irq/byte", "us/irq 3Mbaud");
+    rx_irq_depth(16);
+    rx_irq_depth(64);
+    rx_irq_depth(256);
+    printf("\n");
+
+    printf("Late interrupts, interrupt driven receive of %d bytes, FIFO of %d\n", BENCH_BYTES, EF_UART_FIFO_DEPTH);
+    printf("%-10s %10s %10s %14s\n", "chars late", "lost", "lost RTS", "chars/byte RTS");
+    rx_irq_latency(1);
+    rx_irq_latency(8);
+    rx_irq_latency(32);
+    printf("\n");
+
+    printf("Reconfiguration (PR, data size, parity, stop bits), bus accesses\n");
+    printf("%-10s %10s %10s\n", "", "setters", "apply");
+    printf("%-10s %10llu %10llu\n\n", "running", (unsigned long long)reconfigure(false), (unsigned long long)reconfigure(true));
+
+    printf("%d node multidrop bus, interrupt driven receive, per byte for this node\n", BENCH_NODES);
+    printf("%-10s %10s %10s %10s\n", "filter", "irq/byte", "acc/byte", "received");
+    multidrop("off", false);
+    multidrop("address", true);
+    printf("\n");
+
+    printf("Sync word on a shared line, %d bytes for others and a 12 byte message, interrupt driven receive, per message\n", BENCH_SYNC_OTHER);
+    printf("%-10s %10s %10s %12s\n", "hunt", "irq", "accesses", "bytes to CPU");
+    sync_hunt("off", false);
+    sync_hunt("0xAA55", true);
+    printf("\n");
+
+    printf("CRC-32 of %d frames of %d bytes, sent and received back, CRC work per frame\n", BENCH_CRC_FRAMES, BENCH_CRC_BYTES);
+    printf("%-10s %10s %12s %12s %8s\n", "crc", "acc/frame", "bus cyc", "host ns", "errors");
+    crc("bitwise", 0);
+    crc("table", 1);
+    crc("offload", 2);
+    printf("\n");
+
+    printf("Idle gap framing, %d frames of 4 to 16 bytes with a pause of one character inside, 4 characters apart\n", BENCH_GAP_FRAMES);
+    printf("%-10s %10s %10s %10s\n", "framing", "irq/frame", "acc/frame", "frames ok");
+    gap_frames("rto", false);
+    gap_frames("eof", true);
+    printf("\n");
+
+    printf("Interrupt coalescing, %d bytes each way, %d byte messages received, count rx/tx and time in chars\n", BENCH_BYTES, BENCH_MSG_BYTES);
+    printf("%-10s %10s %12s %12s\n", "setting", "irq/KB", "avg latency", "max latency");
+    coalescing("off", 0, 0, 0);
+    coalescing("4/4 2", 4, 4, 2);
+    coalescing("8/8 4", 8, 8, 4);
+    coalescing("16/12 8", 16, 12, 8);
+    coalescing("16/12 -", 16, 12, 0);
+    printf("\n");
+
+    printf("Logging, %d lines of \"%s\" (~28 bytes) in a burst, per line\n", BENCH_LOG_LINES, "t=%u adc=%d state=%s\\n");
+    printf("%-10s %10s %12s %12s %12s %12s\n", "log", "call acc", "call cyc", "call ns", "drain acc", "total cyc");
+    log_call("blocking", false);
+    log_call("deferred", true);
+    printf("\n");
+
+    printf("Deferred logging, %d lines at a steady rate, 1024 word buffer, %llu cycles per character\n", BENCH_LOG_LINES, (unsigned long long)uart.char_cycles());
+    printf("%-10s %12s %12s %10s %10s\n", "interval", "offered/s", "sent/s", "dropped", "line busy");
+    log_rate(4000);
+    log_rate(2400);
+    log_rate(2000);
+    log_rate(1000);
+    printf("\n");
+
+    printf("Multi-channel interrupt dispatch, %d messages of %d bytes, one channel receiving at a time\n", BENCH_MULTI_MESSAGES, BENCH_MSG_BYTES);
+    printf("%-10s %-10s %10s %12s %12s\n", "channels", "handler", "irq/msg", "acc/irq", "cycles/irq");
+    multi_channel(8, false);
+    multi_channel(8, true);
+    multi_channel(16, false);
+    multi_channel(16, true);
+    printf("\n");
+
+    printf("%d lines of 10 bytes, default receiver timeout\n", BENCH_FRAMES);
+    printf("%-10s %10s %10s %10s\n", "mode", "irq/line", "acc/line", "data");
+    frames("readUntil", 0);
+    frames("irq", 1);
+    frames("frame", 2);
+    printf("\n");
+
+    printf("%d bytes, PR=0, %u bus cycles per register access\n", BENCH_BYTES, uart.bus_cycles);
+    printf("%-10s %10s %14s %14s %9s %12s\n", "mode", "acc/byte", "busy cyc/byte", "total cyc/byte", "busy", "host ns/byte");
+    print("tx polled", tx_polled());
+    print("tx buffer", tx_buffer());
+    print("tx irq", tx_irq());
+    print("tx dma", tx_dma());
+    print("rx polled", rx_polled());
+    print("rx buffer", rx_buffer());
+    print("rx irq", rx_irq());
+    print("rx dma", rx_dma());
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file bench_EF_UART_calls.c
+    \brief Cost of a writeChar call through EF_DRIVER_UART0, through the handle based API and through EF_UART_inline.h.
+
+    The driver is built as plain C, in its own translation unit, against a RAM backed register space at a
+    link-time constant address, with TXE preset in RIS so that writeChar never waits. The Makefile prints
+    the code size of every variant.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <x86intrin.h>
+
+#include <bench_EF_UART_calls.h>
+#include <EF_UART.h>
+#include <EF_UART_inline.h>
+
+uint32_t ef_uart_ram[sizeof(EF_UART_REGS) / sizeof(uint32_t)];
+
+#define BENCH_CALLS 10000000
+
+// One call site per variant; the Makefile reports their sizes
+__attribute__((noinline)) void site_vtable_writeChar(char data){
+
+    EF_DRIVER_UART0.writeChar(data);
+}
+
+__attribute__((noinline)) void site_handle_writeChar(char data){
+
+    EF_UART_writeChar(EF_UART_REG_SPACE, data);
+}
+
+__attribute__((noinline)) void site_inline_writeChar(char data){
+
+    EF_UART_writeCharInline(EF_UART_REG_SPACE, data);
+}
+
+#define BENCH(call) ({                                          \
+    uint64_t start = __rdtsc();                                 \
+    for (uint32_t i = 0; i < BENCH_CALLS; i++)                  \
+        call;                                                   \
+    (double)(__rdtsc() - start) / BENCH_CALLS;                  \
+})
+
+int main(void){
+
+    ef_uart_ram[offsetof(EF_UART_REGS, RIS) / sizeof(uint32_t)] = EF_UART_TXE_FLAG;
+    printf("%-8s %14s\n", "variant", "tsc cycles/call");
+    printf("%-8s %14.2f\n", "vtable", BENCH(EF_DRIVER_UART0.writeChar((char)i)));
+    printf("%-8s %14.2f\n", "handle", BENCH(EF_UART_writeChar(EF_UART_REG_SPACE, (char)i)));
+    printf("%-8s %14.2f\n", "inline", BENCH(EF_UART_writeCharInline(EF_UART_REG_SPACE, (char)i)));
+    return 0;
+}
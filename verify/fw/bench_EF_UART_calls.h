@@ -0,0 +1,33 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file bench_EF_UART_calls.h
+    \brief RAM backed register space for bench_EF_UART_calls.c; force-included when building fw/EF_UART.c for it.
+
+*/
+
+#ifndef BENCH_EF_UART_CALLS_H
+#define BENCH_EF_UART_CALLS_H
+
+#include <stdint.h>
+
+extern uint32_t ef_uart_ram[];
+
+#define EF_UART_REG_SPACE ((EF_UART_REGS*)ef_uart_ram)
+
+#endif // BENCH_EF_UART_CALLS_H
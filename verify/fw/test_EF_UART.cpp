@@ -0,0 +1,1264 @@
+/*
+	Copyright 2025 Efabless Corp.
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+	    www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+
+*/
+
+
+/*! \file test_EF_UART.cpp
+    \brief Host tests of the firmware driver against the EF_UART register model.
+
+*/
+
+#include <EF_UART_mock.h>
+#include <EF_UART_log.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#define CHECK(cond) do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); exit(1); } } while (0)
+
+static EF_UART_Mock &uart = ef_uart_mock0;
+
+static void setup(uint32_t prescaler){
+
+    uart.reset();
+    EF_DRIVER_UART0.setPrescaler(prescaler);
+    EF_DRIVER_UART0.setCTRL(EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_TXEN_MASK | EF_UART_CTRL_REG_RXEN_MASK);
+}
+
+// Let the CPU idle for the given number of cycles, taking interrupts as they come
+static void run(uint64_t cycles){
+
+    uint64_t end = uart.cycle + cycles;
+    while (uart.cycle < end){
+        uart.advance(16);
+        if (uart.irq())
+            EF_UART_IRQHandler();
+    }
+}
+
+static void test_polled(void){
+
+    setup(1);
+    EF_DRIVER_UART0.setTxFIFOThreshold(4);
+    EF_DRIVER_UART0.writeCharArr("Hello");
+    run(10 * uart.char_cycles());
+    CHECK(uart.tx_line.size() == 5);
+    CHECK(memcmp(std::vector<uint8_t>(uart.tx_line.begin(), uart.tx_line.end()).data(), "Hello", 5) == 0);
+
+    EF_DRIVER_UART0.enableLoopBack();
+    EF_DRIVER_UART0.writeChar('x');
+    CHECK(EF_DRIVER_UART0.readChar() == 'x');
+}
+
+static void test_buffer(void){
+
+    uint8_t data[100], out[100];
+
+    setup(1);
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = 3 * i;
+    CHECK((EF_DRIVER_UART0.getStatus() & EF_UART_STATUS_REG_TXLVL_MASK) == 0);
+    EF_DRIVER_UART0.writeBuffer(data, sizeof(data));
+    // the status register reports a full FIFO as its depth rather than 0
+    CHECK(((EF_DRIVER_UART0.getStatus() & EF_UART_STATUS_REG_TXLVL_MASK) >> EF_UART_STATUS_REG_TXLVL_BIT) == EF_UART_FIFO_DEPTH);
+    run(20 * uart.char_cycles());
+    CHECK(uart.tx_line.size() == sizeof(data));
+    for (unsigned i = 0; i < sizeof(data); i++)
+        CHECK(uart.tx_line[i] == data[i]);
+    CHECK(EF_DRIVER_UART0.getStatus() & (EF_UART_TXE_FLAG << EF_UART_STATUS_REG_RIS_BIT));
+
+    uart.receive(data, sizeof(data));
+    EF_DRIVER_UART0.readBuffer(out, sizeof(out));
+    CHECK(memcmp(out, data, sizeof(data)) == 0);
+    CHECK((EF_DRIVER_UART0.getStatus() & EF_UART_STATUS_REG_RXLVL_MASK) == 0);
+}
+
+static void test_irq_rejects_bad_sizes(void){
+
+    static uint8_t tx[64], rx[64];
+
+    setup(1);
+    CHECK(!EF_DRIVER_UART0.initIRQMode(tx, 48, rx, 64));
+    CHECK(!EF_DRIVER_UART0.initIRQMode(tx, 64, rx, 0));
+    CHECK(EF_DRIVER_UART0.initIRQMode(tx, 64, rx, 64));
+}
+
+static void test_irq_tx(void){
+
+    static uint8_t tx[64], rx[16];
+    uint8_t data[100];
+
+    setup(1);
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = i;
+    CHECK(EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx)));
+    // IM belongs to the interrupt handler; write only raises the TX FIFO threshold
+    uint32_t im = EF_DRIVER_UART0.getIM();
+    CHECK(EF_DRIVER_UART0.write(data, sizeof(data)) == 64);
+    CHECK(EF_DRIVER_UART0.getIM() == im);
+    CHECK(EF_UART_getTxFIFOThreshold(&uart.regs) != 0);
+
+    run(70 * uart.char_cycles());
+    CHECK(uart.tx_idle());
+    CHECK(uart.tx_line.size() == 64);
+    for (unsigned i = 0; i < 64; i++)
+        CHECK(uart.tx_line[i] == data[i]);
+    CHECK(EF_UART_getTxFIFOThreshold(&uart.regs) == 0);
+
+    // the ring buffer accepts more data once it drained
+    CHECK(EF_DRIVER_UART0.write(data + 64, 36) == 36);
+    run(40 * uart.char_cycles());
+    CHECK(uart.tx_line.size() == 100);
+    for (unsigned i = 64; i < 100; i++)
+        CHECK(uart.tx_line[i] == data[i]);
+}
+
+static void test_irq_rx(void){
+
+    static uint8_t tx[16], rx[64];
+    uint8_t data[40], out[64];
+
+    setup(1);
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = 0xA0 + i;
+    CHECK(EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx)));
+    uart.receive(data, sizeof(data));
+
+    // the tail of the burst is below the FIFO threshold and arrives through the receiver timeout
+    run(45 * uart.char_cycles() + 64 * 16 * 2);
+    CHECK(uart.rx_idle());
+    CHECK(EF_DRIVER_UART0.read(out, sizeof(out)) == sizeof(data));
+    CHECK(memcmp(out, data, sizeof(data)) == 0);
+    CHECK(EF_DRIVER_UART0.getRxDropped() == 0);
+    CHECK(EF_DRIVER_UART0.read(out, sizeof(out)) == 0);
+}
+
+static void test_irq_rx_overflow(void){
+
+    static uint8_t tx[16], rx[16];
+    uint8_t data[40], out[16];
+
+    setup(1);
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = i;
+    CHECK(EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx)));
+    uart.receive(data, sizeof(data));
+    run(45 * uart.char_cycles() + 64 * 16 * 2);
+
+    // the FIFO keeps being drained; bytes that do not fit in the ring buffer are counted
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_OR_FLAG) == 0);
+    CHECK(EF_DRIVER_UART0.getRxDropped() == 24);
+    CHECK(EF_DRIVER_UART0.read(out, sizeof(out)) == 16);
+    CHECK(memcmp(out, data, sizeof(out)) == 0);
+}
+
+static void test_irq_loopback(void){
+
+    static uint8_t tx[128], rx[128];
+    uint8_t data[128], out[128];
+
+    setup(0);
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = 0xFF - i;
+    CHECK(EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx)));
+    EF_DRIVER_UART0.enableLoopBack();
+    CHECK(EF_DRIVER_UART0.write(data, sizeof(data)) == sizeof(data));
+    run(140 * uart.char_cycles() + 64 * 8 * 2);
+    CHECK(EF_DRIVER_UART0.read(out, sizeof(out)) == sizeof(data));
+    CHECK(memcmp(out, data, sizeof(data)) == 0);
+}
+
+static void test_instances(void){
+
+    static EF_UART_Mock uart1;
+    static uint8_t tx[32], rx[32];
+    static EF_UART_IRQ_STATE state1;
+    uint8_t data[20], out[32];
+
+    setup(1);
+    uart1.reset();
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = 0x40 + i;
+
+    // the handle based API drives the second UART while EF_DRIVER_UART0 keeps working on the first one
+    EF_UART_setPrescaler(&uart1.regs, 2);
+    EF_UART_setCTRL(&uart1.regs, EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_TXEN_MASK | EF_UART_CTRL_REG_RXEN_MASK | EF_UART_CTRL_REG_LPEN_MASK);
+    CHECK(EF_UART_initIRQMode(&uart1.regs, &state1, tx, sizeof(tx), rx, sizeof(rx)));
+    CHECK(EF_UART_write(&state1, data, sizeof(data)) == sizeof(data));
+    EF_DRIVER_UART0.writeBuffer(data, 5);
+
+    for (unsigned i = 0; i < 30 * uart1.char_cycles() + 64 * 24 * 2; i += 16){
+        uart1.advance(16);
+        uart.advance(16);
+        if (uart1.irq())
+            EF_UART_handleIRQ(&state1);
+    }
+    CHECK(EF_UART_read(&state1, out, sizeof(out)) == sizeof(data));
+    CHECK(memcmp(out, data, sizeof(data)) == 0);
+    CHECK(uart1.tx_line.size() == sizeof(data));
+    CHECK(uart.tx_line.size() == 5);
+    CHECK(EF_DRIVER_UART0.getPrescaler() == 1);
+    CHECK(EF_UART_getPrescaler(&uart1.regs) == 2);
+}
+
+static void test_fifo_depth(void){
+
+    static EF_UART_Mock deep(256);
+    static EF_UART_Mock mid(64);
+    static uint8_t tx[16], rx[256];
+    static EF_UART_IRQ_STATE state;
+    uint8_t data[300], out[256];
+
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = i * 7;
+    CHECK(EF_DRIVER_UART0.getFIFODepth() == EF_UART_FIFO_DEPTH);
+
+    // a full 256-entry FIFO reads 255 in STATUS; writeBuffer must not take it for a free entry
+    deep.reset();
+    CHECK(EF_UART_getFIFODepth(&deep.regs) == 256);
+    EF_UART_setCTRL(&deep.regs, EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_TXEN_MASK);
+    EF_UART_writeBuffer(&deep.regs, data, sizeof(data));
+    CHECK(((EF_UART_getStatus(&deep.regs) & EF_UART_STATUS_REG_TXLVL_MASK) >> EF_UART_STATUS_REG_TXLVL_BIT) == EF_UART_STATUS_LEVEL_MAX);
+    deep.advance(sizeof(data) * deep.char_cycles());
+    CHECK(deep.tx_line.size() == sizeof(data));
+    for (unsigned i = 0; i < sizeof(data); i++)
+        CHECK(deep.tx_line[i] == data[i]);
+
+    // the interrupt driven mode scales its thresholds with the depth: fewer interrupts per byte
+    mid.reset();
+    EF_UART_setCTRL(&mid.regs, EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_RXEN_MASK);
+    CHECK(EF_UART_initIRQMode(&mid.regs, &state, tx, sizeof(tx), rx, sizeof(rx)));
+    CHECK(EF_UART_getRxFIFOThreshold(&mid.regs) == EF_UART_IRQ_RX_THRESHOLD_OF(64));
+    mid.receive(data, 240);
+    unsigned interrupts = 0;
+    for (uint64_t end = mid.cycle + 245 * mid.char_cycles(); (mid.cycle < end) && (state.rx.head - state.rx.tail < 240); mid.advance(16)){
+        if (mid.irq()){
+            EF_UART_handleIRQ(&state);
+            interrupts++;
+        }
+    }
+    CHECK(EF_UART_read(&state, out, sizeof(out)) == 240);
+    CHECK(memcmp(out, data, 240) == 0);
+    CHECK(interrupts <= 240 / 48 + 1);
+}
+
+static void test_apply_config(void){
+
+    EF_UART_CONFIG shadow = EF_UART_CONFIG_DEFAULT;
+    EF_UART_CONFIG config = EF_UART_CONFIG_DEFAULT;
+
+    uart.reset();
+    EF_UART_configSetPrescaler(&config, 3);
+    EF_UART_configSetParityType(EF_UART_configSetDataSize(&config, 7), EVEN);
+    EF_UART_configSetCTRL(&config, EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_TXEN_MASK | EF_UART_CTRL_REG_RXEN_MASK);
+    CHECK(config.CFG == ((0x3F << EF_UART_CFG_REG_TIMEOUT_BIT) | (EVEN << EF_UART_CFG_REG_PARITY_BIT) | 7));
+
+    // from reset: PR, CFG and CTRL differ
+    uint64_t writes = uart.bus_writes;
+    CHECK(EF_UART_applyConfig(&uart.regs, &shadow, &config) == 3);
+    CHECK(uart.bus_writes - writes == 3);
+    CHECK(EF_UART_getPrescaler(&uart.regs) == 3);
+    CHECK((uint32_t)uart.regs.CFG == config.CFG);
+    CHECK(EF_UART_getCTRL(&uart.regs) == config.CTRL);
+
+    // nothing changed, nothing written
+    writes = uart.bus_writes;
+    CHECK(EF_UART_applyConfig(&uart.regs, &shadow, &config) == 0);
+    CHECK(uart.bus_writes == writes);
+
+    // the frame format changes while enabled: disable, CFG, enable
+    EF_UART_configSetDataSize(&config, 8);
+    CHECK(EF_UART_applyConfig(&uart.regs, &shadow, &config) == 3);
+    CHECK(((uint32_t)uart.regs.CFG & EF_UART_CFG_REG_WLEN_MASK) == 8);
+    CHECK(EF_UART_getCTRL(&uart.regs) == config.CTRL);
+
+    // a threshold alone does not stop the line
+    EF_UART_configSetRxFIFOThreshold(&config, 5);
+    CHECK(EF_UART_applyConfig(&uart.regs, &shadow, &config) == 1);
+    CHECK(EF_UART_getRxFIFOThreshold(&uart.regs) == 5);
+
+    // the driver structure keeps its own shadow, resynchronized by readConfig
+    EF_UART_CONFIG current;
+    EF_DRIVER_UART0.readConfig(&current);
+    CHECK(memcmp(&current, &config, sizeof(config)) == 0);
+    CHECK(EF_DRIVER_UART0.applyConfig(EF_UART_configSetIM(&current, EF_UART_RXA_FLAG)) == 1);
+    CHECK(EF_UART_getIM(&uart.regs) == EF_UART_RXA_FLAG);
+
+    // the CFG setters change only their own field
+    EF_UART_setParityType(&uart.regs, ODD);
+    CHECK((uint32_t)uart.regs.CFG == ((config.CFG & ~EF_UART_CFG_REG_PARITY_MASK) | (ODD << EF_UART_CFG_REG_PARITY_BIT)));
+}
+
+static void test_baud_rate(void){
+
+    uint32_t pr, prf;
+
+    // 50 MHz with 8 samples per bit: the divisor is in 1/16 of (PR+1)
+    CHECK(EF_UART_calcBaudRate(50000000, 1000000, 8, &pr, &prf) == 0);
+    CHECK((pr == 5) && (prf == 4));
+    CHECK(EF_UART_calcBaudRate(50000000, 115200, 8, &pr, &prf) == 64);
+    CHECK((pr == 53) && (prf == 4));
+    // an integer prescaler is 4.2% off at 3 Mbaud, the fraction brings it to 1%
+    CHECK(EF_UART_calcBaudRate(50000000, 3000000, 8, &pr, &prf) == 10101);
+    CHECK((pr == 1) && (prf == 1));
+
+    // out of range requests are clamped to the closest divisor
+    CHECK(EF_UART_calcBaudRate(50000000, 10000000, 8, &pr, &prf) < 0);
+    CHECK((pr == 0) && (prf == 0));
+    CHECK(EF_UART_calcBaudRate(50000000, 10, 8, &pr, &prf) > 0);
+    CHECK((pr == 0xFFFF) && (prf == 15));
+
+    uart.reset();
+    CHECK(EF_DRIVER_UART0.setBaudRate(50000000, 115200) == 64);
+    CHECK(EF_UART_getPrescaler(&uart.regs) == 53);
+    CHECK(EF_DRIVER_UART0.getPrescalerFraction() == 4);
+
+    // the fraction stretches the character by PRF/16 of a sample per bit
+    EF_UART_setPrescaler(&uart.regs, 0);
+    EF_UART_setPrescalerFraction(&uart.regs, 8);
+    CHECK(uart.char_cycles() == 10 * 12);
+}
+
+static void test_oversampling(void){
+
+    uart.reset();
+    CHECK(EF_DRIVER_UART0.getSamplesPerBit() == EF_UART_SAMPLES);
+
+    // 4x reaches clk/4, out of range for the 8x default
+    EF_DRIVER_UART0.setOversampling(OVERSAMPLING_4);
+    CHECK(EF_UART_getSamplesPerBit(&uart.regs) == 4);
+    CHECK(((uint32_t)uart.regs.CFG & ~EF_UART_CFG_REG_OSR_MASK) == 0x3F08);
+    CHECK(EF_DRIVER_UART0.setBaudRate(50000000, 12500000) == 0);
+    CHECK((EF_UART_getPrescaler(&uart.regs) == 0) && (EF_UART_getPrescalerFraction(&uart.regs) == 0));
+    CHECK(uart.char_cycles() == 10 * 4);
+
+    // 16x keeps the baud rate with half the prescaler
+    EF_DRIVER_UART0.setOversampling(OVERSAMPLING_16);
+    CHECK(EF_DRIVER_UART0.setBaudRate(50000000, 1000000) == 0);
+    CHECK((EF_UART_getPrescaler(&uart.regs) == 2) && (EF_UART_getPrescalerFraction(&uart.regs) == 2));
+    CHECK(uart.char_cycles() == 10 * 50);
+
+    // the field goes through the configuration structure too
+    EF_UART_CONFIG config = EF_UART_CONFIG_DEFAULT;
+    EF_UART_configSetOversampling(&config, OVERSAMPLING_8);
+    CHECK(config.CFG == (0x3F08 | (OVERSAMPLING_8 << EF_UART_CFG_REG_OSR_BIT)));
+}
+
+static void test_read_until(void){
+
+    const char *lines = "cmd1\nlonger command 2\nxy";
+    uint8_t out[32];
+
+    setup(0);
+    EF_DRIVER_UART0.setTimeoutBits(20);
+    EF_DRIVER_UART0.setMatchData(0x1A5);
+    // a mask left by the application would let other characters match the delimiter
+    uart.regs.MATCH_MASK = 0x0FF;
+    uart.receive((const uint8_t *)lines, strlen(lines));
+
+    CHECK(EF_DRIVER_UART0.readUntil('\n', out, sizeof(out)) == 5);
+    CHECK(memcmp(out, "cmd1\n", 5) == 0);
+    // MATCH, MATCH_MASK and IM are back to what the application had set
+    CHECK(uart.regs.MATCH == 0x1A5);
+    CHECK(uart.regs.MATCH_MASK == 0x0FF);
+    CHECK(EF_DRIVER_UART0.getIM() == 0);
+    // the driver slept on the interrupt line instead of polling the flags
+    CHECK(uart.wakeups != 0);
+    // longer than the FIFO, and cut to the size of the buffer
+    CHECK(EF_DRIVER_UART0.readUntil('\n', out, 10) == 10);
+    CHECK(memcmp(out, "longer com", 10) == 0);
+    CHECK(EF_DRIVER_UART0.readUntil('\n', out, sizeof(out)) == 7);
+    CHECK(memcmp(out, "mand 2\n", 7) == 0);
+    // no delimiter: the idle line ends the frame
+    CHECK(EF_DRIVER_UART0.readUntil('\n', out, sizeof(out)) == 2);
+    CHECK(memcmp(out, "xy", 2) == 0);
+    CHECK(uart.rx_idle());
+    // nothing at all: back after one receiver timeout
+    uint64_t start = uart.cycle;
+    CHECK(EF_DRIVER_UART0.readUntil('\n', out, sizeof(out)) == 0);
+    CHECK(uart.cycle - start <= 22 * uart.char_cycles() / 10);
+    CHECK(uart.regs.MATCH == 0x1A5);
+
+    // the multidrop address filter keeps MATCH and MATCH_MASK
+    EF_DRIVER_UART0.setMultidrop(true, 0x12, 0);
+    uart.receive((const uint8_t *)"ab\n", 3);
+    CHECK(EF_DRIVER_UART0.readUntil('\n', out, sizeof(out)) == 0);
+    CHECK(uart.regs.MATCH == (EF_UART_ADDRESS_FLAG | 0x12));
+}
+
+static void test_frame_mode(void){
+
+    static uint8_t tx[16], rx[64];
+    const char *frames[] = {"ping\n", "status 12\n", "a\n", "very long frame of 40 characters......\n"};
+    uint8_t out[64];
+    unsigned interrupts = 0;
+
+    setup(0);
+    EF_DRIVER_UART0.setTimeoutBits(20);
+    CHECK(EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx)));
+    EF_DRIVER_UART0.setMatchData(0x1A5);
+    uart.regs.MATCH_MASK = 0x00F;
+    EF_DRIVER_UART0.enableFrameMode('\n');
+    CHECK(uart.regs.MATCH_MASK == 0);
+    for (unsigned f = 0; f < 4; f++){
+        unsigned length = strlen(frames[f]);
+        uart.receive((const uint8_t *)frames[f], length);
+        for (uint64_t end = uart.cycle + (length + 10) * uart.char_cycles(); uart.cycle < end; uart.advance(16))
+            if (uart.irq()){
+                EF_UART_IRQHandler();
+                interrupts++;
+            }
+        CHECK(EF_DRIVER_UART0.readFrame(out, sizeof(out)) == length);
+        CHECK(memcmp(out, frames[f], length) == 0);
+        CHECK(EF_DRIVER_UART0.readFrame(out, sizeof(out)) == 0);
+    }
+    // first byte and delimiter per frame, plus the FIFO threshold for the long one
+    CHECK(interrupts <= 2 * 4 + 3);
+
+    // frames back to back: at most the first byte and the delimiter of each
+    interrupts = 0;
+    uart.receive((const uint8_t *)"one\ntwo\nthree\n", 14);
+    for (uint64_t end = uart.cycle + 30 * uart.char_cycles(); uart.cycle < end; uart.advance(16))
+        if (uart.irq()){
+            EF_UART_IRQHandler();
+            interrupts++;
+        }
+    CHECK(interrupts <= 2 * 3);
+    CHECK(EF_DRIVER_UART0.readFrame(out, sizeof(out)) == 4);
+    CHECK(EF_DRIVER_UART0.readFrame(out, sizeof(out)) == 4);
+    CHECK(EF_DRIVER_UART0.readFrame(out, sizeof(out)) == 6);
+    CHECK(memcmp(out, "three\n", 6) == 0);
+
+    // leaving the frame mode gives MATCH back to the application
+    EF_DRIVER_UART0.disableFrameMode();
+    CHECK(uart.regs.MATCH == 0x1A5);
+    CHECK(uart.regs.MATCH_MASK == 0x00F);
+    CHECK(EF_DRIVER_UART0.getIM() == (EF_UART_RXA_FLAG | EF_UART_RXF_FLAG | EF_UART_RTO_FLAG | EF_UART_TXB_FLAG));
+
+    // without a delimiter only the idle line ends frames
+    EF_DRIVER_UART0.enableFrameMode(-1);
+    uart.receive((const uint8_t *)"\x01\x03\x00\x10", 4);
+    run(2 * uart.char_cycles());
+    // a transmission queued inside the frame leaves the RTO interrupt that ends it enabled
+    CHECK(EF_DRIVER_UART0.getIM() & EF_UART_RTO_FLAG);
+    CHECK(EF_DRIVER_UART0.write((const uint8_t *)"ok", 2) == 2);
+    CHECK(EF_DRIVER_UART0.getIM() & EF_UART_RTO_FLAG);
+    run(8 * uart.char_cycles());
+    uart.receive((const uint8_t *)"\x02\x06", 2);
+    CHECK(EF_DRIVER_UART0.readFrame(out, sizeof(out)) == 4);
+    CHECK(EF_DRIVER_UART0.readFrame(out, sizeof(out)) == 0);
+    run(10 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.readFrame(out, sizeof(out)) == 2);
+    CHECK(EF_DRIVER_UART0.getRxDropped() == 0);
+}
+
+static void test_dma(void){
+
+    static uint8_t data[1001], out[1001];
+    EF_UART_Mock_DMA dma(uart);
+
+    setup(0);
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = i * 13;
+    EF_DRIVER_UART0.initDMA(&dma.controller);
+
+    // TX: the CPU only starts and completes the transfer, bursts of half the FIFO and single requests for the tail
+    uint64_t cpu = uart.bus_reads + uart.bus_writes;
+    CHECK(EF_DRIVER_UART0.startTxDMA(data, sizeof(data)));
+    CHECK(!EF_DRIVER_UART0.startTxDMA(data, sizeof(data)));
+    while (EF_DRIVER_UART0.getDMACount(DMA_TX) < sizeof(data))
+        uart.advance(uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.completeDMA(DMA_TX) == sizeof(data));
+    CHECK((EF_DRIVER_UART0.getCTRL() & EF_UART_CTRL_REG_TXDMAEN_MASK) == 0);
+    uart.advance(EF_UART_FIFO_DEPTH * uart.char_cycles() * 2);
+    CHECK(uart.tx_line.size() == sizeof(data));
+    for (unsigned i = 0; i < sizeof(data); i++)
+        CHECK(uart.tx_line[i] == data[i]);
+    CHECK(dma.accesses == sizeof(data));
+    CHECK(dma.requests <= sizeof(data) / (EF_UART_FIFO_DEPTH / 2) + EF_UART_FIFO_DEPTH / 2);
+    CHECK(uart.bus_reads + uart.bus_writes - cpu < 4 * sizeof(data) / 100);
+
+    // RX: the tail shorter than a burst is moved by single requests, nothing overruns
+    uart.receive(data, sizeof(data));
+    CHECK(EF_DRIVER_UART0.startRxDMA(out, sizeof(out)));
+    while (EF_DRIVER_UART0.getDMACount(DMA_RX) < sizeof(out))
+        uart.advance(uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.completeDMA(DMA_RX) == sizeof(out));
+    CHECK(memcmp(out, data, sizeof(data)) == 0);
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_OR_FLAG) == 0);
+
+    // a shorter message than expected: complete once the line is idle and get what arrived
+    memset(out, 0, sizeof(out));
+    CHECK(EF_DRIVER_UART0.startRxDMA(out, 100));
+    uart.receive(data, 37);
+    uart.advance(40 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.getDMACount(DMA_RX) == 37 - 37 % (EF_UART_FIFO_DEPTH / 2));
+    CHECK(EF_DRIVER_UART0.completeDMA(DMA_RX) == 37);
+    CHECK(EF_DRIVER_UART0.completeDMA(DMA_RX) == 0);
+    CHECK(memcmp(out, data, 37) == 0);
+
+    // a controller that refuses the channel leaves the request disabled
+    dma.refuse = true;
+    CHECK(!EF_DRIVER_UART0.startTxDMA(data, 10));
+    CHECK(!EF_DRIVER_UART0.startRxDMA(out, 0));
+    CHECK((EF_DRIVER_UART0.getCTRL() & (EF_UART_CTRL_REG_TXDMAEN_MASK | EF_UART_CTRL_REG_RXDMAEN_MASK)) == 0);
+}
+
+static void test_packed(void){
+
+    uint8_t data[EF_UART_FIFO_DEPTH + 7], out[EF_UART_FIFO_DEPTH + 7];
+    EF_UART_REGS *regs = &uart.regs;
+
+    setup(1);
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = 0xA0 + i;
+
+    // a FIFO worth of bytes is a CAP and a STATUS read and a write per 4 bytes
+    uint64_t reads = uart.bus_reads, writes = uart.bus_writes;
+    EF_DRIVER_UART0.writeBuffer(data, EF_UART_FIFO_DEPTH);
+    CHECK(uart.bus_reads - reads == 2);
+    CHECK(uart.bus_writes - writes == EF_UART_FIFO_DEPTH / 4);
+    run((EF_UART_FIFO_DEPTH + 2) * uart.char_cycles());
+    CHECK(uart.tx_line.size() == EF_UART_FIFO_DEPTH);
+    for (unsigned i = 0; i < EF_UART_FIFO_DEPTH; i++)
+        CHECK(uart.tx_line[i] == data[i]);
+
+    // the same in the other direction, with a tail that is read one byte at a time
+    uart.receive(data, EF_UART_FIFO_DEPTH - 1);
+    run((EF_UART_FIFO_DEPTH + 2) * uart.char_cycles());
+    reads = uart.bus_reads;
+    EF_DRIVER_UART0.readBuffer(out, EF_UART_FIFO_DEPTH - 1);
+    CHECK(uart.bus_reads - reads == 1 + (EF_UART_FIFO_DEPTH - 1) / 4 + 3);
+    CHECK(memcmp(out, data, EF_UART_FIFO_DEPTH - 1) == 0);
+
+    // RXDATA_PACKED pops nothing unless 4 bytes are waiting; byte 0 is the oldest
+    uart.receive(data, 3);
+    run(5 * uart.char_cycles());
+    CHECK(regs->RXDATA_PACKED == 0);
+    CHECK((EF_DRIVER_UART0.getStatus() & EF_UART_STATUS_REG_RXLVL_MASK) == 3);
+    uart.receive(data + 3, 1);
+    run(3 * uart.char_cycles());
+    CHECK(regs->RXDATA_PACKED == 0xA3A2A1A0);
+    CHECK((EF_DRIVER_UART0.getStatus() & EF_UART_STATUS_REG_RXLVL_MASK) == 0);
+
+    // TXDATA_PACKED drops the bytes that do not fit
+    setup(1);
+    EF_DRIVER_UART0.setCTRL(EF_UART_CTRL_REG_EN_MASK);
+    for (unsigned i = 0; i < EF_UART_FIFO_DEPTH - 2; i++)
+        regs->TXDATA = i;
+    regs->TXDATA_PACKED = 0x44332211;
+    CHECK(((EF_DRIVER_UART0.getStatus() & EF_UART_STATUS_REG_TXLVL_MASK) >> EF_UART_STATUS_REG_TXLVL_BIT) == EF_UART_FIFO_DEPTH);
+    EF_DRIVER_UART0.setCTRL(EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_TXEN_MASK);
+    run((EF_UART_FIFO_DEPTH + 2) * uart.char_cycles());
+    CHECK(uart.tx_line.size() == EF_UART_FIFO_DEPTH);
+    CHECK(uart.tx_line.back() == 0x22);
+
+    // odd lengths through the IRQ ring buffers, which wrap in the middle of a packed word
+    static uint8_t tx[16], rx[16];
+    setup(1);
+    CHECK(EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx)));
+    for (unsigned round = 0; round < 3; round++){
+        CHECK(EF_DRIVER_UART0.write(data, 7) == 7);
+        run(10 * uart.char_cycles());
+    }
+    CHECK(uart.tx_line.size() == 21);
+    for (unsigned i = 0; i < 21; i++)
+        CHECK(uart.tx_line[i] == data[i % 7]);
+}
+
+static void test_rx_tags(void){
+
+    uint8_t out[40];
+    uint32_t errors[2];
+
+    setup(1);
+    EF_DRIVER_UART0.setMatchData('m');
+    for (unsigned i = 0; i < sizeof(out); i++){
+        if (i == 3)
+            uart.receive_error('f', EF_UART_RXDATA_REG_FE_MASK);
+        else if (i == 17)
+            uart.receive_error('p', EF_UART_RXDATA_REG_PE_MASK);
+        else if (i == 35)
+            uart.receive_error(0, EF_UART_RXDATA_REG_FE_MASK | EF_UART_RXDATA_REG_BRK_MASK);
+        else
+            uart.receive_error((i == 20) ? 'm' : 'a' + i % 26, 0);
+    }
+
+    uint32_t tags = EF_DRIVER_UART0.readBufferTagged(out, errors, sizeof(out));
+    CHECK(tags == (EF_UART_RXDATA_ERROR_MASK | EF_UART_RXDATA_REG_MATCH_MASK));
+    CHECK(errors[0] == ((1u << 3) | (1u << 17)));
+    CHECK(errors[1] == (1u << (35 - 32)));
+    CHECK((out[3] == 'f') && (out[17] == 'p') && (out[20] == 'm') && (out[35] == 0) && (out[39] == 'a' + 39 % 26));
+
+    // a FIFO worth of bytes is a STATUS read and one read per byte that also tells whether it had an error
+    uart.receive(out, EF_UART_FIFO_DEPTH);
+    run((EF_UART_FIFO_DEPTH + 2) * uart.char_cycles());
+    uint64_t reads = uart.bus_reads;
+    EF_DRIVER_UART0.readBufferTagged(out, errors, EF_UART_FIFO_DEPTH);
+    CHECK(uart.bus_reads - reads == 1 + EF_UART_FIFO_DEPTH);
+    CHECK(errors[0] == 0);
+
+    // the sticky flags still tell that something went wrong
+    CHECK((EF_DRIVER_UART0.getRIS() & (EF_UART_FE_FLAG | EF_UART_PRE_FLAG | EF_UART_BRK_FLAG)) == (EF_UART_FE_FLAG | EF_UART_PRE_FLAG | EF_UART_BRK_FLAG));
+
+    // readChar returns the character without its tags
+    uart.receive_error('x', EF_UART_RXDATA_REG_PE_MASK);
+    run(2 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.readChar() == 'x');
+}
+
+static void test_flow_control(void){
+
+    static uint8_t data[200], out[200];
+
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = i ^ 0x5A;
+
+    // without flow control a late reader loses data
+    setup(0);
+    uart.receive(data, sizeof(data));
+    uart.advance(sizeof(data) * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.getRIS() & EF_UART_OR_FLAG);
+
+    // RTS holds the other side at the watermark however late the reader is
+    setup(0);
+    EF_DRIVER_UART0.setFlowControl(true, false, EF_UART_RTS_LEVEL_OF(EF_UART_FIFO_DEPTH));
+    uart.receive(data, sizeof(data));
+    uart.advance(sizeof(data) * uart.char_cycles());
+    CHECK(uart.rts_n());
+    CHECK(((EF_DRIVER_UART0.getStatus() & EF_UART_STATUS_REG_RXLVL_MASK) >> EF_UART_STATUS_REG_RXLVL_BIT) == EF_UART_RTS_LEVEL_OF(EF_UART_FIFO_DEPTH));
+    EF_DRIVER_UART0.readBuffer(out, sizeof(out));
+    CHECK(memcmp(out, data, sizeof(data)) == 0);
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_OR_FLAG) == 0);
+    CHECK(!uart.rts_n());
+
+    // CTS high holds the transmitter between characters
+    setup(0);
+    EF_DRIVER_UART0.setFlowControl(false, true, 0);
+    CHECK((EF_DRIVER_UART0.getCTRL() & (EF_UART_CTRL_REG_RTSEN_MASK | EF_UART_CTRL_REG_CTSEN_MASK)) == EF_UART_CTRL_REG_CTSEN_MASK);
+    uart.cts_n = true;
+    EF_DRIVER_UART0.writeBuffer(data, 5);
+    uart.advance(20 * uart.char_cycles());
+    CHECK(uart.tx_line.empty());
+    uart.cts_n = false;
+    uart.advance(uart.char_cycles() / 2);
+    uart.cts_n = true;
+    uart.advance(20 * uart.char_cycles());
+    CHECK(uart.tx_line.size() == 1);
+    uart.cts_n = false;
+    uart.advance(20 * uart.char_cycles());
+    CHECK(uart.tx_line.size() == 5);
+    CHECK(uart.tx_line[4] == data[4]);
+}
+
+static void test_multidrop(void){
+
+    static const uint8_t mine[] = "for node 5";
+    static const uint8_t other[] = "traffic for the other nodes on the bus";
+    uint8_t out[16];
+
+    setup(1);
+    EF_DRIVER_UART0.setDataSize(9);
+    EF_DRIVER_UART0.setMultidrop(true, 5, 0);
+    EF_DRIVER_UART0.setICR(0xFFFF);
+
+    // only the matching address and the data after it reach the FIFO
+    uart.receive(other, sizeof(other));
+    uart.receive_address(3);
+    uart.receive(other, sizeof(other));
+    uart.receive_address(5);
+    uart.receive(mine, sizeof(mine));
+    uart.receive_address(7);
+    uart.receive(other, sizeof(other));
+    run((4 * sizeof(other)) * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.getRxCount() == 1 + sizeof(mine));
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_OR_FLAG) == 0);
+    CHECK(EF_DRIVER_UART0.getRIS() & EF_UART_MATCH_FLAG);
+    CHECK(EF_DRIVER_UART0.readChar() == (EF_UART_ADDRESS_FLAG | 5));
+    EF_DRIVER_UART0.readBuffer(out, sizeof(mine));
+    CHECK(memcmp(out, mine, sizeof(mine)) == 0);
+
+    // the mask takes a group address; the frames of a data byte equal to the address are not an address
+    EF_DRIVER_UART0.setMultidrop(true, 5, 0x80);
+    uart.receive_address(0x85);
+    uart.receive(mine, 2);
+    uart.receive_error(5, 0);
+    run(8 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.getRxCount() == 4);
+    CHECK(EF_DRIVER_UART0.readChar() == (EF_UART_ADDRESS_FLAG | 0x85));
+
+    // without the filter every frame is received
+    setup(1);
+    EF_DRIVER_UART0.setDataSize(9);
+    EF_DRIVER_UART0.setMultidrop(false, 5, 0);
+    uart.receive_address(3);
+    uart.receive(mine, 4);
+    run(8 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.getRxCount() == 5);
+
+    // the sender side of the bus
+    EF_DRIVER_UART0.writeAddress(5);
+    EF_DRIVER_UART0.writeChar('a');
+    uart.advance(4 * uart.char_cycles());
+    CHECK((uart.tx_line.size() == 2) && (uart.tx_line[0] == (EF_UART_ADDRESS_FLAG | 5)) && (uart.tx_line[1] == 'a'));
+}
+
+static void test_rs485(void){
+
+    static const uint8_t data[] = "ping";
+
+    setup(1);
+    uint64_t bit = uart.char_cycles() / 10;        // 8N1
+    EF_DRIVER_UART0.setRS485(true, 2, 3);
+    CHECK(!uart.de());
+
+    // returns once the last stop bit is out, after the lead time and the characters; de is still up for the lag time
+    uint64_t start = uart.cycle;
+    EF_DRIVER_UART0.writeBufferAndWait(data, 4);
+    CHECK(uart.tx_line.size() == 4);
+    CHECK(uart.cycle - start >= 2 * bit + 4 * uart.char_cycles());
+    CHECK(uart.cycle - start < 2 * bit + 5 * uart.char_cycles());
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_TC_FLAG) == 0);
+    CHECK(uart.de());
+    uart.advance(2 * bit);
+    CHECK(uart.de());
+
+    // a character queued within the lag time goes out at once and keeps de up
+    start = uart.cycle;
+    EF_DRIVER_UART0.writeBufferAndWait(data, 1);
+    CHECK(uart.cycle - start < uart.char_cycles() + bit);
+    uart.advance(2 * bit);
+    CHECK(uart.de());
+    uart.advance(2 * bit);
+    CHECK(!uart.de());
+
+    // without RS-485 mode de stays low, and TC still tells when the line is free
+    EF_DRIVER_UART0.setRS485(false, 0, 0);
+    EF_DRIVER_UART0.setICR(EF_UART_TC_FLAG);
+    EF_DRIVER_UART0.writeBuffer(data, 2);
+    uart.advance(uart.char_cycles());
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_TC_FLAG) == 0);
+    uart.advance(2 * uart.char_cycles());
+    CHECK(!uart.de());
+    CHECK(EF_DRIVER_UART0.getRIS() & EF_UART_TC_FLAG);
+
+    // a character written in the cycle the last one ends is not the end of the transmission; no TC and de stays up
+    EF_DRIVER_UART0.setRS485(true, 0, 0);
+    EF_DRIVER_UART0.setICR(EF_UART_TC_FLAG);
+    uart.regs.TXDATA = 'a';
+    uart.advance(uart.char_cycles() - uart.bus_cycles);
+    uart.regs.TXDATA = 'b';
+    CHECK(uart.tx_line.size() == 8);
+    CHECK(uart.de());
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_TC_FLAG) == 0);
+    uart.advance(uart.char_cycles());
+    CHECK(uart.tx_line.size() == 9);
+    CHECK(EF_DRIVER_UART0.getRIS() & EF_UART_TC_FLAG);
+}
+
+static void test_autobaud(void){
+
+    static const uint8_t hello[] = "hi";
+
+    // the other side sends 0x55 at 50 cycles per bit; (5+1+4/16)*8
+    setup(0);
+    uart.receive_sync(0x55, 50);
+    CHECK(EF_DRIVER_UART0.autoBaud(0));
+    CHECK(EF_DRIVER_UART0.getPrescaler() == 5);
+    CHECK(EF_DRIVER_UART0.getPrescalerFraction() == 4);
+    CHECK((EF_DRIVER_UART0.getCTRL() & EF_UART_CTRL_REG_ABREN_MASK) == 0);
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_ABR_FLAG) == 0);
+
+    // the sync character is not received, the characters after it are, at the measured rate
+    CHECK(EF_DRIVER_UART0.getRxCount() == 0);
+    uart.receive(hello, 2);
+    uart.advance(2 * uart.char_cycles() + 16);
+    CHECK(uart.char_cycles() == 500);
+    CHECK(EF_DRIVER_UART0.readChar() == 'h');
+    CHECK(EF_DRIVER_UART0.readChar() == 'i');
+
+    // 0x7F at 16 samples per bit
+    EF_DRIVER_UART0.setOversampling(OVERSAMPLING_16);
+    uart.receive_sync(0x7F, 16 * 13);
+    CHECK(EF_DRIVER_UART0.autoBaud(0));
+    CHECK(EF_DRIVER_UART0.getPrescaler() == 12);
+    CHECK(EF_DRIVER_UART0.getPrescalerFraction() == 0);
+
+    // nothing on the line
+    CHECK(!EF_DRIVER_UART0.autoBaud(100));
+    CHECK((EF_DRIVER_UART0.getCTRL() & EF_UART_CTRL_REG_ABREN_MASK) == 0);
+
+    // a character without a falling edge after the start bit cannot be measured; PR is left alone
+    uart.receive_sync(0xFF, 50);
+    CHECK(!EF_DRIVER_UART0.autoBaud(0));
+    CHECK(EF_DRIVER_UART0.getPrescaler() == 12);
+}
+
+static void test_coalescing(void){
+
+    static uint8_t tx[64], rx[64];
+    uint8_t data[64], out[64];
+    unsigned interrupts = 0;
+
+    setup(0);
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = 0x30 + i;
+    CHECK(EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx)));
+    EF_DRIVER_UART0.setIRQCoalescing(8, 12, 10 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.getIM() == (EF_UART_RXF_FLAG | EF_UART_COAL_FLAG | EF_UART_TXB_FLAG));
+
+    // one interrupt per 8 bytes received
+    uart.receive(data, 40);
+    for (uint64_t end = uart.cycle + 42 * uart.char_cycles(); uart.cycle < end; uart.advance(16))
+        if (uart.irq()){
+            EF_UART_IRQHandler();
+            interrupts++;
+        }
+    CHECK(interrupts == 5);
+    CHECK(EF_DRIVER_UART0.read(out, sizeof(out)) == 40);
+    CHECK(memcmp(out, data, 40) == 0);
+
+    // a short message is delivered by the time bound
+    uart.receive(data, 3);
+    run(10 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.read(out, sizeof(out)) == 0);
+    run(2 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.read(out, sizeof(out)) == 3);
+
+    // TXB starts the transmission, then one refill per 12 bytes sent and one when the FIFO runs empty
+    interrupts = 0;
+    CHECK(EF_DRIVER_UART0.write(data, sizeof(data)) == sizeof(data));
+    for (uint64_t end = uart.cycle + 70 * uart.char_cycles(); uart.cycle < end; uart.advance(16))
+        if (uart.irq()){
+            EF_UART_IRQHandler();
+            interrupts++;
+        }
+    CHECK(uart.tx_idle());
+    CHECK(uart.tx_line.size() == sizeof(data));
+    for (unsigned i = 0; i < sizeof(data); i++)
+        CHECK(uart.tx_line[i] == data[i]);
+    CHECK(interrupts <= 1 + 64 / 12 + 1);
+    CHECK(EF_UART_getTxFIFOThreshold(&uart.regs) == 0);
+
+    // counts of 0 go back to the FIFO threshold interrupts
+    EF_DRIVER_UART0.setIRQCoalescing(0, 0, 0);
+    CHECK(EF_DRIVER_UART0.getIM() == (EF_UART_RXA_FLAG | EF_UART_RXF_FLAG | EF_UART_RTO_FLAG | EF_UART_TXB_FLAG));
+    uart.receive(data, 3);
+    run(15 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.read(out, sizeof(out)) == 3);
+}
+
+static void test_stats(void){
+
+    uint8_t data[EF_UART_FIFO_DEPTH + 4] = {0};
+    EF_UART_STATS stats;
+
+    setup(0);
+    EF_DRIVER_UART0.setTxFIFOThreshold(8);
+    EF_DRIVER_UART0.writeCharArr("Hello");
+    uart.receive(data, sizeof(data));
+    uart.receive_error('f', EF_UART_RXDATA_REG_FE_MASK);
+    uart.receive_error('p', EF_UART_RXDATA_REG_PE_MASK);
+    uart.receive_error(0, EF_UART_RXDATA_REG_FE_MASK | EF_UART_RXDATA_REG_BRK_MASK);
+    uart.advance((sizeof(data) + 3) * uart.char_cycles() + 16);
+
+    // the RX FIFO is full after the first 16 characters; the rest are lost
+    CHECK(EF_DRIVER_UART0.getStats(&stats));
+    CHECK(stats.tx_chars == 5);
+    CHECK(stats.rx_chars == sizeof(data) + 3);
+    CHECK(stats.overruns == 7);
+    CHECK(stats.frame_errors == 2);
+    CHECK(stats.parity_errors == 1);
+    CHECK(stats.breaks == 1);
+    CHECK(stats.tx_fifo_max == 4);                   // the transmitter took the first character right away
+    CHECK(stats.rx_fifo_max == EF_UART_FIFO_DEPTH);
+
+    // the snapshot restarts the counters; the high-water marks restart from the current levels
+    EF_DRIVER_UART0.readChar();
+    CHECK(EF_DRIVER_UART0.getStats(&stats));
+    CHECK((stats.tx_chars == 0) && (stats.rx_chars == 0) && (stats.overruns == 0) && (stats.frame_errors == 0));
+    CHECK(stats.tx_fifo_max == 0);
+    CHECK(stats.rx_fifo_max == EF_UART_FIFO_DEPTH);
+
+    // the receiver timeout is counted once the line stays idle
+    EF_DRIVER_UART0.setTimeoutBits(20);
+    uart.advance(3 * uart.char_cycles());
+    CHECK(EF_DRIVER_UART0.getStats(&stats));
+    CHECK(stats.timeouts >= 1);
+}
+
+static void test_multi(void){
+
+    static EF_UART_Mock channel[4];
+    static uint8_t tx[4][16], rx[4][32];
+    static EF_UART_IRQ_STATE state[4];
+    EF_UART_IRQ_STATE *const states[4] = {&state[0], &state[1], &state[2], &state[3]};
+    uint8_t data[20], out[32];
+
+    for (unsigned i = 0; i < sizeof(data); i++)
+        data[i] = 0x60 + i;
+    for (unsigned i = 0; i < 4; i++){
+        channel[i].reset();
+        channel[0].multi.push_back(&channel[i]);
+        EF_UART_setCTRL(&channel[i].regs, EF_UART_CTRL_REG_EN_MASK | EF_UART_CTRL_REG_TXEN_MASK | EF_UART_CTRL_REG_RXEN_MASK);
+    }
+    // channels 0 and 2 stay in the polled mode with their interrupts masked
+    CHECK(EF_UART_initIRQMode(&channel[1].regs, &state[1], tx[1], sizeof(tx[1]), rx[1], sizeof(rx[1])));
+    CHECK(EF_UART_initIRQMode(&channel[3].regs, &state[3], tx[3], sizeof(tx[3]), rx[3], sizeof(rx[3])));
+
+    // one summary read finds the channels with data; the others are not accessed
+    channel[1].receive(data, sizeof(data));
+    channel[3].receive(data, 3);
+    uint64_t idle = channel[2].bus_reads + channel[2].bus_writes;
+    uint32_t serviced = 0;
+    for (unsigned t = 0; t < 30 * channel[1].char_cycles(); t += 16){
+        for (unsigned i = 0; i < 4; i++)
+            channel[i].advance(16);
+        serviced |= EF_UART_handleMultiIRQ(&channel[0].regs, states, 4);
+    }
+    CHECK(serviced == 0xA);
+    CHECK(channel[2].bus_reads + channel[2].bus_writes == idle);
+    CHECK(EF_UART_read(&state[1], out, sizeof(out)) == sizeof(data));
+    CHECK(memcmp(out, data, sizeof(data)) == 0);
+    CHECK(EF_UART_read(&state[3], out, sizeof(out)) == 3);
+
+    // the channel windows are 64 KB apart
+    CHECK((uintptr_t)EF_UART_MULTI_CHANNEL(0x30000000, 3) == 0x30030000);
+    CHECK(offsetof(EF_UART_REGS, IRQ_SUMMARY) == 0xFF20);
+}
+
+static void test_majority_vote(void){
+
+    // a single centre sample takes the glitch as the bit
+    setup(0);
+    uart.receive_noisy('b');
+    uart.advance(uart.char_cycles() + 16);
+    CHECK(EF_DRIVER_UART0.readChar() == 'c');
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_NOISE_FLAG) == 0);
+
+    // the majority vote outvotes it and reports it
+    EF_DRIVER_UART0.setMajorityVote(true);
+    CHECK(EF_DRIVER_UART0.getConfig() & EF_UART_CFG_REG_MAJ_MASK);
+    uart.receive_noisy('b');
+    uart.receive((const uint8_t *)"c", 1);
+    uart.advance(2 * uart.char_cycles() + 16);
+    CHECK(EF_DRIVER_UART0.getRIS() & EF_UART_NOISE_FLAG);
+    CHECK(EF_DRIVER_UART0.readChar() == 'b');
+    CHECK(EF_DRIVER_UART0.readChar() == 'c');
+
+    EF_DRIVER_UART0.setMajorityVote(false);
+    CHECK((EF_DRIVER_UART0.getConfig() & EF_UART_CFG_REG_MAJ_MASK) == 0);
+}
+
+static void test_sync_word(void){
+
+    uint8_t out[8];
+
+    // hunt: the noise and the sync word are dropped, the FIFO starts with the message
+    setup(0);
+    EF_DRIVER_UART0.setSyncWord(true, 0x55AA, 0, 2, true);
+    uart.receive((const uint8_t *)"\x12\xAA\x13\xAA\x55" "data\xAA\x55", 11);
+    uart.advance(11 * uart.char_cycles() + 16);
+    CHECK(EF_DRIVER_UART0.getRIS() & EF_UART_SYNC_FLAG);
+    CHECK(EF_DRIVER_UART0.getRxCount() == 6);
+    EF_DRIVER_UART0.readBuffer(out, 6);
+    CHECK(memcmp(out, "data\xAA\x55", 6) == 0);
+
+    // the sync word inside the message is data and raises nothing
+    EF_DRIVER_UART0.setICR(EF_UART_SYNC_FLAG);
+    uart.receive((const uint8_t *)"\xAA\x55", 2);
+    uart.advance(2 * uart.char_cycles() + 16);
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_SYNC_FLAG) == 0);
+    CHECK(EF_DRIVER_UART0.getRxCount() == 2);
+    EF_DRIVER_UART0.readBuffer(out, 2);
+
+    // a receiver timeout ends the message and the hunt starts again
+    uart.advance(70 * uart.char_cycles() / 10);
+    CHECK(EF_DRIVER_UART0.getRIS() & EF_UART_RTO_FLAG);
+    uart.receive((const uint8_t *)"zz", 2);
+    uart.advance(2 * uart.char_cycles() + 16);
+    CHECK(EF_DRIVER_UART0.getRxCount() == 0);
+
+    // detection only, with a masked second character; a framing error restarts the search
+    EF_DRIVER_UART0.setSyncWord(true, 0x00AA, 0xFF00, 2, false);
+    EF_DRIVER_UART0.setICR(EF_UART_SYNC_FLAG);
+    uart.receive_error(0xAA, EF_UART_RXDATA_REG_FE_MASK);
+    uart.receive((const uint8_t *)"\x01", 1);
+    uart.advance(2 * uart.char_cycles() + 16);
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_SYNC_FLAG) == 0);
+    uart.receive((const uint8_t *)"\xAA\x7E", 2);
+    uart.advance(2 * uart.char_cycles() + 16);
+    CHECK(EF_DRIVER_UART0.getRIS() & EF_UART_SYNC_FLAG);
+    CHECK(EF_DRIVER_UART0.getRxCount() == 4);
+
+    EF_DRIVER_UART0.setSyncWord(false, 0, 0, 1, false);
+    CHECK(uart.regs.SYNC_CTRL == 0);
+}
+
+static void test_crc(void){
+
+    const uint8_t check[] = "123456789";
+    uint8_t frame[13];
+    uint32_t crc;
+
+    // the check values of the CRC catalogues, on the characters sent
+    setup(0);
+    CHECK(EF_DRIVER_UART0.setCRC(true, 16, 0x1021, 0xFFFF, false, false));
+    EF_DRIVER_UART0.writeBuffer(check, 9);
+    CHECK(EF_DRIVER_UART0.crcGetTx(&crc, 0) && (crc == 0x29B1));
+    CHECK(EF_DRIVER_UART0.setCRC(true, 16, 0x1021, 0, true, false));
+    EF_DRIVER_UART0.writeBuffer(check, 9);
+    CHECK(EF_DRIVER_UART0.crcGetTx(&crc, 0) && (crc == 0x2189));
+    CHECK(EF_DRIVER_UART0.setCRC(true, 8, 0x07, 0, false, false));
+    EF_DRIVER_UART0.writeBuffer(check, 9);
+    CHECK(EF_DRIVER_UART0.crcGetTx(&crc, 0) && (crc == 0xF4));
+    CHECK(EF_DRIVER_UART0.setCRC(true, 32, 0x04C11DB7, 0xFFFFFFFF, true, true));
+    EF_DRIVER_UART0.writeBuffer(check, 9);
+    CHECK(EF_DRIVER_UART0.crcGetTx(&crc, 0) && (crc == 0xCBF43926));
+
+    // a received frame with its CRC leaves the residue; a corrupted one does not
+    memcpy(frame, check, 9);
+    for (int i = 0; i < 4; i++)
+        frame[9 + i] = crc >> (8 * i);
+    EF_DRIVER_UART0.crcReset(false, true);
+    uart.receive(frame, 13);
+    uart.advance(13 * uart.char_cycles() + 16);
+    CHECK(EF_DRIVER_UART0.crcGetRx() == EF_UART_CRC32_RESIDUE);
+    frame[4] ^= 0x10;
+    EF_DRIVER_UART0.crcReset(false, true);
+    uart.receive(frame, 13);
+    uart.advance(13 * uart.char_cycles() + 16);
+    CHECK(EF_DRIVER_UART0.crcGetRx() != EF_UART_CRC32_RESIDUE);
+
+    // CRC-16/CCITT-FALSE, sent most significant byte first, leaves 0
+    CHECK(EF_DRIVER_UART0.setCRC(true, 16, 0x1021, 0xFFFF, false, false));
+    memcpy(frame, check, 9);
+    frame[9] = 0x29;
+    frame[10] = 0xB1;
+    uart.receive(frame, 11);
+    uart.advance(11 * uart.char_cycles() + 16);
+    CHECK(EF_DRIVER_UART0.crcGetRx() == 0);
+
+    // disabled, the CRCs hold; unsupported widths are refused
+    CHECK(EF_DRIVER_UART0.setCRC(false, 16, 0x1021, 0xFFFF, false, false));
+    EF_DRIVER_UART0.writeBuffer(check, 9);
+    CHECK(EF_DRIVER_UART0.crcGetTx(&crc, 0) && (crc == 0xFFFF));
+    CHECK(!EF_DRIVER_UART0.setCRC(true, 12, 0x80F, 0, false, false));
+
+    // with the transmitter off the TX FIFO never drains; the wait gives up and crc is left alone
+    CHECK(EF_DRIVER_UART0.setCRC(true, 16, 0x1021, 0xFFFF, false, false));
+    EF_DRIVER_UART0.disableTx();
+    EF_DRIVER_UART0.writeBuffer(check, 4);
+    crc = 0x1234;
+    CHECK(!EF_DRIVER_UART0.crcGetTx(&crc, 100));
+    CHECK(crc == 0x1234);
+    EF_DRIVER_UART0.enableTx();
+    CHECK(EF_DRIVER_UART0.crcGetTx(&crc, 0) && (crc == 0x5349));
+}
+
+static void test_frame_gap(void){
+
+    uint8_t out[8];
+    uint32_t errors;
+    uint64_t c;
+
+    // a gap shorter than 3.5 characters does not end the frame; the one after it does
+    setup(0);
+    EF_DRIVER_UART0.setFrameGap(EF_UART_GAP_MODBUS_T35);
+    c = uart.char_cycles();
+    uart.receive((const uint8_t *)"ab", 2);
+    uart.advance(2 * c + 3 * c);
+    uart.receive((const uint8_t *)"cd", 2);
+    uart.advance(2 * c + 3 * c);
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_EOF_FLAG) == 0);
+    CHECK(EF_DRIVER_UART0.readGapFrame(out, sizeof(out), &errors) == 0);
+    uart.advance(c / 2 + 16);
+    CHECK(EF_DRIVER_UART0.getRIS() & EF_UART_EOF_FLAG);
+    CHECK(EF_DRIVER_UART0.readGapFrame(out, sizeof(out), &errors) == 4);
+    CHECK((memcmp(out, "abcd", 4) == 0) && (errors == 0));
+    CHECK(EF_DRIVER_UART0.getRxCount() == 0);
+
+    // the gap follows the frame format; the error summary covers the whole frame
+    EF_DRIVER_UART0.setICR(EF_UART_EOF_FLAG);
+    EF_DRIVER_UART0.setTwoStopBitsSelect(true);
+    EF_DRIVER_UART0.setParityType(EVEN);
+    c = uart.char_cycles();
+    uart.receive((const uint8_t *)"x", 1);
+    uart.receive_error('y', EF_UART_RXDATA_REG_PE_MASK);
+    uart.advance(2 * c + 3 * c);
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_EOF_FLAG) == 0);
+    uart.advance(c / 2 + 16);
+    CHECK(EF_DRIVER_UART0.readGapFrame(out, sizeof(out), &errors) == 2);
+    CHECK(errors == EF_UART_FRAME_REG_PE_MASK);
+
+    // the characters that do not fit are dropped, and the next frame starts at the head of the FIFO
+    uart.receive((const uint8_t *)"123456", 6);
+    uart.advance(6 * c + 4 * c);
+    uart.receive((const uint8_t *)"78", 2);
+    uart.advance(2 * c + 4 * c);
+    CHECK(EF_DRIVER_UART0.readGapFrame(out, 4, &errors) == 6);
+    CHECK(memcmp(out, "1234", 4) == 0);
+    CHECK(EF_DRIVER_UART0.readGapFrame(out, 4, &errors) == 2);
+    CHECK(memcmp(out, "78", 2) == 0);
+
+    // with 4 descriptors waiting, the frames that follow are merged until one is read
+    for (int i = 0; i < 6; i++){
+        uart.receive((const uint8_t *)"abcdef" + i, 1);
+        uart.advance(c + 4 * c);
+    }
+    for (int i = 0; i < 4; i++){
+        CHECK(EF_DRIVER_UART0.readGapFrame(out, sizeof(out), &errors) == 1);
+        CHECK(out[0] == (uint8_t)('a' + i));
+    }
+    CHECK(EF_DRIVER_UART0.readGapFrame(out, sizeof(out), &errors) == 2);
+    CHECK((memcmp(out, "ef", 2) == 0) && (errors == EF_UART_FRAME_REG_MERGED_MASK));
+
+    // a flush drops the descriptors with the characters; a gap of 0 delimits nothing
+    uart.receive((const uint8_t *)"ab", 2);
+    uart.advance(2 * c + 4 * c);
+    uart.regs.RX_FIFO_FLUSH = 1;
+    CHECK(EF_DRIVER_UART0.readGapFrame(out, sizeof(out), &errors) == 0);
+    EF_DRIVER_UART0.setFrameGap(0);
+    EF_DRIVER_UART0.setICR(EF_UART_EOF_FLAG);
+    uart.receive((const uint8_t *)"ab", 2);
+    uart.advance(2 * c + 8 * c);
+    CHECK((EF_DRIVER_UART0.getRIS() & EF_UART_EOF_FLAG) == 0);
+    CHECK(EF_DRIVER_UART0.readGapFrame(out, sizeof(out), &errors) == 0);
+}
+
+static void test_synchronous(void){
+
+    uint8_t out[4];
+
+    // sclk runs at clk/2 with PR=0, one bit per period
+    setup(0);
+    EF_DRIVER_UART0.setSynchronous(true, false);
+    CHECK((uart.regs.CTRL & (EF_UART_CTRL_REG_SCEN_MASK | EF_UART_CTRL_REG_SCEXT_MASK)) == EF_UART_CTRL_REG_SCEN_MASK);
+    CHECK(uart.regs.CTRL & EF_UART_CTRL_REG_EN_MASK);
+    CHECK(EF_DRIVER_UART0.getSamplesPerBit() == 2);
+    CHECK(EF_DRIVER_UART0.setBaudRate(50000000, 25000000) == 0);
+    CHECK((EF_UART_getPrescaler(&uart.regs) == 0) && (EF_UART_getPrescalerFraction(&uart.regs) == 0));
+    CHECK(uart.char_cycles() == 10 * 2);
+
+    // the same frame format and FIFOs as the asynchronous mode
+    uart.receive((const uint8_t *)"sync", 4);
+    EF_DRIVER_UART0.readBuffer(out, 4);
+    CHECK(memcmp(out, "sync", 4) == 0);
+
+    // the external clock sets both bits; turning the mode off clears them and keeps the rest of CTRL
+    EF_DRIVER_UART0.setSynchronous(true, true);
+    CHECK((uart.regs.CTRL & EF_UART_CTRL_REG_SCEXT_MASK) && (uart.regs.CTRL & EF_UART_CTRL_REG_EN_MASK));
+    EF_DRIVER_UART0.setSynchronous(false, true);
+    CHECK((uart.regs.CTRL & (EF_UART_CTRL_REG_SCEN_MASK | EF_UART_CTRL_REG_SCEXT_MASK)) == 0);
+    CHECK(EF_DRIVER_UART0.getSamplesPerBit() == EF_UART_SAMPLES);
+}
+
+// Compare the characters sent since the reset of the mock with a string
+static bool sent(const char *text){
+
+    return std::string(uart.tx_line.begin(), uart.tx_line.end()) == text;
+}
+
+static void test_log(void){
+
+    static uint8_t tx[64], rx[16];
+    static uintptr_t records[64];
+    EF_UART_LOG log;
+    std::string expected;
+
+    setup(0);
+    CHECK(EF_DRIVER_UART0.initIRQMode(tx, sizeof(tx), rx, sizeof(rx)));
+    CHECK(!EF_UART_logInit(&log, EF_UART_getIRQState(), records, 48));
+    CHECK(EF_UART_logInit(&log, EF_UART_getIRQState(), records, 64));
+
+    // recording does not touch the UART; the idle hook formats and queues the lines
+    uint64_t accesses = uart.bus_reads + uart.bus_writes;
+    CHECK(EF_UART_LOG(&log, "boot\n"));
+    CHECK(EF_UART_LOG(&log, "x=%d y=%04x %-3s|%5u %c %X %%\n", -12, 0xab, "ok", 42u, 'z', 0xBEEF));
+    CHECK(EF_UART_LOG(&log, "%s %ld %q %p\n", (const char *)0, 7L, (void *)0x1234));
+    CHECK(uart.bus_reads + uart.bus_writes == accesses);
+    CHECK(EF_UART_logProcess(&log) == 0);
+    run(64 * uart.char_cycles());
+    CHECK(sent("boot\nx=-12 y=00ab ok |   42 z BEEF %\n(null) 7 %q 0x1234\n"));
+
+    // past the first refill, the TXB interrupt formats the following lines without the idle hook
+    uart.tx_line.clear();
+    for (int i = 0; i < 20; i++){
+        CHECK(EF_UART_LOG(&log, "line %2d\n", i));
+        expected += "line " + std::string(i < 10 ? " " : "") + std::to_string(i) + "\n";
+    }
+    CHECK(EF_UART_logProcess(&log) != 0);
+    run(200 * uart.char_cycles());
+    CHECK(sent(expected.c_str()));
+    CHECK(EF_UART_getTxFIFOThreshold(&uart.regs) == 0);
+
+    // a full buffer drops whole records and counts them
+    uart.tx_line.clear();
+    for (int i = 0; i < 21; i++)
+        CHECK(EF_UART_LOG(&log, "%c", 'a' + i));
+    CHECK(!EF_UART_LOG(&log, "%c", '!'));
+    CHECK(EF_UART_logGetDropped(&log) == 1);
+    EF_UART_logProcess(&log);
+    CHECK(EF_UART_LOG(&log, "."));
+    EF_UART_logProcess(&log);
+    run(30 * uart.char_cycles());
+    CHECK(sent("abcdefghijklmnopqrstu."));
+
+    // a line longer than EF_UART_LOG_LINE_MAX is cut
+    std::string text(200, '-');
+    uart.tx_line.clear();
+    CHECK(EF_UART_LOG(&log, "%s", text.c_str()));
+    EF_UART_logProcess(&log);
+    run(300 * uart.char_cycles());
+    CHECK(uart.tx_line.size() == EF_UART_LOG_LINE_MAX);
+}
+
+int main(void){
+
+    test_polled();
+    test_buffer();
+    test_irq_rejects_bad_sizes();
+    test_irq_tx();
+    test_irq_rx();
+    test_irq_rx_overflow();
+    test_irq_loopback();
+    test_instances();
+    test_fifo_depth();
+    test_apply_config();
+    test_baud_rate();
+    test_oversampling();
+    test_read_until();
+    test_frame_mode();
+    test_dma();
+    test_packed();
+    test_rx_tags();
+    test_flow_control();
+    test_multidrop();
+    test_rs485();
+    test_autobaud();
+    test_coalescing();
+    test_stats();
+    test_multi();
+    test_majority_vote();
+    test_sync_word();
+    test_crc();
+    test_frame_gap();
+    test_synchronous();
+    test_log();
+    printf("All tests have passed\n");
+    return 0;
+}
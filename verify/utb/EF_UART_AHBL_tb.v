@@ -68,7 +68,9 @@ module EF_UART_AHBL_tb;
 	EF_UART_AHBL DUV (
 		`TB_AHBL_SLAVE_CONN,
 		.rx(rx),
-		.tx(tx)
+		.tx(tx),
+		.tx_dma_ack(1'b0),
+		.rx_dma_ack(1'b0)
 	);
 
 	`include "ahbl_tasks.vh"
@@ -68,7 +68,9 @@ module EF_UART_APB_tb;
 	EF_UART_APB DUV (
 		`TB_APB_SLAVE_CONN,
 		.rx(rx),
-		.tx(tx)
+		.tx(tx),
+		.tx_dma_ack(1'b0),
+		.rx_dma_ack(1'b0)
 	);
 
 	`include "apb_tasks.vh"
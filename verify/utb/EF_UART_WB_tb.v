@@ -68,7 +68,9 @@ module EF_UART_WB_tb;
 	EF_UART_WB DUV (
 		`TB_WB_SLAVE_CONN,
 		.rx(rx),
-		.tx(tx)
+		.tx(tx),
+		.tx_dma_ack(1'b0),
+		.rx_dma_ack(1'b0)
 	);
 
 	`include "wb_tasks.vh"
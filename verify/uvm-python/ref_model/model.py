@@ -46,6 +46,22 @@ class EF_UART(UVMComponent):
             Event()
         )  # fire when monitor detect new tx received to sync the fifos
         self.new_rx_received = Event()
+        self.selected = False  # multidrop: the last address frame matched
+        self.abr_measured = False  # autobaud: done until CTRL.abren is cleared
+        self.coal_rx_n = 0  # characters counted towards the next COAL event
+        self.coal_tx_n = 0
+        self.sync_hist = []  # sync word detector: the last 3 characters, the oldest first
+        self.sync_locked = False  # hunt mode: the sync word has been seen
+        self.crc_tx = 0  # CRC registers, left aligned in 32 bits like the RTL
+        self.crc_rx = 0
+        self.frame_n = 0  # idle gap framing: characters of the open frame in the RX FIFO
+        self.frame_err = 0  # FE, PE, OR and MERGED bits of the open frame
+        self.frame_late = False  # the gap was reached while the descriptor FIFO was full
+        self.frames = []  # frame descriptors, 4 at most
+        self.stats = dict.fromkeys(self.STATS, 0)  # live statistics counters since the last snapshot
+        glitches_arr = []
+        # NOISE is raised when a glitch lands on one of the vote samples; with glitches it is not predicted
+        self.insert_glitches = UVMConfigDb.get(self, "", "insert_glitches", glitches_arr) and glitches_arr[0]
         self.flags = Flags(self.regs, self.tag)
         cocotb.scheduler.add(self.control_regs())
 
@@ -55,6 +71,19 @@ class EF_UART(UVMComponent):
         self.fifo_tx_threshold = True
         self.fifo_rx = Queue(maxsize=16)
         self.fifo_rx_threshold = False
+        self.selected = False
+        self.abr_measured = False
+        self.coal_rx_n = 0
+        self.coal_tx_n = 0
+        self.sync_hist = []
+        self.sync_locked = False
+        self.crc_tx = 0
+        self.crc_rx = 0
+        self.frame_n = 0
+        self.frame_err = 0
+        self.frame_late = False
+        self.frames = []
+        self.stats = dict.fromkeys(self.STATS, 0)
         self.flags = Flags(self.regs, self.tag)
         uvm_info(self.tag, f"Vip reset {self.fifo_tx.qsize()}", UVM_MEDIUM)
 
@@ -84,7 +113,29 @@ class EF_UART(UVMComponent):
                 )
         if addr == self.regs.reg_name_to_address["CTRL"]:  # control
             uvm_info(self.tag, "UART control reg set", UVM_HIGH)
+            if not data & 0x800:
+                self.abr_measured = False
             self.event_control.set()
+        if addr == self.regs.reg_name_to_address["COAL"]:
+            # a direction that is switched off drops its count
+            if not data & 0xFF:
+                self.coal_rx_n = 0
+            if not data & 0xFF00:
+                self.coal_tx_n = 0
+        if addr == self.regs.reg_name_to_address["SYNC_CTRL"]:
+            # clearing en restarts the search, clearing en or hunt the hunt
+            if not data & 0b100:
+                self.sync_hist = []
+            if not data & 0b100 or not data & 0b1000:
+                self.sync_locked = False
+        if addr == self.regs.reg_name_to_address["CRC_RST"]:
+            init = (self.regs.read_reg_value("CRC_INIT") << self.crc_shift()) & 0xFFFFFFFF
+            if data & 0b1:
+                self.crc_tx = init
+            if data & 0b10:
+                self.crc_rx = init
+        if addr == self.regs.reg_name_to_address["STATS_SNAP"] and data & 1:
+            self.snap_stats()
 
     def read_register(self, addr):
         uvm_info(self.tag, "Reading register " + hex(addr), UVM_MEDIUM)
@@ -100,6 +151,24 @@ class EF_UART(UVMComponent):
                 return data
             except asyncio.QueueEmpty:
                 return "X"  # x means the data is trash so the scoreboard should not check it
+        if addr in (self.regs.reg_name_to_address["STATS_RTO"], self.regs.reg_name_to_address["STATS_MAX"]):
+            return "X"  # timeouts and FIFO levels depend on timing the model does not have
+        if addr == self.regs.reg_name_to_address["CRC_TX"]:
+            # complete once the TX FIFO is empty; before, it depends on where the transmitter is
+            return self.crc_out(self.crc_tx) if self.fifo_tx.empty() else "X"
+        if addr == self.regs.reg_name_to_address["CRC_RX"]:
+            return self.crc_out(self.crc_rx)
+        if addr == self.regs.reg_name_to_address["FRAME"]:
+            # reading pops the descriptor; one that waited for room goes in at once
+            if not self.frames:
+                return 0
+            frame = self.frames.pop(0)
+            if self.frame_late:
+                self.frame_end()
+            return frame
+        if addr in (self.regs.reg_name_to_address["RIS"], self.regs.reg_name_to_address["MIS"]):
+            if self.insert_glitches and (self.regs.read_reg_value("CFG") >> 16) & 1:
+                return "X"
         return self.regs.read_reg_value(addr)
 
     async def transmit(self):
@@ -125,27 +194,58 @@ class EF_UART(UVMComponent):
             # pop last value from as it is sent
             # update rx fifo when loopback is enabled
             await self.fifo_tx.get()
+            self.crc_tx = self.crc_update(self.crc_tx, data_tx)
+            self.coal_count(False, self.fifo_tx.empty())
+            self.count_stat("tx")
+            if self.fifo_tx.empty():
+                self.flags.set_tx_complete()
 
             if (self.regs.read_reg_value("CTRL") & 0xF) == 0xF:
+                accept, match = self.address_filter(data_tx)
+                if match:
+                    self.flags.set_data_match()
+                if not accept:
+                    continue
+                self.crc_rx = self.crc_update(self.crc_rx, data_tx)
+                self.coal_count(True)
+                self.count_stat("rx")
                 try:
-                    self.fifo_rx.put_nowait(data_tx)
-                    self.check_receiver_match(data_tx)
+                    self.fifo_rx.put_nowait(self.rx_entry(data_tx, match))
+                    self.frame_char()
                     self.check_rx_level_threshold()
                     if self.fifo_rx.full():
                         self.flags.set_rx_full()
                 except asyncio.QueueFull:
-                    self.check_receiver_match(data_tx)
                     uvm_warning(
                         self.tag, "writing to rx while fifo is full so ignore the value"
                     )
                     self.flags.set_overrun_err()
+                    self.count_stat("or")
+                    self.frame_err |= 1 << 18
 
     def write_rx(self, tr):
+        # the receiver is held while CTRL.abren is set; the character goes to the autobaud unit
+        if self.regs.read_reg_value("CTRL") & 0x800:
+            if not self.abr_measured:
+                self.measure_baud(tr.char)
+            return
         # if rx is enabled
         if (self.regs.read_reg_value("CTRL") & 7) in [5, 7]:
+            accept, match = self.address_filter(tr.char)
+            if match:
+                self.flags.set_data_match()
+            if not accept:
+                uvm_info(self.tag, f"frame {hex(tr.char)} is for another node", UVM_HIGH)
+                return
+            if self.sync_detect(tr.char):
+                uvm_info(self.tag, f"frame {hex(tr.char)} dropped while hunting for the sync word", UVM_HIGH)
+                return
+            self.crc_rx = self.crc_update(self.crc_rx, tr.char)
+            self.coal_count(True)
+            self.count_stat("rx")
             try:
-                self.fifo_rx.put_nowait(tr.char)
-                self.check_receiver_match(tr.char)
+                self.fifo_rx.put_nowait(self.rx_entry(tr.char, match))
+                self.frame_char()
                 self.check_rx_level_threshold()
                 self.new_rx_received.set()
                 if self.fifo_rx.full():
@@ -153,11 +253,12 @@ class EF_UART(UVMComponent):
                     self.regs.write_reg_value("ris", 0b1, mask=0x1)
             except asyncio.QueueFull:
                 self.new_rx_received.set()
-                self.check_receiver_match(tr.char)
                 uvm_warning(
                     self.tag, "writing to rx while fifo is full so ignore the value"
                 )
                 self.flags.set_overrun_err()
+                self.count_stat("or")
+                self.frame_err |= 1 << 18
         else:
             uvm_warning(self.tag, "received uart transaction while uart is disabled")
 
@@ -177,10 +278,154 @@ class EF_UART(UVMComponent):
             uvm_info(self.tag, "UART control reg changed", UVM_HIGH)
             self.event_control.clear()
 
-    def check_receiver_match(self, new_char):
+    def measure_baud(self, new_char):
+        # ABR holds the time from the start bit to the last falling edge within 9.5 start bit times; data bit 7 of
+        # a 0x55 or 0x7F. The driver spreads the prescaler fraction over the bits, so k bits are floor(k * bit)
+        prescale = self.regs.read_reg_value("PR")
+        prescale_frac = self.regs.read_reg_value("PRF")
+        samples = [8, 16, 8, 4][(self.regs.read_reg_value("CFG") >> 14) & 0b11]
+        bit = ((prescale + 1) * 16 + prescale_frac) * samples / 16
+        levels = [0] + [(new_char >> i) & 1 for i in range(8)] + [1]
+        start_bits = levels.index(1)
+        count = 0
+        for i in range(1, 10):
+            if levels[i - 1] and not levels[i] and i <= 9.5 * start_bits:
+                count = int(i * bit)
+        uvm_info(self.tag, f"autobaud measured {count} cycles on {hex(new_char)}", UVM_MEDIUM)
+        self.regs.write_reg_value("ABR", count, force_write=True)
+        self.abr_measured = True
+        self.flags.set_baud_measured()
+
+    def coal_count(self, rx, last=False):
+        # COAL is raised every COAL.rxcnt characters received or COAL.txcnt sent, and when the TX FIFO runs empty
+        # with TX coalescing on. The COAL_TIME bound is in clock cycles and is not predicted; keep it 0
+        coal = self.regs.read_reg_value("COAL")
+        count = coal & 0xFF if rx else (coal >> 8) & 0xFF
+        if count == 0:
+            return
+        if rx:
+            self.coal_rx_n += 1
+            reached = self.coal_rx_n >= count
+        else:
+            self.coal_tx_n += 1
+            reached = self.coal_tx_n >= count or last
+        if reached:
+            self.coal_rx_n = 0
+            self.coal_tx_n = 0
+            self.flags.set_coalesced()
+
+    # live counter, its width, snapshot register and bit offset in it
+    STATS = {
+        "tx": (32, "STATS_TX", 0),
+        "rx": (32, "STATS_RX", 0),
+        "fe": (16, "STATS_FE_PE", 0),
+        "pe": (16, "STATS_FE_PE", 16),
+        "or": (16, "STATS_OR_BRK", 0),
+        "brk": (16, "STATS_OR_BRK", 16),
+    }
+
+    def count_stat(self, name):
+        # the character counters wrap, the error counters saturate
+        width = self.STATS[name][0]
+        if width == 32:
+            self.stats[name] = (self.stats[name] + 1) & 0xFFFFFFFF
+        else:
+            self.stats[name] = min(self.stats[name] + 1, (1 << width) - 1)
+
+    def snap_stats(self):
+        values = {}
+        for name, (_, reg, bit) in self.STATS.items():
+            values[reg] = values.get(reg, 0) | self.stats[name] << bit
+            self.stats[name] = 0
+        for reg, value in values.items():
+            self.regs.write_reg_value(reg, value, force_write=True)
+
+    def sync_detect(self, new_char):
+        # returns True when the hunt drops the character. The sequences send no line errors, so every character
+        # counts towards the sync word; a receiver timeout restarts the search (sync_restart)
+        ctrl = self.regs.read_reg_value("SYNC_CTRL")
+        if not ctrl & 0b100:
+            return False
+        length = (ctrl & 0b11) + 1
+        hunt = bool(ctrl & 0b1000)
+        drop = hunt and not self.sync_locked
+        if len(self.sync_hist) >= length - 1:
+            window = self.sync_hist[len(self.sync_hist) - (length - 1):] + [new_char & 0xFF]
+            word = sum(c << (8 * i) for i, c in enumerate(window))
+            used = (1 << (8 * length)) - 1
+            if ((word ^ self.regs.read_reg_value("SYNC")) & ~self.regs.read_reg_value("SYNC_MASK") & used) == 0:
+                if not (hunt and self.sync_locked):
+                    self.flags.set_sync()
+                if hunt:
+                    self.sync_locked = True
+        self.sync_hist = (self.sync_hist + [new_char & 0xFF])[-3:]
+        return drop
+
+    def crc_shift(self):
+        # the CRC register is kept left aligned, so the same update serves every width
+        size = (self.regs.read_reg_value("CRC_CTRL") >> 1) & 0b11
+        return 0 if size & 0b10 else 16 if size & 0b1 else 24
+
+    def crc_update(self, crc, new_char):
+        # the low 8 bits of the character, MSB first unless refin (CRC_CTRL)
+        ctrl = self.regs.read_reg_value("CRC_CTRL")
+        if not ctrl & 0b1:
+            return crc
+        poly = (self.regs.read_reg_value("CRC_POLY") << self.crc_shift()) & 0xFFFFFFFF
+        for i in range(7, -1, -1):
+            bit = (new_char >> (7 - i)) & 1 if ctrl & 0b1000 else (new_char >> i) & 1
+            feedback = (crc >> 31) ^ bit
+            crc = ((crc << 1) & 0xFFFFFFFF) ^ (poly if feedback else 0)
+        return crc
+
+    def crc_out(self, crc):
+        ctrl = self.regs.read_reg_value("CRC_CTRL")
+        value = int(f"{crc:032b}"[::-1], 2) if ctrl & 0b10000 else crc >> self.crc_shift()
+        if ctrl & 0b100000:
+            value ^= 0xFFFFFFFF >> self.crc_shift()
+        return value
+
+    def frame_char(self):
+        # a character after a gap that found the descriptor FIFO full joins the open frame
+        if self.frame_late:
+            self.frame_err |= 1 << 19
+        self.frame_n = min(self.frame_n + 1, 0xFFFF)
+
+    def frame_end(self):
+        # the idle gap (GAP) has been reached; the open frame goes into the descriptor FIFO unless it is full
+        if self.frame_n == 0 and not self.frame_err & (1 << 18):
+            return
+        if len(self.frames) == 4:
+            self.frame_late = True
+            return
+        self.frames.append(self.frame_n | self.frame_err)
+        self.flags.set_eof()
+        self.frame_n = 0
+        self.frame_err = 0
+        self.frame_late = False
+
+    def sync_restart(self):
+        self.sync_hist = []
+        self.sync_locked = False
+
+    def rx_entry(self, new_char, match):
+        # RXDATA returns the character with its tags; the match tag is bit 12
+        return new_char | (0x1000 if match else 0)
+
+    def address_filter(self, new_char):
+        # returns (accept, match) for a received character. MATCH_MASK bits are not compared. In the 9-bit multidrop
+        # mode (CTRL.aden) a character with bit 8 set is an address that selects or deselects the receiver; only
+        # a matching address and the data after it are accepted, and only addresses raise MATCH
         match_reg = self.regs.read_reg_value("MATCH")
-        if new_char == match_reg:
-            self.flags.set_data_match()
+        mask = self.regs.read_reg_value("MATCH_MASK")
+        match = ((new_char ^ match_reg) & ~mask & 0x1FF) == 0
+        if not self.regs.read_reg_value("CTRL") & 0x200:
+            self.selected = False
+            return True, match
+        if (self.regs.read_reg_value("CFG") & 0xF) == 9 and new_char & 0x100:
+            self.selected = match
+            return match, match
+        return self.selected, False
 
     def check_rx_level_threshold(self):
         threshold = self.regs.read_reg_value("RX_FIFO_THRESHOLD")
@@ -339,6 +584,51 @@ class Flags:
             uvm_info(self.tag, "[clear flag] clear Timeout interrupt", UVM_MEDIUM)
             self.clear_interrupt(mask=0b1000000000, name="receiver Timeout error")
 
+    def set_tx_complete(self):
+        uvm_info(self.tag, "[interrupt flag] Transmission complete", UVM_MEDIUM)
+        self.write_interrupt(0b10000000000, "Transmission complete")
+
+    def clr_tx_complete(self):
+        if self.regs.read_reg_value("ris") & 0b10000000000 == 0b10000000000:
+            uvm_info(self.tag, "[clear flag] clear Transmission complete interrupt", UVM_MEDIUM)
+            self.clear_interrupt(mask=0b10000000000, name="Transmission complete")
+
+    def set_baud_measured(self):
+        uvm_info(self.tag, "[interrupt flag] Baud rate measured", UVM_MEDIUM)
+        self.write_interrupt(0b100000000000, "Baud rate measured")
+
+    def clr_baud_measured(self):
+        if self.regs.read_reg_value("ris") & 0b100000000000 == 0b100000000000:
+            uvm_info(self.tag, "[clear flag] clear Baud rate measured interrupt", UVM_MEDIUM)
+            self.clear_interrupt(mask=0b100000000000, name="Baud rate measured")
+
+    def set_coalesced(self):
+        uvm_info(self.tag, "[interrupt flag] Coalesced event", UVM_MEDIUM)
+        self.write_interrupt(0b1000000000000, "Coalesced event")
+
+    def clr_coalesced(self):
+        if self.regs.read_reg_value("ris") & 0b1000000000000 == 0b1000000000000:
+            uvm_info(self.tag, "[clear flag] clear Coalesced event interrupt", UVM_MEDIUM)
+            self.clear_interrupt(mask=0b1000000000000, name="Coalesced event")
+
+    def set_sync(self):
+        uvm_info(self.tag, "[interrupt flag] Sync word received", UVM_MEDIUM)
+        self.write_interrupt(0b100000000000000, "Sync word received")
+
+    def clr_sync(self):
+        if self.regs.read_reg_value("ris") & 0b100000000000000 == 0b100000000000000:
+            uvm_info(self.tag, "[clear flag] clear Sync word received interrupt", UVM_MEDIUM)
+            self.clear_interrupt(mask=0b100000000000000, name="Sync word received")
+
+    def set_eof(self):
+        uvm_info(self.tag, "[interrupt flag] End of frame", UVM_MEDIUM)
+        self.write_interrupt(0b1000000000000000, "End of frame")
+
+    def clr_eof(self):
+        if self.regs.read_reg_value("ris") & 0b1000000000000000 == 0b1000000000000000:
+            uvm_info(self.tag, "[clear flag] clear End of frame interrupt", UVM_MEDIUM)
+            self.clear_interrupt(mask=0b1000000000000000, name="End of frame")
+
 
 class TX_QUEUE(Queue):
     """same queue provided by cocotb but with 2 new functions to get the tx value send it and then pop it from the queue after sending"""
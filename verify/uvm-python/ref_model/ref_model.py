@@ -67,12 +67,20 @@ class UART_VIP(ref_model):
         uvm_info(self.tag, "ip_irq Vip write: " + tr.convert2string(), UVM_MEDIUM)
         if tr.rx_timeout:
             self.model.flags.set_timeout_err()
+            self.model.sync_restart()
         if tr.rx_break_line:
             self.model.flags.set_line_break()
+            self.model.count_stat("brk")
         if tr.rx_wrong_parity:
             self.model.flags.set_parity_err()
+            self.model.count_stat("pe")
+            self.model.frame_err |= 1 << 17
         if tr.rx_frame_error:
             self.model.flags.set_frame_err()
+            self.model.count_stat("fe")
+            self.model.frame_err |= 1 << 16
+        if tr.rx_frame_gap:
+            self.model.frame_end()
 
     async def update_irq(self):
         irq = 0
@@ -1,4 +1,5 @@
 import cocotb
+import random
 from uvm.comps import UVMTest
 from uvm import UVMCoreService
 from uvm.macros import uvm_component_utils, uvm_fatal, uvm_info
@@ -31,11 +32,23 @@ from uart_seq_lib.rx_length_parity_seq import (
     rx_length_parity_seq,
     rx_length_parity_seq_wrapper,
 )
+from uart_seq_lib.uart_oversampling_seq import uart_oversampling_seq_wrapper
 from uart_seq_lib.uart_prescalar_seq import (
     uart_prescalar_seq_wrapper,
+    uart_prescalar_frac_seq_wrapper,
     uart_prescalar_seq,
 )
 from uart_seq_lib.uart_loopback_seq import uart_loopback_seq
+from uart_seq_lib.uart_flow_control_seq import uart_flow_control_seq
+from uart_seq_lib.uart_multidrop_seq import uart_multidrop_seq, uart_multidrop_rx_seq
+from uart_seq_lib.uart_rs485_seq import uart_rs485_seq
+from uart_seq_lib.uart_autobaud_seq import uart_autobaud_seq, uart_autobaud_sync_seq
+from uart_seq_lib.uart_coalescing_seq import uart_coalescing_seq
+from uart_seq_lib.uart_majority_seq import uart_majority_seq, uart_majority_rx_seq
+from uart_seq_lib.uart_sync_seq import uart_sync_seq, uart_sync_rx_seq
+from uart_seq_lib.uart_crc_seq import uart_crc_seq, uart_crc_rx_seq
+from uart_seq_lib.uart_frame_gap_seq import uart_frame_gap_seq, uart_frame_gap_rx_seq
+from uart_seq_lib.uart_usart_seq import uart_usart_seq, uart_usart_rx_seq
 from uvm.base import UVMRoot
 
 # override classes
@@ -180,6 +193,27 @@ class LoopbackTest(uart_base_test):
 uvm_component_utils(LoopbackTest)
 
 
+class FlowControlTest(uart_base_test):
+    def __init__(self, name="FlowControlTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        bus_seq = uart_flow_control_seq("uart_flow_control_seq")
+        bus_seq.monitor = self.top_env.ip_env.ip_agent.monitor
+        ip_seq = uart_rx_seq("uart_rx_seq")
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await bus_seq_thread
+        await ip_seq_thread
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(FlowControlTest)
+
+
 class PrescalarStressTest(uart_base_test):
     def __init__(self, name="PrescalarTest", parent=None):
         super().__init__(name, parent)
@@ -201,6 +235,48 @@ class PrescalarStressTest(uart_base_test):
 uvm_component_utils(PrescalarStressTest)
 
 
+class PrescalarFracStressTest(uart_base_test):
+    def __init__(self, name="PrescalarFracStressTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        handshake_event = Event("handshake_event")
+        ip_seq = uart_prescalar_seq(handshake_event)
+        bus_seq = uart_prescalar_frac_seq_wrapper(handshake_event)
+        bus_seq.tx_seq_obj.monitor = self.top_env.ip_env.ip_agent.monitor
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await First(ip_seq_thread, bus_seq_thread)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(PrescalarFracStressTest)
+
+
+class OversamplingStressTest(uart_base_test):
+    def __init__(self, name="OversamplingStressTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        handshake_event = Event("handshake_event")
+        ip_seq = uart_prescalar_seq(handshake_event)
+        bus_seq = uart_oversampling_seq_wrapper(handshake_event)
+        bus_seq.tx_seq_obj.monitor = self.top_env.ip_env.ip_agent.monitor
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await First(ip_seq_thread, bus_seq_thread)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(OversamplingStressTest)
+
+
 class LengthParityTXStressTest(uart_base_test):
     def __init__(self, name="LengthParityTXStressTest", parent=None):
         super().__init__(name, parent)
@@ -238,6 +314,187 @@ class LengthParityRXStressTest(uart_base_test):
 uvm_component_utils(LengthParityRXStressTest)
 
 
+class MultidropTest(uart_base_test):
+    def __init__(self, name="MultidropTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        handshake_event = Event("handshake_event")
+        address = random.randint(0, 0x7F)
+        bus_seq = uart_multidrop_seq(handshake_event, address)
+        ip_seq = uart_multidrop_rx_seq(handshake_event, address)
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await First(ip_seq_thread, bus_seq_thread)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(MultidropTest)
+
+
+class RS485Test(uart_base_test):
+    def __init__(self, name="RS485Test", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        bus_seq = uart_rs485_seq("uart_rs485_seq")
+        bus_seq.monitor = self.top_env.ip_env.ip_agent.monitor
+        await bus_seq.start(self.bus_sqr)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(RS485Test)
+
+
+class AutobaudTest(uart_base_test):
+    def __init__(self, name="AutobaudTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        handshake_event = Event("handshake_event")
+        ip_seq = uart_autobaud_sync_seq(handshake_event)
+        bus_seq = uart_autobaud_seq(handshake_event)
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await First(ip_seq_thread, bus_seq_thread)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(AutobaudTest)
+
+
+class CoalescingTest(uart_base_test):
+    def __init__(self, name="CoalescingTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        bus_seq = uart_coalescing_seq("uart_coalescing_seq")
+        bus_seq.monitor = self.top_env.ip_env.ip_agent.monitor
+        await bus_seq.start(self.bus_sqr)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(CoalescingTest)
+
+
+class MajorityVoteTest(uart_base_test):
+    def __init__(self, name="MajorityVoteTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    def build_phase(self, phase):
+        UVMConfigDb.set(None, "*", "insert_glitches", True)
+        super().build_phase(phase)
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        handshake_event = Event("handshake_event")
+        bus_seq = uart_majority_seq(handshake_event)
+        ip_seq = uart_majority_rx_seq(handshake_event)
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await First(ip_seq_thread, bus_seq_thread)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(MajorityVoteTest)
+
+
+class SyncWordTest(uart_base_test):
+    def __init__(self, name="SyncWordTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        handshake_event = Event("handshake_event")
+        ip_seq = uart_sync_rx_seq(handshake_event)
+        bus_seq = uart_sync_seq(handshake_event, ip_seq)
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await First(ip_seq_thread, bus_seq_thread)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(SyncWordTest)
+
+
+class CrcTest(uart_base_test):
+    def __init__(self, name="CrcTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        handshake_event = Event("handshake_event")
+        ip_seq = uart_crc_rx_seq(handshake_event)
+        bus_seq = uart_crc_seq(handshake_event, ip_seq)
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await First(ip_seq_thread, bus_seq_thread)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(CrcTest)
+
+
+class FrameGapTest(uart_base_test):
+    def __init__(self, name="FrameGapTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        handshake_event = Event("handshake_event")
+        ip_seq = uart_frame_gap_rx_seq(handshake_event)
+        bus_seq = uart_frame_gap_seq(handshake_event, ip_seq)
+        bus_seq.monitor = self.top_env.ip_env.ip_agent.monitor
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await First(ip_seq_thread, bus_seq_thread)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(FrameGapTest)
+
+
+class UsartTest(uart_base_test):
+    def __init__(self, name="UsartTest", parent=None):
+        super().__init__(name, parent)
+        self.tag = name
+
+    async def main_phase(self, phase):
+        uvm_info(self.tag, f"Starting test {self.__class__.__name__}", UVM_LOW)
+        phase.raise_objection(self, f"{self.__class__.__name__} OBJECTED")
+        handshake_event = Event("handshake_event")
+        ip_seq = uart_usart_rx_seq(handshake_event)
+        bus_seq = uart_usart_seq(handshake_event, ip_seq)
+        bus_seq.monitor = self.top_env.ip_env.ip_agent.monitor
+        bus_seq_thread = await cocotb.start(bus_seq.start(self.bus_sqr))
+        ip_seq_thread = await cocotb.start(ip_seq.start(self.ip_sqr))
+        await First(ip_seq_thread, bus_seq_thread)
+        phase.drop_objection(self, f"{self.__class__.__name__} drop objection")
+
+
+uvm_component_utils(UsartTest)
+
+
 class WriteReadRegsTest(uart_base_test):
     def __init__(self, name="WriteReadRegsTest", parent=None):
         super().__init__(name, parent)
@@ -6,6 +6,14 @@ module top();
     wire 		RX;
     wire 		TX;
     wire 		irq;
+    wire 		RTS_n;
+    reg 		CTS_n = 0;
+    wire 		DE;
+    // bit clock of the synchronous mode; driven by the IP unless CTRL.scext, by the agent otherwise
+    reg 		SCLK_IN = 1;
+    wire 		SCLK_OUT;
+    wire 		SCLK_OE;
+    wire 		SCLK = SCLK_OE ? SCLK_OUT : SCLK_IN;
     `ifdef BUS_TYPE_APB
         wire [31:0]	PADDR;
         wire 		PWRITE;
@@ -14,7 +22,7 @@ module top();
         wire [31:0]	PWDATA;
         wire [31:0]	PRDATA;
         wire 		PREADY;
-        EF_UART_APB dut(.rx(RX), .tx(TX), .PCLK(CLK), .PRESETn(RESETn), .PADDR(PADDR), .PWRITE(PWRITE), .PSEL(PSEL), .PENABLE(PENABLE), .PWDATA(PWDATA), .PRDATA(PRDATA), .PREADY(PREADY), .IRQ(irq));
+        EF_UART_APB dut(.rx(RX), .tx(TX), .PCLK(CLK), .PRESETn(RESETn), .PADDR(PADDR), .PWRITE(PWRITE), .PSEL(PSEL), .PENABLE(PENABLE), .PWDATA(PWDATA), .PRDATA(PRDATA), .PREADY(PREADY), .tx_dma_ack(1'b0), .rx_dma_ack(1'b0), .rts_n(RTS_n), .cts_n(CTS_n), .de(DE), .sclk_in(SCLK_IN), .sclk_out(SCLK_OUT), .sclk_oe(SCLK_OE), .IRQ(irq));
     `endif // BUS_TYPE_APB
     `ifdef BUS_TYPE_AHB
         wire [31:0]	HADDR;
@@ -25,7 +33,7 @@ module top();
         wire [31:0]	HWDATA;
         wire [31:0]	HRDATA;
         wire 		HREADY;
-        EF_UART_AHBL dut(.rx(RX), .tx(TX), .HCLK(CLK), .HRESETn(RESETn), .HADDR(HADDR), .HWRITE(HWRITE), .HSEL(HSEL), .HTRANS(HTRANS), .HWDATA(HWDATA), .HRDATA(HRDATA), .HREADY(HREADY),.HREADYOUT(HREADYOUT), .IRQ(irq));
+        EF_UART_AHBL dut(.rx(RX), .tx(TX), .HCLK(CLK), .HRESETn(RESETn), .HADDR(HADDR), .HWRITE(HWRITE), .HSEL(HSEL), .HTRANS(HTRANS), .HWDATA(HWDATA), .HRDATA(HRDATA), .HREADY(HREADY),.HREADYOUT(HREADYOUT), .tx_dma_ack(1'b0), .rx_dma_ack(1'b0), .rts_n(RTS_n), .cts_n(CTS_n), .de(DE), .sclk_in(SCLK_IN), .sclk_out(SCLK_OUT), .sclk_oe(SCLK_OE), .IRQ(irq));
     `endif // BUS_TYPE_AHB
     `ifdef BUS_TYPE_WISHBONE
         wire [31:0] adr_i;
@@ -35,7 +43,7 @@ module top();
         wire        cyc_i;
         wire        stb_i;
         reg         ack_o;
-        EF_UART_WB dut(.rx(RX), .tx(TX), .clk_i(CLK), .rst_i(~RESETn), .adr_i(adr_i), .dat_i(dat_i), .dat_o(dat_o), .sel_i(sel_i), .cyc_i(cyc_i), .stb_i(stb_i), .ack_o(ack_o),.we_i(we_i), .IRQ(irq));
+        EF_UART_WB dut(.rx(RX), .tx(TX), .clk_i(CLK), .rst_i(~RESETn), .adr_i(adr_i), .dat_i(dat_i), .dat_o(dat_o), .sel_i(sel_i), .cyc_i(cyc_i), .stb_i(stb_i), .ack_o(ack_o),.we_i(we_i), .tx_dma_ack(1'b0), .rx_dma_ack(1'b0), .rts_n(RTS_n), .cts_n(CTS_n), .de(DE), .sclk_in(SCLK_IN), .sclk_out(SCLK_OUT), .sclk_oe(SCLK_OE), .IRQ(irq));
     `endif // BUS_TYPE_WISHBONE
     // monitor inside signals
 `ifndef GL 
@@ -37,6 +37,7 @@ class uart_driver(UVMDriver):
 
     async def run_phase(self, phase):
         uvm_info(self.tag, "run_phase started", UVM_LOW)
+        await cocotb.start(self.drive_sclk())
         # assert glitches
         while True:
             tr = []
@@ -66,6 +67,13 @@ class uart_driver(UVMDriver):
         await FallingEdge(self.vif.PRESETn)
 
     async def send_item_rx(self, tr):
+        # flow control: a character is not started while the IP holds RTS high
+        if self.vif.RTS_n.value == 1:
+            uvm_info(self.tag, "waiting for RTS", UVM_HIGH)
+            await FallingEdge(self.vif.RTS_n)
+        if self.is_synchronous():
+            await self.send_item_sync(tr)
+            return
         await self.start_of_rx()
         if self.insert_glitches:
             await cocotb.start(self.add_glitches())  # assert glitches
@@ -82,25 +90,56 @@ class uart_driver(UVMDriver):
         #     uvm_info(self.tag, "Adding breakline", UVM_MEDIUM)
         #     await self.break_line()
 
+    async def send_item_sync(self, tr):
+        # one bit per SCLK period; every bit is driven at a falling edge and sampled by the IP at the rising edge
+        parity_type = (self.regs.read_reg_value("CFG") >> 5) & 0x7
+        tr.calculate_parity(parity_type)
+        bits = [0] + [(tr.char >> i) & 1 for i in range(self.get_n_bits())]
+        if tr.parity != "None":
+            bits.append(int(tr.parity))
+        bits += [1] * (1 + ((self.regs.read_reg_value("CFG") >> 4) & 0x1))
+        for bit in bits:
+            await FallingEdge(self.vif.SCLK)
+            self.vif.RX.value = bit
+        await FallingEdge(self.vif.SCLK)
+
+    async def drive_sclk(self):
+        # with CTRL.scext the agent is the clock master; SCLK_IN toggles every half bit of the programmed rate
+        half_frac = 0
+        while True:
+            if not (self.is_synchronous() and self.regs.read_reg_value("CTRL") & 0x2000):
+                self.vif.SCLK_IN.value = 1
+                await ClockCycles(self.vif.PCLK, 1)
+                continue
+            half_frac += self.get_bit_n_cyc() / 2
+            cycles = max(1, int(half_frac))
+            half_frac -= cycles
+            await ClockCycles(self.vif.PCLK, cycles)
+            self.vif.SCLK_IN.value = 1 - self.vif.SCLK_IN.value.integer
+
+    def is_synchronous(self):
+        return (self.regs.read_reg_value("CTRL") >> 12) & 0b1
+
     async def break_line(self):
         self.vif.RX.value = 0
-        await ClockCycles(self.vif.PCLK, self.num_cyc_bit * random.randint(12, 20))
+        await ClockCycles(self.vif.PCLK, int(self.num_cyc_bit * random.randint(12, 20)))
         self.vif.RX.value = 1
-        await ClockCycles(self.vif.PCLK, self.num_cyc_bit)
+        await ClockCycles(self.vif.PCLK, self.next_bit_n_cyc())
 
     async def start_of_rx(self):
         self.vif.RX.value = 0
         self.num_cyc_bit = self.get_bit_n_cyc()
+        self.bit_frac = 0
         self.word_length = self.get_n_bits()
         uvm_info(self.tag, "starting of start bit", UVM_HIGH)
-        await ClockCycles(self.vif.PCLK, self.num_cyc_bit)
+        await ClockCycles(self.vif.PCLK, self.next_bit_n_cyc())
         uvm_info(self.tag, "finifhing of start bit", UVM_HIGH)
 
     async def send_byte(self, byte):
         for i in range(self.word_length):
             self.vif.RX.value = (byte >> i) & 1
             uvm_info(self.tag, f"driving byte[{i}] = {(byte >> i) & 1}", UVM_HIGH)
-            await ClockCycles(self.vif.PCLK, self.num_cyc_bit)
+            await ClockCycles(self.vif.PCLK, self.next_bit_n_cyc())
 
     async def send_parity(self, tr):
         parity_type = (self.regs.read_reg_value("CFG") >> 5) & 0x7
@@ -109,28 +148,40 @@ class uart_driver(UVMDriver):
             return
         self.vif.RX.value = int(tr.parity)
         uvm_info(self.tag, f"driving parity = {tr.parity}", UVM_HIGH)
-        await ClockCycles(self.vif.PCLK, self.num_cyc_bit)
+        await ClockCycles(self.vif.PCLK, self.next_bit_n_cyc())
 
     async def send_stop_bit(self):
         stop_bit = (self.regs.read_reg_value("CFG") >> 4) & 0x1
         if stop_bit:
             self.vif.RX.value = 1
             uvm_info(self.tag, f"driving extra stop bit", UVM_HIGH)
-            await ClockCycles(self.vif.PCLK, self.num_cyc_bit)
+            await ClockCycles(self.vif.PCLK, self.next_bit_n_cyc())
         return
 
     async def end_of_rx(self, extra_stop_bit=0):
         self.vif.RX.value = 1
         uvm_info(self.tag, f"start ending of RX", UVM_HIGH)
-        await ClockCycles(self.vif.PCLK, self.num_cyc_bit)
+        await ClockCycles(self.vif.PCLK, self.next_bit_n_cyc())
         uvm_info(self.tag, f"finished ending of RX", UVM_HIGH)
         for _ in range(extra_stop_bit):
-            await ClockCycles(self.vif.PCLK, self.num_cyc_bit)
+            await ClockCycles(self.vif.PCLK, self.next_bit_n_cyc())
 
     def get_bit_n_cyc(self):
         prescale = self.regs.read_reg_value("PR")
-        uvm_info(self.tag, "prescale = " + str(prescale), UVM_HIGH)
-        return (prescale + 1) * 8
+        prescale_frac = self.regs.read_reg_value("PRF")
+        # CFG.osr: 0 keeps the SC parameter of the IP (8), 1: 16, 2: 8, 3: 4; a bit is two ticks in the synchronous mode
+        samples = [8, 16, 8, 4][(self.regs.read_reg_value("CFG") >> 14) & 0b11]
+        if self.is_synchronous():
+            samples = 2
+        uvm_info(self.tag, f"prescale = {prescale} fraction = {prescale_frac}/16 samples = {samples}", UVM_HIGH)
+        return ((prescale + 1) * 16 + prescale_frac) * samples / 16
+
+    def next_bit_n_cyc(self):
+        # with a prescaler fraction a bit is not a whole number of cycles; carry the remainder to the next bit
+        self.bit_frac += self.num_cyc_bit
+        cycles = int(self.bit_frac)
+        self.bit_frac -= cycles
+        return cycles
 
     def get_n_bits(self):
         word_length = self.regs.read_reg_value("CFG") & 0xF
@@ -10,6 +10,7 @@ from cocotb.triggers import (
     RisingEdge,
     Combine,
     First,
+    Edge,
 )
 from uart_item.uart_item import uart_item
 from uart_item.uart_interrupt import uart_interrupt
@@ -22,15 +23,19 @@ from EF_UVM.ip_env.ip_agent.ip_monitor import ip_monitor
 class uart_monitor(ip_monitor):
     def __init__(self, name="uart_monitor", parent=None):
         super().__init__(name, parent)
+        self.bit_frac = {uart_item.TX: 0, uart_item.RX: 0}
         self.tx_received = Event("tx_received")
         self.rx_received = Event("rx_received")
+        self.rx_char_end = Event("rx_char_end")
 
     async def run_phase(self, phase):
         sample_tx = await cocotb.start(self.sample_tx())
         sample_rx = await cocotb.start(self.sample_rx())
         timeout_thread = await cocotb.start(self.watch_rx_timeout())
+        frame_gap_thread = await cocotb.start(self.watch_frame_gap())
         break_line_thread = await cocotb.start(self.watch_line_break())
         await self.get_clk_period()
+        tx_rate_thread = await cocotb.start(self.check_tx_rate())
         await Combine(sample_tx, sample_rx)
 
     async def get_clk_period(self):
@@ -76,6 +81,7 @@ class uart_monitor(ip_monitor):
             )
             self.monitor_port.write(tr)
             self.rx_received.set()
+            self.rx_char_end.set()
             self.check_parity(tr.char, tr.parity)
 
     async def get_char(self, direction=uart_item.TX):
@@ -90,20 +96,20 @@ class uart_monitor(ip_monitor):
         char = ""
         parity = "None"
         for i in range(word_length):
-            new_bit = await self.glitch_free_sample(signal, num_cyc_bit, 8)
+            new_bit = await self.sample_bit(signal, self.next_bit_n_cyc(direction, num_cyc_bit))
             char = new_bit + char
             uvm_info(
                 self.tag, f"char[{i}] = {new_bit}  length = {word_length}", UVM_HIGH
             )
         # get parity bit
         if self.is_parity_exists():
-            parity = await self.glitch_free_sample(signal, num_cyc_bit, 8)
+            parity = await self.sample_bit(signal, self.next_bit_n_cyc(direction, num_cyc_bit))
             uvm_info(
                 self.tag, f"parity bit = {parity}  length = {word_length}", UVM_HIGH
             )
         # stop bit
-        stop_bit = await self.glitch_free_sample(
-            signal, num_cyc_bit, 8, last_bit=not self.is_stop_bit_exists()
+        stop_bit = await self.sample_bit(
+            signal, self.next_bit_n_cyc(direction, num_cyc_bit), last_bit=not self.is_stop_bit_exists()
         )
         if stop_bit != "1":
             uvm_warning(self.tag, f"stop bit expected but got {stop_bit}")
@@ -113,8 +119,8 @@ class uart_monitor(ip_monitor):
         # await ClockCycles(self.vif.PCLK, num_cyc_bit - 2)  # to even the /2 in the start of tx
         # mimic stop bit
         if self.is_stop_bit_exists():
-            stop_bit = await self.glitch_free_sample(
-                signal, num_cyc_bit, 8, last_bit=True
+            stop_bit = await self.sample_bit(
+                signal, self.next_bit_n_cyc(direction, num_cyc_bit), last_bit=True
             )
             if stop_bit != "1":
                 uvm_warning(self.tag, f"stop bit expected but got {stop_bit}")
@@ -152,11 +158,13 @@ class uart_monitor(ip_monitor):
                 f"waited for done {(done_time - wait_done_time)/ self.clk_period} cycles num_cyc {num_cyc_bit}",
                 UVM_HIGH,
             )
-            # check the monitor waited for the done less than num_cyc_bit_tx / 2 if not there is an issue in the protocol
-            if (done_time - wait_done_time) / self.clk_period > num_cyc_bit / 2:
+            # check the monitor waited for the done less than num_cyc_bit_tx / 2 if not there is an issue in the protocol;
+            # a synchronous stop bit is sampled at the rising edge of SCLK, half a bit before it ends
+            wait_limit = num_cyc_bit if self.is_synchronous() else num_cyc_bit / 2
+            if (done_time - wait_done_time) / self.clk_period > wait_limit:
                 uvm_error(
                     self.tag,
-                    f"stop bit checker waited for the done more than {num_cyc_bit / 2} < {(done_time - wait_done_time)/ self.clk_period} cycles",
+                    f"stop bit checker waited for the done more than {wait_limit} < {(done_time - wait_done_time)/ self.clk_period} cycles",
                 )
         return int(char, 2), parity, word_length
 
@@ -169,7 +177,14 @@ class uart_monitor(ip_monitor):
             await Timer(1, units="ns")
             if self.vif.TX.value == 1:
                 continue
-            await ClockCycles(self.vif.PCLK, num_cyc_bit_tx)
+            if self.is_synchronous():
+                # the start bit is the first low sample at a rising edge of SCLK
+                await RisingEdge(self.vif.SCLK)
+                if self.vif.TX.value == 1:
+                    continue
+                break
+            self.bit_frac[uart_item.TX] = 0
+            await ClockCycles(self.vif.PCLK, self.next_bit_n_cyc(uart_item.TX, num_cyc_bit_tx))
             break
         return num_cyc_bit_tx, word_length_tx
 
@@ -182,14 +197,40 @@ class uart_monitor(ip_monitor):
             await Timer(1, units="ns")
             if self.vif.RX.value == 1:
                 continue
-            await ClockCycles(self.vif.PCLK, num_cyc_bit_rx)
+            if self.is_synchronous():
+                # the start bit is the first low sample at a rising edge of SCLK
+                await RisingEdge(self.vif.SCLK)
+                if self.vif.RX.value == 1:
+                    continue
+                break
+            self.bit_frac[uart_item.RX] = 0
+            await ClockCycles(self.vif.PCLK, self.next_bit_n_cyc(uart_item.RX, num_cyc_bit_rx))
             break
         return num_cyc_bit_rx, word_length_rx
 
     def get_bit_n_cyc(self):
         prescale = self.regs.read_reg_value("PR")
-        uvm_info(self.tag, "prescale = " + str(prescale), UVM_HIGH)
-        return (prescale + 1) * 8
+        prescale_frac = self.regs.read_reg_value("PRF")
+        samples = self.get_samples()
+        uvm_info(self.tag, f"prescale = {prescale} fraction = {prescale_frac}/16 samples = {samples}", UVM_HIGH)
+        return ((prescale + 1) * 16 + prescale_frac) * samples / 16
+
+    def get_samples(self):
+        # CFG.osr: 0 keeps the SC parameter of the IP (8), 1: 16, 2: 8, 3: 4; a bit is two ticks in the synchronous mode
+        if self.is_synchronous():
+            return 2
+        osr = (self.regs.read_reg_value("CFG") >> 14) & 0b11
+        return [8, 16, 8, 4][osr]
+
+    def is_synchronous(self):
+        return (self.regs.read_reg_value("CTRL") >> 12) & 0b1
+
+    def next_bit_n_cyc(self, direction, num_cyc_bit):
+        # with a prescaler fraction a bit is not a whole number of cycles; carry the remainder to the next bit
+        self.bit_frac[direction] += num_cyc_bit
+        cycles = int(self.bit_frac[direction])
+        self.bit_frac[direction] -= cycles
+        return cycles
 
     def get_n_bits(self):
         word_length = self.regs.read_reg_value("CFG") & 0b1111
@@ -232,13 +273,69 @@ class uart_monitor(ip_monitor):
                 # uvm_info(self.tag, f"timed out for {timeout}", UVM_HIGH)
                 self.monitor_irq_port.write(irq)
 
+    async def watch_frame_gap(self):
+        # the end of frame is raised once the line has been idle for GAP/16 character times after a character
+        while True:
+            await self.rx_char_end.wait()
+            self.rx_char_end.clear()
+            gap = self.regs.read_reg_value("GAP") & 0xFF
+            if gap == 0:
+                continue
+            char_bits = 1 + self.get_n_bits() + int(self.is_parity_exists()) + 1 + self.is_stop_bit_exists()
+            gap_ns = int(gap * char_bits * self.get_bit_n_cyc() * self.clk_period / 16)
+            await First(Timer(gap_ns, "ns"), self.rx_char_end.wait())
+            if not self.rx_char_end.is_set():
+                irq = uart_interrupt.type_id.create("tr_irq", self)
+                irq.rx_frame_gap = 1
+                self.monitor_irq_port.write(irq)
+
+    async def check_tx_rate(self):
+        # every edge inside a TX frame has to fall on a bit boundary of the programmed baud rate;
+        # the baud generator spreads the prescaler fraction over the ticks, so allow one clock of jitter.
+        # The start bit begins between two baud ticks and may be up to one tick longer than a bit,
+        # so the bit boundaries are taken from the first edge after it
+        while True:
+            await FallingEdge(self.vif.TX)
+            start = cocotb.utils.get_sim_time(units="ns")
+            num_cyc_bit = self.get_bit_n_cyc()
+            num_cyc_tick = num_cyc_bit / self.get_samples()
+            frame_bits = 1 + self.get_n_bits() + int(self.is_parity_exists()) + 1 + self.is_stop_bit_exists()
+            frame_end = start + (frame_bits * num_cyc_bit + num_cyc_tick) * self.clk_period - 1
+            reference = None
+            while True:
+                remaining = frame_end - cocotb.utils.get_sim_time(units="ns")
+                if remaining < 1:
+                    break
+                timeout = Timer(remaining, units="ns", round_mode="round")
+                if await First(Edge(self.vif.TX), timeout) is timeout:
+                    break
+                now = cocotb.utils.get_sim_time(units="ns")
+                if reference is None:
+                    cycles = (now - start) / self.clk_period
+                    bits = max(1, int(cycles // num_cyc_bit))
+                    late = cycles - bits * num_cyc_bit
+                    if late < -1.5 or late > num_cyc_tick + 1.5:
+                        uvm_error(
+                            self.tag,
+                            f"first TX edge after {cycles} cycles is off the bit boundary {bits} x {num_cyc_bit} cycles",
+                        )
+                    reference = now - bits * num_cyc_bit * self.clk_period
+                    continue
+                cycles = (now - reference) / self.clk_period
+                bits = round(cycles / num_cyc_bit)
+                if abs(cycles - bits * num_cyc_bit) > 1.5:
+                    uvm_error(
+                        self.tag,
+                        f"TX edge after {cycles} cycles is off the bit boundary {bits} x {num_cyc_bit} cycles",
+                    )
+
     async def watch_line_break(self):
         while True:
             await FallingEdge(self.vif.RX)
             bit_num_cycles = self.get_bit_n_cyc()
             await ClockCycles(self.vif.PCLK, math.floor(bit_num_cycles / 2))
             for _ in range(11):
-                await ClockCycles(self.vif.PCLK, bit_num_cycles)
+                await ClockCycles(self.vif.PCLK, math.ceil(bit_num_cycles))
                 if self.vif.RX.value == 1:
                     break
             if self.vif.RX.value == 1:
@@ -270,7 +367,16 @@ class uart_monitor(ip_monitor):
         irq.rx_frame_error = 1
         self.monitor_irq_port.write(irq)
 
+    async def sample_bit(self, signal, num_cyc, last_bit=False):
+        # the IP samples a synchronous bit at the rising edge of SCLK, an asynchronous one around its centre
+        if self.is_synchronous():
+            await RisingEdge(self.vif.SCLK)
+            return signal.value.binstr
+        return await self.glitch_free_sample(signal, num_cyc, 8, last_bit)
+
     async def glitch_free_sample(self, signal, num_cyc, sample_num, last_bit=False):
+        # at 4x oversampling with a small prescaler a bit is shorter than the number of samples
+        sample_num = max(1, min(sample_num, num_cyc))
         base_value = num_cyc // sample_num
         lst = [base_value] * sample_num
         # Distribute the remainder across the first 'remainder' elements of the list by adding 1
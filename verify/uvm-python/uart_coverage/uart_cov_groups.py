@@ -33,6 +33,17 @@ class ip_cov_groups:
             at_least=3,
             rel=lambda val, b: b[0][0] <= val[0] <= b[0][1] and val[1] == b[1],
         )
+        @CoverPoint(
+            f"{self.hierarchy}.Oversampling",
+            xf=lambda tr: ((self.regs.read_reg_value("CFG") >> 14) & 0b11, tr.direction),
+            bins=[(i, j) for i in range(4) for j in [uart_item.RX, uart_item.TX]],
+            bins_labels=[
+                (["SC", "16x", "8x", "4x"][i], "RX" if j == uart_item.RX else "TX")
+                for i in range(4)
+                for j in [uart_item.RX, uart_item.TX]
+            ],
+            at_least=3,
+        )
         @CoverPoint(
             f"{self.hierarchy}.Loopback",
             xf=lambda tr: (self.regs.read_reg_value("CTRL") & 0b1000 == 0b1000),
@@ -59,12 +70,89 @@ class ip_cov_groups:
             ],
             at_least=3,
         )
+        @CoverPoint(
+            f"{self.hierarchy}.Multidrop",
+            xf=lambda tr: (self.multidrop_frame(tr), tr.direction),
+            bins=[
+                (i, uart_item.RX)
+                for i in ["disabled", "data", "address match", "address other"]
+            ],
+            bins_labels=["disabled", "data", "address match", "address other"],
+            at_least=3,
+        )
+        @CoverPoint(
+            f"{self.hierarchy}.Sync_word",
+            xf=lambda tr: (self.sync_mode(), tr.direction),
+            bins=[("disabled", uart_item.RX)]
+            + [((i, j), uart_item.RX) for i in range(1, 5) for j in ["detect", "hunt"]],
+            bins_labels=["disabled"] + [f"{i} chars {j}" for i in range(1, 5) for j in ["detect", "hunt"]],
+            at_least=3,
+        )
+        @CoverPoint(
+            f"{self.hierarchy}.Crc",
+            xf=lambda tr: (self.crc_mode(), tr.direction),
+            bins=[((w, r), d) for w in [8, 16, 32] for r in ["plain", "reflected"] for d in [uart_item.RX, uart_item.TX]],
+            bins_labels=[f"{w} bits {r} {d}" for w in [8, 16, 32] for r in ["plain", "reflected"] for d in ["rx", "tx"]],
+            at_least=3,
+        )
+        @CoverPoint(
+            f"{self.hierarchy}.Frame_gap",
+            xf=lambda tr: (self.frame_gap(), tr.direction),
+            bins=[(i, uart_item.RX) for i in ["disabled", "under 1 char", "1 char and more"]],
+            bins_labels=["disabled", "under 1 char", "1 char and more"],
+            at_least=3,
+        )
+        @CoverPoint(
+            f"{self.hierarchy}.Clock_mode",
+            xf=lambda tr: (self.clock_mode(), tr.direction),
+            bins=[(i, j) for i in ["asynchronous", "sclk out", "sclk in"] for j in [uart_item.RX, uart_item.TX]],
+            bins_labels=[(i, "RX" if j == uart_item.RX else "TX") for i in ["asynchronous", "sclk out", "sclk in"] for j in [uart_item.RX, uart_item.TX]],
+            at_least=3,
+        )
         def sample(tr):
             uvm_info("coverage_ip", f"tr = {tr}", UVM_LOW)
 
         if do_sampling:
             sample(tr)
 
+    def multidrop_frame(self, tr):
+        # kind of a received frame in the 9-bit multidrop address mode (CTRL.aden)
+        if not self.regs.read_reg_value("CTRL") & 0x200:
+            return "disabled"
+        if tr.word_length != 9 or not tr.char & 0x100:
+            return "data"
+        mask = self.regs.read_reg_value("MATCH_MASK")
+        match = ((tr.char ^ self.regs.read_reg_value("MATCH")) & ~mask & 0x1FF) == 0
+        return "address match" if match else "address other"
+
+    def sync_mode(self):
+        # sync word length and whether the receiver hunts for it (SYNC_CTRL)
+        ctrl = self.regs.read_reg_value("SYNC_CTRL")
+        if not ctrl & 0b100:
+            return "disabled"
+        return ((ctrl & 0b11) + 1, "hunt" if ctrl & 0b1000 else "detect")
+
+    def crc_mode(self):
+        # CRC width and whether the characters are fed LSB first (CRC_CTRL)
+        ctrl = self.regs.read_reg_value("CRC_CTRL")
+        if not ctrl & 0b1:
+            return "disabled"
+        return ({0: 8, 1: 16}.get((ctrl >> 1) & 0b11, 32), "reflected" if ctrl & 0b1000 else "plain")
+
+    def frame_gap(self):
+        # idle gap that ends a frame (GAP), in 1/16 character times
+        gap = self.regs.read_reg_value("GAP")
+        if gap == 0:
+            return "disabled"
+        return "under 1 char" if gap < 16 else "1 char and more"
+
+    def clock_mode(self):
+        # asynchronous, or synchronous with the IP driving SCLK or taking it from the other side (CTRL.scen, CTRL.scext)
+        ctrl = self.regs.read_reg_value("CTRL")
+        if not ctrl & 0x1000:
+            return "asynchronous"
+        return "sclk in" if ctrl & 0x2000 else "sclk out"
+
     def all_word_char(self):
         cov_points = []
         ranges = {9: [32, 16], 8: [16, 16], 7: [16, 8], 6: [8, 8], 5: [8, 4]}
@@ -15,5 +15,10 @@ class uart_if(sv_if):
             "TX": "TX",
             "tx_done": "tx_done",
             "rx_done": "rx_done",
+            "RTS_n": "RTS_n",
+            "CTS_n": "CTS_n",
+            "DE": "DE",
+            "SCLK": "SCLK",
+            "SCLK_IN": "SCLK_IN",
         }
         super().__init__(dut, "", bus_map)
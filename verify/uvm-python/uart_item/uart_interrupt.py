@@ -19,15 +19,17 @@ class uart_interrupt(UVMSequenceItem):
         self.rx_break_line = 0  # bit
         self.rx_wrong_parity = 0  # bit
         self.rx_frame_error = 0  # bit
+        self.rx_frame_gap = 0  # bit
         pass
 
     def convert2string(self):
         return sv.sformatf(
-            "rx_timeout = %d, rx_break_line = %d, rx_wrong_parity = %d, rx_frame_error = %d",
+            "rx_timeout = %d, rx_break_line = %d, rx_wrong_parity = %d, rx_frame_error = %d, rx_frame_gap = %d",
             self.rx_timeout,
             self.rx_break_line,
             self.rx_wrong_parity,
             self.rx_frame_error,
+            self.rx_frame_gap,
         )
 
 
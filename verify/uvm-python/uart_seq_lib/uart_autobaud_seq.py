@@ -0,0 +1,86 @@
+from uvm.seq import UVMSequence
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_message_defines import uvm_info
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+from uvm.base import UVM_LOW
+from uart_item.uart_item import uart_item
+import random
+from EF_UVM.bus_env.bus_item import bus_item
+from uart_seq_lib.uart_config import uart_config
+from uart_seq_lib.uart_prescalar_seq import uart_prescalar_frac_seq_wrapper
+from uart_seq_lib.rx_seq import rx_seq
+from cocotb.triggers import NextTimeStep
+
+
+class uart_autobaud_sync_seq(UVMSequence):
+    """ip side; a sync character for the autobaud unit, then a few characters at the rate it measured"""
+
+    def __init__(self, handshake_event, name="uart_autobaud_sync_seq"):
+        UVMSequence.__init__(self, name)
+        self.set_automatic_phase_objection(1)
+        self.req = uart_item()
+        self.rsp = uart_item()
+        self.tag = name
+        self.handshake_event = handshake_event
+
+    async def body(self):
+        while True:
+            await self.handshake_event.wait()
+            self.handshake_event.clear()
+            await uvm_do_with(
+                self,
+                self.req,
+                lambda direction: direction == uart_item.RX,
+                lambda char: char in [0x55, 0x7F],
+            )
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+            await self.handshake_event.wait()
+            self.handshake_event.clear()
+            await uvm_do(self, rx_seq())
+            self.handshake_event.set()
+            await NextTimeStep()
+
+
+class uart_autobaud_seq(uart_prescalar_frac_seq_wrapper):
+    """sweeps the rates of the fractional prescaler sequence; the ip side sends its sync character at each of them and
+    ABR is read back before the receiver is released"""
+
+    def __init__(self, handshake_event, name="uart_autobaud_seq"):
+        super().__init__(handshake_event, name)
+        self.osr = [random.randint(0, 3) for _ in self.prescaler_vals]
+
+    async def body(self):
+        for prescaler_val, prescaler_frac, osr in zip(self.prescaler_vals, self.prescaler_fracs, self.osr):
+            uvm_info(self.get_type_name(), f"prescaler_val = {prescaler_val} prescaler_frac = {prescaler_frac}/16 osr = {osr}", UVM_LOW)
+            await self.send_reset()
+            # 8N1; EN | RXEN | ABREN
+            await uvm_do(
+                self,
+                uart_config(
+                    im=0,
+                    prescaler=prescaler_val,
+                    prescaler_frac=prescaler_frac,
+                    config=0x3F08 | (osr << 14),
+                    control=0x805,
+                ),
+            )
+            await self.handshake(NextTimeStep)
+            await self.send_req(False, "ABR")
+            await self.send_req(False, "RIS")
+            await self.send_req(True, "IC", lambda data: data == 0x800)
+            # the measurement is only read back; PR already holds the rate the ip side sends at
+            await self.send_req(True, "CTRL", lambda data: data == 0x5)
+            await self.handshake(NextTimeStep)
+            for _ in range(3):
+                await self.send_req(False, "RXDATA")
+
+    async def handshake(self, delay):
+        self.handshake_event.set()
+        await delay()  # wait dummy delay until event is clear
+        await self.handshake_event.wait()  # wait until the sequencer in the ip sequencer is done
+        self.handshake_event.clear()
+
+
+uvm_object_utils(uart_autobaud_sync_seq)
+uvm_object_utils(uart_autobaud_seq)
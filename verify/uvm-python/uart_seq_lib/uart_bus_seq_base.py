@@ -0,0 +1,41 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_sequence_defines import uvm_do_with
+from EF_UVM.bus_env.bus_item import bus_item
+from EF_UVM.bus_env.bus_seq_lib.bus_seq_base import bus_seq_base
+
+
+class uart_bus_seq_base(bus_seq_base):
+    """bus sequence with the register access helper shared by the uart sequences"""
+
+    def __init__(self, name="uart_bus_seq_base"):
+        super().__init__(name)
+
+    async def send_req(self, is_write, reg, data_condition=None):
+        # send request
+        self.create_new_item()
+        if is_write:
+            if data_condition is None:
+                await uvm_do_with(
+                    self,
+                    self.req,
+                    lambda addr: addr == self.adress_dict[reg],
+                    lambda kind: kind == bus_item.WRITE,
+                )
+            else:
+                await uvm_do_with(
+                    self,
+                    self.req,
+                    lambda addr: addr == self.adress_dict[reg],
+                    lambda kind: kind == bus_item.WRITE,
+                    data_condition,
+                )
+        else:
+            await uvm_do_with(
+                self,
+                self.req,
+                lambda addr: addr == self.adress_dict[reg],
+                lambda kind: kind == bus_item.READ,
+            )
+
+
+uvm_object_utils(uart_bus_seq_base)
@@ -0,0 +1,46 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_message_defines import uvm_info
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+from uvm.base import UVM_LOW
+from EF_UVM.bus_env.bus_item import bus_item
+import random
+from uart_seq_lib.uart_config import uart_config
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
+
+
+class uart_coalescing_seq(uart_bus_seq_base):
+    """send bursts in loopback with random COAL counts; the model predicts a
+    COAL event every rxcnt characters received, every txcnt characters sent
+    and when the TX FIFO runs empty. COAL_TIME stays 0, the model has no
+    notion of clock cycles"""
+
+    def __init__(self, name="uart_coalescing_seq", bursts=10):
+        super().__init__(name)
+        self.tag = name
+        self.bursts = bursts
+
+    async def body(self):
+        await super().body()
+        # EN | TXEN | RXEN | LPEN
+        config_seq = uart_config("uart_config", control=0xF)
+        await uvm_do(self, config_seq)
+        await self.send_req(True, "COAL_TIME", lambda data: data == 0)
+        for _ in range(self.bursts):
+            rx_count = random.choice([0, 1, 3, 8, 16, 255])
+            tx_count = random.choice([0, 1, 4, 12, 255])
+            await self.send_req(True, "COAL", lambda data: data == rx_count | tx_count << 8)
+            await self.send_req(True, "IC", lambda data: data == 0x1000)
+            count = random.randint(1, 16)
+            for _ in range(count):
+                value = random.randint(0, 0xFF)
+                await self.send_req(True, "TXDATA", lambda data: data == value)
+            for _ in range(count):
+                await self.monitor.tx_received.wait()
+                self.monitor.tx_received.clear()
+            await self.send_req(False, "RIS")
+            for _ in range(count):
+                await self.send_req(False, "RXDATA")
+            uvm_info(self.tag, f"{count} characters with COAL rx {rx_count} tx {tx_count}", UVM_LOW)
+
+
+uvm_object_utils(uart_coalescing_seq)
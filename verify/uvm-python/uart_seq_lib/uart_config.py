@@ -3,16 +3,17 @@ from uvm.macros.uvm_object_defines import uvm_object_utils
 from uvm.macros.uvm_message_defines import uvm_info, uvm_fatal
 from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
 from uvm.base import sv, UVM_HIGH, UVM_LOW
-from EF_UVM.bus_env.bus_item import bus_item
-from EF_UVM.bus_env.bus_seq_lib.bus_seq_base import bus_seq_base
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
 
 
-class uart_config(bus_seq_base):
+class uart_config(uart_bus_seq_base):
     def __init__(
         self,
         name="uart_config",
         prescaler=None,
+        prescaler_frac=None,
         config=None,
+        oversampling=None,
         im=None,
         match=None,
         fifo_control=None,
@@ -20,7 +21,9 @@ class uart_config(bus_seq_base):
     ):
         super().__init__(name)
         self.prescaler = prescaler
+        self.prescaler_frac = prescaler_frac
         self.config = config
+        self.oversampling = 0 if oversampling is None else oversampling
         self.im = im
         self.match = match
         self.fifo_control = fifo_control
@@ -51,6 +54,14 @@ class uart_config(bus_seq_base):
                 data_condition=lambda data: data in range(0, 0x10),
             )
 
+        # prescaler fraction, left at its reset value unless given
+        if self.prescaler_frac is not None:
+            await self.send_req(
+                is_write=True,
+                reg="PRF",
+                data_condition=lambda data: data == self.prescaler_frac,
+            )
+
         # random config
         if self.config is not None:
             await self.send_req(
@@ -63,7 +74,7 @@ class uart_config(bus_seq_base):
                 is_write=True,
                 reg="CFG",
                 data_condition=lambda data: (
-                    (data >> 8) == 0x3F
+                    (data >> 8) == (0x3F | (self.oversampling << 6))
                     and (data & 0xF) in range(5, 10)
                     and ((data & 0xE0) >> 5) in [0, 1, 2, 4, 5]
                     and data & 0xF == 9
@@ -125,35 +136,8 @@ class uart_config(bus_seq_base):
             await self.send_req(
                 is_write=True,
                 reg="CTRL",
-                data_condition=lambda data: data & 0b1111 == 0x7,
-            )  # tx enabled, rx enabled and loopback disabled
-
-    async def send_req(self, is_write, reg, data_condition=None):
-        # send request
-        self.create_new_item()
-        if is_write:
-            if data_condition is None:
-                await uvm_do_with(
-                    self,
-                    self.req,
-                    lambda addr: addr == self.adress_dict[reg],
-                    lambda kind: kind == bus_item.WRITE,
-                )
-            else:
-                await uvm_do_with(
-                    self,
-                    self.req,
-                    lambda addr: addr == self.adress_dict[reg],
-                    lambda kind: kind == bus_item.WRITE,
-                    data_condition,
-                )
-        else:
-            await uvm_do_with(
-                self,
-                self.req,
-                lambda addr: addr == self.adress_dict[reg],
-                lambda kind: kind == bus_item.READ,
-            )
+                data_condition=lambda data: data & 0b1111 == 0x7 and data & 0x3000 == 0,
+            )  # tx enabled, rx enabled and loopback disabled; the synchronous mode has a test of its own
 
 
 uvm_object_utils(uart_config)
@@ -0,0 +1,74 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+import random
+from EF_UVM.bus_env.bus_item import bus_item
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
+from uart_seq_lib.uart_config import uart_config
+from uvm.seq import UVMSequence
+from uart_item.uart_item import uart_item
+from cocotb.triggers import NextTimeStep
+
+
+class uart_crc_rx_seq(UVMSequence):
+    """ip side of the CRC test; a frame of random characters, longer than the one the bus sequence sends"""
+
+    def __init__(self, handshake_event, name="uart_crc_rx_seq"):
+        UVMSequence.__init__(self, name)
+        self.handshake_event = handshake_event
+        self.req = uart_item()
+        self.rsp = uart_item()
+
+    async def body(self):
+        while True:
+            await self.handshake_event.wait()
+            self.handshake_event.clear()
+            for _ in range(random.randint(9, 12)):
+                await uvm_do_with(
+                    self,
+                    self.req,
+                    lambda direction: direction == uart_item.RX,
+                )
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+
+
+class uart_crc_seq(uart_bus_seq_base):
+    """random CRC settings of every width; a frame is sent and received at the same time and both CRCs are read.
+    The received frame is the longer one, so the transmitter is done and CRC_TX complete when it ends"""
+
+    def __init__(self, handshake_event, ip_seq, name="uart_crc_seq"):
+        super().__init__(name)
+        self.handshake_event = handshake_event
+        self.ip_seq = ip_seq
+
+    async def body(self):
+        await super().body()
+        # 8 data bits, no parity; EN | TXEN | RXEN
+        await uvm_do(self, uart_config(im=0, config=0x3F08, control=0x7))
+        for _ in range(16):
+            size = random.randint(0, 2)
+            width = 8 << size
+            reflect = random.choice([0, 0b11000])
+            invert = random.choice([0, 0b100000])
+            await self.send_req(True, "CRC_CTRL", lambda data: data == 0)
+            poly = random.randint(0, (1 << width) - 1) | 1
+            await self.send_req(True, "CRC_POLY", lambda data: data == poly)
+            init = random.choice([0, (1 << width) - 1, random.randint(0, (1 << width) - 1)])
+            await self.send_req(True, "CRC_INIT", lambda data: data == init)
+            await self.send_req(True, "CRC_CTRL", lambda data: data == 0b1 | size << 1 | reflect | invert)
+            await self.send_req(True, "CRC_RST", lambda data: data == 0b11)
+            for _ in range(random.randint(1, 8)):
+                value = random.randint(0, 0xFF)
+                await self.send_req(True, "TXDATA", lambda data: data == value)
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+            await self.handshake_event.wait()  # wait until the sequencer in the ip sequencer is done
+            self.handshake_event.clear()
+            await self.send_req(False, "CRC_RX")
+            await self.send_req(False, "CRC_TX")
+            for _ in range(16):
+                await self.send_req(False, "RXDATA")
+
+
+uvm_object_utils(uart_crc_rx_seq)
+uvm_object_utils(uart_crc_seq)
@@ -0,0 +1,62 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_message_defines import uvm_info, uvm_error
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+from uvm.base import UVM_LOW
+from EF_UVM.bus_env.bus_item import bus_item
+from cocotb.triggers import ClockCycles, RisingEdge, with_timeout
+from cocotb.result import SimTimeoutError
+import random
+from uart_seq_lib.uart_config import uart_config
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
+
+
+class uart_flow_control_seq(uart_bus_seq_base):
+    """exercise CTS stalls on the TX side and the RTS watermark on the RX side.
+    Needs a uart_rx_seq running on the ip sequencer in parallel to feed RX."""
+
+    def __init__(self, name="uart_flow_control_seq", rts_level=8):
+        super().__init__(name)
+        self.tag = name
+        self.rts_level = rts_level
+
+    async def body(self):
+        await super().body()
+        # EN | TXEN | RXEN | RTSEN | CTSEN
+        config_seq = uart_config("uart_config", control=0x187)
+        await uvm_do(self, config_seq)
+        await self.send_req(True, "RTS", lambda data: data == self.rts_level)
+        await self.cts_stall()
+        await self.rts_watermark()
+
+    async def cts_stall(self):
+        vif = self.monitor.vif
+        vif.CTS_n.value = 1
+        count = random.randint(1, 8)
+        for _ in range(count):
+            value = random.randint(0, 0xFF)
+            await self.send_req(True, "TXDATA", lambda data: data == value)
+        # nothing may leave while the peer holds CTS high
+        try:
+            await with_timeout(self.monitor.tx_received.wait(), 50000, "ns")
+            uvm_error(self.tag, "TX sent a character while CTS_n was high")
+        except SimTimeoutError:
+            pass
+        vif.CTS_n.value = 0
+        for _ in range(count):
+            await self.monitor.tx_received.wait()
+            self.monitor.tx_received.clear()
+        uvm_info(self.tag, f"{count} characters released after CTS stall", UVM_LOW)
+
+    async def rts_watermark(self):
+        vif = self.monitor.vif
+        # the ip side keeps sending; RTS_n must rise once the level is reached
+        await RisingEdge(vif.RTS_n)
+        await ClockCycles(vif.PCLK, random.randint(1000, 20000))
+        await self.send_req(False, "RX_FIFO_LEVEL")
+        for _ in range(self.rts_level + 1):
+            await self.send_req(False, "RXDATA")
+        # let the rest of the ip sequence through
+        await self.send_req(True, "CTRL", lambda data: data == 0x7)
+
+
+uvm_object_utils(uart_flow_control_seq)
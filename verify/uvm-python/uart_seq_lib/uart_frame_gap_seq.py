@@ -0,0 +1,68 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+import random
+from EF_UVM.bus_env.bus_item import bus_item
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
+from uart_seq_lib.uart_config import uart_config
+from uvm.seq import UVMSequence
+from uart_item.uart_item import uart_item
+from cocotb.triggers import ClockCycles, NextTimeStep
+
+
+class uart_frame_gap_rx_seq(UVMSequence):
+    """ip side of the frame gap test; one frame of random characters, sent back to back"""
+
+    def __init__(self, handshake_event, name="uart_frame_gap_rx_seq"):
+        UVMSequence.__init__(self, name)
+        self.handshake_event = handshake_event
+        self.req = uart_item()
+        self.rsp = uart_item()
+
+    async def body(self):
+        while True:
+            await self.handshake_event.wait()
+            self.handshake_event.clear()
+            for _ in range(random.randint(1, 6)):
+                await uvm_do_with(
+                    self,
+                    self.req,
+                    lambda direction: direction == uart_item.RX,
+                )
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+
+
+class uart_frame_gap_seq(uart_bus_seq_base):
+    """frames with random gaps of 1/2 to 1 1/2 character times between them. The line is left idle for 4 characters
+    after each frame, far from the gap, and FRAME and RXDATA are not always read, so the descriptor FIFO fills up and
+    frames get merged"""
+
+    def __init__(self, handshake_event, ip_seq, name="uart_frame_gap_seq"):
+        super().__init__(name)
+        self.handshake_event = handshake_event
+        self.ip_seq = ip_seq
+
+    async def body(self):
+        await super().body()
+        # 8 data bits, no parity, two stop bits at random; EN | RXEN
+        config = random.choice([0x3F08, 0x3F18])
+        await uvm_do(self, uart_config(im=0, config=config, control=0x5))
+        gap = random.randint(8, 24)
+        await self.send_req(True, "GAP", lambda data: data == gap)
+        char_bits = 1 + 8 + 1 + ((config >> 4) & 1)
+        for _ in range(24):
+            await self.send_req(True, "IC", lambda data: data == 0x8000)
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+            await self.handshake_event.wait()  # wait until the sequencer in the ip sequencer is done
+            self.handshake_event.clear()
+            await ClockCycles(self.monitor.vif.PCLK, int(4 * char_bits * self.monitor.get_bit_n_cyc()))
+            await self.send_req(False, "RIS")
+            if random.random() < 0.6:
+                await self.send_req(False, "FRAME")
+                for _ in range(random.randint(0, 8)):
+                    await self.send_req(False, "RXDATA")
+
+
+uvm_object_utils(uart_frame_gap_rx_seq)
+uvm_object_utils(uart_frame_gap_seq)
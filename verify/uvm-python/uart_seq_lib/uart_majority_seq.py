@@ -0,0 +1,61 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+import random
+from EF_UVM.bus_env.bus_item import bus_item
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
+from uart_seq_lib.uart_config import uart_config
+from uvm.seq import UVMSequence
+from uart_item.uart_item import uart_item
+from cocotb.triggers import NextTimeStep
+
+
+class uart_majority_rx_seq(UVMSequence):
+    """ip side of the majority vote test; the driver inserts glitches (insert_glitches) into every character"""
+
+    def __init__(self, handshake_event, name="uart_majority_rx_seq"):
+        UVMSequence.__init__(self, name)
+        self.handshake_event = handshake_event
+        self.req = uart_item()
+        self.rsp = uart_item()
+
+    async def body(self):
+        while True:
+            await self.handshake_event.wait()
+            self.handshake_event.clear()
+            for _ in range(16):
+                await uvm_do_with(
+                    self,
+                    self.req,
+                    lambda direction: direction == uart_item.RX,
+                    lambda char: char in range(0, 0x100),
+                )
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+
+
+class uart_majority_seq(uart_bus_seq_base):
+    """receive glitched characters with the glitch filter off, with and without CFG.maj. With the vote the data
+    must be right; the NOISE flag depends on where the glitches land and is not checked"""
+
+    def __init__(self, handshake_event, name="uart_majority_seq"):
+        super().__init__(name)
+        self.handshake_event = handshake_event
+
+    async def body(self):
+        await super().body()
+        for _ in range(4):
+            await self.send_reset()
+            # 8 data bits, no parity, the longest receiver timeout, CFG.maj; EN | RXEN, no GFEN
+            await uvm_do(self, uart_config(im=0, config=0x13F08, control=0x5))
+            await self.send_req(True, "IC", lambda data: data == 0x3FFF)
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+            await self.handshake_event.wait()  # wait until the sequencer in the ip sequencer is done
+            self.handshake_event.clear()
+            for _ in range(16):
+                await self.send_req(False, "RXDATA")
+            await self.send_req(False, "RIS")
+
+
+uvm_object_utils(uart_majority_rx_seq)
+uvm_object_utils(uart_majority_seq)
@@ -0,0 +1,88 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+import random
+from EF_UVM.bus_env.bus_item import bus_item
+from EF_UVM.bus_env.bus_seq_lib.bus_seq_base import bus_seq_base
+from uart_seq_lib.uart_config import uart_config
+from uvm.seq import UVMSequence
+from uart_item.uart_item import uart_item
+from cocotb.triggers import NextTimeStep
+
+
+class uart_multidrop_rx_seq(UVMSequence):
+    """ip side of a shared 9-bit bus; packets of an address frame (bit 8 set) and data frames for this node,
+    for other nodes, and for the group given by the mask"""
+
+    def __init__(self, handshake_event, address, name="uart_multidrop_rx_seq"):
+        UVMSequence.__init__(self, name)
+        self.handshake_event = handshake_event
+        self.address = address
+        self.req = uart_item()
+        self.rsp = uart_item()
+
+    async def body(self):
+        while True:
+            await self.handshake_event.wait()
+            self.handshake_event.clear()
+            for _ in range(random.randint(5, 15)):
+                address = random.choice(
+                    [self.address, self.address ^ 0x80, random.randint(0, 0xFF)]
+                )
+                await uvm_do_with(
+                    self,
+                    self.req,
+                    lambda direction: direction == uart_item.RX,
+                    lambda char: char == 0x100 | address,
+                )
+                for __ in range(random.randint(0, 4)):
+                    await uvm_do_with(
+                        self,
+                        self.req,
+                        lambda direction: direction == uart_item.RX,
+                        lambda char: char in range(0, 0x100),
+                    )
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+
+
+class uart_multidrop_seq(bus_seq_base):
+    def __init__(self, handshake_event, address, name="uart_multidrop_seq"):
+        super().__init__(name)
+        self.handshake_event = handshake_event
+        self.address = address
+
+    async def body(self):
+        await super().body()
+        for mask in [0, 0x80]:
+            await self.send_reset()
+            # 9 data bits, no parity, the longest receiver timeout; EN | TXEN | RXEN | ADEN
+            await uvm_do(
+                self,
+                uart_config(
+                    im=0, config=0x3F09, match=0x100 | self.address, control=0x207
+                ),
+            )
+            self.create_new_item()
+            await uvm_do_with(
+                self,
+                self.req,
+                lambda addr: addr == self.adress_dict["MATCH_MASK"],
+                lambda kind: kind == bus_item.WRITE,
+                lambda data: data == mask,
+            )
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+            await self.handshake_event.wait()  # wait until the sequencer in the ip sequencer is done
+            self.handshake_event.clear()
+            for _ in range(16):
+                self.create_new_item()
+                await uvm_do_with(
+                    self,
+                    self.req,
+                    lambda addr: addr == self.adress_dict["RXDATA"],
+                    lambda kind: kind == bus_item.READ,
+                )
+
+
+uvm_object_utils(uart_multidrop_rx_seq)
+uvm_object_utils(uart_multidrop_seq)
@@ -0,0 +1,35 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_message_defines import uvm_info
+from uvm.macros.uvm_sequence_defines import uvm_do
+from uvm.base import UVM_LOW
+import random
+from EF_UVM.bus_env.bus_seq_lib.bus_seq_base import bus_seq_base
+from uart_seq_lib.uart_config import uart_config
+from uart_seq_lib.tx_seq import tx_seq
+
+
+# sends and receives at every oversampling ratio of CFG.osr; pairs with uart_prescalar_seq on the
+# ip sequencer, which answers every handshake with an rx_seq
+class uart_oversampling_seq_wrapper(bus_seq_base):
+
+    def __init__(self, handshake_event, name="uart_oversampling_seq_wrapper"):
+        super().__init__(name)
+        self.handshake_event = handshake_event
+        # 0: SC, 1: 16x, 2: 8x, 3: 4x; small prescalers so that 4x runs at the highest baud rates
+        self.oversampling_vals = [0, 1, 2, 3]
+        random.shuffle(self.oversampling_vals)
+        self.prescaler_vals = [random.randint(0, 3) for _ in self.oversampling_vals]
+        self.tx_seq_obj = tx_seq()
+
+    async def body(self):
+        for oversampling, prescaler_val in zip(self.oversampling_vals, self.prescaler_vals):
+            uvm_info(self.get_type_name(), f"oversampling = {oversampling} prescaler_val = {prescaler_val}", UVM_LOW)
+            await self.send_reset()
+            await uvm_do(self, uart_config(im=0, prescaler=prescaler_val, oversampling=oversampling))
+            self.handshake_event.set()
+            await uvm_do(self, self.tx_seq_obj)
+            await self.handshake_event.wait()  # wait until the sequencer in the ip sequencer is done
+            self.handshake_event.clear()
+
+
+uvm_object_utils(uart_oversampling_seq_wrapper)
@@ -5,7 +5,7 @@ from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
 from uvm.base import sv, UVM_HIGH, UVM_LOW
 from uart_item.uart_item import uart_item
 import random
-from EF_UVM.bus_env.bus_seq_lib.bus_seq_base import bus_seq_base
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
 from uart_seq_lib.uart_config import uart_config
 from uart_seq_lib.tx_seq import tx_seq
 from uart_seq_lib.rx_seq import rx_seq
@@ -31,7 +31,7 @@ class uart_prescalar_seq(UVMSequence):
             self.handshake_event.set()
 
 
-class uart_prescalar_seq_wrapper(bus_seq_base):
+class uart_prescalar_seq_wrapper(uart_bus_seq_base):
 
     def __init__(self, handshake_event, name="uart_prescalar_seq_wrapper"):
         super().__init__(name)
@@ -61,5 +61,26 @@ class uart_prescalar_seq_wrapper(bus_seq_base):
             self.handshake_event.clear()
 
 
+class uart_prescalar_frac_seq_wrapper(uart_prescalar_seq_wrapper):
+    """the prescaler sweep with a nonzero fraction in PRF for every prescaler; the monitor checks the achieved
+    rate on every TX edge"""
+
+    def __init__(self, handshake_event, name="uart_prescalar_frac_seq_wrapper"):
+        super().__init__(handshake_event, name)
+        self.prescaler_fracs = [random.randint(1, 15) for _ in self.prescaler_vals]
+
+    async def body(self):
+        # reset then set new prescalar and fraction
+        for prescaler_val, prescaler_frac in zip(self.prescaler_vals, self.prescaler_fracs):
+            uvm_info(self.get_type_name(), f"prescaler_val = {prescaler_val} prescaler_frac = {prescaler_frac}/16", UVM_LOW)
+            await self.send_reset()
+            await uvm_do(self, uart_config(im=0, prescaler=prescaler_val, prescaler_frac=prescaler_frac))
+            self.handshake_event.set()
+            await uvm_do(self, self.tx_seq_obj)
+            await self.handshake_event.wait()  # wait until the sequencer in the ip sequencer is done
+            self.handshake_event.clear()
+
+
 uvm_object_utils(uart_prescalar_seq)
 uvm_object_utils(uart_prescalar_seq_wrapper)
+uvm_object_utils(uart_prescalar_frac_seq_wrapper)
@@ -0,0 +1,111 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_message_defines import uvm_info, uvm_error
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+from uvm.base import UVM_LOW
+from EF_UVM.bus_env.bus_item import bus_item
+from cocotb.triggers import FallingEdge, RisingEdge, ReadOnly, ClockCycles, with_timeout
+from cocotb.result import SimTimeoutError
+import cocotb
+import random
+from uart_seq_lib.uart_config import uart_config
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
+
+
+class uart_rs485_seq(uart_bus_seq_base):
+    """send bursts with the RS-485 driver enable on; DE must rise before the
+    start bit, stay up through the burst and fall after the last stop bit"""
+
+    def __init__(self, name="uart_rs485_seq", bursts=5):
+        super().__init__(name)
+        self.tag = name
+        self.bursts = bursts
+
+    async def body(self):
+        await super().body()
+        # EN | TXEN | RXEN | DEEN
+        config_seq = uart_config("uart_config", control=0x407)
+        await uvm_do(self, config_seq)
+        for _ in range(self.bursts):
+            lead = random.randint(1, 15)
+            lag = random.randint(1, 15)
+            await self.send_req(True, "DE", lambda data: data == lead | lag << 4)
+            await self.burst(random.randint(1, 8))
+            await self.send_req(True, "IC", lambda data: data == 0x400)
+        await self.write_on_completion()
+
+    async def burst(self, count):
+        vif = self.monitor.vif
+        for _ in range(count):
+            value = random.randint(0, 0xFF)
+            await self.send_req(True, "TXDATA", lambda data: data == value)
+        await RisingEdge(vif.DE)
+        await FallingEdge(vif.TX)
+        for i in range(count):
+            await self.monitor.tx_received.wait()
+            self.monitor.tx_received.clear()
+            if vif.DE.value != 1:
+                uvm_error(self.tag, f"DE dropped before the end of character {i}")
+        try:
+            await with_timeout(FallingEdge(vif.DE), 1000000, "ns")
+        except SimTimeoutError:
+            uvm_error(self.tag, "DE stayed up after the last stop bit")
+        if vif.TX.value != 1:
+            uvm_error(self.tag, "DE dropped while TX was not idle")
+        await self.send_req(False, "RIS")
+        uvm_info(self.tag, f"{count} characters sent under DE", UVM_LOW)
+
+    async def write_on_completion(self):
+        """the second character is written later and later into the first one until the write lands in the cycle
+        the first one ends; that must not raise TC, and with no lag time DE must not drop between the two"""
+        vif = self.monitor.vif
+        uart = cocotb.top.dut.instance_to_wrap
+        await self.send_req(True, "DE", lambda data: data == 0)
+        self.hit = False
+        for delay in range(32):
+            await self.send_req(True, "TXDATA", lambda data: data == 0x55)
+            await FallingEdge(vif.TX)
+            if delay == 0:
+                char_cycles = await self.cycles_to_done(uart, vif)
+                await self.send_req(True, "TXDATA", lambda data: data == 0x55)
+                await FallingEdge(vif.TX)
+            watch = await cocotb.start(self.watch_completion(uart, vif))
+            await ClockCycles(vif.PCLK, char_cycles - delay)
+            await self.send_req(True, "TXDATA", lambda data: data == 0xAA)
+            for _ in range(3 if delay == 0 else 2):
+                await self.monitor.tx_received.wait()
+                self.monitor.tx_received.clear()
+            if vif.DE.value == 1:
+                await with_timeout(FallingEdge(vif.DE), 1000000, "ns")
+            watch.kill()
+            if self.hit:
+                uvm_info(self.tag, f"write in the last cycle of the character {delay} cycles before its end", UVM_LOW)
+                break
+        if not self.hit:
+            uvm_error(self.tag, "no write landed in the cycle a character ended")
+        await self.send_req(False, "RIS")
+
+    async def cycles_to_done(self, uart, vif):
+        cycles = 0
+        while True:
+            await RisingEdge(vif.PCLK)
+            await ReadOnly()
+            cycles += 1
+            if uart.tx_done.value == 1:
+                return cycles
+
+    async def watch_completion(self, uart, vif):
+        while True:
+            await RisingEdge(vif.PCLK)
+            await ReadOnly()
+            if uart.tx_done.value == 1 and uart.tx_push.value.integer != 0:
+                self.hit = True
+                if uart.tx_complete_flag.value == 1:
+                    uvm_error(self.tag, "TC raised while a write pushed the next character")
+                for _ in range(2):
+                    await RisingEdge(vif.PCLK)
+                    await ReadOnly()
+                    if vif.DE.value != 1:
+                        uvm_error(self.tag, "DE dropped between back to back characters")
+
+
+uvm_object_utils(uart_rs485_seq)
@@ -0,0 +1,73 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+import random
+from EF_UVM.bus_env.bus_item import bus_item
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
+from uart_seq_lib.uart_config import uart_config
+from uvm.seq import UVMSequence
+from uart_item.uart_item import uart_item
+from cocotb.triggers import NextTimeStep
+
+
+class uart_sync_rx_seq(UVMSequence):
+    """ip side of the sync word test; a few random characters, the sync word of the bus sequence, and a message"""
+
+    def __init__(self, handshake_event, name="uart_sync_rx_seq"):
+        UVMSequence.__init__(self, name)
+        self.handshake_event = handshake_event
+        self.req = uart_item()
+        self.rsp = uart_item()
+        self.sync_word = []
+
+    async def body(self):
+        while True:
+            await self.handshake_event.wait()
+            self.handshake_event.clear()
+            chars = [random.randint(0, 0xFF) for _ in range(random.randint(0, 4))]
+            chars += self.sync_word + [random.randint(0, 0xFF) for _ in range(random.randint(1, 8))]
+            for value in chars:
+                await uvm_do_with(
+                    self,
+                    self.req,
+                    lambda direction: direction == uart_item.RX,
+                    lambda char: char == value,
+                )
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+
+
+class uart_sync_seq(uart_bus_seq_base):
+    """random sync words of 1 to 4 characters with random masks, with and without the hunt. Writing SYNC_CTRL
+    restarts the search for every round, so the ip sequence needs no idle gap to end the previous message"""
+
+    def __init__(self, handshake_event, ip_seq, name="uart_sync_seq"):
+        super().__init__(name)
+        self.handshake_event = handshake_event
+        self.ip_seq = ip_seq
+
+    async def body(self):
+        await super().body()
+        # 8 data bits, no parity, the longest receiver timeout; EN | RXEN
+        await uvm_do(self, uart_config(im=0, config=0x3F08, control=0x5))
+        for _ in range(16):
+            length = random.randint(1, 4)
+            hunt = random.choice([False, True])
+            self.ip_seq.sync_word = [random.randint(0, 0xFF) for _ in range(length)]
+            pattern = sum(c << (8 * i) for i, c in enumerate(self.ip_seq.sync_word))
+            mask = random.choice([0, 0, 0x0F, 0xFF << (8 * (length - 1))])
+            await self.send_req(True, "SYNC_CTRL", lambda data: data == 0)
+            await self.send_req(True, "SYNC", lambda data: data == pattern)
+            await self.send_req(True, "SYNC_MASK", lambda data: data == mask)
+            await self.send_req(True, "SYNC_CTRL", lambda data: data == (length - 1) | 0b100 | (0b1000 if hunt else 0))
+            await self.send_req(True, "IC", lambda data: data == 0x4000)
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+            await self.handshake_event.wait()  # wait until the sequencer in the ip sequencer is done
+            self.handshake_event.clear()
+            await self.send_req(False, "RIS")
+            for _ in range(16):
+                await self.send_req(False, "RXDATA")
+
+
+uvm_object_utils(uart_sync_rx_seq)
+uvm_object_utils(uart_sync_seq)
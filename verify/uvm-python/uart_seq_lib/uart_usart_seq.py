@@ -0,0 +1,73 @@
+from uvm.macros.uvm_object_defines import uvm_object_utils
+from uvm.macros.uvm_sequence_defines import uvm_do_with, uvm_do
+import random
+from EF_UVM.bus_env.bus_item import bus_item
+from uart_seq_lib.uart_bus_seq_base import uart_bus_seq_base
+from uart_seq_lib.uart_config import uart_config
+from uvm.seq import UVMSequence
+from uart_item.uart_item import uart_item
+from cocotb.triggers import NextTimeStep
+
+
+class uart_usart_rx_seq(UVMSequence):
+    """ip side of the synchronous mode test; random characters clocked in back to back"""
+
+    def __init__(self, handshake_event, name="uart_usart_rx_seq"):
+        UVMSequence.__init__(self, name)
+        self.handshake_event = handshake_event
+        self.req = uart_item()
+        self.rsp = uart_item()
+
+    async def body(self):
+        while True:
+            await self.handshake_event.wait()
+            self.handshake_event.clear()
+            for _ in range(random.randint(1, 8)):
+                await uvm_do_with(
+                    self,
+                    self.req,
+                    lambda direction: direction == uart_item.RX,
+                )
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+
+
+class uart_usart_seq(uart_bus_seq_base):
+    """synchronous mode with the IP driving SCLK, or with the agent driving it (CTRL.scext), at random frame formats.
+    Characters are sent and received at the same time. The IP takes a bit per 2*(PR+1) cycles; PR starts at 1 so the
+    monitor sees tx_done after the stop bit sample, and at 4 with the agent's clock, which the IP answers 4 cycles
+    after its falling edge"""
+
+    def __init__(self, handshake_event, ip_seq, name="uart_usart_seq"):
+        super().__init__(name)
+        self.handshake_event = handshake_event
+        self.ip_seq = ip_seq
+
+    async def body(self):
+        await super().body()
+        for _ in range(12):
+            external = random.random() < 0.5
+            prescaler = random.randint(4, 7) if external else random.randint(1, 4)
+            # 5 to 9 data bits, any parity, one or two stop bits
+            config = 0x3F00 | random.randint(5, 9) | random.choice([0, 0x10]) | random.choice([0, 1, 2, 4, 5]) << 5
+            # EN | TXEN | RXEN | SCEN, and SCEXT for the agent's clock
+            control = 0x1007 | (0x2000 if external else 0)
+            await uvm_do(self, uart_config(prescaler=prescaler, prescaler_frac=0, im=0, config=config, control=control))
+            tx_chars = random.randint(1, 8)
+            for _ in range(tx_chars):
+                value = random.randint(0, (1 << (config & 0xF)) - 1)
+                await self.send_req(True, "TXDATA", lambda data: data == value)
+            self.handshake_event.set()
+            await NextTimeStep()  # wait dummy delay until event is clear
+            await self.handshake_event.wait()  # wait until the sequencer in the ip sequencer is done
+            self.handshake_event.clear()
+            for _ in range(tx_chars):  # the next round reconfigures; let the transmitter finish
+                await self.monitor.tx_received.wait()
+                self.monitor.tx_received.clear()
+            for _ in range(8):
+                await self.send_req(False, "RXDATA")
+            await self.send_req(False, "RIS")
+
+
+uvm_object_utils(uart_usart_rx_seq)
+uvm_object_utils(uart_usart_seq)